@@ -1,6 +1,5 @@
 using System;
 using XeryonEtherCAT.Core.Models;
-using XeryonEtherCAT.Core.Internal.Soem;
 
 namespace XeryonEtherCAT.App.ViewModels;
 
@@ -22,9 +21,9 @@ public sealed class DriveEventViewModel
 
     public string Keyword { get; }
 
-    public SoemShim.DriveTxPDO Current { get; }
+    public DriveStatusWord Current { get; }
 
-    public SoemShim.DriveTxPDO Previous { get; }
+    public DriveStatusWord Previous { get; }
 
     public uint ChangedMask { get; }
 
@@ -1,4 +1,3 @@
-using XeryonEtherCAT.Core.Internal.Soem;
 using XeryonEtherCAT.Core.Models;
 
 namespace XeryonEtherCAT.App.ViewModels;
@@ -6,7 +5,7 @@ namespace XeryonEtherCAT.App.ViewModels;
 public sealed class DriveStatusViewModel : ViewModelBase
 {
     private int _position;
-    private SoemShim.DriveTxPDO _status;
+    private DriveStatusWord _status;
     private string _statusText = string.Empty;
 
     public DriveStatusViewModel(int slave)
@@ -22,7 +21,7 @@ public sealed class DriveStatusViewModel : ViewModelBase
         private set => SetProperty(ref _position, value);
     }
 
-    public SoemShim.DriveTxPDO Status
+    public DriveStatusWord Status
     {
         get => _status;
         private set
@@ -40,7 +39,7 @@ public sealed class DriveStatusViewModel : ViewModelBase
         private set => SetProperty(ref _statusText, value);
     }
 
-    public void Update(in SoemShim.DriveTxPDO status)
+    public void Update(in DriveStatusWord status)
     {
         Position = status.ActualPosition;
         Status = status;
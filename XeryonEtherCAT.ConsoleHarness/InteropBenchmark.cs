@@ -0,0 +1,141 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Text;
+using XeryonEtherCAT.Core.Internal.Soem;
+using XeryonEtherCAT.Core.Models;
+
+namespace XeryonEtherCAT.ConsoleHarness;
+
+/// <summary>
+/// Per-cycle cost of staging and transferring every slave's PDOs, before and after the blittable interop rework.
+/// </summary>
+/// <remarks>
+/// "before" replays the old path: a <c>byte[]</c> keyword filled through <see cref="Encoding.GetBytes(string)"/> and a
+/// classic <c>DllImport</c> that marshals the <c>ByValArray</c> struct both ways. "after" is the current path: a
+/// pre-encoded keyword store (<see cref="CommandKeywords"/>) plus the source-generated, <c>SuppressGCTransition</c>
+/// stubs. "iomap" is the zero-copy encode the managed loop uses when the process image is mapped. Native calls go out with a null handle, so the shim returns
+/// immediately and only the transition and marshalling are measured; no bus is needed.
+/// </remarks>
+internal static class InteropBenchmark
+{
+    private static readonly int[] SlaveCounts = { 1, 16, 200 };
+    private const int CallsPerRun = 2_000_000;
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    private struct LegacyDriveRxPDO
+    {
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 32)]
+        public byte[] Command;
+        public int Parameter;
+        public int Velocity;
+        public ushort Acceleration;
+        public ushort Deceleration;
+        public byte Execute;
+    }
+
+    [DllImport("soemshim", EntryPoint = "soem_write_rxpdo", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int LegacyWriteRxPdo(IntPtr h, int slaveIndex, ref LegacyDriveRxPDO inPdo);
+
+    [DllImport("soemshim", EntryPoint = "soem_read_txpdo", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int LegacyReadTxPdo(IntPtr h, int slaveIndex, out SoemShim.DriveTxPDO outPdo);
+
+    public static void Run(ConsoleWriter writer)
+    {
+        var native = true;
+        try
+        {
+            SoemShim.soem_expected_rx_bytes();
+        }
+        catch (DllNotFoundException)
+        {
+            native = false;
+            writer.WriteLine("soemshim not found: measuring staging only (native calls skipped).");
+        }
+
+        writer.WriteLine($"{"slaves",6} | {"path",-6} | {"ns/slave",9} | {"us/cycle",9} | {"B/cycle",8}");
+        foreach (var slaves in SlaveCounts)
+        {
+            var cycles = Math.Max(1000, CallsPerRun / slaves);
+            Report(writer, slaves, "before", cycles, () => RunLegacy(slaves, native));
+            Report(writer, slaves, "after", cycles, () => RunBlittable(slaves, native));
+            Report(writer, slaves, "iomap", cycles, () => RunProcessImage(slaves));
+        }
+    }
+
+    private static void Report(ConsoleWriter writer, int slaves, string path, int cycles, Func<Action> setup)
+    {
+        var cycle = setup();
+        for (var i = 0; i < Math.Min(cycles, 10_000); i++)
+        {
+            cycle();
+        }
+
+        var allocated = GC.GetAllocatedBytesForCurrentThread();
+        var start = Stopwatch.GetTimestamp();
+        for (var i = 0; i < cycles; i++)
+        {
+            cycle();
+        }
+
+        var elapsed = Stopwatch.GetElapsedTime(start);
+        allocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+        var perCycleNs = elapsed.TotalNanoseconds / cycles;
+        writer.WriteLine($"{slaves,6} | {path,-6} | {perCycleNs / slaves,9:F1} | {perCycleNs / 1000,9:F2} | {allocated / cycles,8}");
+    }
+
+    private static Action RunLegacy(int slaves, bool native)
+    {
+        var rx = new LegacyDriveRxPDO[slaves];
+        return () =>
+        {
+            for (var i = 0; i < slaves; i++)
+            {
+                ref var pdo = ref rx[i];
+                pdo.Command = new byte[32];
+                var ascii = Encoding.ASCII.GetBytes("NOP");
+                Array.Copy(ascii, pdo.Command, ascii.Length);
+                if (native)
+                {
+                    LegacyWriteRxPdo(IntPtr.Zero, i + 1, ref pdo);
+                    LegacyReadTxPdo(IntPtr.Zero, i + 1, out _);
+                }
+            }
+        };
+    }
+
+    private static Action RunBlittable(int slaves, bool native)
+    {
+        var rx = new SoemShim.DriveRxPDO[slaves];
+        return () =>
+        {
+            for (var i = 0; i < slaves; i++)
+            {
+                ref var pdo = ref rx[i];
+                CommandKeywords.Write(ref pdo, CommandKeywords.Nop);
+                if (native)
+                {
+                    SoemShim.soem_write_rxpdo(IntPtr.Zero, i + 1, in pdo);
+                    SoemShim.soem_read_txpdo(IntPtr.Zero, i + 1, out _);
+                }
+            }
+        };
+    }
+
+    private static Action RunProcessImage(int slaves)
+    {
+        var rx = new SoemShim.DriveRxPDO[slaves];
+        var image = new byte[slaves * (PdoCodec.RxBytes + PdoCodec.TxBytes)];
+        var inputs = slaves * PdoCodec.RxBytes;
+        return () =>
+        {
+            for (var i = 0; i < slaves; i++)
+            {
+                ref var pdo = ref rx[i];
+                CommandKeywords.Write(ref pdo, CommandKeywords.Nop);
+                PdoCodec.EncodeRx(pdo, image.AsSpan(i * PdoCodec.RxBytes, PdoCodec.RxBytes));
+                PdoCodec.DecodeTx(image.AsSpan(inputs + i * PdoCodec.TxBytes, PdoCodec.TxBytes), out _);
+            }
+        };
+    }
+}
@@ -0,0 +1,98 @@
+using System.Diagnostics;
+using XeryonEtherCAT.Core.Internal.Soem;
+using XeryonEtherCAT.Core.Models;
+using XeryonEtherCAT.Core.Options;
+using XeryonEtherCAT.Core.Services;
+
+namespace XeryonEtherCAT.ConsoleHarness;
+
+/// <summary>
+/// How 1 to 4 buses in one process scale: an <see cref="EthercatBusHost"/> over simulated buses of 16 slaves at
+/// 1 ms, once with the thread-pool IO loop and once with a dedicated IO thread per bus (pinned to its own CPU when
+/// the machine has enough of them).
+/// </summary>
+/// <remarks>
+/// "rate" is the slowest bus's achieved cycle rate and "missed" the share of 1 ms periods it did not run, both from
+/// the status sequence over the measuring window. "max" is the longest IO loop iteration of any bus. "cpu" is
+/// process CPU time per cycle across all buses; a dedicated thread spins through the last millisecond before each
+/// deadline, so at a 1 ms period that figure is mostly spinning and says more about core usage than about work.
+/// The simulator stands in for the shim, so no NIC is needed and the wire round trip is not included.
+/// </remarks>
+internal static class MultiBusBenchmark
+{
+    private const int MaxBuses = 4;
+    private const int SlavesPerBus = 16;
+    private static readonly TimeSpan Period = TimeSpan.FromMilliseconds(1);
+    private static readonly TimeSpan Warmup = TimeSpan.FromMilliseconds(500);
+    private static readonly TimeSpan Window = TimeSpan.FromSeconds(3);
+
+    public static async Task RunAsync(ConsoleWriter writer, CancellationToken ct = default)
+    {
+        writer.WriteLine($"{Environment.ProcessorCount} CPU(s), {SlavesPerBus} simulated slaves per bus, {Period.TotalMilliseconds} ms cycle");
+        writer.WriteLine($"{"buses",5} | {"loop",-6} | {"pinned",-6} | {"rate Hz",8} | {"missed",7} | {"max us",8} | {"cpu us/cycle",12}");
+        for (var buses = 1; buses <= MaxBuses; buses++)
+        {
+            await MeasureAsync(writer, buses, dedicated: false, ct).ConfigureAwait(false);
+            await MeasureAsync(writer, buses, dedicated: true, ct).ConfigureAwait(false);
+        }
+    }
+
+    private static async Task MeasureAsync(ConsoleWriter writer, int count, bool dedicated, CancellationToken ct)
+    {
+        var pinned = dedicated && Environment.ProcessorCount >= count;
+        var buses = new EthercatBusOptions[count];
+        for (var i = 0; i < count; i++)
+        {
+            buses[i] = new EthercatBusOptions
+            {
+                Name = $"bus{i}",
+                Interface = $"sim{i}",
+                Drive = new EthercatDriveOptions
+                {
+                    CyclePeriod = Period,
+                    DedicatedIoThread = dedicated,
+                    IoThreadCpu = pinned ? i : -1
+                }
+            };
+        }
+
+        await using var host = new EthercatBusHost(buses, clientFactory: _ => new SimulatedSoemClient(SlavesPerBus));
+        await host.InitializeAsync(ct).ConfigureAwait(false);
+        await Task.Delay(Warmup, ct).ConfigureAwait(false);
+
+        var process = Process.GetCurrentProcess();
+        var start = Sequences(host);
+        var cpuStart = process.TotalProcessorTime;
+        var clock = Stopwatch.StartNew();
+        await Task.Delay(Window, ct).ConfigureAwait(false);
+        var end = Sequences(host);
+        process.Refresh();
+        var cpu = process.TotalProcessorTime - cpuStart;
+        var elapsed = clock.Elapsed;
+
+        long cycles = 0;
+        var slowest = long.MaxValue;
+        for (var i = 0; i < count; i++)
+        {
+            var ran = end[i] - start[i];
+            cycles += ran;
+            slowest = Math.Min(slowest, ran);
+        }
+
+        var rate = slowest / elapsed.TotalSeconds;
+        var missed = Math.Max(0, 1 - rate * Period.TotalSeconds);
+        var max = host.GetStatus().MaxCycleTime;
+        writer.WriteLine($"{count,5} | {(dedicated ? "thread" : "pool"),-6} | {(pinned ? "yes" : "no"),-6} | {rate,8:F0} | {missed,7:P1} | {max.TotalMicroseconds,8:F0} | {cpu.TotalMicroseconds / Math.Max(1, cycles),12:F1}");
+    }
+
+    private static long[] Sequences(EthercatBusHost host)
+    {
+        var sequences = new long[host.Count];
+        for (var i = 0; i < host.Count; i++)
+        {
+            sequences[i] = host[i].GetStatus(Span<DriveStatus>.Empty).Sequence;
+        }
+
+        return sequences;
+    }
+}
@@ -122,6 +122,18 @@ internal sealed class Harness : IAsyncDisposable
                     case "12":
                         await ToggleGrpcServerAsync().ConfigureAwait(false);
                         break;
+                    case "13":
+                        InteropBenchmark.Run(_consoleWriter);
+                        break;
+                    case "14":
+                        StatusScanBenchmark.Run(_consoleWriter);
+                        break;
+                    case "15":
+                        await MultiBusBenchmark.RunAsync(_consoleWriter).ConfigureAwait(false);
+                        break;
+                    case "16":
+                        await SdoBenchmark.RunAsync(_consoleWriter).ConfigureAwait(false);
+                        break;
                     case "0":
                         exit = true;
                         break;
@@ -167,6 +179,10 @@ internal sealed class Harness : IAsyncDisposable
         Console.WriteLine("10) Reset / homing / recovery workflow");
         Console.WriteLine("11) Toggle MQTT bridge");
         Console.WriteLine("12) Toggle gRPC server");
+        Console.WriteLine("13) PDO interop benchmark (1/16/200 slaves)");
+        Console.WriteLine("14) Status scan benchmark (8/64/200 slaves)");
+        Console.WriteLine("15) Multi-bus scaling benchmark (1-4 simulated buses)");
+        Console.WriteLine("16) SDO load benchmark (cycle with and without SDO traffic)");
         Console.WriteLine(" 0) Exit");
     }
 
@@ -249,7 +265,7 @@ internal sealed class Harness : IAsyncDisposable
 
     private void OnFaulted(object? sender, SoemFaultEvent e)
     {
-        var status = DriveStateFormatter.DriveTxPdoToHexString(e.Status);
+        var status = DriveStateFormatter.StatusWordToHexString(e.Status);
         _logger.LogError("Fault reported for slave {Slave}: {Error}, txPDO: {rawHex}", e.Slave, e.Error, status);
         var message = $"Fault detected on slave {e.Slave}: {e.Error.Code} - {e.Error.Message} (tx={status})";
         _eventQueue.TryEnqueue(new ConsoleMessage(message, ConsoleColor.Red));
@@ -372,16 +388,51 @@ internal sealed class Harness : IAsyncDisposable
         _consoleWriter.WriteLine($"Slaves: {count}, Operational: {snapshot.Health.SlavesOperational}, WKC: {snapshot.Health.LastWkc}/{snapshot.Health.GroupExpectedWkc}");
         _consoleWriter.WriteLine($"IO bytes: out={snapshot.Health.BytesOut} in={snapshot.Health.BytesIn}");
         _consoleWriter.WriteLine($"Cycle: last={snapshot.CycleTime.TotalMilliseconds:F2} ms min={snapshot.MinCycleTime.TotalMilliseconds:F2} ms max={snapshot.MaxCycleTime.TotalMilliseconds:F2} ms");
+        _consoleWriter.WriteLine($"Bus round trip: {snapshot.RoundTripTime.TotalMilliseconds:F3} ms, host work: {snapshot.HostTime.TotalMilliseconds:F3} ms");
+        var stats = service.GetCycleStatistics();
+        if (stats.Total.Count > 0)
+        {
+            _consoleWriter.WriteLine($"Last {stats.Interval.TotalSeconds:F1} s ({stats.Total.Count} cycles), p50/p99/p99.9 [max] in us:");
+            WriteLatency("  round trip", stats.RoundTrip);
+            WriteLatency("  wake late ", stats.WakeLateness);
+            WriteLatency("  total     ", stats.Total);
+        }
+
+        var dc = snapshot.Health.DistributedClock;
+        if (dc.Active)
+        {
+            _consoleWriter.WriteLine($"SYNC0: {dc.Sync0Slaves} slaves, cycle={dc.CycleNs} ns lead={dc.LeadNs} ns, offset={dc.OffsetNs} ns [{dc.MinOffsetNs}..{dc.MaxOffsetNs}], drift={dc.DriftPpb} ppb, correction={dc.CorrectionNs} ns");
+        }
+
+        var ring = snapshot.Health.Redundancy;
+        if (ring.Enabled)
+        {
+            _consoleWriter.WriteLine($"Ring: {ring}, degraded cycles={ring.DegradedCycles}, topology changes={ring.TopologyChanges}");
+        }
+
+        var groups = new SoemGroupStatus[4];
+        var groupCount = Math.Min(service.GetGroupStatus(groups), groups.Length);
+        for (var g = 0; groupCount > 1 && g < groupCount; g++)
+        {
+            _consoleWriter.WriteLine($"Process data {groups[g]}");
+        }
 
         for (var i = 0; i < snapshot.DriveStates.Length; i++)
         {
             var status = snapshot.DriveStates[i];
-            var mask = DriveStateFormatter.ToBitMask(status);
-            var hex = DriveStateFormatter.DriveTxPdoToHexString(status);
+            var hex = DriveStateFormatter.StatusWordToHexString(status);
             _consoleWriter.WriteLine($"Slave {i + 1}: {hex} [{DriveStateFormatter.Describe(status)}]");
         }
     }
 
+    private void WriteLatency(string label, SoemLatencySummary latency)
+    {
+        if (latency.Count > 0)
+        {
+            _consoleWriter.WriteLine($"{label}: {latency.P50.TotalMicroseconds:F1} / {latency.P99.TotalMicroseconds:F1} / {latency.P999.TotalMicroseconds:F1} [{latency.Max.TotalMicroseconds:F1}]");
+        }
+    }
+
     private async Task RunSoakTestAsync()
     {
         var service = RequireService();
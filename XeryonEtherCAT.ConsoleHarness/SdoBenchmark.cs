@@ -0,0 +1,82 @@
+using System.Diagnostics;
+using XeryonEtherCAT.Core.Internal.Soem;
+using XeryonEtherCAT.Core.Options;
+using XeryonEtherCAT.Core.Services;
+
+namespace XeryonEtherCAT.ConsoleHarness;
+
+/// <summary>
+/// What SDO traffic costs the cycle: one simulated bus of 16 slaves at 1 ms on a dedicated IO thread, once idle and
+/// once with 0x1018:4 reads kept in flight to every slave, for several SDO worker counts and per-cycle mailbox budgets.
+/// </summary>
+/// <remarks>
+/// "p99"/"max" are the iteration time percentiles of the last 1 s statistics window. "SDO/s" is completed transfers
+/// per second, "service max" the longest mailbox handler pass and "latency max" the longest submit-to-result time.
+/// The simulator stands in for the shim and moves one mailbox per handler action, so the figures show the scheduling
+/// cost and the transfer rate the per-cycle action budget allows, not the wire time of a real mailbox exchange.
+/// </remarks>
+internal static class SdoBenchmark
+{
+    private const int Slaves = 16;
+    private static readonly TimeSpan Period = TimeSpan.FromMilliseconds(1);
+    private static readonly TimeSpan Warmup = TimeSpan.FromMilliseconds(500);
+    private static readonly TimeSpan Window = TimeSpan.FromSeconds(2);
+
+    public static async Task RunAsync(ConsoleWriter writer, CancellationToken ct = default)
+    {
+        writer.WriteLine($"{Slaves} simulated slaves, {Period.TotalMilliseconds} ms cycle, dedicated IO thread");
+        writer.WriteLine($"{"load",-8} | {"workers",7} | {"mbx",3} | {"rate Hz",8} | {"p99 us",7} | {"max us",7} | {"SDO/s",7} | {"service max us",14} | {"latency max ms",14}");
+        await MeasureAsync(writer, workers: 0, mailboxes: 0, ct).ConfigureAwait(false);
+        await MeasureAsync(writer, workers: 1, mailboxes: 2, ct).ConfigureAwait(false);
+        await MeasureAsync(writer, workers: 4, mailboxes: 2, ct).ConfigureAwait(false);
+        await MeasureAsync(writer, workers: 4, mailboxes: 8, ct).ConfigureAwait(false);
+    }
+
+    private static async Task MeasureAsync(ConsoleWriter writer, int workers, int mailboxes, CancellationToken ct)
+    {
+        var options = new EthercatDriveOptions
+        {
+            CyclePeriod = Period,
+            DedicatedIoThread = true,
+            SdoWorkers = workers,
+            SdoMailboxesPerCycle = mailboxes
+        };
+        await using var service = new EthercatDriveService(options, null, new SimulatedSoemClient(Slaves));
+        await service.InitializeAsync("sim", ct).ConfigureAwait(false);
+        await Task.Delay(Warmup, ct).ConfigureAwait(false);
+
+        using var stop = CancellationTokenSource.CreateLinkedTokenSource(ct);
+        var load = workers == 0
+            ? Task.CompletedTask
+            : Task.WhenAll(Enumerable.Range(1, Slaves).Select(slave => ReadLoopAsync(service, slave, stop.Token)));
+
+        var start = service.GetStatus(Span<Core.Models.DriveStatus>.Empty).Sequence;
+        var completedStart = service.GetSdoStatistics().Completed;
+        var clock = Stopwatch.StartNew();
+        await Task.Delay(Window, ct).ConfigureAwait(false);
+        var cycles = service.GetStatus(Span<Core.Models.DriveStatus>.Empty).Sequence - start;
+        var sdo = service.GetSdoStatistics();
+        var elapsed = clock.Elapsed;
+        stop.Cancel();
+        await load.ConfigureAwait(false);
+
+        var total = service.GetCycleStatistics().Total;
+        writer.WriteLine($"{(workers == 0 ? "idle" : "0x1018:4"),-8} | {workers,7} | {mailboxes,3} | {cycles / elapsed.TotalSeconds,8:F0} | {total.P99.TotalMicroseconds,7:F0} | {total.Max.TotalMicroseconds,7:F0} | " +
+            $"{(sdo.Completed - completedStart) / elapsed.TotalSeconds,7:F0} | {sdo.MaxServiceTime.TotalMicroseconds,14:F1} | {sdo.MaxLatency.TotalMilliseconds,14:F1}");
+    }
+
+    private static async Task ReadLoopAsync(EthercatDriveService service, int slave, CancellationToken ct)
+    {
+        while (!ct.IsCancellationRequested)
+        {
+            try
+            {
+                await service.ReadSdoAsync(slave, 0x1018, 4, ct).ConfigureAwait(false);
+            }
+            catch (OperationCanceledException)
+            {
+                return;
+            }
+        }
+    }
+}
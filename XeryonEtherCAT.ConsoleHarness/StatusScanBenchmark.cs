@@ -0,0 +1,166 @@
+using System.Diagnostics;
+using XeryonEtherCAT.Core.Internal.Soem;
+using XeryonEtherCAT.Core.Models;
+
+namespace XeryonEtherCAT.ConsoleHarness;
+
+/// <summary>
+/// Per-cycle cost of finding which axes' inputs changed, and of expanding packed status words to the
+/// byte-per-flag <see cref="SoemShim.DriveTxPDO"/>, per kernel the shim can run.
+/// </summary>
+/// <remarks>
+/// "diff" rows compare the whole input block against the previous cycle's (one axis in eight moves every cycle,
+/// as with a few axes in motion): "managed" is the per-axis <see cref="DriveStatusWord.FromWire"/> decode and
+/// compare the IO loop did before <c>soem_scan_inputs</c>; the others call <c>soem_diff_inputs</c> with that
+/// kernel forced. "expand" rows time <c>soem_expand_status</c> against <see cref="DriveStatusWord.ToPdo"/>.
+/// Kernels above <c>soem_simd_level()</c> are skipped. No bus is needed.
+/// </remarks>
+internal static unsafe class StatusScanBenchmark
+{
+    private static readonly int[] SlaveCounts = { 8, 64, 200 };
+    private const int AxesPerCycle = 2_000_000;
+
+    public static void Run(ConsoleWriter writer)
+    {
+        int level;
+        try
+        {
+            level = SoemShim.soem_simd_level();
+        }
+        catch (DllNotFoundException)
+        {
+            writer.WriteLine("soemshim not found: the scan kernels live in the shim, nothing to measure.");
+            return;
+        }
+
+        writer.WriteLine($"best kernel: {IsaName(level)}");
+        writer.WriteLine($"{"slaves",6} | {"op",-6} | {"kernel",-7} | {"ns/slave",9} | {"ns/cycle",9}");
+        foreach (var slaves in SlaveCounts)
+        {
+            var cycles = Math.Max(1000, AxesPerCycle / slaves);
+            Report(writer, slaves, "diff", "managed", cycles, ManagedDiff(slaves));
+            for (var isa = SoemShim.SOEM_ISA_SCALAR; isa <= level; isa++)
+            {
+                Report(writer, slaves, "diff", IsaName(isa), cycles, NativeDiff(slaves, isa));
+            }
+
+            Report(writer, slaves, "expand", "managed", cycles, ManagedExpand(slaves));
+            for (var isa = SoemShim.SOEM_ISA_SCALAR; isa <= level; isa++)
+            {
+                Report(writer, slaves, "expand", IsaName(isa), cycles, NativeExpand(slaves, isa));
+            }
+        }
+    }
+
+    private static string IsaName(int isa) => isa switch
+    {
+        SoemShim.SOEM_ISA_SCALAR => "scalar",
+        SoemShim.SOEM_ISA_SSE2 => "sse2",
+        SoemShim.SOEM_ISA_AVX2 => "avx2",
+        _ => isa.ToString()
+    };
+
+    private static void Report(ConsoleWriter writer, int slaves, string op, string kernel, int cycles, Action<int> cycle)
+    {
+        for (var i = 0; i < Math.Min(cycles, 10_000); i++)
+        {
+            cycle(i);
+        }
+
+        var start = Stopwatch.GetTimestamp();
+        for (var i = 0; i < cycles; i++)
+        {
+            cycle(i);
+        }
+
+        var perCycleNs = Stopwatch.GetElapsedTime(start).TotalNanoseconds / cycles;
+        writer.WriteLine($"{slaves,6} | {op,-6} | {kernel,-7} | {perCycleNs / slaves,9:F2} | {perCycleNs,9:F1}");
+    }
+
+    /// <summary>
+    /// Advances the position of every eighth axis, starting at a different one each cycle.
+    /// </summary>
+    private static void Move(byte[] inputs, int slaves, int cycle)
+    {
+        for (var i = cycle & 7; i < slaves; i += 8)
+        {
+            inputs[i * PdoCodec.TxBytes] = (byte)cycle;
+        }
+    }
+
+    private static Action<int> ManagedDiff(int slaves)
+    {
+        var inputs = new byte[slaves * PdoCodec.TxBytes];
+        var previous = new DriveStatusWord[slaves];
+        var changed = new uint[(slaves + 31) / 32];
+        return cycle =>
+        {
+            Move(inputs, slaves, cycle);
+            Array.Clear(changed);
+            for (var i = 0; i < slaves; i++)
+            {
+                var word = DriveStatusWord.FromWire(inputs.AsSpan(i * PdoCodec.TxBytes, PdoCodec.TxBytes));
+                if (word != previous[i])
+                {
+                    previous[i] = word;
+                    changed[i >> 5] |= 1u << (i & 31);
+                }
+            }
+        };
+    }
+
+    private static Action<int> NativeDiff(int slaves, int isa)
+    {
+        var inputs = new byte[slaves * PdoCodec.TxBytes];
+        var previous = new byte[inputs.Length];
+        var changed = new uint[(slaves + 31) / 32];
+        return cycle =>
+        {
+            Move(inputs, slaves, cycle);
+            fixed (byte* cur = inputs)
+            fixed (byte* prev = previous)
+            fixed (uint* bits = changed)
+            {
+                SoemShim.soem_diff_inputs(cur, prev, slaves, bits, changed.Length, isa);
+            }
+        };
+    }
+
+    private static DriveStatusWord[] CreateWords(int slaves)
+    {
+        var words = new DriveStatusWord[slaves];
+        for (var i = 0; i < slaves; i++)
+        {
+            words[i] = new DriveStatusWord(i * 1000, (DriveStatusFlags)((uint)i * 0x9E3779B1u), (byte)i);
+        }
+
+        return words;
+    }
+
+    private static Action<int> ManagedExpand(int slaves)
+    {
+        var words = CreateWords(slaves);
+        var pdos = new SoemShim.DriveTxPDO[slaves];
+        return _ =>
+        {
+            for (var i = 0; i < slaves; i++)
+            {
+                pdos[i] = words[i].ToPdo();
+            }
+        };
+    }
+
+    private static Action<int> NativeExpand(int slaves, int isa)
+    {
+        var words = CreateWords(slaves);
+        var pdos = new SoemShim.DriveTxPDO[slaves];
+        return _ =>
+        {
+            fixed (DriveStatusWord* input = words)
+            fixed (SoemShim.DriveTxPDO* output = pdos)
+            {
+                SoemShim.soem_expand_status(input, output, slaves, isa);
+            }
+        };
+    }
+}
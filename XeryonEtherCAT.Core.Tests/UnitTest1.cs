@@ -5,9 +5,11 @@ using System.Linq;
 using System.Reflection;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
+using XeryonEtherCAT.Core.Abstractions;
 using XeryonEtherCAT.Core.Internal.Soem;
 using XeryonEtherCAT.Core.Models;
 using XeryonEtherCAT.Core.Services;
+using XeryonEtherCAT.Core.Utilities;
 using Xunit;
 
 namespace XeryonEtherCAT.Core.Tests;
@@ -17,18 +19,31 @@ public sealed class SoemShimImportTests
     [Fact]
     public void AllNativeMethodsAreBoundToSoemShimLibrary()
     {
-        var methods = typeof(SoemShim).GetMethods(BindingFlags.Static | BindingFlags.NonPublic);
+        var methods = typeof(SoemShim).GetMethods(BindingFlags.Static | BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.DeclaredOnly)
+            .Where(m => m.Name.StartsWith("soem_", StringComparison.Ordinal))
+            .ToArray();
         Assert.NotEmpty(methods);
 
         foreach (var method in methods)
         {
-            var import = method.GetCustomAttribute<DllImportAttribute>();
+            var import = method.GetCustomAttribute<LibraryImportAttribute>();
             Assert.NotNull(import);
-            Assert.Equal("soemshim", import!.Value);
-            Assert.Equal(CallingConvention.Cdecl, import.CallingConvention);
+            Assert.Equal("soemshim", import!.LibraryName);
+            var callConv = method.GetCustomAttribute<UnmanagedCallConvAttribute>();
+            Assert.NotNull(callConv);
+            Assert.Contains(typeof(CallConvCdecl), callConv!.CallConvs!);
         }
     }
 
+    [Fact]
+    public void PdoStructsAreBlittable()
+    {
+        Assert.False(RuntimeHelpers.IsReferenceOrContainsReferences<SoemShim.DriveRxPDO>());
+        Assert.False(RuntimeHelpers.IsReferenceOrContainsReferences<SoemShim.DriveTxPDO>());
+        Assert.Equal(45, Unsafe.SizeOf<SoemShim.DriveRxPDO>());
+        Assert.Equal(27, Unsafe.SizeOf<SoemShim.DriveTxPDO>());
+    }
+
     [Fact]
     public void MissingNativeLibrarySurfacesAsDllNotFound()
     {
@@ -52,6 +67,75 @@ public sealed class SoemShimLayoutTests
         var size = Marshal.SizeOf<SoemShim.DriveTxPDO>();
         Assert.Equal(27, size);
     }
+
+    [Fact]
+    public void ErrorRecordMatchesNativeSize()
+    {
+        Assert.Equal(32, Marshal.SizeOf<SoemShim.SoemErrorRecord>());
+        Assert.Equal(26, (int)Marshal.OffsetOf<SoemShim.SoemErrorRecord>(nameof(SoemShim.SoemErrorRecord.subindex)));
+    }
+
+    [Fact]
+    public void SlaveStateMatchesNativeSize()
+    {
+        Assert.Equal(8, Marshal.SizeOf<SoemShim.SoemSlaveState>());
+        Assert.Equal(32, Marshal.SizeOf<SoemShim.SoemStateInfo>());
+    }
+
+    [Fact]
+    public void RedundancyMatchesNativeSize()
+    {
+        Assert.Equal(72, Marshal.SizeOf<SoemShim.SoemRedundancy>());
+        Assert.Equal(48, Marshal.SizeOf<SoemShim.SoemRtSample>());
+    }
+
+    [Fact]
+    public void GroupStatusMatchesNativeSize()
+    {
+        Assert.Equal(56, Marshal.SizeOf<SoemShim.SoemGroupStatus>());
+        Assert.Equal(120, Marshal.SizeOf<SoemShim.SoemInitOptions>());
+    }
+
+    [Fact]
+    public void NicRecordsMatchNativeSize()
+    {
+        Assert.Equal(48, Marshal.SizeOf<SoemShim.SoemNicStats>());
+        Assert.Equal(72, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.nic_backend)));
+    }
+
+    [Fact]
+    public void CaptureRecordsMatchNativeSize()
+    {
+        Assert.Equal(56, Marshal.SizeOf<SoemShim.SoemCaptureStats>());
+        Assert.Equal(80, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.capture_dir)));
+        Assert.Equal(96, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.capture_flags)));
+    }
+
+    [Fact]
+    public void SdoRecordsMatchNativeSize()
+    {
+        Assert.Equal(288, Marshal.SizeOf<SoemShim.SoemSdoCompletion>());
+        Assert.Equal(32, (int)Marshal.OffsetOf<SoemShim.SoemSdoCompletion>(nameof(SoemShim.SoemSdoCompletion.data)));
+        Assert.Equal(56, Marshal.SizeOf<SoemShim.SoemSdoStats>());
+        Assert.Equal(64, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.sdo_workers)));
+    }
+
+    [Fact]
+    public void BootReportMatchesNativeSize()
+    {
+        Assert.Equal(96, Marshal.SizeOf<SoemShim.SoemBootReport>());
+        Assert.Equal(32, (int)Marshal.OffsetOf<SoemShim.SoemBootReport>(nameof(SoemShim.SoemBootReport.configure_ns)));
+        Assert.Equal(48, (int)Marshal.OffsetOf<SoemShim.SoemBootReport>(nameof(SoemShim.SoemBootReport.nic_ns)));
+        Assert.Equal(88, (int)Marshal.OffsetOf<SoemShim.SoemBootReport>(nameof(SoemShim.SoemBootReport.op_ns)));
+        Assert.Equal(104, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.config_path)));
+        Assert.Equal(112, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.sii_cache_path)));
+    }
+
+    [Fact]
+    public void InitOptionsCarryTheBusIdInTheFormerReservedSlot()
+    {
+        Assert.Equal(60, (int)Marshal.OffsetOf<SoemShim.SoemInitOptions>(nameof(SoemShim.SoemInitOptions.bus_id)));
+    }
 }
 
 public sealed class PendingCommandEncodingTests
@@ -88,7 +172,7 @@ public sealed class PendingCommandEncodingTests
         var apply = PendingCommandType.GetMethod("Apply", BindingFlags.Public | BindingFlags.Instance)
             ?? throw new InvalidOperationException("Apply method not found.");
 
-        var parameters = new object[] { new SoemShim.DriveRxPDO { Command = new byte[32] } };
+        var parameters = new object[] { new SoemShim.DriveRxPDO() };
         apply.Invoke(command, parameters);
         var pdo = (SoemShim.DriveRxPDO)parameters[0];
 
@@ -109,11 +193,11 @@ public sealed class PendingCommandEncodingTests
         Assert.Equal(0, pdo.Execute); // command acknowledged clears execute bit
     }
 
-    private static string GetAsciiString(byte[] buffer)
+    private static string GetAsciiString(ReadOnlySpan<byte> buffer)
     {
-        var terminator = Array.IndexOf(buffer, (byte)0);
+        var terminator = buffer.IndexOf((byte)0);
         var length = terminator >= 0 ? terminator : buffer.Length;
-        return System.Text.Encoding.ASCII.GetString(buffer, 0, length);
+        return System.Text.Encoding.ASCII.GetString(buffer.Slice(0, length));
     }
 }
 
@@ -134,3 +218,1008 @@ public sealed class DriveStateFormatterTests
         Assert.Equal((1u << 0) | (1u << 1) | (1u << 19) | (1u << 16), mask);
     }
 }
+
+public sealed class PdoCodecTests
+{
+    [Fact]
+    public void DecodeMatchesNativeBitLayout()
+    {
+        // position 0x01020304, byte 4..6 carry the 22 flag bits in ToBitMask order, byte 7 is the slot
+        var raw = new byte[] { 0x04, 0x03, 0x02, 0x01, 0x21, 0x05, 0x08, 0x07 };
+
+        PdoCodec.DecodeTx(raw, out var tx);
+
+        Assert.Equal(0x01020304, tx.ActualPosition);
+        Assert.Equal(1, tx.AmplifiersEnabled);
+        Assert.Equal(1, tx.MotorOn);
+        Assert.Equal(1, tx.EncoderValid);
+        Assert.Equal(1, tx.PositionReached);
+        Assert.Equal(1, tx.ExecuteAck);
+        Assert.Equal(7, tx.Slot);
+        Assert.Equal(0x080521u, DriveStateFormatter.ToBitMask(tx));
+
+        var word = DriveStatusWord.FromWire(raw);
+        Assert.Equal(0x01020304, word.ActualPosition);
+        Assert.Equal(DriveStateFormatter.ToBitMask(tx), word.Mask);
+        Assert.Equal(7, word.Slot);
+        Assert.True(word.Has(DriveStatusFlags.MotorOn | DriveStatusFlags.ExecuteAck));
+        Assert.False(word.EncoderError);
+    }
+
+    [Fact]
+    public void StatusWordMatchesNativeLayoutAndRoundTrips()
+    {
+        Assert.Equal(8, Unsafe.SizeOf<DriveStatusWord>());
+        Assert.False(RuntimeHelpers.IsReferenceOrContainsReferences<DriveStatusWord>());
+
+        var tx = new SoemShim.DriveTxPDO { ActualPosition = -5, ClosedLoop = 1, SafetyTimeout = 1, PositionFail = 1, Slot = 2 };
+        var word = DriveStatusWord.FromPdo(tx);
+        Assert.Equal(DriveStatusFlags.ClosedLoop | DriveStatusFlags.SafetyTimeout | DriveStatusFlags.PositionFail, word.Flags);
+        Assert.Equal(tx, word.ToPdo());
+
+        // Change detection is one XOR of the masks.
+        var previous = new DriveStatusWord(-5, DriveStatusFlags.ClosedLoop, 2);
+        Assert.Equal((uint)(DriveStatusFlags.SafetyTimeout | DriveStatusFlags.PositionFail), word.Mask ^ previous.Mask);
+    }
+
+    [Fact]
+    public void EncodeRoundTripsThroughDecode()
+    {
+        var tx = new SoemShim.DriveTxPDO
+        {
+            ActualPosition = -123456,
+            EndStop = 1,
+            EncoderIndex = 1,
+            RightEndStop = 1,
+            PositionFail = 1,
+            Slot = 3
+        };
+
+        var raw = new byte[PdoCodec.TxBytes];
+        PdoCodec.EncodeTx(tx, raw);
+        PdoCodec.DecodeTx(raw, out var decoded);
+
+        Assert.Equal(tx, decoded);
+    }
+}
+
+public sealed class SimulatedCycleEngineTests
+{
+    [Fact]
+    public void EngineAppliesPushedCommandsAndPublishesSamples()
+    {
+        using var client = new SimulatedSoemClient(slaveCount: 2);
+        var handle = client.Initialize("sim");
+        var config = new SoemShim.SoemRtConfig { cycle_time_us = 1000, ring_capacity = 64 };
+        Assert.Equal(1, client.StartCycleEngine(handle, ref config));
+
+        var pdo = new SoemShim.DriveRxPDO { Parameter = 500, Execute = 1 };
+        System.Text.Encoding.ASCII.GetBytes("DPOS").CopyTo((Span<byte>)pdo.Command);
+        Assert.Equal(1, client.PushCommand(handle, 2, ref pdo));
+
+        var inputs = new byte[2 * PdoCodec.TxBytes];
+        var deadline = DateTime.UtcNow.AddSeconds(5);
+        SoemShim.DriveTxPDO tx = default;
+        while (DateTime.UtcNow < deadline && tx.ActualPosition != 500)
+        {
+            while (client.PopSample(handle, out var sample, inputs) == 1)
+            {
+                Assert.Equal(2, sample.slave_count);
+                PdoCodec.DecodeTx(inputs.AsSpan(PdoCodec.TxBytes), out tx);
+            }
+
+            Thread.Sleep(1);
+        }
+
+        Assert.Equal(500, tx.ActualPosition);
+        Assert.Equal(1, client.StopCycleEngine(handle));
+        Assert.Equal(1, client.GetCycleEngineStats(handle, out var stats));
+        Assert.Equal(0, stats.running);
+        Assert.True(stats.commands_applied >= 1);
+    }
+}
+
+/// <summary>
+/// Setup shared by the tests that run the service on a simulated bus, and waits that poll a condition against a
+/// deadline instead of sleeping for a guessed time.
+/// </summary>
+internal static class SimulatedBus
+{
+    private static readonly TimeSpan Timeout = TimeSpan.FromSeconds(2);
+
+    public static async Task<EthercatDriveService> StartAsync(SimulatedSoemClient client, Options.EthercatDriveOptions? options = null, string interfaceName = "sim")
+    {
+        var service = new EthercatDriveService(options ?? new Options.EthercatDriveOptions(), null, client);
+        try
+        {
+            await service.InitializeAsync(interfaceName, CancellationToken.None);
+            return service;
+        }
+        catch
+        {
+            await service.DisposeAsync();
+            throw;
+        }
+    }
+
+    /// <summary>
+    /// Polls until the condition holds or the deadline passes; the caller asserts on what it finds.
+    /// </summary>
+    public static async Task WaitUntilAsync(Func<bool> condition)
+    {
+        var deadline = DateTime.UtcNow + Timeout;
+        while (!condition() && DateTime.UtcNow < deadline)
+        {
+            await Task.Delay(5);
+        }
+    }
+
+    public static Task WaitForEnabledDrivesAsync(IEthercatDriveService service, int drives)
+        => WaitUntilAsync(() => service.GetStatus().DriveStates is { } states && states.Length == drives && states.All(s => s.AmplifiersEnabled));
+
+    /// <summary>
+    /// Waits until the bus has run the given number of cycles more, counted by the simulator's first group.
+    /// </summary>
+    public static async Task WaitForCyclesAsync(SimulatedSoemClient client, int cycles)
+    {
+        var target = Exchanges(client) + (ulong)cycles;
+        await WaitUntilAsync(() => Exchanges(client) >= target);
+    }
+
+    public static ulong Exchanges(SimulatedSoemClient client)
+    {
+        var groups = new SoemShim.SoemGroupStatus[SoemShim.SOEM_MAX_GROUPS];
+        client.GetGroupStatus(new IntPtr(1), groups);
+        return groups[0].exchanges;
+    }
+}
+
+public sealed class SimulatedFusedCycleTests
+{
+    [Fact]
+    public void CycleWritesOutputsAndReturnsAllStatusesInOneCall()
+    {
+        using var client = new SimulatedSoemClient(slaveCount: 3);
+        var handle = client.Initialize("sim");
+        var rx = new SoemShim.DriveRxPDO[3];
+
+        System.Text.Encoding.ASCII.GetBytes("DPOS").CopyTo((Span<byte>)rx[2].Command);
+        rx[2].Parameter = 42;
+        rx[2].Execute = 1;
+        var tx = new DriveStatusWord[3];
+
+        var rc = client.Cycle(handle, rx, tx, 1000, out var result);
+
+        Assert.Equal(result.expected_wkc, rc);
+        Assert.Equal(rc, result.status);
+        Assert.Equal(3, result.tx_count);
+        Assert.Equal(0, result.error_pending);
+        Assert.Equal(42, tx[2].ActualPosition);
+        Assert.True(tx[2].ExecuteAck);
+        Assert.False(tx[0].ExecuteAck);
+    }
+
+    [Fact]
+    public void SplitCycleLatchesOutputsAtSendAndInputsAtReceive()
+    {
+        using var client = new SimulatedSoemClient(slaveCount: 2);
+        var handle = client.Initialize("sim");
+        var image = ProcessImage.TryCreate(client, handle, 2)!;
+        var pdo = new SoemShim.DriveRxPDO { Parameter = 42, Execute = 1 };
+        CommandKeywords.Write(ref pdo, CommandKeywords.Encode("DPOS"));
+        PdoCodec.EncodeRx(pdo, image.Outputs(1));
+
+        Assert.Equal(1, client.SendCycle(handle));
+        Assert.Equal(SoemErrorCodes.SOEM_ERR_BUSY, client.SendCycle(handle));
+        Assert.Equal(SoemErrorCodes.SOEM_ERR_BUSY, client.ExchangeProcessData(handle, 1000));
+        PdoCodec.EncodeRx(default, image.Outputs(1)); // restaging after the send must not reach this cycle
+        Assert.False(DriveStatusWord.FromWire(image.Inputs(1)).ExecuteAck);
+        Assert.Equal(1, client.PollCycle(handle));
+
+        var tx = new DriveStatusWord[2];
+        var rc = client.ReceiveCycle(handle, tx, 1000, out var result);
+        Assert.Equal(result.expected_wkc, rc);
+        Assert.Equal(2, result.tx_count);
+        Assert.Equal(42, tx[1].ActualPosition);
+        Assert.True(DriveStatusWord.FromWire(image.Inputs(1)).ExecuteAck);
+
+        // The receive copies the sent frame back over the IOmap, outputs included: the restaged bytes are gone.
+        var echoed = new SoemShim.DriveRxPDO();
+        PdoCodec.DecodeRx(image.Outputs(1), ref echoed);
+        Assert.Equal(42, echoed.Parameter);
+        Assert.Equal(1, echoed.Execute);
+        Assert.Equal(SoemErrorCodes.SOEM_ERR_BAD_ARGS, client.ReceiveCycle(handle, tx, 1000, out _));
+    }
+}
+
+public sealed class OverlappedCycleTests
+{
+    [Fact]
+    public async Task OverlappedLoopCompletesMotionAndReportsBusTiming()
+    {
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(5), OverlapCycleProcessing = true };
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 2), options);
+        await SimulatedBus.WaitForEnabledDrivesAsync(service, 2);
+
+        await service.MoveAbsoluteAsync(2, -300, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        await SimulatedBus.WaitUntilAsync(() => service.GetStatus().RoundTripTime > TimeSpan.Zero);
+
+        var snapshot = service.GetStatus();
+        Assert.Equal(-300, snapshot.DriveStates[1].ActualPosition);
+        Assert.True(snapshot.RoundTripTime > TimeSpan.Zero);
+        Assert.True(snapshot.HostTime > TimeSpan.Zero && snapshot.HostTime <= snapshot.CycleTime);
+    }
+
+    [Fact]
+    public async Task OverlappedLoopCommandsStagedInFlightReachTheWire()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(2), OverlapCycleProcessing = true };
+        await using var service = await SimulatedBus.StartAsync(client, options);
+        await SimulatedBus.WaitForEnabledDrivesAsync(service, 2);
+
+        // Once the loop runs, every command is staged between a send and its receive.
+        await service.MoveAbsoluteAsync(2, 250, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        Assert.Equal(250, service.GetStatus().DriveStates[1].ActualPosition);
+
+        // Clearing Execute after the completed move changes the outputs again inside the window.
+        await SimulatedBus.WaitUntilAsync(() => client.GetWireOutputs(2).Execute == 0);
+        Assert.Equal(0, client.GetWireOutputs(2).Execute);
+    }
+}
+
+public sealed class DistributedClockTests
+{
+    [Fact]
+    public async Task DistributedClockSettingsReachShimAndEveryCycleReportsSync0()
+    {
+        var options = new Options.EthercatDriveOptions
+        {
+            CyclePeriod = TimeSpan.FromMilliseconds(5),
+            DistributedClockCycle = TimeSpan.FromMilliseconds(1),
+            DistributedClockShift = TimeSpan.FromMicroseconds(50)
+        };
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 3), options);
+        await SimulatedBus.WaitUntilAsync(() => service.GetStatus().Health.DistributedClock.Samples > 0);
+
+        var first = service.GetStatus().Health.DistributedClock;
+        await SimulatedBus.WaitUntilAsync(() => service.GetStatus().Health.DistributedClock.Samples > first.Samples);
+        var dc = service.GetStatus().Health.DistributedClock;
+
+        Assert.True(dc.Active);
+        Assert.Equal(3, dc.Sync0Slaves);
+        Assert.Equal(1_000_000, dc.CycleNs);
+        Assert.Equal(50_000, dc.ShiftNs);
+        Assert.Equal(250_000, dc.LeadNs);
+        Assert.True(dc.Samples > first.Samples);
+    }
+}
+
+public sealed class CycleStatisticsTests
+{
+    [Fact]
+    public async Task CycleStatisticsWindowsCloseAndReset()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(5), CycleStatisticsWindow = TimeSpan.FromMilliseconds(50) };
+        await using var service = new EthercatDriveService(options, null, client);
+        Assert.Equal(0, service.GetCycleStatistics().Total.Count);
+
+        await service.InitializeAsync("sim", CancellationToken.None);
+        await SimulatedBus.WaitUntilAsync(() => service.GetCycleStatistics().Total.Count > 0);
+        var first = service.GetCycleStatistics();
+        await SimulatedBus.WaitUntilAsync(() => service.GetCycleStatistics().Timestamp > first.Timestamp);
+        var second = service.GetCycleStatistics();
+        var cycles = SimulatedBus.Exchanges(client);
+
+        // Each window counts only its own cycles: together they never exceed what the bus ran.
+        Assert.True(second.Timestamp > first.Timestamp);
+        Assert.True(first.Total.Count > 0 && second.Total.Count > 0);
+        Assert.True((ulong)(first.Total.Count + second.Total.Count) <= cycles);
+        Assert.True(second.Interval > TimeSpan.Zero);
+        Assert.True(second.RoundTrip.Min <= second.RoundTrip.P99 && second.RoundTrip.P99 <= second.RoundTrip.Max);
+    }
+}
+
+public sealed class SoemErrorTests
+{
+    [Fact]
+    public async Task SoemErrorRecordsRaiseTypedFaults()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        await using var service = new EthercatDriveService(new Options.EthercatDriveOptions(), null, client);
+        var faulted = new TaskCompletionSource<SoemFaultEvent>(TaskCreationOptions.RunContinuationsAsynchronously);
+        service.Faulted += (_, e) => faulted.TrySetResult(e);
+
+        await service.InitializeAsync("sim", CancellationToken.None);
+        Assert.False(client.HasErrors(IntPtr.Zero));
+        client.InjectError(new SoemShim.SoemErrorRecord { type = SoemShim.SOEM_ERRT_EMERGENCY, slave = 2, error_code = 0x4210, error_reg = 0x09 });
+
+        var fault = await faulted.Task.WaitAsync(TimeSpan.FromSeconds(2));
+        Assert.Equal(2, fault.Slave);
+        Assert.Equal(DriveErrorCode.Emergency, fault.Error.Code);
+        Assert.Contains("0x4210", fault.Error.Message);
+        Assert.False(client.HasErrors(IntPtr.Zero));
+    }
+}
+
+public sealed class SlaveRecoveryTests
+{
+    [Fact]
+    public async Task SlaveStatesArePublishedWithoutPerCycleReads()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 3);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(2), StateCheckInterval = TimeSpan.FromMilliseconds(250) };
+        await using var service = await SimulatedBus.StartAsync(client, options);
+
+        var states = new SoemSlaveState[4];
+        await SimulatedBus.WaitUntilAsync(() => service.GetSlaveStates(states) == 3 && states.Take(3).All(s => s.IsOperational));
+        Assert.Equal(3, service.GetSlaveStates(states));
+        Assert.Equal(3, states[2].Slave);
+        Assert.True(states[0].IsOperational && states[2].IsOperational);
+        Assert.Equal("OP", states[1].ToString());
+
+        client.GetSlaveStates(IntPtr.Zero, new SoemShim.SoemSlaveState[3], out var info);
+        Assert.Equal(0ul, info.reads);  // a full WKC never asked for an ecx_readstate
+    }
+
+    [Fact]
+    public async Task LostSlaveRecoversWhileHealthyAxesKeepCycling()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(2) };
+        await using var service = new EthercatDriveService(options, null, client);
+        var lost = new TaskCompletionSource<SoemFaultEvent>(TaskCreationOptions.RunContinuationsAsynchronously);
+        service.Faulted += (_, e) =>
+        {
+            if (e.Error.Code == DriveErrorCode.SlaveLost)
+            {
+                lost.TrySetResult(e);
+            }
+        };
+
+        await service.InitializeAsync("sim", CancellationToken.None);
+        client.SetSlaveLost(2, true);
+        Assert.Equal(2, (await lost.Task.WaitAsync(TimeSpan.FromSeconds(2))).Slave);
+
+        await service.MoveAbsoluteAsync(1, 120, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        Assert.Equal(120, service.GetStatus().DriveStates[0].ActualPosition);
+        var states = new SoemSlaveState[2];
+        service.GetSlaveStates(states);
+        Assert.True(states[1].IsLost && states[1].IsRecovering);
+        Assert.True(states[0].IsOperational);
+
+        client.SetSlaveLost(2, false);
+        await SimulatedBus.WaitUntilAsync(() => service.GetSlaveStates(states) > 0 && !states[1].IsLost);
+
+        Assert.True(states[1].IsOperational && !states[1].IsLost);
+        await service.MoveAbsoluteAsync(2, -40, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        Assert.Equal(-40, service.GetStatus().DriveStates[1].ActualPosition);
+    }
+}
+
+public sealed class RedundancyTests
+{
+    [Fact]
+    public async Task RingBreakIsATopologyEventWithoutMissedCycles()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 3);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(2), SecondaryInterface = "sim1" };
+        await using var service = new EthercatDriveService(options, null, client);
+        var faults = 0;
+        service.Faulted += (_, _) => Interlocked.Increment(ref faults);
+
+        await service.InitializeAsync("sim0", CancellationToken.None);
+        await SimulatedBus.WaitUntilAsync(() => service.GetStatus().Health.Redundancy.Enabled);
+        var ring = service.GetStatus().Health.Redundancy;
+        Assert.True(ring.Enabled);
+        Assert.Equal(RingPath.Ring, ring.Path);
+        Assert.Equal(0, ring.TopologyChanges);
+
+        client.SetRingBreak(1);
+        await service.MoveAbsoluteAsync(3, 75, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        var health = service.GetStatus().Health;
+        ring = health.Redundancy;
+        Assert.Equal(RingPath.Split, ring.Path);
+        Assert.Equal(RingPath.Split, ring.GetFramePath(0));
+        Assert.Equal((1, 2, 1), (ring.PrimarySlaves, ring.SecondarySlaves, ring.BreakAfterSlave));
+        Assert.Equal(health.GroupExpectedWkc, health.LastWkc);
+        Assert.Equal(75, service.GetStatus().DriveStates[2].ActualPosition);
+
+        client.SetRingBreak(null);
+        await SimulatedBus.WaitUntilAsync(() => service.GetStatus().Health.Redundancy.Path == RingPath.Ring);
+        ring = service.GetStatus().Health.Redundancy;
+        Assert.Equal(RingPath.Ring, ring.Path);
+        Assert.Equal(2, ring.TopologyChanges);
+        Assert.True(ring.DegradedCycles > 0);
+        Assert.Equal(0, Volatile.Read(ref faults));
+    }
+}
+
+public sealed class ProcessDataGroupTests
+{
+    [Fact]
+    public async Task SlowGroupExchangesAtItsOwnRateWithItsOwnWkc()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 3);
+        var options = new Options.EthercatDriveOptions
+        {
+            CyclePeriod = TimeSpan.FromMilliseconds(2),
+            SlaveGroups = new[] { 0, 0, 1 },
+            GroupCycleDividers = new[] { 1, 5 }
+        };
+        await using var service = await SimulatedBus.StartAsync(client, options);
+        await SimulatedBus.WaitForEnabledDrivesAsync(service, 3); // the slow group's first exchange brings slave 3's status in
+
+        await service.MoveAbsoluteAsync(3, 60, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        Assert.Equal(60, service.GetStatus().DriveStates[2].ActualPosition);
+
+        var groups = new SoemGroupStatus[4];
+        Assert.Equal(2, service.GetGroupStatus(groups));
+        Assert.Equal((2, 1, 8), (groups[0].SlaveCount, groups[0].CycleDivider, groups[0].ExpectedWkc));
+        Assert.Equal((1, 5, 4), (groups[1].SlaveCount, groups[1].CycleDivider, groups[1].ExpectedWkc));
+
+        // Group 1 is due on every fifth cycle, staggered by one: after n cycles it has exchanged n / 5 times.
+        var native = new SoemShim.SoemGroupStatus[2];
+        client.GetGroupStatus(new IntPtr(1), native);
+        Assert.Equal(native[0].exchanges / 5, native[1].exchanges);
+
+        client.SetSlaveLost(3, true);
+        await SimulatedBus.WaitUntilAsync(() => service.GetGroupStatus(groups) > 0 && !groups[1].IsHealthy);
+
+        Assert.False(groups[1].IsHealthy);
+        Assert.Equal(0, groups[1].SlavesOperational);
+        Assert.True(groups[0].IsHealthy);
+        Assert.Equal(0, groups[0].WkcLowCount);
+    }
+}
+
+public sealed class BusHostTests
+{
+    [Fact]
+    public async Task BusHostRunsBusesIndependentlyAndAggregatesTheirStatus()
+    {
+        var clients = new Dictionary<string, SimulatedSoemClient>
+        {
+            ["left"] = new SimulatedSoemClient(slaveCount: 2),
+            ["right"] = new SimulatedSoemClient(slaveCount: 3)
+        };
+        var buses = new[]
+        {
+            new Options.EthercatBusOptions { Name = "left", Interface = "sim0", Drive = new() { CyclePeriod = TimeSpan.FromMilliseconds(2) } },
+            new Options.EthercatBusOptions { Name = "right", Interface = "sim1", Drive = new() { CyclePeriod = TimeSpan.FromMilliseconds(1), DedicatedIoThread = true } }
+        };
+        await using var host = new EthercatBusHost(buses, clientFactory: bus => clients[bus.Name]);
+        await host.InitializeAsync(CancellationToken.None);
+        await SimulatedBus.WaitForEnabledDrivesAsync(host["right"], 3);
+
+        // Slave 2 exists on both buses; moving it on one leaves the other alone.
+        await host["right"].MoveAbsoluteAsync(2, 77, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        await SimulatedBus.WaitUntilAsync(() => host.GetStatus() is var s && s.AllOperational && s["right"].DriveStates[1].ActualPosition == 77);
+
+        var status = host.GetStatus();
+        Assert.Equal("left,right", string.Join(",", status.Names));
+        Assert.Equal(5, status.SlavesFound);
+        Assert.Equal(5, status.DriveCount);
+        Assert.True(status.AllOperational);
+        Assert.Equal(77, status["right"].DriveStates[1].ActualPosition);
+        Assert.Equal(0, status["left"].DriveStates[1].ActualPosition);
+
+        clients["left"].SetSlaveLost(1, true);
+        await SimulatedBus.WaitUntilAsync(() => !host.GetStatus().AllOperational);
+
+        status = host.GetStatus();
+        Assert.False(status.AllOperational);
+        Assert.Equal(3, status["right"].Health.SlavesOperational);
+    }
+
+    [Fact]
+    public void BusHostRejectsSharedInterfacesAndPinnedCpus()
+    {
+        Assert.Throws<ArgumentException>(() => new EthercatBusHost(new[]
+        {
+            new Options.EthercatBusOptions { Name = "a", Interface = "eth0" },
+            new Options.EthercatBusOptions { Name = "b", Interface = "eth0" }
+        }, clientFactory: _ => new SimulatedSoemClient()));
+
+        Assert.Throws<ArgumentException>(() => new EthercatBusHost(new[]
+        {
+            new Options.EthercatBusOptions { Name = "a", Interface = "eth0", Drive = new() { DedicatedIoThread = true, IoThreadCpu = 2 } },
+            new Options.EthercatBusOptions { Name = "b", Interface = "eth1", Drive = new() { DedicatedIoThread = true, IoThreadCpu = 2 } }
+        }, clientFactory: _ => new SimulatedSoemClient()));
+    }
+}
+
+public sealed class SdoTests
+{
+    [Fact]
+    public async Task SdoTransfersRunAlongsideTheCycle()
+    {
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(1), SdoWorkers = 2 };
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 4), options);
+
+        var serials = await Task.WhenAll(Enumerable.Range(1, 4).Select(slave => service.ReadSdoAsync(slave, 0x1018, 4)));
+        for (var slave = 1; slave <= 4; slave++)
+        {
+            Assert.Equal((uint)slave, BitConverter.ToUInt32(serials[slave - 1]));
+        }
+
+        await service.WriteSdoAsync(2, 0x2000, 1, new byte[] { 0x34, 0x12 });
+        Assert.Equal(0x1234, BitConverter.ToUInt16(await service.ReadSdoAsync(2, 0x2000, 1)));
+
+        // The drives kept exchanging throughout, and the transfers were spread over several handler passes.
+        var stats = service.GetSdoStatistics();
+        Assert.Equal((2, 0, 6L, 6L, 0L), (stats.Workers, stats.InFlight, stats.Submitted, stats.Completed, stats.Failed));
+        Assert.True(stats.ServicePasses >= 3);
+        Assert.Equal(4, service.GetStatus().Health.SlavesOperational);
+    }
+
+    [Fact]
+    public async Task SdoAbortsFailTheTaskAndReachTheErrorList()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 1);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(1), SdoWorkers = 1 };
+        await using var service = new EthercatDriveService(options, null, client);
+        var faulted = new TaskCompletionSource<SoemFaultEvent>(TaskCreationOptions.RunContinuationsAsynchronously);
+        service.Faulted += (_, e) => faulted.TrySetResult(e);
+        await service.InitializeAsync("sim", CancellationToken.None);
+
+        await Assert.ThrowsAsync<InvalidOperationException>(() => service.ReadSdoAsync(1, 0x2100, 0));
+        await Assert.ThrowsAsync<InvalidOperationException>(() => service.WriteSdoAsync(1, 0x1008, 0, new byte[] { 1 }));
+        Assert.Equal(2L, service.GetSdoStatistics().Failed);
+
+        var fault = await faulted.Task.WaitAsync(TimeSpan.FromSeconds(2));
+        Assert.Equal(DriveErrorCode.SdoAbort, fault.Error.Code);
+        Assert.Contains("0x06020000", fault.Error.Message);
+    }
+
+    [Fact]
+    public async Task SdoAccessNeedsWorkers()
+    {
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 1));
+
+        await Assert.ThrowsAsync<NotSupportedException>(() => service.ReadSdoAsync(1, 0x1018, 4));
+        Assert.Equal(0, service.GetSdoStatistics().Workers);
+    }
+}
+
+public sealed class NicRingTests
+{
+    [Fact]
+    public async Task MappedRingCarriesTheCyclicFrames()
+    {
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(1), NicBackend = NicBackend.MappedRing, NicRingFrames = 64 };
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 4), options);
+        await SimulatedBus.WaitUntilAsync(() => service.GetNicStatistics().Sends > 0);
+
+        var nic = service.GetNicStatistics();
+        Assert.Equal(NicBackend.MappedRing, nic.Backend);
+        Assert.Equal(64, nic.RingFrames);
+        Assert.True(nic.Sends > 0);
+        Assert.Equal(nic.Sends, nic.TxFrames);
+        Assert.Equal(nic.TxFrames, nic.RxFrames);
+    }
+
+    [Fact]
+    public async Task MappedRingFallsBackToTheSocketWithSdoWorkers()
+    {
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(1), NicBackend = NicBackend.MappedRing, SdoWorkers = 1 };
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 1), options);
+
+        var nic = service.GetNicStatistics();
+        Assert.Equal(NicBackend.Socket, nic.Backend);
+        Assert.Equal(0L, nic.TxFrames);
+    }
+}
+
+public sealed class WireCaptureTests
+{
+    [Fact]
+    public async Task CaptureRingCountsFramesAndExportsOnWkcDrop()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(1), CaptureBytes = 1 << 20, CaptureOnFault = true };
+        await using var service = await SimulatedBus.StartAsync(client, options);
+        await SimulatedBus.WaitUntilAsync(() => service.GetCaptureStatistics().Frames > 0);
+
+        var capture = service.GetCaptureStatistics();
+        Assert.True(capture.Enabled);
+        Assert.Equal(1L << 20, capture.RingBytes);
+        Assert.True(capture.Frames > 0 && capture.Frames % 2 == 0);
+        Assert.Equal(0L, capture.FaultExports);
+
+        client.SetSlaveLost(2, true);
+        await SimulatedBus.WaitUntilAsync(() => service.GetCaptureStatistics().FaultExports > 0);
+
+        Assert.Equal(1L, service.GetCaptureStatistics().FaultExports);
+
+        var path = System.IO.Path.Combine(System.IO.Path.GetTempPath(), $"capture-{Guid.NewGuid():N}.pcapng");
+        try
+        {
+            var exported = service.ExportCapture(path);
+            var file = System.IO.File.ReadAllBytes(path);
+            Assert.Equal(0x0A0D0D0Au, BitConverter.ToUInt32(file, 0));
+            Assert.Equal(2L, service.GetCaptureStatistics().Exports);
+
+            // Past the section and interface headers, nothing but enhanced packet blocks, each with its direction.
+            int outbound = 0, inbound = 0;
+            for (var at = 60; at < file.Length;)
+            {
+                var total = BitConverter.ToInt32(file, at + 4);
+                var caplen = BitConverter.ToInt32(file, at + 20);
+                Assert.Equal(6u, BitConverter.ToUInt32(file, at));
+                Assert.Equal(caplen, BitConverter.ToInt32(file, at + 24));
+                Assert.Equal(28 + ((caplen + 3) & ~3) + 16, total);
+                Assert.Equal(total, BitConverter.ToInt32(file, at + total - 4));
+
+                var option = at + 28 + ((caplen + 3) & ~3);
+                Assert.Equal(2, BitConverter.ToUInt16(file, option));
+                Assert.Equal(4, BitConverter.ToUInt16(file, option + 2));
+                var direction = BitConverter.ToUInt32(file, option + 4);
+                Assert.Equal(direction == 2 ? 0x01 : 0x03, file[at + 28 + 6]);
+                if (direction == 2)
+                {
+                    outbound++;
+                }
+                else
+                {
+                    inbound++;
+                }
+
+                at += total;
+            }
+
+            Assert.Equal(exported, outbound + inbound);
+            Assert.True(outbound > 0 && outbound == inbound);
+        }
+        finally
+        {
+            System.IO.File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public async Task CaptureExportNeedsACaptureRing()
+    {
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 1));
+
+        Assert.False(service.GetCaptureStatistics().Enabled);
+        Assert.Throws<InvalidOperationException>(() => service.ExportCapture("unused.pcapng"));
+    }
+}
+
+public sealed class StoredConfigurationTests
+{
+    [Fact]
+    public async Task StoredConfigurationIsWrittenReusedAndRejectedOnIdentityChange()
+    {
+        var path = System.IO.Path.Combine(System.IO.Path.GetTempPath(), $"bus-{Guid.NewGuid():N}.cfg");
+        var options = new Options.EthercatDriveOptions { StoredConfigurationPath = path };
+        try
+        {
+            await using (var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 3), options))
+            {
+                var first = service.GetColdStartReport();
+                Assert.Equal(BootSource.Discovered, first.Source);
+                Assert.Equal(StoredConfigurationStatus.Missing, first.Configuration);
+                Assert.True(first.ConfigurationWritten);
+                Assert.Equal(3, first.Slaves);
+                Assert.Equal(3, first.SlavesInOp);
+                Assert.Equal(first.ConfigureTime, first.Timeline.Discovery);
+                Assert.Null(service.GetLastRecoveryReport());
+            }
+
+            await using (var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 3), options))
+            {
+                var reused = service.GetColdStartReport();
+                Assert.Equal(BootSource.StoredConfiguration, reused.Source);
+                Assert.Equal(StoredConfigurationStatus.Used, reused.Configuration);
+                Assert.False(reused.ConfigurationWritten);
+            }
+
+            var swapped = new SimulatedSoemClient(slaveCount: 3);
+            swapped.SetSlaveRevision(2, 7);
+            await using (var service = await SimulatedBus.StartAsync(swapped, options))
+            {
+                var rejected = service.GetColdStartReport();
+                Assert.Equal(BootSource.Discovered, rejected.Source);
+                Assert.Equal(StoredConfigurationStatus.IdentityChanged, rejected.Configuration);
+                Assert.Equal(2, rejected.MismatchSlave);
+                Assert.True(rejected.ConfigurationWritten);
+            }
+        }
+        finally
+        {
+            System.IO.File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public async Task RecoveryThatReinitializesBootsFromTheStoredConfiguration()
+    {
+        var path = System.IO.Path.Combine(System.IO.Path.GetTempPath(), $"bus-{Guid.NewGuid():N}.cfg");
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        var options = new Options.EthercatDriveOptions
+        {
+            CyclePeriod = TimeSpan.FromMilliseconds(2),
+            StoredConfigurationPath = path,
+            RecoveryTimeoutMilliseconds = 50,
+            ReinitializationDelay = TimeSpan.Zero
+        };
+        try
+        {
+            await using var service = await SimulatedBus.StartAsync(client, options);
+            Assert.Equal(BootSource.Discovered, service.GetColdStartReport().Source);
+            Assert.Null(service.GetLastRecoveryReport());
+
+            // With no slave back in OP past the recovery timeout, the service reopens the bus, which still matches the file.
+            client.SetSlaveLost(1, true);
+            client.SetSlaveLost(2, true);
+            await SimulatedBus.WaitUntilAsync(() => service.GetLastRecoveryReport() is not null);
+
+            Assert.NotNull(service.GetLastRecoveryReport());
+            var recovery = service.GetLastRecoveryReport()!.Value;
+            Assert.Equal(BootSource.StoredConfiguration, recovery.Source);
+            Assert.Equal(StoredConfigurationStatus.Used, recovery.Configuration);
+            Assert.Equal(2, recovery.Slaves);
+            Assert.True(recovery.ConfigureTime > TimeSpan.Zero);
+            Assert.True(recovery.BusOpenTime > TimeSpan.Zero);
+            Assert.True(recovery.Timeline.Discovery > TimeSpan.Zero);
+            Assert.True(recovery.StartupTime > TimeSpan.Zero);
+
+            client.SetSlaveLost(1, false);
+            client.SetSlaveLost(2, false);
+            await SimulatedBus.WaitUntilAsync(() => service.GetStatus().Health.SlavesOperational == 2);
+            Assert.Equal(2, service.GetStatus().Health.SlavesOperational);
+        }
+        finally
+        {
+            System.IO.File.Delete(path);
+        }
+    }
+}
+
+public sealed class SiiCacheTests
+{
+    [Fact]
+    public async Task SiiCacheServesKnownSlavesAndReadsNewOnes()
+    {
+        var path = System.IO.Path.Combine(System.IO.Path.GetTempPath(), $"bus-{Guid.NewGuid():N}.sii");
+        var options = new Options.EthercatDriveOptions { SiiCachePath = path };
+        try
+        {
+            await using (var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 3), options))
+            {
+                var first = service.GetColdStartReport();
+                Assert.Equal(0, first.SiiCached);
+                Assert.Equal(3, first.SiiRead);
+            }
+
+            await using (var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 3), options))
+            {
+                var warm = service.GetColdStartReport();
+                Assert.Equal(3, warm.SiiCached);
+                Assert.Equal(0, warm.SiiRead);
+            }
+
+            var swapped = new SimulatedSoemClient(slaveCount: 4);
+            swapped.SetSlaveRevision(2, 7);
+            await using (var service = await SimulatedBus.StartAsync(swapped, options))
+            {
+                var grown = service.GetColdStartReport();
+                Assert.Equal(2, grown.SiiCached);
+                Assert.Equal(2, grown.SiiRead);
+            }
+        }
+        finally
+        {
+            System.IO.File.Delete(path);
+        }
+    }
+}
+
+public sealed class ProcessImageTests
+{
+    [Fact]
+    public void EncodeRxMatchesShimPackingAndRoundTrips()
+    {
+        var pdo = new SoemShim.DriveRxPDO { Parameter = -5, Velocity = 1000, Acceleration = 7, Deceleration = 9, Execute = 1 };
+        System.Text.Encoding.ASCII.GetBytes("SCAN").CopyTo((Span<byte>)pdo.Command);
+        var image = new byte[PdoCodec.RxBytes];
+        image[19] = 0xAA;
+
+        PdoCodec.EncodeRx(pdo, image);
+
+        Assert.Equal(new byte[] { (byte)'S', (byte)'C', (byte)'A', (byte)'N', 0xFB, 0xFF, 0xFF, 0xFF, 0xE8, 0x03, 0, 0, 7, 0, 9, 0, 1 }, image[..17]);
+        Assert.Equal(0xAA, image[19]);
+
+        var decoded = new SoemShim.DriveRxPDO();
+        PdoCodec.DecodeRx(image, ref decoded);
+        Assert.True(((ReadOnlySpan<byte>)pdo.Command).SequenceEqual(decoded.Command));
+        Assert.Equal(pdo.Parameter, decoded.Parameter);
+        Assert.Equal(pdo.Velocity, decoded.Velocity);
+        Assert.Equal(pdo.Acceleration, decoded.Acceleration);
+        Assert.Equal(pdo.Deceleration, decoded.Deceleration);
+        Assert.Equal(pdo.Execute, decoded.Execute);
+    }
+
+    [Fact]
+    public void CycleExchangesThroughMappedProcessImage()
+    {
+        using var client = new SimulatedSoemClient(slaveCount: 2);
+        var handle = client.Initialize("sim");
+        var image = ProcessImage.TryCreate(client, handle, 2);
+        Assert.NotNull(image);
+
+        var pdo = new SoemShim.DriveRxPDO { Parameter = 77, Execute = 1 };
+        System.Text.Encoding.ASCII.GetBytes("DPOS").CopyTo((Span<byte>)pdo.Command);
+        PdoCodec.EncodeRx(pdo, image!.Outputs(1));
+
+        var rc = client.Cycle(handle, Array.Empty<SoemShim.DriveRxPDO>(), Array.Empty<DriveStatusWord>(), 1000, out _);
+
+        Assert.True(rc >= 0);
+        PdoCodec.DecodeTx(image.Inputs(1), out var tx);
+        Assert.Equal(77, tx.ActualPosition);
+        Assert.Equal(1, tx.ExecuteAck);
+        PdoCodec.DecodeTx(image.Inputs(0), out var idle);
+        Assert.Equal(0, idle.ExecuteAck);
+    }
+}
+
+public sealed class OutputStagingTests
+{
+    [Fact]
+    public void KeywordsEncodeToTheirWireBytes()
+    {
+        var pdo = new SoemShim.DriveRxPDO();
+        CommandKeywords.Write(ref pdo, CommandKeywords.Encode("DPOS"));
+        Assert.Equal(new byte[] { (byte)'D', (byte)'P', (byte)'O', (byte)'S', 0 }, ((ReadOnlySpan<byte>)pdo.Command).Slice(0, 5).ToArray());
+
+        CommandKeywords.Write(ref pdo, CommandKeywords.Nop);
+        Assert.Equal(new byte[] { (byte)'N', (byte)'O', (byte)'P', 0 }, ((ReadOnlySpan<byte>)pdo.Command).Slice(0, 4).ToArray());
+        Assert.Equal(CommandKeywords.Encode("SCAN"), CommandKeywords.Encode("SCANX"));
+    }
+
+    [Fact]
+    public async Task IdleAxesAreNotRestagedEveryCycle()
+    {
+        var client = new SimulatedSoemClient(slaveCount: 2);
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(5) };
+        await using var service = await SimulatedBus.StartAsync(client, options);
+        await SimulatedBus.WaitForEnabledDrivesAsync(service, 2);
+
+        // Scribble over slave 1's staged parameter; an idle axis must not be rewritten.
+        var iomap = client.GetIoMap(new IntPtr(1), out _);
+        Marshal.WriteInt32(iomap, 4, 0x5A5A5A5A);
+        await SimulatedBus.WaitForCyclesAsync(client, 10);
+        Assert.Equal(0x5A5A5A5A, Marshal.ReadInt32(iomap, 4));
+
+        await service.MoveAbsoluteAsync(1, 250, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+        await SimulatedBus.WaitUntilAsync(() => Marshal.ReadInt32(iomap, 4) == 0);
+        Assert.Equal(0, Marshal.ReadInt32(iomap, 4)); // back to NOP after the move completed
+        Assert.Equal(250, service.GetStatus().DriveStates[0].ActualPosition);
+    }
+}
+
+public sealed class StatusScanTests
+{
+    [Fact]
+    public void ScanFlagsOnlyAxesWhoseInputsChanged()
+    {
+        using var client = new SimulatedSoemClient(slaveCount: 40);
+        var handle = client.Initialize("sim");
+        var changed = new uint[2];
+        var status = new DriveStatusWord[40];
+
+        Assert.Equal(40, client.ScanInputs(handle, changed, status)); // first scan reports everything
+        Assert.Equal(new uint[] { 0xFFFFFFFF, 0xFF }, changed);
+        Assert.Equal(0, client.ScanInputs(handle, changed, status));
+        Assert.Equal(new uint[] { 0, 0 }, changed);
+
+        var layout = new SoemShim.SoemSlaveIo[40];
+        client.GetIoLayout(handle, layout);
+        var iomap = client.GetIoMap(handle, out _);
+        Marshal.WriteInt32(iomap, layout[33].in_offset, 1234);
+        Marshal.WriteByte(iomap, layout[33].in_offset + 4, 0x21); // AmplifiersEnabled | MotorOn
+        status[0] = new DriveStatusWord(-1, DriveStatusFlags.EndStop, 9);
+
+        Assert.Equal(1, client.ScanInputs(handle, changed, status));
+        Assert.Equal(new uint[] { 0, 1u << 1 }, changed);
+        Assert.Equal(1234, status[33].ActualPosition);
+        Assert.True(status[33].MotorOn && status[33].AmplifiersEnabled);
+        Assert.Equal(-1, status[0].ActualPosition); // unchanged axes are left alone
+        Assert.Equal(SoemErrorCodes.SOEM_ERR_BAD_ARGS, client.ScanInputs(handle, new uint[1], status));
+    }
+}
+
+public sealed class StatusSnapshotStoreTests
+{
+    [Fact]
+    public void PublishDoesNotAllocateOnceSized()
+    {
+        var store = new StatusSnapshotStore();
+        var drives = new DriveStatusWord[16];
+        var health = new SoemHealthSnapshot(16, 48, 48, 320, 128, 16, 0);
+        store.Publish(drives, health, TimeSpan.Zero, TimeSpan.Zero, TimeSpan.Zero);
+        store.Publish(drives, health, TimeSpan.Zero, TimeSpan.Zero, TimeSpan.Zero);
+
+        var before = GC.GetAllocatedBytesForCurrentThread();
+        for (var i = 0; i < 1000; i++)
+        {
+            drives[0] = new DriveStatusWord(i, DriveStatusFlags.MotorOn, 0);
+            store.Publish(drives, health, TimeSpan.FromTicks(i), TimeSpan.Zero, TimeSpan.Zero);
+        }
+
+        Assert.Equal(0, GC.GetAllocatedBytesForCurrentThread() - before);
+
+        Span<DriveStatus> copy = stackalloc DriveStatus[4];
+        var header = store.Read(copy);
+        Assert.Equal(1002, header.Sequence);
+        Assert.Equal(16, header.DriveCount);
+        Assert.Equal(999, copy[0].ActualPosition);
+        Assert.True(store.TryReadDrive(0, out var first));
+        Assert.Equal(999, first.ActualPosition);
+        Assert.False(store.TryReadDrive(16, out _));
+    }
+
+    [Fact]
+    public async Task ServiceCopiesStatusIntoCallerSpan()
+    {
+        var options = new Options.EthercatDriveOptions { CyclePeriod = TimeSpan.FromMilliseconds(5) };
+        await using var service = await SimulatedBus.StartAsync(new SimulatedSoemClient(slaveCount: 3), options);
+        await SimulatedBus.WaitForEnabledDrivesAsync(service, 3);
+        await service.MoveAbsoluteAsync(2, -75, 100, 10, 10, TimeSpan.FromSeconds(2), CancellationToken.None);
+
+        var drives = new DriveStatus[2];
+        var header = service.GetStatus(drives);
+        Assert.Equal(3, header.DriveCount);
+        Assert.True(header.Sequence > 0);
+        Assert.Equal(-75, drives[1].ActualPosition);
+
+        var snapshot = service.GetStatus();
+        Assert.Equal(3, snapshot.DriveStates.Length);
+        Assert.Equal(-75, snapshot.ActualPositions[1]);
+    }
+
+    [Fact]
+    public void ReadersNeverSeeATornSnapshot()
+    {
+        var store = new StatusSnapshotStore();
+        var drives = new DriveStatusWord[64];
+        var stop = false;
+        var writer = new Thread(() =>
+        {
+            for (var seq = 1; !Volatile.Read(ref stop); seq++)
+            {
+                for (var i = 0; i < drives.Length; i++)
+                {
+                    drives[i] = new DriveStatusWord(seq, DriveStatusFlags.None, 0);
+                }
+
+                store.Publish(drives, default, TimeSpan.FromTicks(seq), TimeSpan.Zero, TimeSpan.Zero);
+            }
+        });
+        writer.Start();
+
+        var copy = new DriveStatus[drives.Length];
+        try
+        {
+            for (var n = 0; n < 20_000; n++)
+            {
+                var header = store.Read(copy);
+                if (header.Sequence == 0)
+                {
+                    continue;
+                }
+
+                Assert.Equal(header.Sequence, header.CycleTime.Ticks);
+                Assert.All(copy, status => Assert.Equal(header.Sequence, status.ActualPosition));
+            }
+        }
+        finally
+        {
+            Volatile.Write(ref stop, true);
+            writer.Join();
+        }
+    }
+}
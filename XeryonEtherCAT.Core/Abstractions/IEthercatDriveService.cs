@@ -62,6 +62,75 @@ public interface IEthercatDriveService : IAsyncDisposable
     /// </summary>
     SoemStatusSnapshot GetStatus();
 
+    /// <summary>
+    /// Copies the latest per-drive status into <paramref name="destination"/> without allocating and returns the
+    /// health and timing of the same cycle. Drives beyond the span's length are not copied.
+    /// </summary>
+    SoemStatusHeader GetStatus(Span<DriveStatus> destination);
+
+    /// <summary>
+    /// Round-trip, wake-up lateness and total cycle time percentiles of the last completed
+    /// <c>CycleStatisticsWindow</c>; default until the first window closes.
+    /// </summary>
+    SoemCycleStatistics GetCycleStatistics();
+
+    /// <summary>
+    /// Copies the per-slave AL state and status code (slave 1 first) as of the last state read into
+    /// <paramref name="destination"/> and returns the count copied. Refreshed on a WKC drop and every
+    /// <c>StateCheckInterval</c>, not every cycle.
+    /// </summary>
+    int GetSlaveStates(Span<SoemSlaveState> destination);
+
+    /// <summary>
+    /// Copies the per-group WKC and health (group 0 first) into <paramref name="destination"/> and returns the group
+    /// count. Refreshed every cycle; a bus opened without <c>SlaveGroups</c> has the single group 0.
+    /// </summary>
+    int GetGroupStatus(Span<SoemGroupStatus> destination);
+
+    /// <summary>
+    /// Reads a CoE object while the cycle runs: the shim's SDO workers carry the transfer and the IO loop steps the
+    /// mailboxes in its slack. Needs <c>SdoWorkers</c>; an SDO abort completes the task with an exception.
+    /// </summary>
+    Task<byte[]> ReadSdoAsync(int slave, ushort index, byte subindex, CancellationToken ct = default);
+
+    /// <summary>
+    /// Writes 1 to 256 bytes to a CoE object the same way as <see cref="ReadSdoAsync"/>.
+    /// </summary>
+    Task WriteSdoAsync(int slave, ushort index, byte subindex, ReadOnlyMemory<byte> data, CancellationToken ct = default);
+
+    /// <summary>
+    /// Counters of the SDO engine since the bus was opened.
+    /// </summary>
+    SoemSdoStatistics GetSdoStatistics();
+
+    /// <summary>
+    /// Which transport carries the cyclic frames and its counters since the bus was opened.
+    /// </summary>
+    SoemNicStatistics GetNicStatistics();
+
+    /// <summary>
+    /// Writes the capture ring (the newest <c>CaptureWindow</c> of it) to a pcapng file and returns how many frames
+    /// it holds. Throws <see cref="InvalidOperationException"/> without <c>CaptureBytes</c> and
+    /// <see cref="System.IO.IOException"/> when the file cannot be written.
+    /// </summary>
+    int ExportCapture(string path);
+
+    /// <summary>
+    /// Counters of the wire capture ring since the bus was opened.
+    /// </summary>
+    SoemCaptureStatistics GetCaptureStatistics();
+
+    /// <summary>
+    /// How <see cref="InitializeAsync"/> brought the bus up: discovered or from <c>StoredConfigurationPath</c>,
+    /// and how long each part took.
+    /// </summary>
+    SoemBootReport GetColdStartReport();
+
+    /// <summary>
+    /// The same for the latest reinitialization after a failed recovery; null when there was none.
+    /// </summary>
+    SoemBootReport? GetLastRecoveryReport();
+
     /// <summary>
     /// Raised when a drive enters a faulted state.
     /// </summary>
@@ -1,5 +1,6 @@
 using System;
 using System.Text;
+using XeryonEtherCAT.Core.Models;
 
 namespace XeryonEtherCAT.Core.Internal.Soem;
 
@@ -7,6 +8,17 @@ public interface ISoemClient : IDisposable
 {
     IntPtr Initialize(string iface);
 
+    /// <summary>
+    /// Same as <see cref="Initialize(string)"/> with explicit options (process image placement, ...).
+    /// </summary>
+    IntPtr Initialize(string iface, SoemShim.SoemInitOptions options);
+
+    /// <summary>
+    /// Opens a ring wired back to <paramref name="secondaryIface"/> (<c>ecx_init_redundant</c>): every frame goes
+    /// out of both ports, so a single cable break costs no cycle.
+    /// </summary>
+    IntPtr InitializeRedundant(string iface, string secondaryIface, SoemShim.SoemInitOptions options);
+
     void Shutdown(IntPtr handle);
 
     int GetSlaveCount(IntPtr handle);
@@ -19,13 +31,189 @@ public interface ISoemClient : IDisposable
 
     int ReadTxPdo(IntPtr handle, int slaveIndex, out SoemShim.DriveTxPDO pdo);
 
+    /// <summary>
+    /// Reads a slave's TxPDO as a packed <see cref="DriveStatusWord"/>. Returns 1 on success, 0 otherwise.
+    /// </summary>
+    int ReadStatus(IntPtr handle, int slaveIndex, out DriveStatusWord status);
+
     int ExchangeProcessData(IntPtr handle, int timeoutUs);
 
+    /// <summary>
+    /// Runs one complete bus cycle in a single native call: writes every RxPDO in <paramref name="rx"/>,
+    /// exchanges process data and reads every slave's status word into <paramref name="tx"/>.
+    /// Returns the same codes as <see cref="ExchangeProcessData"/>.
+    /// </summary>
+    int Cycle(IntPtr handle, SoemShim.DriveRxPDO[] rx, DriveStatusWord[] tx, int timeoutUs, out SoemShim.SoemCycleResult result);
+
+    /// <summary>
+    /// First half of a split cycle: sends the IOmap outputs and returns 1 without waiting for the frames.
+    /// Until <see cref="ReceiveCycle"/> the IOmap inputs keep the previous cycle and the outputs may be restaged.
+    /// </summary>
+    int SendCycle(IntPtr handle);
+
+    /// <summary>
+    /// Non-blocking check on a sent cycle: 1 once every frame is back, 0 while any is still on the wire.
+    /// </summary>
+    int PollCycle(IntPtr handle);
+
+    /// <summary>
+    /// Second half of a split cycle: waits for the frames and reads the status words like <see cref="Cycle"/>.
+    /// <c>result.exchange_ns</c> is the round trip from the send.
+    /// </summary>
+    int ReceiveCycle(IntPtr handle, DriveStatusWord[] tx, int timeoutUs, out SoemShim.SoemCycleResult result);
+
     int GetHealth(IntPtr handle, out SoemShim.SoemHealth health);
 
+    /// <summary>
+    /// Distributed clock statistics without the slave state reads of <see cref="GetHealth"/>; cheap enough to call
+    /// every cycle and safe while the cyclic engine runs.
+    /// </summary>
+    int GetDcStats(IntPtr handle, out SoemShim.SoemDcStats stats);
+
+    /// <summary>
+    /// Summarises the cycle latency histograms recorded since the previous call and starts a new window.
+    /// </summary>
+    int GetCycleStats(IntPtr handle, out SoemShim.SoemCycleStats stats);
+
+    /// <summary>
+    /// Base address and size of the native process image (IOmap). Valid until <see cref="Shutdown"/>;
+    /// returns <see cref="IntPtr.Zero"/> when there is none.
+    /// </summary>
+    IntPtr GetIoMap(IntPtr handle, out int size);
+
+    /// <summary>
+    /// Fills <paramref name="layout"/> with each slave's output/input offsets and lengths inside the IOmap
+    /// (slave 1 at index 0). Returns the number of entries written.
+    /// </summary>
+    int GetIoLayout(IntPtr handle, SoemShim.SoemSlaveIo[] layout);
+
+    /// <summary>
+    /// Compares every slave's inputs with the previous scan and sets bit <c>i % 32</c> of <c>changed[i / 32]</c>
+    /// for each axis <c>i</c> that differs; the first scan after <see cref="Initialize(string)"/> reports every axis.
+    /// Only changed entries of <paramref name="status"/> are rewritten, so pass the same array every cycle.
+    /// Returns the number of changed axes, or a negative <see cref="SoemErrorCodes"/> value.
+    /// </summary>
+    int ScanInputs(IntPtr handle, uint[] changed, DriveStatusWord[] status);
+
     int TryRecover(IntPtr handle, int timeoutMs);
 
     int ListNetworkAdapterNames();
 
     string DrainErrorList(IntPtr handle, StringBuilder? buffer = null);
+
+    /// <summary>
+    /// True when SOEM's error list holds entries. Cheap enough to call every cycle.
+    /// </summary>
+    bool HasErrors(IntPtr handle);
+
+    /// <summary>
+    /// Pops up to <c>records.Length</c> entries of SOEM's error list, oldest first, and returns how many were
+    /// written. Entries that do not fit stay queued for the next call.
+    /// </summary>
+    int PopErrors(IntPtr handle, SoemShim.SoemErrorRecord[] records);
+
+    /// <summary>
+    /// Runs the AL state read a cycle flagged with <c>state_due</c> (or one regardless with <paramref name="force"/>).
+    /// Returns the OP count, 0 when nothing was due, <c>SOEM_ERR_BUSY</c> while the cyclic engine owns the bus.
+    /// Costs a bus round trip; call it after the cycle's work, never between send and receive.
+    /// </summary>
+    int CheckState(IntPtr handle, bool force);
+
+    /// <summary>
+    /// Copies the cached per-slave AL states (slave 1 first) without touching the bus. Returns the count copied.
+    /// </summary>
+    int GetSlaveStates(IntPtr handle, SoemShim.SoemSlaveState[] states, out SoemShim.SoemStateInfo info);
+
+    /// <summary>
+    /// Arms per-slave recovery without touching the bus. Healthy slaves keep cycling while it runs.
+    /// </summary>
+    bool StartRecovery(IntPtr handle);
+
+    /// <summary>
+    /// Cable redundancy status without touching the bus; all zero for a handle opened without a secondary interface.
+    /// </summary>
+    int GetRedundancy(IntPtr handle, out SoemShim.SoemRedundancy status);
+
+    /// <summary>
+    /// Copies the per-group process-data status (group 0 first) without touching the bus. Returns the group count.
+    /// </summary>
+    int GetGroupStatus(IntPtr handle, SoemShim.SoemGroupStatus[] status);
+
+    /// <summary>
+    /// Takes one bounded recovery action on one slave out of OP. Returns the slaves still out of OP (&gt; 0), 0 once
+    /// all are back, <c>SOEM_ERR_BUSY</c> while the cyclic engine owns the bus (it steps recovery itself).
+    /// Call it once per cycle, after the cycle's work.
+    /// </summary>
+    int RecoverStep(IntPtr handle);
+
+    /// <summary>
+    /// Queues an SDO upload (read) and returns its ticket (&gt; 0), 0 when the queue is full, or
+    /// <c>SOEM_ERR_UNSUPPORTED</c> when the handle was opened without <c>sdo_workers</c> or the slave has no CoE
+    /// mailbox. Safe from any thread; the result arrives through <see cref="PollSdo"/>.
+    /// </summary>
+    int SdoRead(IntPtr handle, int slave, ushort index, byte subindex);
+
+    /// <summary>
+    /// Queues an SDO download (write) of at most <c>SOEM_SDO_MAX_BYTES</c>; returns like <see cref="SdoRead"/>.
+    /// </summary>
+    int SdoWrite(IntPtr handle, int slave, ushort index, byte subindex, ReadOnlySpan<byte> data);
+
+    /// <summary>
+    /// Copies finished SDO transfers into <paramref name="completions"/> and returns how many. Never waits.
+    /// </summary>
+    int PollSdo(IntPtr handle, SoemShim.SoemSdoCompletion[] completions);
+
+    /// <summary>
+    /// Lets the mailbox handler move a bounded number of mailboxes. Returns how many moved (0 with nothing in
+    /// flight), <c>SOEM_ERR_BUSY</c> while the cyclic engine owns the bus (it services them itself). Call it once per
+    /// cycle, after the cycle's work.
+    /// </summary>
+    int ServiceSdo(IntPtr handle);
+
+    int GetSdoStats(IntPtr handle, out SoemShim.SoemSdoStats stats);
+
+    /// <summary>
+    /// Which transport carries the cyclic frames (<c>nic_backend</c> after any fallback) and the ring's counters.
+    /// </summary>
+    int GetNicStats(IntPtr handle, out SoemShim.SoemNicStats stats);
+
+    /// <summary>
+    /// Writes the capture ring's frames (the newest <c>capture_window_ms</c> of them) to a pcapng file. Returns the
+    /// frame count, <c>SOEM_ERR_UNSUPPORTED</c> without a capture ring or <c>SOEM_ERR_IO</c>. Does file I/O; never
+    /// call it from the cycle thread.
+    /// </summary>
+    int ExportCapture(IntPtr handle, string path);
+
+    int GetCaptureStats(IntPtr handle, out SoemShim.SoemCaptureStats stats);
+
+    /// <summary>
+    /// How the handle's bus was configured (discovered or from <c>config_path</c>) and how long that took.
+    /// </summary>
+    int GetBootReport(IntPtr handle, out SoemShim.SoemBootReport report);
+
+    /// <summary>
+    /// Starts the native cyclic engine. Returns 1 on success or a <see cref="SoemErrorCodes"/> value
+    /// (<c>SOEM_ERR_UNSUPPORTED</c> when the native build has no engine).
+    /// </summary>
+    int StartCycleEngine(IntPtr handle, ref SoemShim.SoemRtConfig config);
+
+    int StopCycleEngine(IntPtr handle);
+
+    /// <summary>
+    /// Queues an RxPDO for the engine to apply on its next cycle. Returns 1 when queued, 0 when the ring is full.
+    /// </summary>
+    int PushCommand(IntPtr handle, int slaveIndex, ref SoemShim.DriveRxPDO pdo);
+
+    /// <summary>
+    /// Pops the oldest engine sample and copies its raw per-slave TxPDO bytes into <paramref name="inputs"/>.
+    /// Returns 1 when a sample was popped, 0 when the ring is empty.
+    /// </summary>
+    int PopSample(IntPtr handle, out SoemShim.SoemRtSample sample, byte[] inputs);
+
+    int GetCycleEngineStats(IntPtr handle, out SoemShim.SoemRtStats stats);
+
+    /// <summary>
+    /// Pins the calling thread to <paramref name="cpu"/>. False when the OS refused or cannot pin threads.
+    /// </summary>
+    bool PinCurrentThread(int cpu);
 }
@@ -0,0 +1,127 @@
+using System;
+using System.Buffers.Binary;
+
+namespace XeryonEtherCAT.Core.Internal.Soem;
+
+/// <summary>
+/// Managed mirror of the shim's wire packing for the Xeryon process image.
+/// Used wherever raw IOmap bytes reach managed code without going through <c>soem_read_txpdo</c>.
+/// </summary>
+internal static class PdoCodec
+{
+    /// <summary>
+    /// Raw RxPDO (output) bytes per slave, matches <c>IO_RX_BYTES</c>.
+    /// </summary>
+    public const int RxBytes = 20;
+
+    /// <summary>
+    /// Raw TxPDO (input) bytes per slave, matches <c>IO_TX_BYTES</c>.
+    /// </summary>
+    public const int TxBytes = 8;
+
+    /// <summary>
+    /// Packs a command into its 20-byte wire image exactly like <c>soem_write_rxpdo</c>: keyword bytes 0..3,
+    /// parameter, velocity, acceleration, deceleration, execute. Bytes 17..19 are left untouched.
+    /// </summary>
+    public static void EncodeRx(in SoemShim.DriveRxPDO rx, Span<byte> dst)
+    {
+        if (dst.Length < RxBytes)
+        {
+            throw new ArgumentException($"RxPDO image must be at least {RxBytes} bytes.", nameof(dst));
+        }
+
+        ((ReadOnlySpan<byte>)rx.Command).Slice(0, 4).CopyTo(dst);
+
+        BinaryPrimitives.WriteInt32LittleEndian(dst.Slice(4), rx.Parameter);
+        BinaryPrimitives.WriteInt32LittleEndian(dst.Slice(8), rx.Velocity);
+        BinaryPrimitives.WriteUInt16LittleEndian(dst.Slice(12), rx.Acceleration);
+        BinaryPrimitives.WriteUInt16LittleEndian(dst.Slice(14), rx.Deceleration);
+        dst[16] = rx.Execute;
+    }
+
+    /// <summary>
+    /// Unpacks a 20-byte command image into <paramref name="rx"/>.
+    /// </summary>
+    public static void DecodeRx(ReadOnlySpan<byte> src, ref SoemShim.DriveRxPDO rx)
+    {
+        if (src.Length < RxBytes)
+        {
+            throw new ArgumentException($"RxPDO image must be at least {RxBytes} bytes.", nameof(src));
+        }
+
+        Span<byte> command = rx.Command;
+        command.Clear();
+        src.Slice(0, 4).CopyTo(command);
+        rx.Parameter = BinaryPrimitives.ReadInt32LittleEndian(src.Slice(4));
+        rx.Velocity = BinaryPrimitives.ReadInt32LittleEndian(src.Slice(8));
+        rx.Acceleration = BinaryPrimitives.ReadUInt16LittleEndian(src.Slice(12));
+        rx.Deceleration = BinaryPrimitives.ReadUInt16LittleEndian(src.Slice(14));
+        rx.Execute = src[16];
+    }
+
+    /// <summary>
+    /// Unpacks the 8-byte status image (position, flag bytes 4..6, slot) exactly like <c>soem_read_txpdo</c>.
+    /// </summary>
+    public static void DecodeTx(ReadOnlySpan<byte> src, out SoemShim.DriveTxPDO tx)
+    {
+        if (src.Length < TxBytes)
+        {
+            throw new ArgumentException($"TxPDO image must be at least {TxBytes} bytes.", nameof(src));
+        }
+
+        var b4 = src[4];
+        var b5 = src[5];
+        var b6 = src[6];
+
+        tx = new SoemShim.DriveTxPDO
+        {
+            ActualPosition = BinaryPrimitives.ReadInt32LittleEndian(src),
+            AmplifiersEnabled = (byte)(b4 & 0x1),
+            EndStop = (byte)((b4 >> 1) & 0x1),
+            ThermalProtection1 = (byte)((b4 >> 2) & 0x1),
+            ThermalProtection2 = (byte)((b4 >> 3) & 0x1),
+            ForceZero = (byte)((b4 >> 4) & 0x1),
+            MotorOn = (byte)((b4 >> 5) & 0x1),
+            ClosedLoop = (byte)((b4 >> 6) & 0x1),
+            EncoderIndex = (byte)((b4 >> 7) & 0x1),
+            EncoderValid = (byte)(b5 & 0x1),
+            SearchingIndex = (byte)((b5 >> 1) & 0x1),
+            PositionReached = (byte)((b5 >> 2) & 0x1),
+            ErrorCompensation = (byte)((b5 >> 3) & 0x1),
+            EncoderError = (byte)((b5 >> 4) & 0x1),
+            Scanning = (byte)((b5 >> 5) & 0x1),
+            LeftEndStop = (byte)((b5 >> 6) & 0x1),
+            RightEndStop = (byte)((b5 >> 7) & 0x1),
+            ErrorLimit = (byte)(b6 & 0x1),
+            SearchingOptimalFrequency = (byte)((b6 >> 1) & 0x1),
+            SafetyTimeout = (byte)((b6 >> 2) & 0x1),
+            ExecuteAck = (byte)((b6 >> 3) & 0x1),
+            EmergencyStop = (byte)((b6 >> 4) & 0x1),
+            PositionFail = (byte)((b6 >> 5) & 0x1),
+            Slot = src[7]
+        };
+    }
+
+    /// <summary>
+    /// Packs a status into its 8-byte wire image. Used by the simulator to produce the same bytes a drive would.
+    /// </summary>
+    public static void EncodeTx(in SoemShim.DriveTxPDO tx, Span<byte> dst)
+    {
+        if (dst.Length < TxBytes)
+        {
+            throw new ArgumentException($"TxPDO image must be at least {TxBytes} bytes.", nameof(dst));
+        }
+
+        BinaryPrimitives.WriteInt32LittleEndian(dst, tx.ActualPosition);
+        dst[4] = (byte)(Bit(tx.AmplifiersEnabled, 0) | Bit(tx.EndStop, 1) | Bit(tx.ThermalProtection1, 2) | Bit(tx.ThermalProtection2, 3)
+            | Bit(tx.ForceZero, 4) | Bit(tx.MotorOn, 5) | Bit(tx.ClosedLoop, 6) | Bit(tx.EncoderIndex, 7));
+        dst[5] = (byte)(Bit(tx.EncoderValid, 0) | Bit(tx.SearchingIndex, 1) | Bit(tx.PositionReached, 2) | Bit(tx.ErrorCompensation, 3)
+            | Bit(tx.EncoderError, 4) | Bit(tx.Scanning, 5) | Bit(tx.LeftEndStop, 6) | Bit(tx.RightEndStop, 7));
+        dst[6] = (byte)(Bit(tx.ErrorLimit, 0) | Bit(tx.SearchingOptimalFrequency, 1) | Bit(tx.SafetyTimeout, 2) | Bit(tx.ExecuteAck, 3)
+            | Bit(tx.EmergencyStop, 4) | Bit(tx.PositionFail, 5));
+        dst[7] = tx.Slot;
+    }
+
+    private static int Bit(byte flag, int shift)
+        => (flag != 0 ? 1 : 0) << shift;
+}
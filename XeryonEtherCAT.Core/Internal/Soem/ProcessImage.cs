@@ -0,0 +1,83 @@
+using System;
+
+namespace XeryonEtherCAT.Core.Internal.Soem;
+
+/// <summary>
+/// Zero-copy view over the native IOmap: each axis' 20-byte command and 8-byte status as spans straight into
+/// the memory SOEM sends from and receives into.
+/// </summary>
+/// <remarks>
+/// The view does not own the memory. It is only valid until the handle it was created from is shut down, and
+/// must not be touched while the native cycle engine owns the bus.
+/// </remarks>
+internal sealed unsafe class ProcessImage
+{
+    private readonly byte* _base;
+    private readonly int[] _outOffsets;
+    private readonly int[] _inOffsets;
+
+    private ProcessImage(IntPtr basePtr, int size, int[] outOffsets, int[] inOffsets)
+    {
+        _base = (byte*)basePtr;
+        Size = size;
+        _outOffsets = outOffsets;
+        _inOffsets = inOffsets;
+    }
+
+    public int Size { get; }
+
+    public int SlaveCount => _outOffsets.Length;
+
+    /// <summary>
+    /// Raw RxPDO bytes for <paramref name="axis"/> (0-based), written by the next cycle.
+    /// </summary>
+    public Span<byte> Outputs(int axis)
+        => new(_base + _outOffsets[axis], PdoCodec.RxBytes);
+
+    /// <summary>
+    /// Raw TxPDO bytes for <paramref name="axis"/> (0-based) as received by the last cycle.
+    /// </summary>
+    public ReadOnlySpan<byte> Inputs(int axis)
+        => new(_base + _inOffsets[axis], PdoCodec.TxBytes);
+
+    /// <summary>
+    /// Maps the process image of <paramref name="handle"/>. Returns <c>null</c> when the client has no IOmap or
+    /// any slave's mapping is too small or out of range, in which case callers fall back to the marshalled path.
+    /// </summary>
+    public static ProcessImage? TryCreate(ISoemClient soem, IntPtr handle, int slaveCount)
+    {
+        if (slaveCount <= 0)
+        {
+            return null;
+        }
+
+        var basePtr = soem.GetIoMap(handle, out var size);
+        if (basePtr == IntPtr.Zero || size <= 0)
+        {
+            return null;
+        }
+
+        var layout = new SoemShim.SoemSlaveIo[slaveCount];
+        if (soem.GetIoLayout(handle, layout) != slaveCount)
+        {
+            return null;
+        }
+
+        var outOffsets = new int[slaveCount];
+        var inOffsets = new int[slaveCount];
+        for (var i = 0; i < slaveCount; i++)
+        {
+            var io = layout[i];
+            if (io.out_offset < 0 || io.out_bytes < PdoCodec.RxBytes || io.out_offset + PdoCodec.RxBytes > size
+                || io.in_offset < 0 || io.in_bytes < PdoCodec.TxBytes || io.in_offset + PdoCodec.TxBytes > size)
+            {
+                return null;
+            }
+
+            outOffsets[i] = io.out_offset;
+            inOffsets[i] = io.in_offset;
+        }
+
+        return new ProcessImage(basePtr, size, outOffsets, inOffsets);
+    }
+}
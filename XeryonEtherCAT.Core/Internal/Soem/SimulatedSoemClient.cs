@@ -1,11 +1,17 @@
-using System;
+﻿using System;
+using System.Buffers.Binary;
 using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
 using System.Runtime.InteropServices;
 using System.Text;
+using System.Threading;
+using XeryonEtherCAT.Core.Models;
 
 namespace XeryonEtherCAT.Core.Internal.Soem;
 
-public sealed class SimulatedSoemClient : ISoemClient
+public sealed partial class SimulatedSoemClient : ISoemClient
 {
     private readonly object _gate = new();
     private readonly List<SimulatedSlave> _slaves = new();
@@ -15,6 +21,99 @@ public sealed class SimulatedSoemClient : ISoemClient
     private int _nextHandle = 1;
     private SoemShim.SoemHealth _health;
 
+    // Distributed clocks: SYNC0 on every slave when requested at init, phase-locked with no offset or drift.
+    private SoemShim.SoemDcStats _dc;
+
+    // Cycle statistics window. No histogram here: the simulator reports count, min, max and mean, and every
+    // percentile as the maximum.
+    private long _statsWindowStart = Stopwatch.GetTimestamp();
+    private LatencyAccumulator _roundTrip;
+    private LatencyAccumulator _wakeLateness;
+    private LatencyAccumulator _cycleTotal;
+
+    // Native process image laid out like SOEM maps it: every slave's outputs, then every slave's inputs.
+    private readonly IntPtr _ioMap;
+    private readonly int _ioMapSize;
+
+    // ScanInputs baseline: the inputs as of the last scan, primed by the first scan after Initialize.
+    private readonly byte[] _scanInputs;
+    private bool _scanPrimed;
+
+    // Split cycle: commands are latched at send, the slaves answer at receive. As in SOEM, the receive copies each
+    // LRW payload back over the IOmap, so the outputs read back as sent (not with the ring backend's in_skip).
+    private bool _cycleInFlight;
+    private byte[] _sentOutputs = Array.Empty<byte>();
+    private long _cycleSentTimestamp;
+
+    // Cyclic engine emulation: a background thread standing in for the native RT thread.
+    private readonly Queue<(int Slave, SoemShim.DriveRxPDO Pdo)> _engineCommands = new();
+    private readonly Queue<(SoemShim.SoemRtSample Sample, byte[] Inputs)> _engineSamples = new();
+    private Thread? _engineThread;
+    private volatile bool _engineRun;
+    private int _engineCapacity;
+    private SoemShim.SoemRtStats _engineStats;
+
+    // SOEM error list: entries queued by InjectError until PopErrors takes them.
+    private readonly Queue<SoemShim.SoemErrorRecord> _errors = new();
+
+    // AL state reads: a simulated slave is in OP unless SetSlaveLost took it off the bus.
+    private ulong _stateReads;
+    private bool[] _lost;
+    private int _lostCount;
+    private bool _recovering;
+
+    // Cable redundancy: set by InitializeRedundant. _ringBreak is the slave after which the ring is open, -1 closed.
+    private SoemShim.SoemRedundancy _red;
+    private int _ringBreak = -1;
+
+    // Process-data groups from the init options. A cycle processes only the slaves of the groups due on it, and
+    // its expected WKC covers those groups, as in soem_group.c.
+    private readonly int[] _slaveGroup;
+    private SoemShim.SoemGroupStatus[] _groups = Array.Empty<SoemShim.SoemGroupStatus>();
+    private ulong _groupTick;
+    private uint _groupsDue = 1;
+    private int _cycleExpected;
+    private int _cycleLost;
+
+    // SDO engine from the init options (sdo_workers). Each slave has a small object dictionary behind a mailbox;
+    // a transfer takes two mailbox moves (request out, reply in), at most _sdoActions of which happen per
+    // ServiceSdo or engine cycle, with up to _sdoWorkers transfers to different slaves open at once.
+    private const int SdoSlots = 64;
+    private int _sdoWorkers;
+    private int _sdoActions;
+    private int _sdoNextTicket = 1;
+    private readonly List<SimulatedSdo> _sdoQueue = new(); // oldest first
+    private readonly Queue<SoemShim.SoemSdoCompletion> _sdoDone = new();
+    private readonly Dictionary<(int Slave, ushort Index, byte Subindex), byte[]> _objects = new();
+    private SoemShim.SoemSdoStats _sdoStats;
+
+    // Cyclic frame transport from the init options (nic_backend). The ring opens unless the shim would refuse it
+    // (cable redundancy, SDO workers); each due group then counts as one frame out and back per 1486 bytes.
+    private const int RingFrameBytes = 1486;
+    private SoemShim.SoemNicStats _nic;
+
+    // Capture ring from the init options (capture_bytes). The ring counts what the shim would copy (each due
+    // group's frames out and back, overwriting the oldest once full) and a WKC drop counts as a fault export under
+    // SOEM_CAPTURE_ON_FAULT. Only the last CaptureKeptFrames records are kept, as LRW frames with a zeroed payload,
+    // and ExportCapture writes them as the shim would: one enhanced packet block each, direction in epb_flags.
+    private const int CaptureMinBytes = 64 * 1024;
+    private const int CaptureFrameOverhead = 14 + 2 + 10 + 2; // Ethernet, EtherCAT and datagram headers, WKC
+    private const int CaptureKeptFrames = 64;
+    private readonly Queue<(bool Outgoing, long Stamp, int Payload, ushort Wkc)> _captureFrames = new();
+    private SoemShim.SoemCaptureStats _capture;
+    private uint _captureFlags;
+    private ulong _captureUsed;
+    private long _captureHoldUntil;
+    private bool _captureLow;
+
+    // Stored configuration from the init options (config_path). A text file with the mapping options and each
+    // slave's revision stands in for the shim's binary slave map: a start whose slaves and options match it comes
+    // up from it, anything else is discovered and rewrites it, as in soem_boot.c.
+    private const string BootFileHeader = "soemsim-config 1";
+    private const string SiiFileHeader = "soemsim-sii 1";
+    private readonly uint[] _revisions;
+    private SoemShim.SoemBootReport _boot;
+
     public SimulatedSoemClient(int slaveCount = 2)
     {
         if (slaveCount <= 0)
@@ -23,6 +122,11 @@ public sealed class SimulatedSoemClient : ISoemClient
         }
 
         _expectedWkc = slaveCount * 4;
+        _cycleExpected = _expectedWkc;
+        _lost = new bool[slaveCount];
+        _slaveGroup = new int[slaveCount];
+        _revisions = new uint[slaveCount];
+        Array.Fill(_revisions, 1u);
         for (var i = 0; i < slaveCount; i++)
         {
             _slaves.Add(new SimulatedSlave());
@@ -30,7 +134,7 @@ public sealed class SimulatedSoemClient : ISoemClient
 
         _health = new SoemShim.SoemHealth
         {
-            group_expected_wkc = _expectedWkc,
+            group_expected_wkc = _cycleExpected,
             last_wkc = _expectedWkc,
             slaves_found = slaveCount,
             slaves_op = slaveCount,
@@ -38,6 +142,14 @@ public sealed class SimulatedSoemClient : ISoemClient
             bytes_out = Marshal.SizeOf<SoemShim.DriveRxPDO>() * slaveCount,
             al_status_code = 0
         };
+
+        _ioMapSize = slaveCount * (PdoCodec.RxBytes + PdoCodec.TxBytes);
+        _scanInputs = new byte[slaveCount * PdoCodec.TxBytes];
+        unsafe
+        {
+            _ioMap = (IntPtr)NativeMemory.AlignedAlloc((nuint)_ioMapSize, 64);
+            NativeMemory.Clear((void*)_ioMap, (nuint)_ioMapSize);
+        }
     }
 
     public IntPtr Initialize(string iface)
@@ -45,13 +157,87 @@ public sealed class SimulatedSoemClient : ISoemClient
         lock (_gate)
         {
             _handle = new IntPtr(_nextHandle++);
+            _red = default;
+            _ringBreak = -1;
+            ConfigureGroups(default);
+            ConfigureSdo(default);
+            _nic = default;
+            _capture = default;
+            _captureFlags = 0;
+            _captureUsed = 0;
+            _captureHoldUntil = 0;
+            _captureLow = false;
+            _captureFrames.Clear();
+            _boot = new SoemShim.SoemBootReport { source = SoemShim.SOEM_BOOT_DISCOVERED, slaves = _slaves.Count, op_slaves = _slaves.Count };
             ResetSlaves();
             return _handle;
         }
     }
 
+    public IntPtr Initialize(string iface, SoemShim.SoemInitOptions options)
+    {
+        lock (_gate)
+        {
+            _dc = default;
+            if (options.dc_cycle_ns > 0)
+            {
+                var cycle = (int)Math.Min(options.dc_cycle_ns, int.MaxValue);
+                _dc.active = 1;
+                _dc.sync0_slaves = _slaves.Count;
+                _dc.cycle_ns = cycle;
+                _dc.shift_ns = options.dc_shift_ns;
+                _dc.lead_ns = options.dc_lead_ns > 0 ? options.dc_lead_ns % cycle : cycle / 4;
+            }
+        }
+
+        var handle = Initialize(iface);
+        lock (_gate)
+        {
+            ConfigureGroups(options);
+            ConfigureSdo(options);
+            if (options.nic_backend == SoemShim.SOEM_NIC_RING && options.sdo_workers == 0)
+            {
+                _nic.backend = (int)SoemShim.SOEM_NIC_RING;
+                _nic.ring_frames = options.nic_ring_frames > 0 ? (int)options.nic_ring_frames : 256;
+            }
+
+            if (options.capture_bytes > 0)
+            {
+                _capture.enabled = 1;
+                _capture.window_ms = options.capture_window_ms;
+                _capture.ring_bytes = Math.Max(CaptureMinBytes, ((ulong)options.capture_bytes + 7) & ~7ul);
+                _captureFlags = options.capture_flags;
+            }
+
+            if (options.config_path != IntPtr.Zero)
+            {
+                Boot(Marshal.PtrToStringUTF8(options.config_path)!, options);
+            }
+
+            if (options.sii_cache_path != IntPtr.Zero && _boot.source == SoemShim.SOEM_BOOT_DISCOVERED)
+            {
+                SiiCache(Marshal.PtrToStringUTF8(options.sii_cache_path)!);
+            }
+        }
+
+        return handle;
+    }
+
+    public IntPtr InitializeRedundant(string iface, string secondaryIface, SoemShim.SoemInitOptions options)
+    {
+        var handle = Initialize(iface, options);
+        lock (_gate)
+        {
+            _red.enabled = 1;
+            _nic = default;
+        }
+
+        return handle;
+    }
+
     public void Shutdown(IntPtr handle)
     {
+        StopCycleEngine(handle);
         lock (_gate)
         {
             if (_handle == handle)
@@ -88,6 +274,7 @@ public sealed class SimulatedSoemClient : ISoemClient
             }
 
             _slaves[idx].Pending = pdo;
+            PdoCodec.EncodeRx(pdo, OutputImage(idx));
             return 0;
         }
     }
@@ -110,18 +297,180 @@ public sealed class SimulatedSoemClient : ISoemClient
         }
     }
 
+    public int ReadStatus(IntPtr handle, int slaveIndex, out DriveStatusWord status)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            var idx = slaveIndex - 1;
+            if ((uint)idx >= _slaves.Count)
+            {
+                status = default;
+                return 0;
+            }
+
+            status = DriveStatusWord.FromWire(InputImage(idx));
+            return 1;
+        }
+    }
+
     public int ExchangeProcessData(IntPtr handle, int timeoutUs)
     {
         lock (_gate)
         {
             EnsureHandle(handle);
-            foreach (var slave in _slaves)
+            if (_cycleInFlight)
+            {
+                return SoemErrorCodes.SOEM_ERR_BUSY;
+            }
+
+            ProcessSlaves();
+            _health.last_wkc = CurrentWkc;
+            return CycleReturn();
+        }
+    }
+
+    public int Cycle(IntPtr handle, SoemShim.DriveRxPDO[] rx, DriveStatusWord[] tx, int timeoutUs, out SoemShim.SoemCycleResult result)
+    {
+        var start = Stopwatch.GetTimestamp();
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (_cycleInFlight)
+            {
+                result = default;
+                return SoemErrorCodes.SOEM_ERR_BUSY;
+            }
+
+            if (rx.Length == 0)
+            {
+                // Zero-copy caller: the commands are whatever it wrote into the IOmap.
+                for (var i = 0; i < _slaves.Count; i++)
+                {
+                    PdoCodec.DecodeRx(OutputImage(i), ref _slaves[i].Pending);
+                }
+            }
+
+            var rxCount = Math.Min(rx.Length, _slaves.Count);
+            for (var i = 0; i < rxCount; i++)
+            {
+                _slaves[i].Pending = rx[i];
+                PdoCodec.EncodeRx(rx[i], OutputImage(i));
+            }
+
+            ProcessSlaves();
+
+            var txCount = Math.Min(tx.Length, _slaves.Count);
+            for (var i = 0; i < txCount; i++)
+            {
+                tx[i] = DriveStatusWord.FromWire(InputImage(i));
+            }
+
+            _health.last_wkc = CurrentWkc;
+            var elapsedNs = (long)(Stopwatch.GetElapsedTime(start).Ticks * 100);
+            _roundTrip.Add(elapsedNs);
+            _cycleTotal.Add(elapsedNs);
+            result = new SoemShim.SoemCycleResult
+            {
+                status = CycleReturn(),
+                wkc = CurrentWkc,
+                expected_wkc = _cycleExpected,
+                slave_count = _slaves.Count,
+                tx_count = txCount,
+                exchange_ns = elapsedNs,
+                total_ns = elapsedNs,
+                error_pending = _errors.Count > 0 ? 1 : 0,
+                red_path = NoteRing()
+            };
+            return CycleReturn();
+        }
+    }
+
+    public int SendCycle(IntPtr handle)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (_cycleInFlight)
+            {
+                return SoemErrorCodes.SOEM_ERR_BUSY;
+            }
+
+            for (var i = 0; i < _slaves.Count; i++)
+            {
+                PdoCodec.DecodeRx(OutputImage(i), ref _slaves[i].Pending);
+            }
+
+            if (_sentOutputs.Length != _slaves.Count * PdoCodec.RxBytes)
+            {
+                _sentOutputs = new byte[_slaves.Count * PdoCodec.RxBytes];
+            }
+
+            for (var i = 0; i < _slaves.Count; i++)
+            {
+                OutputImage(i).CopyTo(_sentOutputs.AsSpan(i * PdoCodec.RxBytes, PdoCodec.RxBytes));
+            }
+
+            _cycleInFlight = true;
+            _cycleSentTimestamp = Stopwatch.GetTimestamp();
+            return 1;
+        }
+    }
+
+    public int PollCycle(IntPtr handle)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            return _cycleInFlight ? 1 : SoemErrorCodes.SOEM_ERR_BAD_ARGS;
+        }
+    }
+
+    public int ReceiveCycle(IntPtr handle, DriveStatusWord[] tx, int timeoutUs, out SoemShim.SoemCycleResult result)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (!_cycleInFlight)
             {
-                slave.Process();
+                result = default;
+                return SoemErrorCodes.SOEM_ERR_BAD_ARGS;
             }
 
-            _health.last_wkc = _expectedWkc;
-            return _expectedWkc;
+            _cycleInFlight = false;
+            if (_nic.backend != (int)SoemShim.SOEM_NIC_RING)
+            {
+                for (var i = 0; i < _slaves.Count; i++)
+                {
+                    _sentOutputs.AsSpan(i * PdoCodec.RxBytes, PdoCodec.RxBytes).CopyTo(OutputImage(i));
+                }
+            }
+
+            ProcessSlaves();
+
+            var txCount = Math.Min(tx.Length, _slaves.Count);
+            for (var i = 0; i < txCount; i++)
+            {
+                tx[i] = DriveStatusWord.FromWire(InputImage(i));
+            }
+
+            _health.last_wkc = CurrentWkc;
+            var elapsedNs = (long)(Stopwatch.GetElapsedTime(_cycleSentTimestamp).Ticks * 100);
+            _roundTrip.Add(elapsedNs);
+            _cycleTotal.Add(elapsedNs);
+            result = new SoemShim.SoemCycleResult
+            {
+                status = CycleReturn(),
+                wkc = CurrentWkc,
+                expected_wkc = _cycleExpected,
+                slave_count = _slaves.Count,
+                tx_count = txCount,
+                exchange_ns = elapsedNs,
+                total_ns = elapsedNs,
+                error_pending = _errors.Count > 0 ? 1 : 0,
+                red_path = NoteRing()
+            };
+            return CycleReturn();
         }
     }
 
@@ -131,89 +480,1309 @@ public sealed class SimulatedSoemClient : ISoemClient
         {
             EnsureHandle(handle);
             health = _health;
+            health.slaves_op = _slaves.Count - _lostCount; // the shim answers from its AL state cache
+            health.dc = _dc;
             return 1;
         }
     }
 
-    public int TryRecover(IntPtr handle, int timeoutMs)
+    public int GetCycleStats(IntPtr handle, out SoemShim.SoemCycleStats stats)
     {
         lock (_gate)
         {
             EnsureHandle(handle);
-            _health.last_wkc = _expectedWkc;
+            var now = Stopwatch.GetTimestamp();
+            stats = new SoemShim.SoemCycleStats
+            {
+                interval_ns = (long)(Stopwatch.GetElapsedTime(_statsWindowStart, now).Ticks * 100),
+                round_trip = _roundTrip.Drain(),
+                wake_lateness = _wakeLateness.Drain(),
+                total = _cycleTotal.Drain()
+            };
+            _statsWindowStart = now;
             return 1;
         }
     }
 
-    public string DrainErrorList(IntPtr handle, StringBuilder? buffer = null)
+    public int GetDcStats(IntPtr handle, out SoemShim.SoemDcStats stats)
     {
-        return string.Empty;
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            stats = _dc;
+            return 1;
+        }
     }
 
-    public int ListNetworkAdapterNames()
+    public IntPtr GetIoMap(IntPtr handle, out int size)
     {
-        return 0;
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            size = _ioMapSize;
+            return _ioMap;
+        }
     }
 
-    public void Dispose()
+    public int GetIoLayout(IntPtr handle, SoemShim.SoemSlaveIo[] layout)
     {
-        _disposed = true;
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            var count = Math.Min(layout.Length, _slaves.Count);
+            for (var i = 0; i < count; i++)
+            {
+                layout[i] = new SoemShim.SoemSlaveIo
+                {
+                    out_offset = i * PdoCodec.RxBytes,
+                    out_bytes = PdoCodec.RxBytes,
+                    in_offset = _slaves.Count * PdoCodec.RxBytes + i * PdoCodec.TxBytes,
+                    in_bytes = PdoCodec.TxBytes
+                };
+            }
+
+            return count;
+        }
     }
 
-    private void EnsureHandle(IntPtr handle)
+    public int ScanInputs(IntPtr handle, uint[] changed, DriveStatusWord[] status)
     {
-        if (_disposed)
+        lock (_gate)
         {
-            throw new ObjectDisposedException(nameof(SimulatedSoemClient));
+            EnsureHandle(handle);
+            var count = _slaves.Count;
+            if (changed.Length < (count + 31) / 32)
+            {
+                return SoemErrorCodes.SOEM_ERR_BAD_ARGS;
+            }
+
+            Array.Clear(changed, 0, (count + 31) / 32);
+            var changedCount = 0;
+            for (var i = 0; i < count; i++)
+            {
+                var current = InputImage(i);
+                var previous = _scanInputs.AsSpan(i * PdoCodec.TxBytes, PdoCodec.TxBytes);
+                if (_scanPrimed && current.SequenceEqual(previous))
+                {
+                    continue;
+                }
+
+                current.CopyTo(previous);
+                changed[i >> 5] |= 1u << (i & 31);
+                changedCount++;
+                if (i < status.Length)
+                {
+                    status[i] = DriveStatusWord.FromWire(current);
+                }
+            }
+
+            _scanPrimed = true;
+            return changedCount;
         }
+    }
 
-        if (handle == IntPtr.Zero || handle != _handle)
+    public int TryRecover(IntPtr handle, int timeoutMs)
+    {
+        lock (_gate)
         {
-            throw new InvalidOperationException("Invalid simulated handle.");
+            EnsureHandle(handle);
+            _health.last_wkc = CurrentWkc;
+            return _lostCount == 0 ? 1 : 0;
         }
     }
 
-    private void ResetSlaves()
+    public string DrainErrorList(IntPtr handle, StringBuilder? buffer = null)
     {
-        foreach (var slave in _slaves)
+        return string.Empty;
+    }
+
+    public bool HasErrors(IntPtr handle)
+    {
+        lock (_gate)
         {
-            slave.Reset();
+            return _errors.Count > 0;
         }
     }
 
-    private sealed class SimulatedSlave
+    public int PopErrors(IntPtr handle, SoemShim.SoemErrorRecord[] records)
     {
-        public SoemShim.DriveRxPDO Pending;
-        public int Position;
-        public SoemShim.DriveTxPDO Status;
+        lock (_gate)
+        {
+            var count = 0;
+            while (count < records.Length && _errors.TryDequeue(out var record))
+            {
+                records[count++] = record;
+            }
 
-        public void Reset()
+            return count;
+        }
+    }
+
+    public int CheckState(IntPtr handle, bool force)
+    {
+        lock (_gate)
         {
-            Pending.Command = new byte[32];
-            Position = 0;
-            Status = new SoemShim.DriveTxPDO
+            EnsureHandle(handle);
+            if (_engineRun)
             {
-                AmplifiersEnabled = 1,
-                MotorOn = 1,
-                ClosedLoop = 1,
-                EncoderValid = 1,
-                PositionReached = 1
+                return SoemErrorCodes.SOEM_ERR_BUSY;
+            }
+
+            _stateReads++;
+            return _slaves.Count - _lostCount;
+        }
+    }
+
+    public int GetSlaveStates(IntPtr handle, SoemShim.SoemSlaveState[] states, out SoemShim.SoemStateInfo info)
+    {
+        lock (_gate)
+        {
+            info = new SoemShim.SoemStateInfo
+            {
+                slaves_op = _slaves.Count - _lostCount,
+                reads = _stateReads,
+                recovering = _recovering ? 1 : 0,
+                slaves_lost = _recovering ? _lostCount : 0
             };
+            var count = Math.Min(states.Length, _slaves.Count);
+            for (var i = 0; i < count; i++)
+            {
+                // A lost slave is only flagged once recovery has looked at it, as on the real bus.
+                states[i] = _lost[i]
+                    ? new SoemShim.SoemSlaveState { state = 0, flags = (ushort)(_recovering ? SoemShim.SOEM_SLAVE_LOST | SoemShim.SOEM_SLAVE_RECOVERING : 0) }
+                    : new SoemShim.SoemSlaveState { state = 0x08 };
+            }
+
+            return count;
+        }
+    }
+
+    public bool StartRecovery(IntPtr handle)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            _recovering = true;
+            return true;
         }
+    }
 
-        public void Process()
+    public int RecoverStep(IntPtr handle)
+    {
+        lock (_gate)
         {
-            if (Pending.Command == null)
+            EnsureHandle(handle);
+            if (_engineRun)
             {
-                Pending.Command = new byte[32];
+                return SoemErrorCodes.SOEM_ERR_BUSY;
             }
 
-            var keyword = GetCommandKeyword(Pending.Command);
-            if (Pending.Execute == 0)
+            return StepRecovery();
+        }
+    }
+
+    /// <summary>
+    /// Takes slave <paramref name="slave"/> (1-based) off the bus or puts it back, as a pulled cable or a power
+    /// cycle would. A lost slave keeps its last inputs, stops executing commands and lowers the WKC by its share.
+    /// </summary>
+    public void SetSlaveLost(int slave, bool lost)
+    {
+        lock (_gate)
+        {
+            var idx = slave - 1;
+            if ((uint)idx >= _slaves.Count || _lost[idx] == lost)
             {
                 return;
             }
 
+            _lost[idx] = lost;
+            _lostCount += lost ? 1 : -1;
+        }
+    }
+
+    /// <summary>
+    /// The RxPDO slave <paramref name="slave"/> (1-based) last received from the wire.
+    /// </summary>
+    public SoemShim.DriveRxPDO GetWireOutputs(int slave)
+    {
+        lock (_gate)
+        {
+            return _slaves[slave - 1].Pending;
+        }
+    }
+
+    /// <summary>
+    /// Changes the SII revision slave <paramref name="slave"/> (1-based) reports from the next Initialize on, as a
+    /// replaced drive would; a stored configuration written before no longer matches it.
+    /// </summary>
+    public void SetSlaveRevision(int slave, uint revision)
+    {
+        lock (_gate)
+        {
+            if ((uint)(slave - 1) < _revisions.Length)
+            {
+                _revisions[slave - 1] = revision;
+            }
+        }
+    }
+
+    // Caller holds _gate.
+    private void Boot(string path, in SoemShim.SoemInitOptions options)
+    {
+        var started = Stopwatch.GetTimestamp();
+        var key = BootKey(options);
+        string[]? stored = null;
+        try
+        {
+            stored = File.Exists(path) ? File.ReadAllLines(path) : null;
+        }
+        catch (IOException)
+        {
+            stored = Array.Empty<string>();
+        }
+        catch (UnauthorizedAccessException)
+        {
+            stored = Array.Empty<string>();
+        }
+
+        var mismatch = 0;
+        var config = stored is null ? SoemShim.SOEM_CONFIG_MISSING
+            : stored.Length < 2 || stored[0] != BootFileHeader || stored[1] != key ? SoemShim.SOEM_CONFIG_STALE
+            : stored.Length - 2 != _revisions.Length ? SoemShim.SOEM_CONFIG_COUNT
+            : SoemShim.SOEM_CONFIG_USED;
+        for (var i = 0; config == SoemShim.SOEM_CONFIG_USED && i < _revisions.Length; i++)
+        {
+            if (stored![i + 2] != _revisions[i].ToString("x8"))
+            {
+                config = SoemShim.SOEM_CONFIG_IDENTITY;
+                mismatch = i + 1;
+            }
+        }
+
+        _boot.config = config;
+        _boot.mismatch_slave = mismatch;
+        _boot.source = config == SoemShim.SOEM_CONFIG_USED ? SoemShim.SOEM_BOOT_CACHED : SoemShim.SOEM_BOOT_DISCOVERED;
+        if (config != SoemShim.SOEM_CONFIG_USED)
+        {
+            var lines = new List<string> { BootFileHeader, key };
+            foreach (var revision in _revisions)
+            {
+                lines.Add(revision.ToString("x8"));
+            }
+
+            try
+            {
+                File.WriteAllLines(path, lines);
+                _boot.config_written = 1;
+            }
+            catch (IOException)
+            {
+            }
+            catch (UnauthorizedAccessException)
+            {
+            }
+        }
+
+        _boot.configure_ns = (long)Stopwatch.GetElapsedTime(started).TotalNanoseconds;
+        _boot.total_ns = _boot.configure_ns;
+        _boot.discovery_ns = _boot.configure_ns;
+    }
+
+    // SII cache (sii_cache_path) for a discovery: one "revision serial" line per known slave stands in for the
+    // shim's images keyed by identity and serial (the slave position here), as in soem_sii.c. Caller holds _gate.
+    private void SiiCache(string path)
+    {
+        var known = new HashSet<string>(StringComparer.Ordinal);
+        try
+        {
+            var lines = File.Exists(path) ? File.ReadAllLines(path) : Array.Empty<string>();
+            if (lines.Length > 0 && lines[0] == SiiFileHeader)
+            {
+                known.UnionWith(lines.Skip(1));
+            }
+        }
+        catch (IOException)
+        {
+        }
+        catch (UnauthorizedAccessException)
+        {
+        }
+
+        var cached = 0;
+        for (var i = 0; i < _revisions.Length; i++)
+        {
+            if (!known.Add($"{_revisions[i]:x8} {i + 1}"))
+            {
+                cached++;
+            }
+        }
+
+        _boot.sii_cached = cached;
+        _boot.sii_read = _revisions.Length - cached;
+        if (_boot.sii_read > 0)
+        {
+            try
+            {
+                File.WriteAllLines(path, known.Prepend(SiiFileHeader));
+            }
+            catch (IOException)
+            {
+            }
+            catch (UnauthorizedAccessException)
+            {
+            }
+        }
+    }
+
+    // The options the shim keys its stored map on: the group layout and whether the SDO engine maps mailboxes.
+    private static string BootKey(in SoemShim.SoemInitOptions options)
+    {
+        var groups = new byte[options.slave_group != IntPtr.Zero ? Math.Max(0, options.slave_group_count) : 0];
+        if (groups.Length > 0)
+        {
+            Marshal.Copy(options.slave_group, groups, 0, groups.Length);
+        }
+
+        return $"groups={Math.Max(1u, options.group_count)} sdo={(options.sdo_workers > 0 ? 1 : 0)} map={Convert.ToHexString(groups)}";
+    }
+
+    /// <summary>
+    /// Opens the simulated ring after slave <paramref name="afterSlave"/> (0 = primary link down, slave count =
+    /// secondary cable unplugged), or closes it again when null. Only meaningful after InitializeRedundant; the
+    /// redundant ring still reaches every slave, so the WKC does not change.
+    /// </summary>
+    public void SetRingBreak(int? afterSlave)
+    {
+        lock (_gate)
+        {
+            _ringBreak = afterSlave is { } after ? Math.Clamp(after, 0, _slaves.Count) : -1;
+        }
+    }
+
+    public int GetRedundancy(IntPtr handle, out SoemShim.SoemRedundancy status)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            status = _red;
+            return 1;
+        }
+    }
+
+    // Caller holds _gate. Grades the cycle's single frame and publishes per-side reach as the native probe would.
+    private int NoteRing()
+    {
+        if (_red.enabled == 0)
+        {
+            return 0;
+        }
+
+        var n = _slaves.Count;
+        var path = _ringBreak < 0 ? SoemShim.SOEM_RED_PATH_RING
+            : _ringBreak == 0 ? SoemShim.SOEM_RED_PATH_SECONDARY
+            : _ringBreak >= n ? SoemShim.SOEM_RED_PATH_PRIMARY
+            : SoemShim.SOEM_RED_PATH_SPLIT;
+
+        if (path != _red.path && _red.path != 0)
+        {
+            _red.topology_changes++;
+            _red.changed_ns = Stopwatch.GetTimestamp();
+        }
+
+        _red.path = path;
+        _red.frames = 1;
+        _red.frame_path[0] = (byte)path;
+        _red.cycles++;
+        if (path != SoemShim.SOEM_RED_PATH_RING)
+        {
+            _red.degraded_cycles++;
+        }
+
+        _red.primary_slaves = _ringBreak < 0 ? n : _ringBreak;
+        _red.secondary_slaves = _ringBreak < 0 ? n : n - _ringBreak;
+        _red.break_after = path == SoemShim.SOEM_RED_PATH_SPLIT ? _ringBreak : 0;
+        return path;
+    }
+
+    public int GetGroupStatus(IntPtr handle, SoemShim.SoemGroupStatus[] status)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            _groups.AsSpan(0, Math.Min(_groups.Length, status.Length)).CopyTo(status);
+            return _groups.Length;
+        }
+    }
+
+    // Caller holds _gate.
+    private unsafe void ConfigureGroups(in SoemShim.SoemInitOptions options)
+    {
+        var count = (int)Math.Clamp(options.group_count, 1u, (uint)SoemShim.SOEM_MAX_GROUPS);
+        _groups = new SoemShim.SoemGroupStatus[count];
+        for (var g = 0; g < count; g++)
+        {
+            _groups[g] = new SoemShim.SoemGroupStatus
+            {
+                group = g,
+                divider = (int)Math.Max(1u, options.group_divider[g]),
+                last_wkc = -1
+            };
+        }
+
+        var map = (byte*)options.slave_group;
+        for (var i = 0; i < _slaveGroup.Length; i++)
+        {
+            var g = map != null && i < options.slave_group_count ? map[i] : 0;
+            _slaveGroup[i] = g < count ? g : 0;
+            _groups[_slaveGroup[i]].slave_count++;
+        }
+
+        for (var g = 0; g < count; g++)
+        {
+            _groups[g].expected_wkc = 4 * _groups[g].slave_count;
+            _groups[g].bytes_out = PdoCodec.RxBytes * _groups[g].slave_count;
+            _groups[g].bytes_in = PdoCodec.TxBytes * _groups[g].slave_count;
+        }
+
+        _groupTick = 0;
+        _groupsDue = (1u << count) - 1;
+        _cycleExpected = _expectedWkc;
+        _cycleLost = 0;
+    }
+
+    // Caller holds _gate. Picks the groups due on this cycle, with the same stagger as soem_group_send.
+    private void BeginGroupCycle()
+    {
+        var tick = _groupTick++;
+        _groupsDue = 0;
+        _cycleExpected = 0;
+        for (var g = 0; g < _groups.Length; g++)
+        {
+            if (_groups[g].slave_count > 0 && (tick + (ulong)g) % (ulong)_groups[g].divider == 0)
+            {
+                _groupsDue |= 1u << g;
+                _cycleExpected += _groups[g].expected_wkc;
+            }
+        }
+    }
+
+    private bool GroupDue(int slaveIndex) => (_groupsDue & (1u << _slaveGroup[slaveIndex])) != 0;
+
+    // Caller holds _gate, after the due slaves were processed.
+    private void EndGroupCycle()
+    {
+        _cycleLost = 0;
+        Span<int> lost = stackalloc int[SoemShim.SOEM_MAX_GROUPS];
+        for (var i = 0; i < _slaveGroup.Length; i++)
+        {
+            if (_lost[i] && GroupDue(i))
+            {
+                _cycleLost++;
+                lost[_slaveGroup[i]]++;
+            }
+        }
+
+        var now = Stopwatch.GetTimestamp();
+        for (var g = 0; g < _groups.Length; g++)
+        {
+            if ((_groupsDue & (1u << g)) == 0)
+            {
+                continue;
+            }
+
+            ref var status = ref _groups[g];
+            if (_nic.backend == (int)SoemShim.SOEM_NIC_RING)
+            {
+                var frames = (ulong)((status.bytes_out + status.bytes_in + RingFrameBytes - 1) / RingFrameBytes);
+                _nic.tx_frames += frames;
+                _nic.rx_frames += frames;
+            }
+
+            if (_capture.enabled != 0)
+            {
+                CaptureGroup(status.bytes_out + status.bytes_in, (ushort)(status.expected_wkc - 4 * lost[g]), now);
+            }
+
+            status.last_wkc = status.expected_wkc - 4 * lost[g];
+            status.slaves_op = status.slave_count - lost[g];
+            status.exchanges++;
+            status.last_exchange_ns = now;
+            if (lost[g] > 0)
+            {
+                status.wkc_low++;
+            }
+        }
+
+        if (_nic.backend == (int)SoemShim.SOEM_NIC_RING)
+        {
+            _nic.kicks++;
+        }
+
+        if (_capture.enabled != 0)
+        {
+            CaptureFault(now);
+        }
+    }
+
+    // Caller holds _gate. One group's frames out and their replies, as 16-byte records padded to 8 bytes.
+    private void CaptureGroup(int payload, ushort wkc, long now)
+    {
+        var frames = (payload + RingFrameBytes - 1) / RingFrameBytes;
+        for (var f = 0; f < frames; f++)
+        {
+            var length = Math.Min(RingFrameBytes, payload - f * RingFrameBytes);
+            KeepCapturedFrame((true, now, length, 0));
+            KeepCapturedFrame((false, now, length, wkc));
+        }
+
+        var bytes = (ulong)(payload + CaptureFrameOverhead * frames);
+        var records = 2 * (ulong)frames;
+        _capture.frames += records;
+        _capture.bytes += 2 * bytes;
+        _captureUsed += 2 * ((bytes + 7) & ~7ul) + 16 * records;
+        if (_captureUsed > _capture.ring_bytes)
+        {
+            _capture.overwritten += records;
+        }
+    }
+
+    private void KeepCapturedFrame((bool Outgoing, long Stamp, int Payload, ushort Wkc) frame)
+    {
+        if (_captureFrames.Count == CaptureKeptFrames)
+        {
+            _captureFrames.Dequeue();
+        }
+
+        _captureFrames.Enqueue(frame);
+    }
+
+    // Caller holds _gate. The shim's exporter fires on the cycle the WKC drops, then holds off for the window.
+    private void CaptureFault(long now)
+    {
+        var low = _cycleLost > 0;
+        if (low && !_captureLow && (_captureFlags & SoemShim.SOEM_CAPTURE_ON_FAULT) != 0 && now >= _captureHoldUntil)
+        {
+            _capture.exports++;
+            _capture.fault_exports++;
+            _captureHoldUntil = now + Stopwatch.Frequency * Math.Max(_capture.window_ms, 1000) / 1000;
+        }
+
+        _captureLow = low;
+    }
+
+    private int CurrentWkc => _cycleExpected - 4 * _cycleLost;
+
+    private int CycleReturn() => _cycleLost > 0 ? SoemErrorCodes.SOEM_ERR_WKC_LOW : CurrentWkc;
+
+    // Caller holds _gate. Returns the slaves still out of OP, 0 once recovery is complete.
+    private int StepRecovery()
+    {
+        if (!_recovering)
+        {
+            return 0;
+        }
+
+        if (_lostCount == 0)
+        {
+            _recovering = false;
+            return 0;
+        }
+
+        return _lostCount;
+    }
+
+    public int SdoRead(IntPtr handle, int slave, ushort index, byte subindex)
+        => SubmitSdo(handle, slave, index, subindex, write: false, ReadOnlySpan<byte>.Empty);
+
+    public int SdoWrite(IntPtr handle, int slave, ushort index, byte subindex, ReadOnlySpan<byte> data)
+    {
+        if (data.IsEmpty || data.Length > SoemShim.SOEM_SDO_MAX_BYTES)
+        {
+            return SoemErrorCodes.SOEM_ERR_BAD_ARGS;
+        }
+
+        return SubmitSdo(handle, slave, index, subindex, write: true, data);
+    }
+
+    public int PollSdo(IntPtr handle, SoemShim.SoemSdoCompletion[] completions)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            var count = 0;
+            while (count < completions.Length && _sdoDone.TryDequeue(out var done))
+            {
+                completions[count++] = done;
+            }
+
+            return count;
+        }
+    }
+
+    public int ServiceSdo(IntPtr handle)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (_sdoWorkers == 0)
+            {
+                return SoemErrorCodes.SOEM_ERR_UNSUPPORTED;
+            }
+
+            return _engineRun || _cycleInFlight ? SoemErrorCodes.SOEM_ERR_BUSY : StepSdo();
+        }
+    }
+
+    public int GetNicStats(IntPtr handle, out SoemShim.SoemNicStats stats)
+    {
+        lock (_gate)
+        {
+            stats = _nic;
+            return 1;
+        }
+    }
+
+    public int ExportCapture(IntPtr handle, string path)
+    {
+        (bool Outgoing, long Stamp, int Payload, ushort Wkc)[] frames;
+        lock (_gate)
+        {
+            if (_capture.enabled == 0)
+            {
+                return SoemErrorCodes.SOEM_ERR_UNSUPPORTED;
+            }
+
+            _capture.exports++;
+            frames = _captureFrames.ToArray();
+        }
+
+        // Section header and an Ethernet interface with nanosecond stamps, as the shim writes them.
+        using var file = new MemoryStream();
+        var header = new byte[28 + 32];
+        var span = header.AsSpan();
+        BinaryPrimitives.WriteUInt32LittleEndian(span, 0x0A0D0D0A);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[4..], 28);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[8..], 0x1A2B3C4D);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[12..], 1);
+        BinaryPrimitives.WriteInt64LittleEndian(span[16..], -1);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[24..], 28);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[28..], 1);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[32..], 32);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[36..], 1);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[44..], 9);
+        BinaryPrimitives.WriteUInt16LittleEndian(span[46..], 1);
+        span[48] = 9;
+        BinaryPrimitives.WriteUInt32LittleEndian(span[56..], 32);
+        file.Write(header);
+        var wallOffsetNs = (DateTime.UtcNow - DateTime.UnixEpoch).Ticks * 100 - StampNs(Stopwatch.GetTimestamp());
+        foreach (var frame in frames)
+        {
+            WriteCapturedFrame(file, frame, StampNs(frame.Stamp) + wallOffsetNs);
+        }
+
+        try
+        {
+            File.WriteAllBytes(path, file.ToArray());
+            return frames.Length;
+        }
+        catch (IOException)
+        {
+            return SoemErrorCodes.SOEM_ERR_IO;
+        }
+        catch (UnauthorizedAccessException)
+        {
+            return SoemErrorCodes.SOEM_ERR_IO;
+        }
+    }
+
+    private static long StampNs(long ticks) => (long)(ticks * (1_000_000_000.0 / Stopwatch.Frequency));
+
+    // An enhanced packet block around one LRW frame: the master's source MAC going out, with bit 1 set by the first
+    // slave coming back, padded to 60 bytes on the wire and to 4 in the block.
+    private static void WriteCapturedFrame(Stream file, (bool Outgoing, long Stamp, int Payload, ushort Wkc) frame, long wallNs)
+    {
+        var length = Math.Max(60, CaptureFrameOverhead + frame.Payload);
+        var padded = (length + 3) & ~3;
+        var block = new byte[28 + padded + 16];
+        var span = block.AsSpan();
+        BinaryPrimitives.WriteUInt32LittleEndian(span, 6);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[4..], (uint)block.Length);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[12..], (uint)((ulong)wallNs >> 32));
+        BinaryPrimitives.WriteUInt32LittleEndian(span[16..], (uint)wallNs);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[20..], (uint)length);
+        BinaryPrimitives.WriteUInt32LittleEndian(span[24..], (uint)length);
+
+        var wire = span.Slice(28, length);
+        wire[..6].Fill(0xFF);
+        wire.Slice(6, 6).Fill(0x01);
+        if (!frame.Outgoing)
+        {
+            wire[6] |= 0x02;
+        }
+
+        BinaryPrimitives.WriteUInt16BigEndian(wire[12..], 0x88A4);
+        BinaryPrimitives.WriteUInt16LittleEndian(wire[14..], (ushort)((10 + frame.Payload + 2) | (1 << 12)));
+        wire[16] = 0x0C; // LRW
+        BinaryPrimitives.WriteUInt16LittleEndian(wire[22..], (ushort)frame.Payload);
+        BinaryPrimitives.WriteUInt16LittleEndian(wire[(26 + frame.Payload)..], frame.Wkc);
+
+        var tail = span[(28 + padded)..];
+        BinaryPrimitives.WriteUInt16LittleEndian(tail, 2); // epb_flags
+        BinaryPrimitives.WriteUInt16LittleEndian(tail[2..], 4);
+        BinaryPrimitives.WriteUInt32LittleEndian(tail[4..], frame.Outgoing ? 2u : 1u);
+        BinaryPrimitives.WriteUInt32LittleEndian(tail[12..], (uint)block.Length);
+        file.Write(block);
+    }
+
+    public int GetCaptureStats(IntPtr handle, out SoemShim.SoemCaptureStats stats)
+    {
+        lock (_gate)
+        {
+            stats = _capture;
+            return 1;
+        }
+    }
+
+    public int GetBootReport(IntPtr handle, out SoemShim.SoemBootReport report)
+    {
+        lock (_gate)
+        {
+            report = _boot;
+            return 1;
+        }
+    }
+
+    public int GetSdoStats(IntPtr handle, out SoemShim.SoemSdoStats stats)
+    {
+        lock (_gate)
+        {
+            stats = _sdoStats;
+            stats.in_flight = _sdoQueue.Count;
+            return 1;
+        }
+    }
+
+    /// <summary>
+    /// Sets an entry of slave <paramref name="slave"/>'s simulated object dictionary (1-based slave). Objects in the
+    /// communication area (0x1000..0x1FFF) are read-only to SDO writes, as on the drive.
+    /// </summary>
+    public void SetObject(int slave, ushort index, byte subindex, byte[] value)
+    {
+        lock (_gate)
+        {
+            _objects[(slave, index, subindex)] = (byte[])value.Clone();
+        }
+    }
+
+    // Caller holds _gate.
+    private void ConfigureSdo(in SoemShim.SoemInitOptions options)
+    {
+        _sdoWorkers = (int)Math.Min(options.sdo_workers, 8);
+        _sdoActions = options.sdo_actions > 0 ? (int)options.sdo_actions : 2;
+        _sdoQueue.Clear();
+        _sdoDone.Clear();
+        _sdoStats = new SoemShim.SoemSdoStats { workers = _sdoWorkers };
+        _objects.Clear();
+        for (var slave = 1; slave <= _slaves.Count; slave++)
+        {
+            // Device type, name and identity (vendor, product and revision are placeholders; serial = position).
+            _objects[(slave, 0x1000, 0)] = BitConverter.GetBytes(0u);
+            _objects[(slave, 0x1008, 0)] = Encoding.ASCII.GetBytes("XD-OEM");
+            _objects[(slave, 0x1018, 1)] = BitConverter.GetBytes(0x1u);
+            _objects[(slave, 0x1018, 2)] = BitConverter.GetBytes(0x1u);
+            _objects[(slave, 0x1018, 3)] = BitConverter.GetBytes(0x1u);
+            _objects[(slave, 0x1018, 4)] = BitConverter.GetBytes((uint)slave);
+        }
+    }
+
+    private int SubmitSdo(IntPtr handle, int slave, ushort index, byte subindex, bool write, ReadOnlySpan<byte> data)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (_sdoWorkers == 0)
+            {
+                return SoemErrorCodes.SOEM_ERR_UNSUPPORTED;
+            }
+
+            if (slave < 1 || slave > _slaves.Count)
+            {
+                return SoemErrorCodes.SOEM_ERR_BAD_ARGS;
+            }
+
+            if (_sdoQueue.Count + _sdoDone.Count >= SdoSlots)
+            {
+                return 0;
+            }
+
+            var ticket = _sdoNextTicket;
+            _sdoNextTicket = ticket == int.MaxValue ? 1 : ticket + 1;
+            var request = new SoemShim.SoemSdoCompletion
+            {
+                ticket = (uint)ticket,
+                slave = (ushort)slave,
+                index = index,
+                subindex = subindex,
+                write = (byte)(write ? 1 : 0),
+                size = (ushort)data.Length
+            };
+            data.CopyTo(request.data);
+            _sdoQueue.Add(new SimulatedSdo { Request = request, Submitted = Stopwatch.GetTimestamp() });
+            _sdoStats.submitted++;
+            return ticket;
+        }
+    }
+
+    // Caller holds _gate. One mailbox handler pass: opens transfers on free workers, then moves up to _sdoActions
+    // mailboxes. Returns the mailboxes moved.
+    private int StepSdo()
+    {
+        if (_sdoQueue.Count == 0)
+        {
+            return 0;
+        }
+
+        var start = Stopwatch.GetTimestamp();
+        var active = 0;
+        foreach (var sdo in _sdoQueue)
+        {
+            active += sdo.Active ? 1 : 0;
+        }
+
+        foreach (var sdo in _sdoQueue)
+        {
+            if (active >= _sdoWorkers)
+            {
+                break;
+            }
+
+            if (!sdo.Active && !_sdoQueue.Exists(other => other.Active && other.Request.slave == sdo.Request.slave))
+            {
+                sdo.Active = true;
+                active++;
+            }
+        }
+
+        var moved = 0;
+        for (var i = 0; i < _sdoQueue.Count && moved < _sdoActions; i++)
+        {
+            var sdo = _sdoQueue[i];
+            while (sdo.Active && sdo.Moves < 2 && moved < _sdoActions)
+            {
+                sdo.Moves++;
+                moved++;
+            }
+
+            if (sdo.Moves == 2)
+            {
+                CompleteSdo(sdo);
+                _sdoQueue.RemoveAt(i--);
+            }
+        }
+
+        _sdoStats.service_calls++;
+        _sdoStats.max_service_ns = Math.Max(_sdoStats.max_service_ns, (long)Stopwatch.GetElapsedTime(start).TotalNanoseconds);
+        return moved;
+    }
+
+    // Caller holds _gate. Answers the transfer from the object dictionary; a failure queues its abort code in the
+    // error list, as ecx_SDOerror does.
+    private void CompleteSdo(SimulatedSdo sdo)
+    {
+        var done = sdo.Request;
+        var key = ((int)done.slave, done.index, done.subindex);
+        var abort = 0u;
+        if (done.write == 0)
+        {
+            if (_objects.TryGetValue(key, out var value))
+            {
+                var size = Math.Min(value.Length, SoemShim.SOEM_SDO_MAX_BYTES);
+                value.AsSpan(0, size).CopyTo(done.data);
+                done.size = (ushort)size;
+            }
+            else
+            {
+                abort = 0x0602_0000; // object does not exist
+            }
+        }
+        else if (done.index is >= 0x1000 and < 0x2000)
+        {
+            abort = 0x0601_0002; // attempt to write a read-only object
+        }
+        else
+        {
+            _objects[key] = ((ReadOnlySpan<byte>)done.data)[..done.size].ToArray();
+        }
+
+        done.status = abort == 0 ? done.size : SoemErrorCodes.SOEM_ERR_SDO;
+        done.elapsed_ns = (long)Stopwatch.GetElapsedTime(sdo.Submitted).TotalNanoseconds;
+        if (abort != 0)
+        {
+            _sdoStats.failed++;
+            _errors.Enqueue(new SoemShim.SoemErrorRecord
+            {
+                type = SoemShim.SOEM_ERRT_SDO,
+                slave = done.slave,
+                index = done.index,
+                subindex = done.subindex,
+                abort_code = unchecked((int)abort)
+            });
+        }
+
+        _sdoStats.completed++;
+        _sdoStats.max_latency_ns = Math.Max(_sdoStats.max_latency_ns, done.elapsed_ns);
+        _sdoDone.Enqueue(done);
+    }
+
+    private sealed class SimulatedSdo
+    {
+        public SoemShim.SoemSdoCompletion Request;
+        public long Submitted;
+        public bool Active;
+        public int Moves;
+    }
+
+    /// <summary>
+    /// Queues an entry in the simulated SOEM error list, as a slave's emergency or an SDO abort would. The next
+    /// cycle reports it as pending.
+    /// </summary>
+    public void InjectError(SoemShim.SoemErrorRecord record)
+    {
+        lock (_gate)
+        {
+            _errors.Enqueue(record);
+        }
+    }
+
+    public int ListNetworkAdapterNames()
+    {
+        return 0;
+    }
+
+    public int StartCycleEngine(IntPtr handle, ref SoemShim.SoemRtConfig config)
+    {
+        if (config.cycle_time_us <= 0)
+        {
+            return SoemErrorCodes.SOEM_ERR_BAD_ARGS;
+        }
+
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (_engineThread is not null)
+            {
+                return SoemErrorCodes.SOEM_ERR_BUSY;
+            }
+
+            _engineCapacity = config.ring_capacity > 0 ? config.ring_capacity : 256;
+            _engineCommands.Clear();
+            _engineSamples.Clear();
+            _engineStats = new SoemShim.SoemRtStats { running = 1, cycle_time_us = config.cycle_time_us };
+            _engineRun = true;
+            var period = TimeSpan.FromTicks(config.cycle_time_us * TimeSpan.TicksPerMillisecond / 1000);
+            _engineThread = new Thread(() => RunEngine(period))
+            {
+                IsBackground = true,
+                Name = "soem-rt (simulated)"
+            };
+            _engineThread.Start();
+            return 1;
+        }
+    }
+
+    public int StopCycleEngine(IntPtr handle)
+    {
+        Thread? thread;
+        lock (_gate)
+        {
+            thread = _engineThread;
+            _engineThread = null;
+            _engineRun = false;
+            _engineStats.running = 0;
+        }
+
+        thread?.Join();
+        return 1;
+    }
+
+    public int PushCommand(IntPtr handle, int slaveIndex, ref SoemShim.DriveRxPDO pdo)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (_engineCommands.Count >= _engineCapacity)
+            {
+                return 0;
+            }
+
+            _engineCommands.Enqueue((slaveIndex, pdo));
+            return 1;
+        }
+    }
+
+    public int PopSample(IntPtr handle, out SoemShim.SoemRtSample sample, byte[] inputs)
+    {
+        lock (_gate)
+        {
+            EnsureHandle(handle);
+            if (!_engineSamples.TryDequeue(out var entry))
+            {
+                sample = default;
+                return 0;
+            }
+
+            sample = entry.Sample;
+            Array.Copy(entry.Inputs, inputs, Math.Min(entry.Inputs.Length, inputs.Length));
+            return 1;
+        }
+    }
+
+    public int GetCycleEngineStats(IntPtr handle, out SoemShim.SoemRtStats stats)
+    {
+        lock (_gate)
+        {
+            stats = _engineStats;
+            return 1;
+        }
+    }
+
+    /// <summary>
+    /// Pins for real on Linux (<c>sched_setaffinity</c> on the calling thread), so simulated buses can be measured
+    /// on their own cores; false elsewhere.
+    /// </summary>
+    public unsafe bool PinCurrentThread(int cpu)
+    {
+        if (!OperatingSystem.IsLinux() || cpu < 0 || cpu >= 1024)
+        {
+            return false;
+        }
+
+        var mask = stackalloc ulong[16]; // cpu_set_t
+        new Span<ulong>(mask, 16).Clear();
+        mask[cpu / 64] = 1UL << (cpu % 64);
+        return sched_setaffinity(0, 16 * sizeof(ulong), mask) == 0;
+    }
+
+    [LibraryImport("libc", SetLastError = true)]
+    private static unsafe partial int sched_setaffinity(int pid, nuint size, ulong* mask);
+
+    public void Dispose()
+    {
+        StopCycleEngine(_handle);
+        lock (_gate)
+        {
+            if (_disposed)
+            {
+                return;
+            }
+
+            _disposed = true;
+            unsafe
+            {
+                NativeMemory.AlignedFree((void*)_ioMap);
+            }
+        }
+    }
+
+    private void RunEngine(TimeSpan period)
+    {
+        var clock = Stopwatch.StartNew();
+        var deadline = TimeSpan.Zero;
+        ulong cycle = 0;
+
+        while (_engineRun)
+        {
+            deadline += period;
+            var remaining = deadline - clock.Elapsed;
+            if (remaining > TimeSpan.Zero)
+            {
+                Thread.Sleep(remaining);
+            }
+
+            var woke = clock.Elapsed;
+            var latencyNs = (long)((woke - deadline).Ticks * 100);
+
+            lock (_gate)
+            {
+                while (_engineCommands.TryDequeue(out var command))
+                {
+                    var idx = command.Slave - 1;
+                    if ((uint)idx < _slaves.Count)
+                    {
+                        _slaves[idx].Pending = command.Pdo;
+                        _engineStats.commands_applied++;
+                    }
+                }
+
+                ProcessSlaves();
+                StepRecovery();
+                StepSdo();
+
+                cycle++;
+                _engineStats.cycles = cycle;
+                _engineStats.last_wake_latency_ns = latencyNs;
+                _engineStats.max_wake_latency_ns = Math.Max(_engineStats.max_wake_latency_ns, latencyNs);
+                var busNs = (long)((clock.Elapsed - woke).Ticks * 100);
+                _wakeLateness.Add(Math.Max(0, latencyNs));
+                _roundTrip.Add(busNs);
+                _cycleTotal.Add(busNs);
+
+                if (_engineSamples.Count >= _engineCapacity)
+                {
+                    _engineStats.samples_dropped++;
+                }
+                else
+                {
+                    var inputs = new byte[_slaves.Count * PdoCodec.TxBytes];
+                    for (var i = 0; i < _slaves.Count; i++)
+                    {
+                        PdoCodec.EncodeTx(_slaves[i].CreateTx(), inputs.AsSpan(i * PdoCodec.TxBytes, PdoCodec.TxBytes));
+                    }
+
+                    var sample = new SoemShim.SoemRtSample
+                    {
+                        cycle = cycle,
+                        timestamp_ns = clock.Elapsed.Ticks * 100,
+                        wkc = CurrentWkc,
+                        expected_wkc = _cycleExpected,
+                        wake_latency_ns = (int)Math.Min(int.MaxValue, latencyNs),
+                        slave_count = _slaves.Count,
+                        error_pending = _errors.Count > 0 ? 1 : 0,
+                        red_path = NoteRing()
+                    };
+                    _engineSamples.Enqueue((sample, inputs));
+                }
+            }
+
+            if (woke - deadline > period)
+            {
+                _engineStats.overruns++;
+                deadline = woke;
+            }
+        }
+    }
+
+    private void ProcessSlaves()
+    {
+        BeginGroupCycle();
+        for (var i = 0; i < _slaves.Count; i++)
+        {
+            if (_lost[i] || !GroupDue(i))
+            {
+                continue;
+            }
+
+            _slaves[i].Process();
+            PdoCodec.EncodeTx(_slaves[i].CreateTx(), InputImage(i));
+        }
+
+        EndGroupCycle();
+
+        if (_dc.active != 0)
+        {
+            _dc.samples++;
+            _dc.dc_time_ns += _dc.cycle_ns;
+        }
+    }
+
+    private unsafe Span<byte> OutputImage(int idx)
+        => new((byte*)_ioMap + idx * PdoCodec.RxBytes, PdoCodec.RxBytes);
+
+    private unsafe Span<byte> InputImage(int idx)
+        => new((byte*)_ioMap + _slaves.Count * PdoCodec.RxBytes + idx * PdoCodec.TxBytes, PdoCodec.TxBytes);
+
+    private void EnsureHandle(IntPtr handle)
+    {
+        if (_disposed)
+        {
+            throw new ObjectDisposedException(nameof(SimulatedSoemClient));
+        }
+
+        if (handle == IntPtr.Zero || handle != _handle)
+        {
+            throw new InvalidOperationException("Invalid simulated handle.");
+        }
+    }
+
+    private void ResetSlaves()
+    {
+        foreach (var slave in _slaves)
+        {
+            slave.Reset();
+        }
+
+        _scanPrimed = false;
+        _cycleInFlight = false;
+
+        unsafe
+        {
+            NativeMemory.Clear((void*)_ioMap, (nuint)_ioMapSize);
+        }
+    }
+
+    private struct LatencyAccumulator
+    {
+        private ulong _count;
+        private long _min;
+        private long _max;
+        private long _sum;
+
+        public void Add(long ns)
+        {
+            _min = _count == 0 ? ns : Math.Min(_min, ns);
+            _max = Math.Max(_max, ns);
+            _sum += ns;
+            _count++;
+        }
+
+        public SoemShim.SoemLatencySummary Drain()
+        {
+            var summary = _count == 0 ? default : new SoemShim.SoemLatencySummary
+            {
+                count = _count,
+                min_ns = _min,
+                max_ns = _max,
+                mean_ns = _sum / (long)_count,
+                p50_ns = _max,
+                p90_ns = _max,
+                p99_ns = _max,
+                p999_ns = _max,
+                p9999_ns = _max
+            };
+            this = default;
+            return summary;
+        }
+    }
+
+    private sealed class SimulatedSlave
+    {
+        public SoemShim.DriveRxPDO Pending;
+        public int Position;
+        public SoemShim.DriveTxPDO Status;
+
+        public void Reset()
+        {
+            Pending = default;
+            Position = 0;
+            Status = new SoemShim.DriveTxPDO
+            {
+                AmplifiersEnabled = 1,
+                MotorOn = 1,
+                ClosedLoop = 1,
+                EncoderValid = 1,
+                PositionReached = 1
+            };
+        }
+
+        public void Process()
+        {
+            if (Pending.Execute == 0)
+            {
+                return;
+            }
+
+            var keyword = GetCommandKeyword(Pending.Command);
+
             Status.ExecuteAck = 1;
             Status.SafetyTimeout = 0;
             Status.ErrorLimit = 0;
@@ -287,15 +1856,15 @@ public sealed class SimulatedSoemClient : ISoemClient
         public SoemShim.DriveTxPDO CreateTx()
             => Status;
 
-        private static string GetCommandKeyword(byte[] command)
+        private static string GetCommandKeyword(ReadOnlySpan<byte> command)
         {
-            var len = Array.IndexOf(command, (byte)0);
+            var len = command.IndexOf((byte)0);
             if (len < 0)
             {
                 len = command.Length;
             }
 
-            return Encoding.ASCII.GetString(command, 0, Math.Max(0, len)).Trim();
+            return Encoding.ASCII.GetString(command.Slice(0, len)).Trim();
         }
 
 
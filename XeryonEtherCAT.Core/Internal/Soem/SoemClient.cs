@@ -1,34 +1,83 @@
 ﻿using Microsoft.Extensions.Logging;
 using System;
+using System.Collections.Concurrent;
 using System.Reflection;
 using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 using System.Text;
+using System.Threading;
+using XeryonEtherCAT.Core.Models;
 
 [assembly: InternalsVisibleTo("XeryonEtherCAT.ConsoleHarness")]
 
 namespace XeryonEtherCAT.Core.Internal.Soem;
 
-internal sealed class SoemClient : ISoemClient
+internal sealed unsafe class SoemClient : ISoemClient
 {
 
     private readonly ILogger _logger;
 
-    // Keep a strong reference to prevent GC collection
-    private readonly SoemShim.SoemLogCallback _logCallback;
+    // One native callback for the process: records carry the bus id of the handle they were written for and are
+    // routed to the logger of the client that opened it. Records outside any handle (bus 0, or a bus already shut
+    // down) go to the most recently created client's logger.
+    private static readonly SoemShim.SoemLogBusCallback LogCallback = RouteNativeLog;
+    private static readonly ConcurrentDictionary<uint, ILogger> BusLoggers = new();
+    private static volatile ILogger? s_fallbackLogger;
+    private static int s_logCallbackSet;
+
+    private readonly ConcurrentDictionary<uint, byte> _buses = new(); // bus ids this client opened
+
+    private readonly byte[] _errorBytes = new byte[4096];
+
+    // The shim only queues log records; this thread formats and forwards them so the bus thread never waits on a logger.
+    private static readonly TimeSpan LogDrainInterval = TimeSpan.FromMilliseconds(20);
+    private const int LogDrainBatch = 256;
+    private readonly ManualResetEventSlim _logStop = new(false);
+    private readonly Thread _logPump;
+    private int _disposed;
 
     public SoemClient(ILogger logger)
     {
         _logger = logger;
+        s_fallbackLogger = logger;
 
-        // Create delegate and keep reference
-        _logCallback = NativeLogHandler;
+        if (Interlocked.Exchange(ref s_logCallbackSet, 1) == 0)
+        {
+            SoemShim.soem_set_log_bus_callback(Marshal.GetFunctionPointerForDelegate(LogCallback));
+        }
+
+        _logPump = new Thread(RunLogPump) { IsBackground = true, Name = "soem-log" };
+        _logPump.Start();
+    }
+
+    private void RunLogPump()
+    {
+        while (!_logStop.Wait(LogDrainInterval))
+        {
+            DrainLog();
+        }
+    }
+
+    private static void DrainLog()
+    {
+        while (SoemShim.soem_log_drain(LogDrainBatch) == LogDrainBatch)
+        {
+        }
+    }
 
-        // Register native log callback
-        SoemShim.soem_set_log_callback(_logCallback);
+    private static void RouteNativeLog(SoemShim.SoemLogLevel level, uint bus, string message)
+    {
+        if (BusLoggers.TryGetValue(bus, out var logger))
+        {
+            Log(logger, level, message);
+        }
+        else if (s_fallbackLogger is { } fallback)
+        {
+            Log(fallback, level, message);
+        }
     }
 
-    private void NativeLogHandler(SoemShim.SoemLogLevel level, string message)
+    private static void Log(ILogger logger, SoemShim.SoemLogLevel level, string message)
     {
         var logLevel = level switch
         {
@@ -38,14 +87,57 @@ internal sealed class SoemClient : ISoemClient
             _ => LogLevel.Debug
         };
 
-        _logger.Log(logLevel, "{Message}", message);
+        logger.Log(logLevel, "{Message}", message);
+    }
+
+    // Every handle gets its bus id before the shim opens it, so the initialization's own records are routed too.
+    private uint OpenBusLog(ref SoemShim.SoemInitOptions options)
+    {
+        options.struct_size = (uint)Marshal.SizeOf<SoemShim.SoemInitOptions>();
+        options.bus_id = SoemShim.soem_log_new_bus();
+        BusLoggers[options.bus_id] = _logger;
+        _buses[options.bus_id] = 0;
+        return options.bus_id;
+    }
+
+    private IntPtr Opened(IntPtr handle, uint bus)
+    {
+        if (handle == IntPtr.Zero)
+        {
+            CloseBusLog(bus);
+        }
+
+        return handle;
+    }
+
+    private void CloseBusLog(uint bus)
+    {
+        DrainLog();
+        BusLoggers.TryRemove(bus, out _);
+        _buses.TryRemove(bus, out _);
     }
 
     public IntPtr Initialize(string iface)
-        => SoemShim.soem_initialize(iface);
+        => Initialize(iface, default);
+
+    public IntPtr Initialize(string iface, SoemShim.SoemInitOptions options)
+    {
+        var bus = OpenBusLog(ref options);
+        return Opened(SoemShim.soem_initialize_ex(iface, ref options), bus);
+    }
+
+    public IntPtr InitializeRedundant(string iface, string secondaryIface, SoemShim.SoemInitOptions options)
+    {
+        var bus = OpenBusLog(ref options);
+        return Opened(SoemShim.soem_initialize_redundant(iface, secondaryIface, ref options), bus);
+    }
 
     public void Shutdown(IntPtr handle)
-        => SoemShim.soem_shutdown(handle);
+    {
+        var bus = SoemShim.soem_get_bus_id(handle);
+        SoemShim.soem_shutdown(handle);
+        CloseBusLog(bus);
+    }
 
     public int GetSlaveCount(IntPtr handle)
         => SoemShim.soem_get_slave_count(handle);
@@ -57,11 +149,14 @@ internal sealed class SoemClient : ISoemClient
         => SoemShim.soem_expected_tx_bytes();
 
     public int WriteRxPdo(IntPtr handle, int slaveIndex, ref SoemShim.DriveRxPDO pdo)
-        => SoemShim.soem_write_rxpdo(handle, slaveIndex, ref pdo);
+        => SoemShim.soem_write_rxpdo(handle, slaveIndex, in pdo);
 
     public int ReadTxPdo(IntPtr handle, int slaveIndex, out SoemShim.DriveTxPDO pdo)
         => SoemShim.soem_read_txpdo(handle, slaveIndex, out pdo);
 
+    public int ReadStatus(IntPtr handle, int slaveIndex, out DriveStatusWord status)
+        => SoemShim.soem_read_status(handle, slaveIndex, out status);
+
     public int ExchangeProcessData(IntPtr handle, int timeoutUs)
     {
         if (handle == IntPtr.Zero)
@@ -81,7 +176,7 @@ internal sealed class SoemClient : ISoemClient
                 •	If inputs == NULL → skips the memcpy(inputs, g->inputs, ...).
                 •	The data is still received into the internal g->inputs buffer and can be read later via soem_read_txpdo.
             */
-            return SoemShim.soem_exchange_process_data(handle, null!, 0, null!, 0, timeoutUs);
+            return SoemShim.soem_exchange_process_data(handle, null, 0, null, 0, timeoutUs);
         }
         catch (Exception ex)
         {
@@ -100,24 +195,213 @@ internal sealed class SoemClient : ISoemClient
         }
     }
 
+    public int Cycle(IntPtr handle, SoemShim.DriveRxPDO[] rx, DriveStatusWord[] tx, int timeoutUs, out SoemShim.SoemCycleResult result)
+    {
+        SoemShim.SoemCycleResult res;
+        int rc;
+        fixed (SoemShim.DriveRxPDO* prx = rx)
+        fixed (DriveStatusWord* ptx = tx)
+        {
+            rc = SoemShim.soem_cycle(handle, prx, rx.Length, ptx, tx.Length, timeoutUs, &res);
+        }
+
+        result = res;
+        return rc;
+    }
+
+    public int SendCycle(IntPtr handle)
+        => SoemShim.soem_send_cycle(handle);
+
+    public int PollCycle(IntPtr handle)
+        => SoemShim.soem_poll_cycle(handle);
+
+    public int ReceiveCycle(IntPtr handle, DriveStatusWord[] tx, int timeoutUs, out SoemShim.SoemCycleResult result)
+    {
+        SoemShim.SoemCycleResult res;
+        int rc;
+        fixed (DriveStatusWord* ptx = tx)
+        {
+            rc = SoemShim.soem_receive_cycle(handle, ptx, tx.Length, timeoutUs, &res);
+        }
+
+        result = res;
+        return rc;
+    }
+
     public int GetHealth(IntPtr handle, out SoemShim.SoemHealth health)
         => SoemShim.soem_get_health(handle, out health);
 
+    public int GetDcStats(IntPtr handle, out SoemShim.SoemDcStats stats)
+        => SoemShim.soem_get_dc_stats(handle, out stats);
+
+    public int GetCycleStats(IntPtr handle, out SoemShim.SoemCycleStats stats)
+        => SoemShim.soem_get_cycle_stats(handle, out stats);
+
     public int TryRecover(IntPtr handle, int timeoutMs)
         => SoemShim.soem_try_recover(handle, timeoutMs);
 
+    public IntPtr GetIoMap(IntPtr handle, out int size)
+        => SoemShim.soem_get_iomap(handle, out size);
+
+    public int GetIoLayout(IntPtr handle, SoemShim.SoemSlaveIo[] layout)
+    {
+        fixed (SoemShim.SoemSlaveIo* p = layout)
+        {
+            return SoemShim.soem_get_io_layout(handle, p, layout.Length);
+        }
+    }
+
+    public int ScanInputs(IntPtr handle, uint[] changed, DriveStatusWord[] status)
+    {
+        fixed (uint* pc = changed)
+        fixed (DriveStatusWord* ps = status)
+        {
+            return SoemShim.soem_scan_inputs(handle, pc, changed.Length, ps, status.Length);
+        }
+    }
+
     public int ListNetworkAdapterNames()
         => SoemShim.soem_get_network_adapters();
 
     public string DrainErrorList(IntPtr handle, StringBuilder? buffer = null)
     {
-        buffer ??= new StringBuilder(4096);
+        int rc;
+        fixed (byte* p = _errorBytes)
+        {
+            rc = SoemShim.soem_drain_error_list(handle, p, _errorBytes.Length);
+        }
+
+        if (rc == 0)
+        {
+            return string.Empty;
+        }
+
+        var length = Array.IndexOf(_errorBytes, (byte)0);
+        if (length < 0)
+        {
+            length = _errorBytes.Length;
+        }
+
+        buffer ??= new StringBuilder(length);
         buffer.Clear();
-        var rc = SoemShim.soem_drain_error_list(handle, buffer, buffer.Capacity);
-        return rc == 0 ? string.Empty : buffer.ToString();
+        buffer.Append(Encoding.UTF8.GetString(_errorBytes, 0, length));
+        return buffer.ToString();
+    }
+
+    public bool HasErrors(IntPtr handle)
+        => SoemShim.soem_has_errors(handle) != 0;
+
+    public int PopErrors(IntPtr handle, SoemShim.SoemErrorRecord[] records)
+    {
+        fixed (SoemShim.SoemErrorRecord* p = records)
+        {
+            return SoemShim.soem_pop_errors(handle, p, records.Length);
+        }
+    }
+
+    public int CheckState(IntPtr handle, bool force)
+        => SoemShim.soem_check_state(handle, force ? 1 : 0);
+
+    public int GetSlaveStates(IntPtr handle, SoemShim.SoemSlaveState[] states, out SoemShim.SoemStateInfo info)
+    {
+        fixed (SoemShim.SoemSlaveState* p = states)
+        {
+            return SoemShim.soem_get_slave_states(handle, p, states.Length, out info);
+        }
+    }
+
+    public bool StartRecovery(IntPtr handle)
+        => SoemShim.soem_recover_start(handle) != 0;
+
+    public int GetRedundancy(IntPtr handle, out SoemShim.SoemRedundancy status)
+        => SoemShim.soem_get_redundancy(handle, out status);
+
+    public int GetGroupStatus(IntPtr handle, SoemShim.SoemGroupStatus[] status)
+    {
+        fixed (SoemShim.SoemGroupStatus* p = status)
+        {
+            return SoemShim.soem_get_group_status(handle, p, status.Length);
+        }
+    }
+
+    public int RecoverStep(IntPtr handle)
+        => SoemShim.soem_recover_step(handle);
+
+    public int SdoRead(IntPtr handle, int slave, ushort index, byte subindex)
+        => SoemShim.soem_sdo_read(handle, slave, index, subindex);
+
+    public int SdoWrite(IntPtr handle, int slave, ushort index, byte subindex, ReadOnlySpan<byte> data)
+    {
+        fixed (byte* p = data)
+        {
+            return SoemShim.soem_sdo_write(handle, slave, index, subindex, p, data.Length);
+        }
     }
 
+    public int PollSdo(IntPtr handle, SoemShim.SoemSdoCompletion[] completions)
+    {
+        fixed (SoemShim.SoemSdoCompletion* p = completions)
+        {
+            return SoemShim.soem_sdo_poll(handle, p, completions.Length);
+        }
+    }
+
+    public int ServiceSdo(IntPtr handle)
+        => SoemShim.soem_sdo_service(handle);
+
+    public int GetSdoStats(IntPtr handle, out SoemShim.SoemSdoStats stats)
+        => SoemShim.soem_sdo_get_stats(handle, out stats);
+
+    public int GetNicStats(IntPtr handle, out SoemShim.SoemNicStats stats)
+        => SoemShim.soem_get_nic_stats(handle, out stats);
+
+    public int ExportCapture(IntPtr handle, string path)
+        => SoemShim.soem_capture_export(handle, path);
+
+    public int GetCaptureStats(IntPtr handle, out SoemShim.SoemCaptureStats stats)
+        => SoemShim.soem_capture_get_stats(handle, out stats);
+
+    public int GetBootReport(IntPtr handle, out SoemShim.SoemBootReport report)
+        => SoemShim.soem_get_boot_report(handle, out report);
+
+    public int StartCycleEngine(IntPtr handle, ref SoemShim.SoemRtConfig config)
+        => SoemShim.soem_rt_start(handle, in config);
+
+    public int StopCycleEngine(IntPtr handle)
+        => SoemShim.soem_rt_stop(handle);
+
+    public int PushCommand(IntPtr handle, int slaveIndex, ref SoemShim.DriveRxPDO pdo)
+        => SoemShim.soem_rt_push_command(handle, slaveIndex, in pdo);
+
+    public int PopSample(IntPtr handle, out SoemShim.SoemRtSample sample, byte[] inputs)
+    {
+        fixed (byte* p = inputs)
+        {
+            return SoemShim.soem_rt_pop_sample(handle, out sample, p, inputs.Length);
+        }
+    }
+
+    public int GetCycleEngineStats(IntPtr handle, out SoemShim.SoemRtStats stats)
+        => SoemShim.soem_rt_get_stats(handle, out stats);
+
+    public bool PinCurrentThread(int cpu)
+        => SoemShim.soem_pin_thread(cpu) != 0;
+
     public void Dispose()
     {
+        if (Interlocked.Exchange(ref _disposed, 1) != 0)
+        {
+            return;
+        }
+
+        _logStop.Set();
+        _logPump.Join();
+        DrainLog();
+        foreach (var bus in _buses.Keys)
+        {
+            BusLoggers.TryRemove(bus, out _);
+        }
+
+        _logStop.Dispose();
     }
 }
@@ -26,6 +26,31 @@ internal static class SoemErrorCodes
     /// </summary>
     public const int SOEM_ERR_WKC_LOW = -10;
 
+    /// <summary>
+    /// Feature not available in this native build (e.g. the cyclic engine on Windows).
+    /// </summary>
+    public const int SOEM_ERR_UNSUPPORTED = -14;
+
+    /// <summary>
+    /// The native cyclic engine owns the bus; stop it before exchanging or recovering directly.
+    /// </summary>
+    public const int SOEM_ERR_BUSY = -15;
+
+    /// <summary>
+    /// The native cyclic engine thread could not be started.
+    /// </summary>
+    public const int SOEM_ERR_RT_START = -16;
+
+    /// <summary>
+    /// An SDO transfer was aborted by the slave or timed out; an abort code is in SOEM's error list.
+    /// </summary>
+    public const int SOEM_ERR_SDO = -17;
+
+    /// <summary>
+    /// A file could not be read or written (capture export).
+    /// </summary>
+    public const int SOEM_ERR_IO = -18;
+
     /// <summary>
     /// Checks if the error code indicates a fatal communication error.
     /// </summary>
@@ -59,6 +84,11 @@ internal static class SoemErrorCodes
             SOEM_ERR_SEND_FAIL => "Failed to send EtherCAT process data",
             SOEM_ERR_RECV_FAIL => "Failed to receive EtherCAT process data",
             SOEM_ERR_WKC_LOW => "Working counter below expected (slave communication issue)",
+            SOEM_ERR_UNSUPPORTED => "Not supported by this soemshim build",
+            SOEM_ERR_BUSY => "Native cyclic engine is running",
+            SOEM_ERR_RT_START => "Failed to start the native cyclic engine",
+            SOEM_ERR_SDO => "SDO transfer aborted or timed out",
+            SOEM_ERR_IO => "File could not be read or written",
             _ when errorCode < 0 => $"Unknown SOEM error code: {errorCode}",
             _ => "Success"
         };
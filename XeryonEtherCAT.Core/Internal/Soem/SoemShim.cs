@@ -1,11 +1,11 @@
 using System;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
-using System.Text;
 using XeryonEtherCAT.Core.Models; // added to forward to formatter
 
 namespace XeryonEtherCAT.Core.Internal.Soem;
 
-public static class SoemShim
+public static unsafe partial class SoemShim
 {
     [StructLayout(LayoutKind.Sequential)]
     public struct SoemHandle
@@ -13,11 +13,22 @@ public static class SoemShim
         public IntPtr Handle;
     }
 
+    /// <summary>
+    /// Inline 32-byte ASCII keyword, NUL padded. Converts implicitly to <see cref="Span{T}"/> of bytes.
+    /// </summary>
+    [InlineArray(32)]
+    public struct CommandBytes
+    {
+        private byte _element0;
+    }
+
+    /// <summary>
+    /// Blittable mirror of the native <c>DriveRxPDO</c>: passed by pointer, never copied by the marshaller.
+    /// </summary>
     [StructLayout(LayoutKind.Sequential, Pack = 1)]
     public struct DriveRxPDO
     {
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 32)]
-        public byte[] Command;
+        public CommandBytes Command;
         public int Parameter;
         public int Velocity;
         public ushort Acceleration;
@@ -54,6 +65,54 @@ public static class SoemShim
         public byte Slot;
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemDcStats
+    {
+        public int active;
+        public int sync0_slaves;
+        public int cycle_ns;
+        public int shift_ns;
+        public int lead_ns;
+        public int offset_ns;
+        public int offset_min_ns;
+        public int offset_max_ns;
+        public int drift_ppb;
+        public int correction_ns;
+        public long dc_time_ns;
+        public ulong samples;
+    }
+
+    // SOEM error list entry types (ec_err_type) carried in SoemErrorRecord.type.
+    public const int SOEM_ERRT_SDO = 0;
+    public const int SOEM_ERRT_EMERGENCY = 1;
+    public const int SOEM_ERRT_PACKET = 3;
+    public const int SOEM_ERRT_SDOINFO = 4;
+    public const int SOEM_ERRT_FOE = 5;
+    public const int SOEM_ERRT_FOE_BUF2SMALL = 6;
+    public const int SOEM_ERRT_FOE_PACKETNO = 7;
+    public const int SOEM_ERRT_SOE = 8;
+    public const int SOEM_ERRT_MBX = 9;
+    public const int SOEM_ERRT_FOE_NOTFOUND = 10;
+    public const int SOEM_ERRT_EOE_RX = 11;
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemErrorRecord
+    {
+        public long timestamp_ns;
+        public int type;
+        public int abort_code;
+        public ushort slave;
+        public ushort index;
+        public ushort error_code;
+        public ushort emergency_w1;
+        public ushort emergency_w2;
+        public byte subindex;
+        public byte error_reg;
+        public byte emergency_b1;
+        private byte _reserved0;
+        private ushort _reserved1;
+    }
+
     [StructLayout(LayoutKind.Sequential)]
     public struct SoemHealth
     {
@@ -64,6 +123,305 @@ public static class SoemShim
         public int bytes_in;
         public int slaves_op;
         public int al_status_code;
+        public SoemDcStats dc;
+    }
+
+    // Kernel selection for the bulk scan exports; AUTO picks the best the CPU supports.
+    public const int SOEM_ISA_AUTO = 0;
+    public const int SOEM_ISA_SCALAR = 1;
+    public const int SOEM_ISA_SSE2 = 2;
+    public const int SOEM_ISA_AVX2 = 3;
+
+    public const uint SOEM_IOMAP_LOCKED = 0x1;
+    public const uint SOEM_IOMAP_HUGE_PAGES = 0x2;
+    public const uint SOEM_NIC_SOCKET = 0;
+    public const uint SOEM_NIC_RING = 1;
+    public const uint SOEM_CAPTURE_ON_FAULT = 0x1;
+    public const int SOEM_BOOT_DISCOVERED = 0;
+    public const int SOEM_BOOT_CACHED = 1;
+    public const int SOEM_CONFIG_OFF = 0;
+    public const int SOEM_CONFIG_USED = 1;
+    public const int SOEM_CONFIG_MISSING = 2;
+    public const int SOEM_CONFIG_STALE = 3;
+    public const int SOEM_CONFIG_COUNT = 4;
+    public const int SOEM_CONFIG_IDENTITY = 5;
+    public const int SOEM_CONFIG_TOPOLOGY = 6;
+    public const int SOEM_CONFIG_FAILED = 7;
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemInitOptions
+    {
+        public uint struct_size;
+        public uint iomap_flags;
+        public uint dc_cycle_ns;
+        public int dc_shift_ns;
+        public int dc_lead_ns;
+        public uint cycle_period_ns;
+        public uint state_check_ms;
+        public uint group_count;
+        public GroupDividers group_divider;
+        public IntPtr slave_group; // byte per slave, slave 1 first; must stay pinned for the initialize call
+        public int slave_group_count;
+        public uint bus_id; // log tag from soem_log_new_bus; 0 = the shim takes a new one
+        public uint sdo_workers; // > 0: CoE mailboxes through the cyclic handler, with this many SDO threads
+        public uint sdo_actions; // mailboxes moved per service call, 0 = 2
+        public uint nic_backend; // SOEM_NIC_*; a ring the shim cannot open falls back to the socket with a warning
+        public uint nic_ring_frames; // slots per RX and TX ring, 0 = 256
+        public IntPtr capture_dir; // UTF-8 directory of the capture ring and fault exports, null = /dev/shm
+        public uint capture_bytes; // > 0: capture every cyclic frame into a mapped ring of this size (Linux)
+        public uint capture_window_ms; // newest part of the ring a fault export keeps, 0 = all of it
+        public uint capture_flags; // SOEM_CAPTURE_*
+        public IntPtr config_path; // UTF-8 stored configuration: used when the bus matches it, written after a discovery
+        public IntPtr sii_cache_path; // UTF-8 SII images by vendor/product/revision/serial, for the discovery
+    }
+
+    public const int SOEM_SDO_MAX_BYTES = 256;
+
+    [InlineArray(SOEM_SDO_MAX_BYTES)]
+    public struct SdoData
+    {
+        private byte _element0;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemSdoCompletion
+    {
+        public uint ticket;
+        public int status; // bytes transferred, or SOEM_ERR_SDO
+        public ushort slave;
+        public ushort index;
+        public byte subindex;
+        public byte write;
+        public ushort size;
+        public long reserved;
+        public long elapsed_ns;
+        public SdoData data;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemSdoStats
+    {
+        public int workers;
+        public int in_flight;
+        public ulong submitted;
+        public ulong completed;
+        public ulong failed;
+        public ulong service_calls;
+        public long max_service_ns;
+        public long max_latency_ns;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemNicStats
+    {
+        public int backend; // SOEM_NIC_* actually in use
+        public int ring_frames;
+        public ulong tx_frames;
+        public ulong rx_frames;
+        public ulong rx_dropped;
+        public ulong tx_busy;
+        public ulong kicks;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemCaptureStats
+    {
+        public int enabled;
+        public uint window_ms;
+        public ulong ring_bytes;
+        public ulong frames;
+        public ulong bytes;
+        public ulong overwritten;
+        public ulong exports;
+        public ulong fault_exports;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemBootReport
+    {
+        public int source; // SOEM_BOOT_*
+        public int config; // SOEM_CONFIG_*
+        public int mismatch_slave;
+        public int config_written;
+        public int slaves;
+        public int sii_cached; // slaves whose SII came from sii_cache_path
+        public int sii_read; // slaves whose SII was read from the bus
+        public int op_slaves; // slaves in OP at the end of the startup
+        public long configure_ns; // discovery and mapping, or check and restore
+        public long total_ns; // whole initialization, NIC open to OP
+        public long nic_ns; // startup timeline, one phase after the other
+        public long discovery_ns;
+        public long mapping_ns;
+        public long dc_ns;
+        public long safeop_ns; // cycling until the last slave reported SAFE-OP
+        public long op_ns; // from there until the last slave reported OP
+    }
+
+    public const int SOEM_MAX_GROUPS = 4;
+
+    [InlineArray(SOEM_MAX_GROUPS)]
+    public struct GroupDividers
+    {
+        private uint _element0;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemGroupStatus
+    {
+        public int group;
+        public int divider;
+        public int slave_count;
+        public int expected_wkc;
+        public int last_wkc;
+        public int slaves_op;
+        public int bytes_out;
+        public int bytes_in;
+        public ulong exchanges;
+        public ulong wkc_low;
+        public long last_exchange_ns;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemSlaveIo
+    {
+        public int out_offset;
+        public int out_bytes;
+        public int in_offset;
+        public int in_bytes;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemCycleResult
+    {
+        public int status;
+        public int wkc;
+        public int expected_wkc;
+        public int error_pending;
+        public int slave_count;
+        public int tx_count;
+        public long exchange_ns;
+        public long total_ns;
+        public int state_due;
+        public int red_path;
+    }
+
+    public const int SOEM_RED_PATH_RING = 1;
+    public const int SOEM_RED_PATH_PRIMARY = 2;
+    public const int SOEM_RED_PATH_SECONDARY = 3;
+    public const int SOEM_RED_PATH_SPLIT = 4;
+    public const int SOEM_RED_PATH_LOST = 5;
+
+    /// <summary>
+    /// SOEM_RED_PATH_* of each frame of a cycle (<c>soem_redundancy_t.frame_path</c>).
+    /// </summary>
+    [InlineArray(16)]
+    public struct RedFramePaths
+    {
+        private byte _element0;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemRedundancy
+    {
+        public int enabled;
+        public int path;
+        public int primary_slaves;
+        public int secondary_slaves;
+        public int break_after;
+        public int frames;
+        public RedFramePaths frame_path;
+        public ulong cycles;
+        public ulong degraded_cycles;
+        public ulong topology_changes;
+        public long changed_ns;
+    }
+
+    public const ushort SOEM_SLAVE_LOST = 0x1;
+    public const ushort SOEM_SLAVE_RECOVERING = 0x2;
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemSlaveState
+    {
+        public ushort state;
+        public ushort al_status_code;
+        public ushort flags;
+        private ushort _reserved;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemStateInfo
+    {
+        public int slaves_op;
+        public uint al_status_code;
+        public long read_ns;
+        public ulong reads;
+        public int recovering;
+        public int slaves_lost;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemRtConfig
+    {
+        public int cycle_time_us;
+        public int priority;
+        public int cpu;
+        public int lock_memory;
+        public int receive_timeout_us;
+        public int ring_capacity;
+        public int dc_sync;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemLatencySummary
+    {
+        public ulong count;
+        public long min_ns;
+        public long max_ns;
+        public long mean_ns;
+        public long p50_ns;
+        public long p90_ns;
+        public long p99_ns;
+        public long p999_ns;
+        public long p9999_ns;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemCycleStats
+    {
+        public long interval_ns;
+        public SoemLatencySummary round_trip;
+        public SoemLatencySummary wake_lateness;
+        public SoemLatencySummary total;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemRtSample
+    {
+        public ulong cycle;
+        public long timestamp_ns;
+        public int wkc;
+        public int expected_wkc;
+        public int wake_latency_ns;
+        public int exchange_ns;
+        public int slave_count;
+        public int error_pending;
+        public int red_path;
+        private int _reserved;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct SoemRtStats
+    {
+        public int running;
+        public int cycle_time_us;
+        public ulong cycles;
+        public ulong overruns;
+        public ulong wkc_low;
+        public ulong samples_dropped;
+        public ulong commands_applied;
+        public long last_wake_latency_ns;
+        public long max_wake_latency_ns;
+        public long max_exchange_ns;
     }
 
 
@@ -78,42 +436,265 @@ public static class SoemShim
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
     public delegate void SoemLogCallback(SoemLogLevel level, [MarshalAs(UnmanagedType.LPStr)] string message);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    public static extern void soem_set_log_callback(SoemLogCallback callback);
+    [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+    public delegate void SoemLogBusCallback(SoemLogLevel level, uint bus, [MarshalAs(UnmanagedType.LPStr)] string message);
+
+    // Source-generated stubs: every struct crossing the boundary is blittable, so nothing is copied or allocated.
+    // [SuppressGCTransition] is reserved for exports the header lists as non-blocking and callback-free; anything
+    // that can log, touch the NIC or wait must keep the regular transition.
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    public static partial void soem_set_log_callback(IntPtr callback);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    public static partial void soem_set_log_bus_callback(IntPtr callback);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    public static partial uint soem_log_new_bus();
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial uint soem_get_bus_id(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_pin_thread(int cpu);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    public static partial int soem_log_drain(int maxRecords);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    public static partial ulong soem_log_dropped();
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    public static partial int soem_drain_error_list(IntPtr handle, byte* buffer, int bufferSize);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_has_errors(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_pop_errors(IntPtr h, SoemErrorRecord* records, int max);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_check_state(IntPtr h, int force);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_slave_states(IntPtr h, SoemSlaveState* states, int maxCount, out SoemStateInfo info);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_recover_start(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_recover_step(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_redundancy(IntPtr h, out SoemRedundancy status);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_group_status(IntPtr h, SoemGroupStatus* status, int max);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_sdo_read(IntPtr h, int slave, ushort index, byte subindex);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_sdo_write(IntPtr h, int slave, ushort index, byte subindex, byte* data, int size);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_sdo_poll(IntPtr h, SoemSdoCompletion* completions, int max);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_sdo_service(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_sdo_get_stats(IntPtr h, out SoemSdoStats stats);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_nic_stats(IntPtr h, out SoemNicStats stats);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_capture_get_stats(IntPtr h, out SoemCaptureStats stats);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_boot_report(IntPtr h, out SoemBootReport report);
+
+    [LibraryImport("soemshim", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_capture_export(IntPtr h, string path);
+
+    [LibraryImport("soemshim", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_capture_convert(string ringPath, string path, uint windowMs);
+
+    [LibraryImport("soemshim", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial IntPtr soem_initialize(string ifname);
+
+    [LibraryImport("soemshim", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial IntPtr soem_initialize_ex(string ifname, ref SoemInitOptions options);
+
+    [LibraryImport("soemshim", StringMarshalling = StringMarshalling.Utf8)]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial IntPtr soem_initialize_redundant(string ifname, string if2name, ref SoemInitOptions options);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial void soem_shutdown(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_slave_count(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_expected_rx_bytes();
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_expected_tx_bytes();
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_write_rxpdo(IntPtr h, int slaveIndex, in DriveRxPDO inPdo);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_read_txpdo(IntPtr h, int slaveIndex, out DriveTxPDO outPdo);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_read_status(IntPtr h, int slaveIndex, out DriveStatusWord status);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_exchange_process_data(IntPtr h, byte* outputs, int outputsLen, byte* inputs, int inputsLen, int timeoutUs);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_cycle(IntPtr h, DriveRxPDO* rx, int rxCount, DriveStatusWord* tx, int txCount, int timeoutUs, SoemCycleResult* result);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_send_cycle(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_poll_cycle(IntPtr h);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_receive_cycle(IntPtr h, DriveStatusWord* tx, int txCount, int timeoutUs, SoemCycleResult* result);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_get_health(IntPtr h, out SoemHealth health);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_dc_stats(IntPtr h, out SoemDcStats stats);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_get_cycle_stats(IntPtr h, out SoemCycleStats stats);
+
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial IntPtr soem_get_iomap(IntPtr h, out int size);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    public static extern int soem_drain_error_list(IntPtr handle, [MarshalAs(UnmanagedType.LPStr)] StringBuilder buffer, int bufferSize);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_get_io_layout(IntPtr h, SoemSlaveIo* layout, int maxCount);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern IntPtr soem_initialize([MarshalAs(UnmanagedType.LPStr)] string ifname);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_scan_inputs(IntPtr h, uint* changed, int changedWords, DriveStatusWord* status, int statusCount);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern void soem_shutdown(IntPtr h);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_diff_inputs(byte* cur, byte* prev, int count, uint* changed, int changedWords, int isa);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_get_slave_count(IntPtr h);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_expand_status(DriveStatusWord* input, DriveTxPDO* output, int count, int isa);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_expected_rx_bytes();
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_simd_level();
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_expected_tx_bytes();
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_try_recover(IntPtr h, int timeoutMs);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_write_rxpdo(IntPtr h, int slaveIndex, ref DriveRxPDO inPdo);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_get_network_adapters();
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_read_txpdo(IntPtr h, int slaveIndex, out DriveTxPDO outPdo);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_rt_start(IntPtr h, in SoemRtConfig config);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_exchange_process_data(IntPtr h, byte[] outputs, int outputsLen, byte[] inputs, int inputsLen, int timeoutUs);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    internal static partial int soem_rt_stop(IntPtr h);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_get_health(IntPtr h, out SoemHealth health);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_rt_push_command(IntPtr h, int slaveIndex, in DriveRxPDO inPdo);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_try_recover(IntPtr h, int timeoutMs);
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_rt_pop_sample(IntPtr h, out SoemRtSample sample, byte* inputs, int inputsLen);
 
-    [DllImport("soemshim", CallingConvention = CallingConvention.Cdecl)]
-    internal static extern int soem_get_network_adapters();
+    [LibraryImport("soemshim")]
+    [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+    [SuppressGCTransition]
+    internal static partial int soem_rt_get_stats(IntPtr h, out SoemRtStats stats);
 }
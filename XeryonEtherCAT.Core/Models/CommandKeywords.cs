@@ -0,0 +1,47 @@
+using System;
+using System.Buffers.Binary;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Xeryon command keywords pre-encoded as the four ASCII bytes that reach the drive (little-endian, NUL padded).
+/// Staging a command is then a single 32-bit store into <see cref="SoemShim.DriveRxPDO.Command"/> instead of a
+/// string encode per slave per cycle.
+/// </summary>
+internal static class CommandKeywords
+{
+    /// <summary>
+    /// Keyword bytes carried by the RxPDO; anything after them never leaves the shim.
+    /// </summary>
+    public const int WireLength = 4;
+
+    /// <summary>
+    /// Staged for idle axes. Every other keyword is encoded once when its <see cref="PendingCommand"/> is created.
+    /// </summary>
+    public static readonly uint Nop = Encode("NOP");
+
+    /// <summary>
+    /// Encodes the first <see cref="WireLength"/> characters of <paramref name="keyword"/>; non-ASCII characters become '?'.
+    /// </summary>
+    public static uint Encode(string keyword)
+    {
+        ArgumentNullException.ThrowIfNull(keyword);
+
+        var value = 0u;
+        var length = Math.Min(keyword.Length, WireLength);
+        for (var i = 0; i < length; i++)
+        {
+            var c = keyword[i];
+            value |= (uint)(c < 0x80 ? c : '?') << (8 * i);
+        }
+
+        return value;
+    }
+
+    /// <summary>
+    /// Stores an encoded keyword in the command field. The rest of the field is left as is (always NUL).
+    /// </summary>
+    public static void Write(ref SoemShim.DriveRxPDO pdo, uint keyword)
+        => BinaryPrimitives.WriteUInt32LittleEndian(pdo.Command, keyword);
+}
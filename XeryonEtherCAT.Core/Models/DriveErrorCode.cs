@@ -16,4 +16,8 @@ public enum DriveErrorCode
     ForceZero,
     ErrorCompensationFault,
     UnknownFault,
+    Emergency,
+    SdoAbort,
+    MailboxError,
+    SlaveLost,
 }
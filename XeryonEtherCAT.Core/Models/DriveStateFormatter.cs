@@ -1,3 +1,4 @@
+using System;
 using System.Collections.Generic;
 using System.Linq;
 using System.Reflection;
@@ -7,10 +8,14 @@ using XeryonEtherCAT.Core.Internal.Soem;
 namespace XeryonEtherCAT.Core.Models;
 
 /// <summary>
-/// Helper utilities for interpreting <see cref="SoemShim.DriveTxPDO"/> values.
+/// Helper utilities for interpreting <see cref="DriveStatusWord"/> and <see cref="SoemShim.DriveTxPDO"/> values.
 /// </summary>
 public static class DriveStateFormatter
 {
+    private static readonly DriveStatusFlags[] AllFlags = Enum.GetValues<DriveStatusFlags>()
+        .Where(flag => flag != DriveStatusFlags.None)
+        .ToArray();
+
     /// <summary>
     /// Converts the drive status bits into a packed mask for logging/debugging.
     /// </summary>
@@ -48,6 +53,44 @@ public static class DriveStateFormatter
         return FormatAs3ByteHex(mask);
     }
 
+    public static string ToHexString(in DriveStatusWord status)
+        => FormatAs3ByteHex(status.Mask);
+
+    /// <summary>
+    /// Names of the set flags, in bit order, or "Idle" when none are set.
+    /// </summary>
+    public static string Describe(in DriveStatusWord status)
+    {
+        var parts = new List<string>();
+        foreach (var flag in AllFlags)
+        {
+            if (status.Has(flag))
+            {
+                parts.Add(flag.ToString());
+            }
+        }
+
+        return parts.Count == 0 ? "Idle" : string.Join(", ", parts);
+    }
+
+    /// <summary>
+    /// Format a status word like <see cref="DriveTxPdoToHexString"/>: "pos: XX XX XX XX (n), status: XX XX XX, slot: XX".
+    /// </summary>
+    public static string StatusWordToHexString(in DriveStatusWord status, string separator = " ", bool prefixPerByte = false)
+    {
+        var position = status.ActualPosition;
+        var mask = status.Mask;
+
+        // Position and status most significant byte first; slot displayed 1-based
+        var pos = new[] { (byte)(position >> 24), (byte)(position >> 16), (byte)(position >> 8), (byte)position };
+        var flags = new[] { (byte)(mask >> 16), (byte)(mask >> 8), (byte)mask };
+        var slot = (byte)(status.Slot + 1);
+
+        string fmt(byte b) => prefixPerByte ? "0x" + b.ToString("X2") : b.ToString("X2");
+
+        return $"pos: {string.Join(separator, pos.Select(fmt))} ({position}), status: {string.Join(separator, flags.Select(fmt))}, slot: {fmt(slot)}";
+    }
+
     // Helper to format a 24-bit mask as "AA BB CC"
     private static string FormatAs3ByteHex(uint value)
     {
@@ -0,0 +1,21 @@
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Status of one drive as published by the last IO cycle.
+/// </summary>
+public readonly struct DriveStatus
+{
+    public DriveStatus(DriveStatusWord word)
+    {
+        Word = word;
+    }
+
+    /// <summary>
+    /// Packed position, flags and slot.
+    /// </summary>
+    public DriveStatusWord Word { get; }
+
+    public int ActualPosition => Word.ActualPosition;
+
+    public DriveStatusFlags Flags => Word.Flags;
+}
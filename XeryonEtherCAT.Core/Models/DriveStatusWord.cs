@@ -0,0 +1,151 @@
+using System;
+using System.Buffers.Binary;
+using System.Runtime.InteropServices;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// One drive's TxPDO in its wire form: position, the 24 flag bits of bytes 4..6 and the slot byte, 8 bytes in all.
+/// Mirrors the native <c>soem_status_word_t</c>, so it is filled straight from the input bytes and two statuses
+/// are compared with a single XOR of <see cref="Mask"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential, Pack = 1)]
+public readonly struct DriveStatusWord : IEquatable<DriveStatusWord>
+{
+    /// <summary>
+    /// Bits of <see cref="Mask"/> that carry flags; the top byte of the native word is the slot.
+    /// </summary>
+    public const uint FlagsMask = 0x00FF_FFFF;
+
+    private readonly int _position;
+    private readonly uint _flagsAndSlot;
+
+    public DriveStatusWord(int actualPosition, DriveStatusFlags flags, byte slot)
+    {
+        _position = actualPosition;
+        _flagsAndSlot = ((uint)flags & FlagsMask) | ((uint)slot << 24);
+    }
+
+    public int ActualPosition => _position;
+
+    public DriveStatusFlags Flags => (DriveStatusFlags)(_flagsAndSlot & FlagsMask);
+
+    /// <summary>
+    /// Flag bits as a raw 24-bit mask (same bit order as <see cref="DriveStateFormatter.ToBitMask"/>).
+    /// </summary>
+    public uint Mask => _flagsAndSlot & FlagsMask;
+
+    /// <summary>
+    /// Slot byte as reported by the drive (0-based).
+    /// </summary>
+    public byte Slot => (byte)(_flagsAndSlot >> 24);
+
+    public bool AmplifiersEnabled => Has(DriveStatusFlags.AmplifiersEnabled);
+    public bool EndStop => Has(DriveStatusFlags.EndStop);
+    public bool ThermalProtection1 => Has(DriveStatusFlags.ThermalProtection1);
+    public bool ThermalProtection2 => Has(DriveStatusFlags.ThermalProtection2);
+    public bool ForceZero => Has(DriveStatusFlags.ForceZero);
+    public bool MotorOn => Has(DriveStatusFlags.MotorOn);
+    public bool ClosedLoop => Has(DriveStatusFlags.ClosedLoop);
+    public bool EncoderIndex => Has(DriveStatusFlags.EncoderIndex);
+    public bool EncoderValid => Has(DriveStatusFlags.EncoderValid);
+    public bool SearchingIndex => Has(DriveStatusFlags.SearchingIndex);
+    public bool PositionReached => Has(DriveStatusFlags.PositionReached);
+    public bool ErrorCompensation => Has(DriveStatusFlags.ErrorCompensation);
+    public bool EncoderError => Has(DriveStatusFlags.EncoderError);
+    public bool Scanning => Has(DriveStatusFlags.Scanning);
+    public bool LeftEndStop => Has(DriveStatusFlags.LeftEndStop);
+    public bool RightEndStop => Has(DriveStatusFlags.RightEndStop);
+    public bool ErrorLimit => Has(DriveStatusFlags.ErrorLimit);
+    public bool SearchingOptimalFrequency => Has(DriveStatusFlags.SearchingOptimalFrequency);
+    public bool SafetyTimeout => Has(DriveStatusFlags.SafetyTimeout);
+    public bool ExecuteAck => Has(DriveStatusFlags.ExecuteAck);
+    public bool EmergencyStop => Has(DriveStatusFlags.EmergencyStop);
+    public bool PositionFail => Has(DriveStatusFlags.PositionFail);
+
+    /// <summary>
+    /// True when every bit of <paramref name="flags"/> is set.
+    /// </summary>
+    public bool Has(DriveStatusFlags flags)
+        => (_flagsAndSlot & (uint)flags) == (uint)flags;
+
+    /// <summary>
+    /// True when any bit of <paramref name="flags"/> is set.
+    /// </summary>
+    public bool HasAny(DriveStatusFlags flags)
+        => (_flagsAndSlot & (uint)flags & FlagsMask) != 0;
+
+    /// <summary>
+    /// Reads the 8-byte TxPDO image (position little-endian, flag bytes 4..6, slot).
+    /// </summary>
+    public static DriveStatusWord FromWire(ReadOnlySpan<byte> src)
+    {
+        if (src.Length < PdoCodec.TxBytes)
+        {
+            throw new ArgumentException($"TxPDO image must be at least {PdoCodec.TxBytes} bytes.", nameof(src));
+        }
+
+        return new DriveStatusWord(
+            BinaryPrimitives.ReadInt32LittleEndian(src),
+            (DriveStatusFlags)BinaryPrimitives.ReadUInt32LittleEndian(src.Slice(4)),
+            src[7]);
+    }
+
+    /// <summary>
+    /// Packs the unpacked <see cref="SoemShim.DriveTxPDO"/> form.
+    /// </summary>
+    public static DriveStatusWord FromPdo(in SoemShim.DriveTxPDO pdo)
+        => new(pdo.ActualPosition, (DriveStatusFlags)DriveStateFormatter.ToBitMask(pdo), pdo.Slot);
+
+    /// <summary>
+    /// Expands to the one-byte-per-flag <see cref="SoemShim.DriveTxPDO"/> form, for consumers that still expect it.
+    /// </summary>
+    public SoemShim.DriveTxPDO ToPdo()
+        => new()
+        {
+            ActualPosition = _position,
+            AmplifiersEnabled = Bit(DriveStatusFlags.AmplifiersEnabled),
+            EndStop = Bit(DriveStatusFlags.EndStop),
+            ThermalProtection1 = Bit(DriveStatusFlags.ThermalProtection1),
+            ThermalProtection2 = Bit(DriveStatusFlags.ThermalProtection2),
+            ForceZero = Bit(DriveStatusFlags.ForceZero),
+            MotorOn = Bit(DriveStatusFlags.MotorOn),
+            ClosedLoop = Bit(DriveStatusFlags.ClosedLoop),
+            EncoderIndex = Bit(DriveStatusFlags.EncoderIndex),
+            EncoderValid = Bit(DriveStatusFlags.EncoderValid),
+            SearchingIndex = Bit(DriveStatusFlags.SearchingIndex),
+            PositionReached = Bit(DriveStatusFlags.PositionReached),
+            ErrorCompensation = Bit(DriveStatusFlags.ErrorCompensation),
+            EncoderError = Bit(DriveStatusFlags.EncoderError),
+            Scanning = Bit(DriveStatusFlags.Scanning),
+            LeftEndStop = Bit(DriveStatusFlags.LeftEndStop),
+            RightEndStop = Bit(DriveStatusFlags.RightEndStop),
+            ErrorLimit = Bit(DriveStatusFlags.ErrorLimit),
+            SearchingOptimalFrequency = Bit(DriveStatusFlags.SearchingOptimalFrequency),
+            SafetyTimeout = Bit(DriveStatusFlags.SafetyTimeout),
+            ExecuteAck = Bit(DriveStatusFlags.ExecuteAck),
+            EmergencyStop = Bit(DriveStatusFlags.EmergencyStop),
+            PositionFail = Bit(DriveStatusFlags.PositionFail),
+            Slot = Slot
+        };
+
+    public bool Equals(DriveStatusWord other)
+        => _position == other._position && _flagsAndSlot == other._flagsAndSlot;
+
+    public override bool Equals(object? obj)
+        => obj is DriveStatusWord other && Equals(other);
+
+    public override int GetHashCode()
+        => HashCode.Combine(_position, _flagsAndSlot);
+
+    public static bool operator ==(DriveStatusWord left, DriveStatusWord right) => left.Equals(right);
+
+    public static bool operator !=(DriveStatusWord left, DriveStatusWord right) => !left.Equals(right);
+
+    public override string ToString()
+        => $"pos={_position} flags=0x{Mask:X6} slot={Slot}";
+
+    private byte Bit(DriveStatusFlags flag)
+        => (byte)((_flagsAndSlot & (uint)flag) != 0 ? 1 : 0);
+}
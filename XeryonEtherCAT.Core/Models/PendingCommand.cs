@@ -45,6 +45,7 @@ internal sealed class PendingCommand
     {
         SlaveIndex = slaveIndex;
         Keyword = keyword;
+        EncodedKeyword = CommandKeywords.Encode(keyword);
         Parameter = parameter;
         Velocity = velocity;
         Acceleration = acc;
@@ -59,6 +60,11 @@ internal sealed class PendingCommand
 
     public string Keyword { get; }
 
+    /// <summary>
+    /// <see cref="Keyword"/> as it goes on the wire, see <see cref="CommandKeywords"/>.
+    /// </summary>
+    public uint EncodedKeyword { get; }
+
     public int Parameter { get; }
 
     public int Velocity { get; }
@@ -100,17 +106,22 @@ internal sealed class PendingCommand
         Acked = true;
     }
 
+    /// <summary>
+    /// Execute bit this command stages: set until the drive acknowledges it (for commands that require an ack).
+    /// </summary>
+    public byte Execute => (byte)(Acked && RequiresAck ? 0 : 1);
+
     public void Apply(ref SoemShim.DriveRxPDO pdo)
     {
-        FillCommand(ref pdo, Keyword);
+        CommandKeywords.Write(ref pdo, EncodedKeyword);
         pdo.Parameter = Parameter;
         pdo.Velocity = Velocity;
         pdo.Acceleration = Acceleration;
         pdo.Deceleration = Deceleration;
-        pdo.Execute = (byte)(Acked && RequiresAck ? 0 : 1);
+        pdo.Execute = Execute;
     }
 
-    public CommandState Evaluate(SoemShim.DriveTxPDO status)
+    public CommandState Evaluate(DriveStatusWord status)
     {
         // Special handling for AckWithTimeout - needs both ACK and full timeout duration
         if (_completion == CommandCompletion.AckWithTimeout)
@@ -143,18 +154,18 @@ internal sealed class PendingCommand
         {
             CommandCompletion.AckOnly => Acked ? CommandState.Completed : CommandState.Pending,
             CommandCompletion.PositionReached => EvaluatePositionReached(status),
-            CommandCompletion.Indexed => (status.EncoderValid != 0 && status.PositionReached != 0) ? CommandState.Completed : CommandState.Pending,
-            CommandCompletion.Enabled => (status.AmplifiersEnabled != 0 && status.MotorOn != 0) ? CommandState.Completed : CommandState.Pending,
-            CommandCompletion.Disabled => status.AmplifiersEnabled == 0 ? CommandState.Completed : CommandState.Pending,
-            CommandCompletion.Halt => status.Scanning == 0 ? CommandState.Completed : CommandState.Pending,
+            CommandCompletion.Indexed => status.Has(DriveStatusFlags.EncoderValid | DriveStatusFlags.PositionReached) ? CommandState.Completed : CommandState.Pending,
+            CommandCompletion.Enabled => status.Has(DriveStatusFlags.AmplifiersEnabled | DriveStatusFlags.MotorOn) ? CommandState.Completed : CommandState.Pending,
+            CommandCompletion.Disabled => !status.AmplifiersEnabled ? CommandState.Completed : CommandState.Pending,
+            CommandCompletion.Halt => !status.Scanning ? CommandState.Completed : CommandState.Pending,
             _ => CommandState.Pending,
         };
     }
 
-    private CommandState EvaluatePositionReached(SoemShim.DriveTxPDO status)
+    private CommandState EvaluatePositionReached(DriveStatusWord status)
     {
-        var currentPositionReached = status.PositionReached != 0;
-        var currentMotorOn = status.MotorOn != 0;
+        var currentPositionReached = status.PositionReached;
+        var currentMotorOn = status.MotorOn;
 
         // Initialize edge detection on first call
         if (!_edgeDetectionInitialized)
@@ -219,17 +230,4 @@ internal sealed class PendingCommand
 
     public static PendingCommand CreateControl(int slaveIndex, string keyword, int parameter, TimeSpan timeout, CommandCompletion completion, ILogger? logger = null)
         => new(slaveIndex, keyword, parameter, 0, 0, 0, timeout, completion, requiresAck: true, logger);
-
-    public static void FillCommand(ref SoemShim.DriveRxPDO pdo, string keyword)
-    {
-        if (pdo.Command == null || pdo.Command.Length != 32)
-        {
-            pdo.Command = new byte[32];
-        }
-
-        Array.Clear(pdo.Command, 0, 32);
-        var ascii = Encoding.ASCII.GetBytes(keyword);
-        var length = Math.Min(ascii.Length, 32);
-        Array.Copy(ascii, 0, pdo.Command, 0, length);
-    }
 }
@@ -0,0 +1,168 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Where the shim took the bus configuration from when it opened the bus.
+/// </summary>
+public enum BootSource
+{
+    /// <summary>Full discovery: every slave's SII and PDO mapping read over the bus.</summary>
+    Discovered = 0,
+
+    /// <summary>
+    /// The stored configuration at <c>StoredConfigurationPath</c>, after the slave count, each slave's
+    /// vendor/product/revision and its open ports were checked against it.
+    /// </summary>
+    StoredConfiguration = 1,
+}
+
+/// <summary>
+/// What became of the stored configuration when the bus was opened.
+/// </summary>
+public enum StoredConfigurationStatus
+{
+    /// <summary>No <c>StoredConfigurationPath</c>.</summary>
+    Off = 0,
+
+    Used = 1,
+
+    /// <summary>No file yet; the discovery wrote it.</summary>
+    Missing = 2,
+
+    /// <summary>Unreadable, written by another shim build, or mapped with other group or SDO options.</summary>
+    Stale = 3,
+
+    SlaveCountChanged = 4,
+
+    /// <summary>A slave has another vendor, product or revision (<see cref="SoemBootReport.MismatchSlave"/>).</summary>
+    IdentityChanged = 5,
+
+    /// <summary>A slave has other ports open (<see cref="SoemBootReport.MismatchSlave"/>).</summary>
+    TopologyChanged = 6,
+
+    /// <summary>A slave did not take the stored SM/FMMU settings (<see cref="SoemBootReport.MismatchSlave"/>).</summary>
+    Rejected = 7,
+}
+
+/// <summary>
+/// How one opening of the bus went (<c>soem_get_boot_report</c>): at <c>InitializeAsync</c>, or when the service
+/// reinitialized the bus after a failed recovery.
+/// </summary>
+public readonly struct SoemBootReport
+{
+    public SoemBootReport(BootSource source, StoredConfigurationStatus configuration, int mismatchSlave, bool configurationWritten, int slaves,
+        int siiCached, int siiRead, int slavesInOp, TimeSpan configureTime, TimeSpan busOpenTime, TimeSpan startupTime, StartupTimeline timeline)
+    {
+        Source = source;
+        Configuration = configuration;
+        MismatchSlave = mismatchSlave;
+        ConfigurationWritten = configurationWritten;
+        Slaves = slaves;
+        SiiCached = siiCached;
+        SiiRead = siiRead;
+        SlavesInOp = slavesInOp;
+        ConfigureTime = configureTime;
+        BusOpenTime = busOpenTime;
+        StartupTime = startupTime;
+        Timeline = timeline;
+    }
+
+    internal static SoemBootReport FromNative(in SoemShim.SoemBootReport report, TimeSpan startupTime)
+        => new((BootSource)report.source, (StoredConfigurationStatus)report.config, report.mismatch_slave, report.config_written != 0, report.slaves,
+            report.sii_cached, report.sii_read, report.op_slaves, Ticks(report.configure_ns), Ticks(report.total_ns), startupTime,
+            new StartupTimeline(Ticks(report.nic_ns), Ticks(report.discovery_ns), Ticks(report.mapping_ns), Ticks(report.dc_ns),
+                Ticks(report.safeop_ns), Ticks(report.op_ns)));
+
+    private static TimeSpan Ticks(long ns) => TimeSpan.FromTicks(ns / 100);
+
+    public BootSource Source { get; }
+
+    public StoredConfigurationStatus Configuration { get; }
+
+    /// <summary>
+    /// Slave (1-based) that failed the check against the stored configuration, 0 when none did.
+    /// </summary>
+    public int MismatchSlave { get; }
+
+    /// <summary>
+    /// The discovery (re)wrote the stored configuration.
+    /// </summary>
+    public bool ConfigurationWritten { get; }
+
+    public int Slaves { get; }
+
+    /// <summary>
+    /// Slaves whose SII the discovery took from <c>SiiCachePath</c>; 0 without one or when the stored configuration
+    /// was used.
+    /// </summary>
+    public int SiiCached { get; }
+
+    /// <summary>
+    /// Slaves whose SII the discovery read from the bus into <c>SiiCachePath</c>.
+    /// </summary>
+    public int SiiRead { get; }
+
+    /// <summary>
+    /// Slaves in OP when the shim returned the bus. Fewer than <see cref="Slaves"/> means the bring-up timed out;
+    /// the shim logs each slave left behind.
+    /// </summary>
+    public int SlavesInOp { get; }
+
+    /// <summary>
+    /// Discovery and mapping, or the check and restore from the stored configuration.
+    /// </summary>
+    public TimeSpan ConfigureTime { get; }
+
+    /// <summary>
+    /// The shim's whole initialization, NIC open to OP.
+    /// </summary>
+    public TimeSpan BusOpenTime { get; }
+
+    /// <summary>
+    /// From the service opening the bus until its IO loop or native engine was running.
+    /// </summary>
+    public TimeSpan StartupTime { get; }
+
+    /// <summary>
+    /// Where <see cref="BusOpenTime"/> went.
+    /// </summary>
+    public StartupTimeline Timeline { get; }
+}
+
+/// <summary>
+/// The phases of the shim's initialization, one after the other. From the end of the DC setup the shim exchanges
+/// process data cyclically and requests each slave to OP as soon as it reports SAFE-OP, so the last two phases end
+/// with the slowest slave.
+/// </summary>
+public readonly struct StartupTimeline
+{
+    public StartupTimeline(TimeSpan nicOpen, TimeSpan discovery, TimeSpan mapping, TimeSpan distributedClocks, TimeSpan safeOp, TimeSpan op)
+    {
+        NicOpen = nicOpen;
+        Discovery = discovery;
+        Mapping = mapping;
+        DistributedClocks = distributedClocks;
+        SafeOp = safeOp;
+        Op = op;
+    }
+
+    /// <summary>Opening the interface(s).</summary>
+    public TimeSpan NicOpen { get; }
+
+    /// <summary><c>ecx_config_init</c>, or the check and restore of the stored configuration.</summary>
+    public TimeSpan Discovery { get; }
+
+    /// <summary>Group assignment, PDO mapping and the process image; nearly zero when restored.</summary>
+    public TimeSpan Mapping { get; }
+
+    /// <summary><c>ecx_configdc</c> and SYNC0.</summary>
+    public TimeSpan DistributedClocks { get; }
+
+    /// <summary>Cycling until the last slave reported SAFE-OP.</summary>
+    public TimeSpan SafeOp { get; }
+
+    /// <summary>From there until the last slave reported OP, or the shim gave up.</summary>
+    public TimeSpan Op { get; }
+}
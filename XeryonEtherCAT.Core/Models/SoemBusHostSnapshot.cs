@@ -0,0 +1,86 @@
+using System;
+using System.Collections.Generic;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Latest status of every bus of an <see cref="Services.EthercatBusHost"/>, in configuration order, with totals.
+/// Each bus is read on its own, so the per-bus snapshots may be a cycle apart.
+/// </summary>
+public sealed class SoemBusHostSnapshot
+{
+    public SoemBusHostSnapshot(DateTimeOffset timestamp, IReadOnlyList<string> names, IReadOnlyList<SoemStatusSnapshot> buses)
+    {
+        if (names.Count != buses.Count)
+        {
+            throw new ArgumentException("One name per bus snapshot is required.", nameof(names));
+        }
+
+        Timestamp = timestamp;
+        Names = names;
+        Buses = buses;
+
+        foreach (var bus in buses)
+        {
+            SlavesFound += bus.Health.SlavesFound;
+            SlavesOperational += bus.Health.SlavesOperational;
+            DriveCount += bus.DriveStates.Length;
+            if (bus.MaxCycleTime > MaxCycleTime)
+            {
+                MaxCycleTime = bus.MaxCycleTime;
+            }
+        }
+    }
+
+    public DateTimeOffset Timestamp { get; }
+
+    public IReadOnlyList<string> Names { get; }
+
+    public IReadOnlyList<SoemStatusSnapshot> Buses { get; }
+
+    public int SlavesFound { get; }
+
+    public int SlavesOperational { get; }
+
+    public int DriveCount { get; }
+
+    /// <summary>
+    /// Longest IO loop iteration of any bus.
+    /// </summary>
+    public TimeSpan MaxCycleTime { get; }
+
+    /// <summary>
+    /// Every bus found slaves and all of them are in OP.
+    /// </summary>
+    public bool AllOperational
+    {
+        get
+        {
+            foreach (var bus in Buses)
+            {
+                if (bus.Health.SlavesFound == 0 || bus.Health.SlavesOperational < bus.Health.SlavesFound)
+                {
+                    return false;
+                }
+            }
+
+            return Buses.Count > 0;
+        }
+    }
+
+    public SoemStatusSnapshot this[string name]
+    {
+        get
+        {
+            for (var i = 0; i < Names.Count; i++)
+            {
+                if (string.Equals(Names[i], name, StringComparison.Ordinal))
+                {
+                    return Buses[i];
+                }
+            }
+
+            throw new KeyNotFoundException($"No bus named '{name}'.");
+        }
+    }
+}
@@ -0,0 +1,61 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Counters of the shim's wire capture ring (<c>soem_capture_get_stats</c>) since the bus was opened. Default when
+/// the service runs without <c>CaptureBytes</c> or the shim has no capture (Windows).
+/// </summary>
+public readonly struct SoemCaptureStatistics
+{
+    public SoemCaptureStatistics(bool enabled, TimeSpan window, long ringBytes, long frames, long bytes, long overwritten, long exports, long faultExports)
+    {
+        Enabled = enabled;
+        Window = window;
+        RingBytes = ringBytes;
+        Frames = frames;
+        Bytes = bytes;
+        Overwritten = overwritten;
+        Exports = exports;
+        FaultExports = faultExports;
+    }
+
+    internal static SoemCaptureStatistics FromNative(in SoemShim.SoemCaptureStats stats)
+        => new(stats.enabled != 0, TimeSpan.FromMilliseconds(stats.window_ms), (long)stats.ring_bytes, (long)stats.frames, (long)stats.bytes,
+            (long)stats.overwritten, (long)stats.exports, (long)stats.fault_exports);
+
+    public bool Enabled { get; }
+
+    /// <summary>
+    /// Newest part of the ring an export keeps; zero keeps all of it.
+    /// </summary>
+    public TimeSpan Window { get; }
+
+    /// <summary>
+    /// Size of the mapped ring; how many seconds it holds is this over the bus's bytes per second.
+    /// </summary>
+    public long RingBytes { get; }
+
+    /// <summary>
+    /// Frames copied into the ring, sent and received.
+    /// </summary>
+    public long Frames { get; }
+
+    public long Bytes { get; }
+
+    /// <summary>
+    /// Frames overwritten by newer ones before any export took them.
+    /// </summary>
+    public long Overwritten { get; }
+
+    /// <summary>
+    /// Files written, on request and after faults.
+    /// </summary>
+    public long Exports { get; }
+
+    /// <summary>
+    /// Files written by the shim after a working counter drop.
+    /// </summary>
+    public long FaultExports { get; }
+}
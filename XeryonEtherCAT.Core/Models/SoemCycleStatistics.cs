@@ -0,0 +1,89 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Latency distribution of one cycle metric over a statistics window. Percentiles come from the shim's
+/// log-linear histogram and are exact to within 3.1 %.
+/// </summary>
+public readonly struct SoemLatencySummary
+{
+    public SoemLatencySummary(long count, TimeSpan min, TimeSpan max, TimeSpan mean, TimeSpan p50, TimeSpan p90, TimeSpan p99, TimeSpan p999, TimeSpan p9999)
+    {
+        Count = count;
+        Min = min;
+        Max = max;
+        Mean = mean;
+        P50 = p50;
+        P90 = p90;
+        P99 = p99;
+        P999 = p999;
+        P9999 = p9999;
+    }
+
+    internal static SoemLatencySummary FromNative(in SoemShim.SoemLatencySummary s)
+        => new((long)s.count, FromNs(s.min_ns), FromNs(s.max_ns), FromNs(s.mean_ns), FromNs(s.p50_ns), FromNs(s.p90_ns), FromNs(s.p99_ns), FromNs(s.p999_ns), FromNs(s.p9999_ns));
+
+    private static TimeSpan FromNs(long ns) => TimeSpan.FromTicks(ns / 100);
+
+    /// <summary>
+    /// Cycles recorded in the window; every other value is zero when this is.
+    /// </summary>
+    public long Count { get; }
+
+    public TimeSpan Min { get; }
+
+    public TimeSpan Max { get; }
+
+    public TimeSpan Mean { get; }
+
+    public TimeSpan P50 { get; }
+
+    public TimeSpan P90 { get; }
+
+    public TimeSpan P99 { get; }
+
+    public TimeSpan P999 { get; }
+
+    public TimeSpan P9999 { get; }
+}
+
+/// <summary>
+/// Native cycle timing over one window of <c>CycleStatisticsWindow</c>, taken with snapshot-and-reset from
+/// <c>soem_get_cycle_stats</c>.
+/// </summary>
+public readonly struct SoemCycleStatistics
+{
+    public SoemCycleStatistics(DateTimeOffset timestamp, TimeSpan interval, SoemLatencySummary roundTrip, SoemLatencySummary wakeLateness, SoemLatencySummary total)
+    {
+        Timestamp = timestamp;
+        Interval = interval;
+        RoundTrip = roundTrip;
+        WakeLateness = wakeLateness;
+        Total = total;
+    }
+
+    /// <summary>
+    /// When the window closed; default until the first window completes.
+    /// </summary>
+    public DateTimeOffset Timestamp { get; }
+
+    public TimeSpan Interval { get; }
+
+    /// <summary>
+    /// Send until the frames were back.
+    /// </summary>
+    public SoemLatencySummary RoundTrip { get; }
+
+    /// <summary>
+    /// How late each cycle started: against the native engine's deadline, or against a <c>CyclePeriod</c> schedule
+    /// for the managed loop.
+    /// </summary>
+    public SoemLatencySummary WakeLateness { get; }
+
+    /// <summary>
+    /// Cycle start until the shim call returned (native engine: until the sample was published).
+    /// </summary>
+    public SoemLatencySummary Total { get; }
+}
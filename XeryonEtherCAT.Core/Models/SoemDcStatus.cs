@@ -0,0 +1,67 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Distributed clock synchronisation as seen by the shim. Phase is where in the SYNC0 period a cycle's frames
+/// passed the reference clock, measured against the target of <see cref="LeadNs"/> before SYNC0.
+/// Default (inactive) unless <c>DistributedClockCycle</c> was configured and a slave supports DC.
+/// </summary>
+public readonly struct SoemDcStatus
+{
+    public SoemDcStatus(bool active, int sync0Slaves, int cycleNs, int shiftNs, int leadNs, int offsetNs, int minOffsetNs, int maxOffsetNs, int driftPpb, int correctionNs, long samples)
+    {
+        Active = active;
+        Sync0Slaves = sync0Slaves;
+        CycleNs = cycleNs;
+        ShiftNs = shiftNs;
+        LeadNs = leadNs;
+        OffsetNs = offsetNs;
+        MinOffsetNs = minOffsetNs;
+        MaxOffsetNs = maxOffsetNs;
+        DriftPpb = driftPpb;
+        CorrectionNs = correctionNs;
+        Samples = samples;
+    }
+
+    internal static SoemDcStatus FromNative(in SoemShim.SoemDcStats dc)
+        => new(dc.active != 0, dc.sync0_slaves, dc.cycle_ns, dc.shift_ns, dc.lead_ns, dc.offset_ns, dc.offset_min_ns, dc.offset_max_ns, dc.drift_ppb, dc.correction_ns, (long)dc.samples);
+
+    /// <summary>
+    /// SYNC0 is running on <see cref="Sync0Slaves"/> slaves.
+    /// </summary>
+    public bool Active { get; }
+
+    public int Sync0Slaves { get; }
+
+    public int CycleNs { get; }
+
+    public int ShiftNs { get; }
+
+    public int LeadNs { get; }
+
+    /// <summary>
+    /// Phase error of the last cycle; positive when the frames arrived later than the lead asks for.
+    /// </summary>
+    public int OffsetNs { get; }
+
+    public int MinOffsetNs { get; }
+
+    public int MaxOffsetNs { get; }
+
+    /// <summary>
+    /// Host clock rate minus reference clock rate in parts per billion (positive: the host runs fast).
+    /// </summary>
+    public int DriftPpb { get; }
+
+    /// <summary>
+    /// Last wake-up correction applied by the native engine's PI controller; 0 when it is not steering.
+    /// </summary>
+    public int CorrectionNs { get; }
+
+    /// <summary>
+    /// Cycles that returned a DC time.
+    /// </summary>
+    public long Samples { get; }
+}
@@ -1,5 +1,4 @@
 using System;
-using XeryonEtherCAT.Core.Internal.Soem;
 
 namespace XeryonEtherCAT.Core.Models;
 
@@ -8,7 +7,7 @@ namespace XeryonEtherCAT.Core.Models;
 /// </summary>
 public sealed class SoemFaultEvent : EventArgs
 {
-    public SoemFaultEvent(int slave, SoemShim.DriveTxPDO status, DriveError error, SoemHealthSnapshot health)
+    public SoemFaultEvent(int slave, DriveStatusWord status, DriveError error, SoemHealthSnapshot health)
     {
         Slave = slave;
         Status = status;
@@ -18,7 +17,7 @@ public sealed class SoemFaultEvent : EventArgs
 
     public int Slave { get; }
 
-    public SoemShim.DriveTxPDO Status { get; }
+    public DriveStatusWord Status { get; }
 
     public DriveError Error { get; }
 
@@ -0,0 +1,65 @@
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Process-data status of one slave group (<c>soem_get_group_status</c>). Each group is exchanged every
+/// <see cref="CycleDivider"/>-th cycle, and its WKC is taken from its own frames.
+/// </summary>
+public readonly struct SoemGroupStatus
+{
+    public SoemGroupStatus(int group, int cycleDivider, int slaveCount, int expectedWkc, int lastWkc, int slavesOperational, int bytesOut, int bytesIn, long exchanges, long wkcLowCount)
+    {
+        Group = group;
+        CycleDivider = cycleDivider;
+        SlaveCount = slaveCount;
+        ExpectedWkc = expectedWkc;
+        LastWkc = lastWkc;
+        SlavesOperational = slavesOperational;
+        BytesOut = bytesOut;
+        BytesIn = bytesIn;
+        Exchanges = exchanges;
+        WkcLowCount = wkcLowCount;
+    }
+
+    internal static SoemGroupStatus FromNative(in SoemShim.SoemGroupStatus status)
+        => new(status.group, status.divider, status.slave_count, status.expected_wkc, status.last_wkc, status.slaves_op,
+            status.bytes_out, status.bytes_in, (long)status.exchanges, (long)status.wkc_low);
+
+    public int Group { get; }
+
+    /// <summary>
+    /// The group is exchanged every this many cycles (1 = every cycle).
+    /// </summary>
+    public int CycleDivider { get; }
+
+    public int SlaveCount { get; }
+
+    public int ExpectedWkc { get; }
+
+    /// <summary>
+    /// WKC of the group's last exchange, -1 before the first.
+    /// </summary>
+    public int LastWkc { get; }
+
+    /// <summary>
+    /// Every slave of the group while its WKC is full, otherwise the OP count of the last AL state read.
+    /// </summary>
+    public int SlavesOperational { get; }
+
+    public int BytesOut { get; }
+
+    public int BytesIn { get; }
+
+    public long Exchanges { get; }
+
+    /// <summary>
+    /// Exchanges that came back with a WKC below <see cref="ExpectedWkc"/>.
+    /// </summary>
+    public long WkcLowCount { get; }
+
+    public bool IsHealthy => ExpectedWkc > 0 && LastWkc >= ExpectedWkc;
+
+    public override string ToString()
+        => $"group {Group} (1/{CycleDivider}): {SlaveCount} slaves, WKC {LastWkc}/{ExpectedWkc}, {SlavesOperational} OP, {Exchanges} exchanges, {WkcLowCount} low";
+}
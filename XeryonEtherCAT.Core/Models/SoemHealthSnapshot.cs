@@ -7,7 +7,7 @@ namespace XeryonEtherCAT.Core.Models;
 /// </summary>
 public readonly struct SoemHealthSnapshot
 {
-    public SoemHealthSnapshot(int slavesFound, int groupExpectedWkc, int lastWkc, int bytesOut, int bytesIn, int slavesOperational, int alStatusCode)
+    public SoemHealthSnapshot(int slavesFound, int groupExpectedWkc, int lastWkc, int bytesOut, int bytesIn, int slavesOperational, int alStatusCode, SoemDcStatus distributedClock = default, SoemRedundancyStatus redundancy = default)
     {
         SlavesFound = slavesFound;
         GroupExpectedWkc = groupExpectedWkc;
@@ -16,6 +16,8 @@ public readonly struct SoemHealthSnapshot
         BytesIn = bytesIn;
         SlavesOperational = slavesOperational;
         AlStatusCode = alStatusCode;
+        DistributedClock = distributedClock;
+        Redundancy = redundancy;
     }
 
     public int SlavesFound { get; }
@@ -31,4 +33,14 @@ public readonly struct SoemHealthSnapshot
     public int SlavesOperational { get; }
 
     public int AlStatusCode { get; }
+
+    /// <summary>
+    /// SYNC0 phase and drift statistics; inactive when distributed clocks are not in use.
+    /// </summary>
+    public SoemDcStatus DistributedClock { get; }
+
+    /// <summary>
+    /// Ring path and per-side reach; disabled unless a secondary interface was configured.
+    /// </summary>
+    public SoemRedundancyStatus Redundancy { get; }
 }
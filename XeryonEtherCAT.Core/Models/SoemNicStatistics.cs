@@ -0,0 +1,68 @@
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// How the cyclic process-data frames reach the NIC.
+/// </summary>
+public enum NicBackend
+{
+    /// <summary>SOEM's own driver: a raw packet socket on Linux, pcap on Windows, one send/receive per frame.</summary>
+    Socket = 0,
+
+    /// <summary>
+    /// Memory-mapped AF_PACKET TX/RX rings (Linux only): a cycle's frames are queued in the TX ring and sent with one
+    /// system call, replies are read in place. Mailbox, state and recovery traffic stays on SOEM's socket.
+    /// </summary>
+    MappedRing = 1,
+}
+
+/// <summary>
+/// Cyclic frame transport counters from the shim (<c>soem_get_nic_stats</c>) since the bus was opened. The counters
+/// stay zero on <see cref="NicBackend.Socket"/>.
+/// </summary>
+public readonly struct SoemNicStatistics
+{
+    public SoemNicStatistics(NicBackend backend, int ringFrames, long txFrames, long rxFrames, long rxDropped, long txBusy, long sends)
+    {
+        Backend = backend;
+        RingFrames = ringFrames;
+        TxFrames = txFrames;
+        RxFrames = rxFrames;
+        RxDropped = rxDropped;
+        TxBusy = txBusy;
+        Sends = sends;
+    }
+
+    internal static SoemNicStatistics FromNative(in SoemShim.SoemNicStats stats)
+        => new((NicBackend)stats.backend, stats.ring_frames, (long)stats.tx_frames, (long)stats.rx_frames, (long)stats.rx_dropped, (long)stats.tx_busy, (long)stats.kicks);
+
+    /// <summary>
+    /// The transport actually in use: <see cref="NicBackend.Socket"/> when a requested ring could not be opened.
+    /// </summary>
+    public NicBackend Backend { get; }
+
+    /// <summary>
+    /// Slots in each of the RX and TX rings.
+    /// </summary>
+    public int RingFrames { get; }
+
+    public long TxFrames { get; }
+
+    public long RxFrames { get; }
+
+    /// <summary>
+    /// Frames that came back after their cycle had been given up on.
+    /// </summary>
+    public long RxDropped { get; }
+
+    /// <summary>
+    /// Cycles not sent because the kernel still held the next TX slot.
+    /// </summary>
+    public long TxBusy { get; }
+
+    /// <summary>
+    /// Send system calls, one per cycle.
+    /// </summary>
+    public long Sends { get; }
+}
@@ -0,0 +1,113 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Where a cycle's frames travelled on a ring opened with a secondary interface.
+/// </summary>
+public enum RingPath
+{
+    /// <summary>No cable redundancy, or no cycle yet.</summary>
+    None = 0,
+
+    /// <summary>Ring closed: each port's frame came back on the other port.</summary>
+    Ring = 1,
+
+    /// <summary>Line from the primary port; the secondary side is open.</summary>
+    PrimaryOnly = 2,
+
+    /// <summary>Line from the secondary port; the primary link is down.</summary>
+    SecondaryOnly = 3,
+
+    /// <summary>Ring broken between two slaves; each port reached its half and the shim merged the results.</summary>
+    Split = 4,
+
+    /// <summary>A frame came back on neither port.</summary>
+    Lost = 5,
+}
+
+/// <summary>
+/// Cable redundancy status from the shim (<c>soem_get_redundancy</c>). Default (disabled) unless the service was
+/// configured with a <c>SecondaryInterface</c>. The per-side slave counts come from a DL status probe the shim runs
+/// after every path change, so they trail <see cref="Path"/> by a cycle or two.
+/// </summary>
+public readonly struct SoemRedundancyStatus
+{
+    private readonly ulong _framePaths; // 4 bits per frame, frame 0 in the low nibble
+
+    public SoemRedundancyStatus(bool enabled, RingPath path, int primarySlaves, int secondarySlaves, int breakAfterSlave, int frames, ulong framePaths, long degradedCycles, long topologyChanges)
+    {
+        Enabled = enabled;
+        Path = path;
+        PrimarySlaves = primarySlaves;
+        SecondarySlaves = secondarySlaves;
+        BreakAfterSlave = breakAfterSlave;
+        Frames = frames;
+        _framePaths = framePaths;
+        DegradedCycles = degradedCycles;
+        TopologyChanges = topologyChanges;
+    }
+
+    internal static SoemRedundancyStatus FromNative(in SoemShim.SoemRedundancy red)
+    {
+        var frames = Math.Min(red.frames, 16);
+        ulong packed = 0;
+        for (var i = 0; i < frames; i++)
+        {
+            packed |= (ulong)(red.frame_path[i] & 0xF) << (4 * i);
+        }
+
+        return new(red.enabled != 0, (RingPath)red.path, red.primary_slaves, red.secondary_slaves, red.break_after, frames, packed, (long)red.degraded_cycles, (long)red.topology_changes);
+    }
+
+    public bool Enabled { get; }
+
+    /// <summary>
+    /// Path of the last cycle: its most degraded frame.
+    /// </summary>
+    public RingPath Path { get; }
+
+    /// <summary>
+    /// Slaves the primary port reaches.
+    /// </summary>
+    public int PrimarySlaves { get; }
+
+    /// <summary>
+    /// Slaves the secondary port reaches.
+    /// </summary>
+    public int SecondarySlaves { get; }
+
+    /// <summary>
+    /// On a <see cref="RingPath.Split"/> ring, the slave whose outgoing link is down; 0 when none was found.
+    /// </summary>
+    public int BreakAfterSlave { get; }
+
+    /// <summary>
+    /// Frames in the last cycle.
+    /// </summary>
+    public int Frames { get; }
+
+    /// <summary>
+    /// Cycles that did not travel a closed ring. None of them was lost to the break.
+    /// </summary>
+    public long DegradedCycles { get; }
+
+    public long TopologyChanges { get; }
+
+    /// <summary>
+    /// Path of one frame of the last cycle, i.e. which port it came back on.
+    /// </summary>
+    public RingPath GetFramePath(int frame)
+        => (uint)frame < (uint)Frames ? (RingPath)((_framePaths >> (4 * frame)) & 0xF) : RingPath.None;
+
+    public override string ToString() => Path switch
+    {
+        RingPath.Ring => $"ring closed ({PrimarySlaves} slaves)",
+        RingPath.Split => $"ring open after slave {BreakAfterSlave}: {PrimarySlaves} via primary, {SecondarySlaves} via secondary",
+        RingPath.PrimaryOnly => $"secondary side open: {PrimarySlaves} via primary",
+        RingPath.SecondaryOnly => $"primary link down: {SecondarySlaves} via secondary",
+        RingPath.Lost => "no frame returned",
+        _ => "no redundancy"
+    };
+}
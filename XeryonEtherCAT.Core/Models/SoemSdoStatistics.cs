@@ -0,0 +1,58 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Counters of the shim's SDO engine (<c>soem_sdo_get_stats</c>) since the bus was opened. Default when the
+/// service runs without <c>SdoWorkers</c>.
+/// </summary>
+public readonly struct SoemSdoStatistics
+{
+    public SoemSdoStatistics(int workers, int inFlight, long submitted, long completed, long failed, long servicePasses, TimeSpan maxServiceTime, TimeSpan maxLatency)
+    {
+        Workers = workers;
+        InFlight = inFlight;
+        Submitted = submitted;
+        Completed = completed;
+        Failed = failed;
+        ServicePasses = servicePasses;
+        MaxServiceTime = maxServiceTime;
+        MaxLatency = maxLatency;
+    }
+
+    internal static SoemSdoStatistics FromNative(in SoemShim.SoemSdoStats stats)
+        => new(stats.workers, stats.in_flight, (long)stats.submitted, (long)stats.completed, (long)stats.failed, (long)stats.service_calls,
+            TimeSpan.FromTicks(stats.max_service_ns / 100), TimeSpan.FromTicks(stats.max_latency_ns / 100));
+
+    public int Workers { get; }
+
+    /// <summary>
+    /// Transfers queued or waiting for their reply.
+    /// </summary>
+    public int InFlight { get; }
+
+    public long Submitted { get; }
+
+    /// <summary>
+    /// Finished transfers, <see cref="Failed"/> included.
+    /// </summary>
+    public long Completed { get; }
+
+    public long Failed { get; }
+
+    /// <summary>
+    /// Mailbox handler passes after a cycle that had a transfer open.
+    /// </summary>
+    public long ServicePasses { get; }
+
+    /// <summary>
+    /// Longest of those passes: the most of a cycle's slack SDO traffic has taken.
+    /// </summary>
+    public TimeSpan MaxServiceTime { get; }
+
+    /// <summary>
+    /// Longest time from submitting a transfer to its result.
+    /// </summary>
+    public TimeSpan MaxLatency { get; }
+}
@@ -0,0 +1,69 @@
+using System;
+using XeryonEtherCAT.Core.Internal.Soem;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// AL state of one slave from the shim's state cache. The cache is refreshed by <c>ecx_readstate</c> only when the
+/// WKC drops or the <c>StateCheckInterval</c> elapses; a full WKC after a degraded cycle marks every slave OP.
+/// While per-slave recovery runs, <see cref="IsRecovering"/> and <see cref="IsLost"/> track its progress.
+/// </summary>
+public readonly struct SoemSlaveState
+{
+    private const ushort StateMask = 0x0F;
+    private const ushort ErrorBit = 0x10;
+    private const ushort Operational = 0x08;
+
+    public SoemSlaveState(int slave, ushort state, ushort alStatusCode, bool isLost = false, bool isRecovering = false)
+    {
+        Slave = slave;
+        State = state;
+        AlStatusCode = alStatusCode;
+        IsLost = isLost;
+        IsRecovering = isRecovering;
+    }
+
+    internal static SoemSlaveState FromNative(int slave, in SoemShim.SoemSlaveState state)
+        => new(slave, state.state, state.al_status_code,
+            (state.flags & SoemShim.SOEM_SLAVE_LOST) != 0, (state.flags & SoemShim.SOEM_SLAVE_RECOVERING) != 0);
+
+    /// <summary>
+    /// 1-based slave position.
+    /// </summary>
+    public int Slave { get; }
+
+    /// <summary>
+    /// Raw EtherCAT AL state: INIT 0x01, PRE-OP 0x02, BOOT 0x03, SAFE-OP 0x04, OP 0x08, with 0x10 set on an AL error.
+    /// </summary>
+    public ushort State { get; }
+
+    /// <summary>
+    /// AL status code the slave reported with its last error, 0 when none.
+    /// </summary>
+    public ushort AlStatusCode { get; }
+
+    public bool IsOperational => State == Operational;
+
+    public bool HasError => (State & ErrorBit) != 0;
+
+    /// <summary>
+    /// The slave stopped answering. Its process data is stale and the service leaves its axis alone until
+    /// recovery finds it again.
+    /// </summary>
+    public bool IsLost { get; }
+
+    /// <summary>
+    /// The slave is out of OP and queued for per-slave recovery.
+    /// </summary>
+    public bool IsRecovering { get; }
+
+    public override string ToString() => IsLost ? "LOST" : (State & StateMask) switch
+    {
+        0x01 => "INIT",
+        0x02 => "PRE-OP",
+        0x03 => "BOOT",
+        0x04 => "SAFE-OP",
+        0x08 => "OP",
+        _ => $"0x{State & StateMask:X2}"
+    } + (HasError ? $" + ERROR (AL 0x{AlStatusCode:X4})" : string.Empty);
+}
@@ -0,0 +1,52 @@
+using System;
+
+namespace XeryonEtherCAT.Core.Models;
+
+/// <summary>
+/// Bus-level part of a status snapshot, returned by the copy-into <c>GetStatus</c> overload.
+/// </summary>
+public readonly struct SoemStatusHeader
+{
+    public SoemStatusHeader(long sequence, DateTimeOffset timestamp, SoemHealthSnapshot health, int driveCount, TimeSpan cycleTime, TimeSpan minCycle, TimeSpan maxCycle, TimeSpan roundTrip = default, TimeSpan hostTime = default)
+    {
+        Sequence = sequence;
+        Timestamp = timestamp;
+        Health = health;
+        DriveCount = driveCount;
+        CycleTime = cycleTime;
+        MinCycleTime = minCycle;
+        MaxCycleTime = maxCycle;
+        RoundTripTime = roundTrip;
+        HostTime = hostTime;
+    }
+
+    /// <summary>
+    /// Publication counter (1 for the first cycle); 0 until the IO loop has completed a cycle.
+    /// </summary>
+    public long Sequence { get; }
+
+    public DateTimeOffset Timestamp { get; }
+
+    public SoemHealthSnapshot Health { get; }
+
+    /// <summary>
+    /// Drives in the snapshot. May exceed the number copied when the destination span was shorter.
+    /// </summary>
+    public int DriveCount { get; }
+
+    public TimeSpan CycleTime { get; }
+
+    public TimeSpan MinCycleTime { get; }
+
+    public TimeSpan MaxCycleTime { get; }
+
+    /// <summary>
+    /// Send-to-receive time of the bus frames behind this snapshot.
+    /// </summary>
+    public TimeSpan RoundTripTime { get; }
+
+    /// <summary>
+    /// Part of <see cref="CycleTime"/> the IO loop spent on its own work rather than blocked on the bus.
+    /// </summary>
+    public TimeSpan HostTime { get; }
+}
@@ -1,5 +1,4 @@
 using System;
-using XeryonEtherCAT.Core.Internal.Soem;
 
 namespace XeryonEtherCAT.Core.Models;
 
@@ -8,11 +7,16 @@ namespace XeryonEtherCAT.Core.Models;
 /// </summary>
 public sealed class SoemStatusSnapshot
 {
-    public SoemStatusSnapshot(DateTimeOffset timestamp, SoemHealthSnapshot health, SoemShim.DriveTxPDO[] drives, TimeSpan cycleTime, TimeSpan minCycle, TimeSpan maxCycle)
+    public SoemStatusSnapshot(DateTimeOffset timestamp, SoemHealthSnapshot health, DriveStatusWord[] drives, TimeSpan cycleTime, TimeSpan minCycle, TimeSpan maxCycle)
+        : this(timestamp, health, drives, cycleTime, minCycle, maxCycle, TimeSpan.Zero, TimeSpan.Zero)
+    {
+    }
+
+    public SoemStatusSnapshot(DateTimeOffset timestamp, SoemHealthSnapshot health, DriveStatusWord[] drives, TimeSpan cycleTime, TimeSpan minCycle, TimeSpan maxCycle, TimeSpan roundTrip, TimeSpan hostTime)
     {
         Timestamp = timestamp;
         Health = health;
-        DriveStates = drives ?? Array.Empty<SoemShim.DriveTxPDO>();
+        DriveStates = drives ?? Array.Empty<DriveStatusWord>();
         ActualPositions = new int[DriveStates.Length];
         for (var i = 0; i < DriveStates.Length; i++)
         {
@@ -22,13 +26,15 @@ public sealed class SoemStatusSnapshot
         CycleTime = cycleTime;
         MinCycleTime = minCycle;
         MaxCycleTime = maxCycle;
+        RoundTripTime = roundTrip;
+        HostTime = hostTime;
     }
 
     public DateTimeOffset Timestamp { get; }
 
     public SoemHealthSnapshot Health { get; }
 
-    public SoemShim.DriveTxPDO[] DriveStates { get; }
+    public DriveStatusWord[] DriveStates { get; }
 
     public int[] ActualPositions { get; }
 
@@ -37,4 +43,14 @@ public sealed class SoemStatusSnapshot
     public TimeSpan MinCycleTime { get; }
 
     public TimeSpan MaxCycleTime { get; }
+
+    /// <summary>
+    /// Send-to-receive time of the bus frames behind this snapshot.
+    /// </summary>
+    public TimeSpan RoundTripTime { get; }
+
+    /// <summary>
+    /// Part of <see cref="CycleTime"/> the IO loop spent on its own work rather than blocked on the bus.
+    /// </summary>
+    public TimeSpan HostTime { get; }
 }
@@ -0,0 +1,26 @@
+using System;
+
+namespace XeryonEtherCAT.Core.Options;
+
+/// <summary>
+/// One bus of an <see cref="Services.EthercatBusHost"/>: its NIC and the options of the service that drives it.
+/// Slave numbers are per bus, starting at 1 on each.
+/// </summary>
+public sealed class EthercatBusOptions
+{
+    /// <summary>
+    /// Looks the bus up in the host and names its logger and IO thread.
+    /// </summary>
+    public string Name { get; set; } = string.Empty;
+
+    /// <summary>
+    /// Network interface passed to the SOEM shim.
+    /// </summary>
+    public string Interface { get; set; } = string.Empty;
+
+    /// <summary>
+    /// Options of this bus's drive service. Give every bus its own <see cref="EthercatDriveOptions.DedicatedIoThread"/>
+    /// and a distinct <see cref="EthercatDriveOptions.IoThreadCpu"/> so one bus's work never delays another's cycle.
+    /// </summary>
+    public EthercatDriveOptions Drive { get; set; } = new();
+}
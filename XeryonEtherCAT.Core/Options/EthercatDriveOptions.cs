@@ -1,4 +1,5 @@
 using System;
+using XeryonEtherCAT.Core.Models;
 
 namespace XeryonEtherCAT.Core.Options;
 
@@ -23,7 +24,8 @@ public sealed class EthercatDriveOptions
     public int WkcRecoveryThreshold { get; set; } = 3;
 
     /// <summary>
-    /// Timeout passed to <c>soem_try_recover</c> in milliseconds.
+    /// How long per-slave recovery may run without a single slave in OP before the session is reinitialized,
+    /// in milliseconds. Recovery that keeps at least one slave in OP runs until the lost slaves return.
     /// </summary>
     public int RecoveryTimeoutMilliseconds { get; set; } = 5000;
 
@@ -46,4 +48,184 @@ public sealed class EthercatDriveOptions
     /// Enables verbose per-cycle tracing.
     /// </summary>
     public bool EnableCycleTraceLogging { get; set; } = false;
+
+    /// <summary>
+    /// Runs the bus cycle on the shim's native real-time thread instead of the managed IO loop.
+    /// The managed loop then only feeds commands and consumes status samples at <see cref="CyclePeriod"/>.
+    /// Falls back to the managed loop when the native build does not provide the engine (Windows).
+    /// </summary>
+    public bool UseNativeCycleEngine { get; set; } = false;
+
+    /// <summary>
+    /// Splits each managed cycle at the wire (<c>soem_send_cycle</c>/<c>soem_receive_cycle</c>): the previous
+    /// cycle's statuses are evaluated, events raised and the next outputs staged while the frames are in flight.
+    /// Status handling then trails the bus by one cycle. Needs the mapped process image; ignored otherwise and
+    /// while the native engine runs.
+    /// </summary>
+    public bool OverlapCycleProcessing { get; set; } = false;
+
+    /// <summary>
+    /// Runs the managed IO loop on its own thread instead of the thread pool. The thread sleeps to within
+    /// a millisecond of each deadline and spins the rest, so cycles do not inherit the pool's timer granularity
+    /// or wait behind other work; several buses in one process each get one.
+    /// </summary>
+    public bool DedicatedIoThread { get; set; } = false;
+
+    /// <summary>
+    /// CPU the dedicated IO thread is pinned to (<c>soem_pin_thread</c>). -1 disables pinning. Ignored without
+    /// <see cref="DedicatedIoThread"/>.
+    /// </summary>
+    public int IoThreadCpu { get; set; } = -1;
+
+    /// <summary>
+    /// Length of a cycle statistics window: the IO loop takes the shim's latency histograms with
+    /// <c>soem_get_cycle_stats</c> (snapshot-and-reset) this often. Zero stops collecting windows.
+    /// </summary>
+    public TimeSpan CycleStatisticsWindow { get; set; } = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// How often the shim re-reads every slave's AL state while the WKC is full. A WKC drop triggers a read on
+    /// the next cycle regardless; in between, a full WKC stands for "every slave in OP" and health costs no bus
+    /// traffic. Zero uses the shim default (1 s).
+    /// </summary>
+    public TimeSpan StateCheckInterval { get; set; } = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// Bus cycle period of the native engine.
+    /// </summary>
+    public TimeSpan NativeCyclePeriod { get; set; } = TimeSpan.FromMilliseconds(1);
+
+    /// <summary>
+    /// SCHED_FIFO priority of the native engine thread (1..99). 0 keeps the default scheduler.
+    /// </summary>
+    public int NativeCyclePriority { get; set; } = 80;
+
+    /// <summary>
+    /// CPU the native engine thread is pinned to. -1 disables pinning.
+    /// </summary>
+    public int NativeCycleCpu { get; set; } = -1;
+
+    /// <summary>
+    /// Locks the process address space (<c>mlockall</c>) before the native engine starts.
+    /// </summary>
+    public bool NativeCycleLockMemory { get; set; } = true;
+
+    /// <summary>
+    /// Capacity of the native command and sample rings. Must cover <see cref="CyclePeriod"/> / <see cref="NativeCyclePeriod"/> samples.
+    /// </summary>
+    public int NativeRingCapacity { get; set; } = 256;
+
+    /// <summary>
+    /// Locks the process image (IOmap) in RAM so a cycle never page-faults on it.
+    /// </summary>
+    public bool LockProcessImage { get; set; } = true;
+
+    /// <summary>
+    /// Backs the process image with a huge/large page when the OS allows it (Linux hugetlbfs pages,
+    /// Windows large pages with SeLockMemoryPrivilege). Falls back to regular pages otherwise.
+    /// </summary>
+    public bool UseHugePagesForProcessImage { get; set; } = false;
+
+    /// <summary>
+    /// Process-data group of each slave, slave 1 first; slaves past the end stay in group 0. Each group is mapped
+    /// separately and exchanged at its own rate (<see cref="GroupCycleDividers"/>), so slow axes stop riding in
+    /// every fast frame. Null keeps every slave in group 0.
+    /// </summary>
+    public int[]? SlaveGroups { get; set; }
+
+    /// <summary>
+    /// Group g is exchanged every <c>GroupCycleDividers[g]</c>-th cycle, e.g. <c>[1, 10]</c> with a 1 ms cycle runs
+    /// group 1 at 10 ms. Missing entries (and values below 1) mean every cycle. At most four groups, and no more
+    /// than the SOEM build's <c>EC_MAXGROUP</c> (2 by default).
+    /// </summary>
+    public int[]? GroupCycleDividers { get; set; }
+
+    /// <summary>
+    /// Second NIC the far end of the ring is wired back to. When set the bus is opened with cable redundancy
+    /// (<c>ecx_init_redundant</c>): a single cable break becomes a logged topology change instead of a recovery.
+    /// </summary>
+    public string? SecondaryInterface { get; set; }
+
+    /// <summary>
+    /// Threads the shim gives to SDO transfers (<c>ReadSdoAsync</c>/<c>WriteSdoAsync</c>), i.e. how many slaves can
+    /// have one open at once. Above zero every CoE slave's mailbox is run by SOEM's cyclic mailbox handler, which
+    /// the IO loop steps after each cycle. Zero (the default) leaves SDO access off and the mapping as before.
+    /// </summary>
+    public int SdoWorkers { get; set; } = 0;
+
+    /// <summary>
+    /// Mailboxes the handler may move after one cycle (each a short bus round trip; a transfer takes two). Bounds
+    /// how much of the slack SDO traffic can use. Zero uses the shim default (2).
+    /// </summary>
+    public int SdoMailboxesPerCycle { get; set; } = 0;
+
+    /// <summary>
+    /// Transport of the cyclic frames. <see cref="NicBackend.MappedRing"/> needs the Linux shim, CAP_NET_RAW and a
+    /// bus without <see cref="SecondaryInterface"/> or <see cref="SdoWorkers"/>; otherwise the bus cycles over
+    /// SOEM's socket and a warning is logged.
+    /// </summary>
+    public NicBackend NicBackend { get; set; } = NicBackend.Socket;
+
+    /// <summary>
+    /// Slots in each RX and TX ring of <see cref="NicBackend.MappedRing"/>. Zero uses the shim default (256).
+    /// </summary>
+    public int NicRingFrames { get; set; } = 0;
+
+    /// <summary>
+    /// Size of the wire capture ring: every cyclic frame sent and received is copied, time stamped, into a
+    /// memory-mapped file of this many bytes, which always holds the last stretch of traffic for
+    /// <c>ExportCapture</c>. Zero (the default) leaves capture off. Linux shim only; Windows logs a warning.
+    /// </summary>
+    public int CaptureBytes { get; set; } = 0;
+
+    /// <summary>
+    /// Newest part of the capture ring that an export keeps. Zero keeps everything the ring holds.
+    /// </summary>
+    public TimeSpan CaptureWindow { get; set; } = TimeSpan.Zero;
+
+    /// <summary>
+    /// Writes <see cref="CaptureWindow"/> to a pcapng file in <see cref="CaptureDirectory"/> from a background thread
+    /// shortly after the working counter drops, at most once per window (or second).
+    /// </summary>
+    public bool CaptureOnFault { get; set; } = false;
+
+    /// <summary>
+    /// Directory of the capture ring file and the fault exports. Null uses /dev/shm. The ring of a process that died
+    /// is kept there as <c>soemshim-bus&lt;n&gt;.cap.prev</c>.
+    /// </summary>
+    public string? CaptureDirectory { get; set; }
+
+    /// <summary>
+    /// File holding the bus configuration (slave list, SM/FMMU settings, process image layout) from the last
+    /// discovery. When the slave count, every slave's vendor/product/revision and the open ports still match, the
+    /// bus is configured from it instead of being discovered and mapped again; otherwise it is discovered and the
+    /// file rewritten. Delete it to force a rediscovery. Null always discovers.
+    /// </summary>
+    public string? StoredConfigurationPath { get; set; }
+
+    /// <summary>
+    /// File holding every slave's SII (EEPROM) image, keyed by vendor, product, revision and serial number. A
+    /// discovery then reads only each slave's identity and one check word from its EEPROM and takes the rest from
+    /// the file; new slaves, and slaves whose check word no longer matches, are read in full and added. Speeds up
+    /// the discoveries <see cref="StoredConfigurationPath"/> cannot skip. Null reads every SII from the bus.
+    /// </summary>
+    public string? SiiCachePath { get; set; }
+
+    /// <summary>
+    /// Starts SYNC0 with this period on every slave with distributed clocks. Zero leaves DC unsynchronized.
+    /// Set it to the bus period (<see cref="NativeCyclePeriod"/> with the native engine, which then steers its
+    /// wake-ups to hold <see cref="DistributedClockLead"/>; otherwise <see cref="CyclePeriod"/>, statistics only).
+    /// </summary>
+    public TimeSpan DistributedClockCycle { get; set; } = TimeSpan.Zero;
+
+    /// <summary>
+    /// SYNC0 shift from the distributed clock period boundary.
+    /// </summary>
+    public TimeSpan DistributedClockShift { get; set; } = TimeSpan.Zero;
+
+    /// <summary>
+    /// How long before SYNC0 the cycle's frames should pass the reference clock. Zero means a quarter of
+    /// <see cref="DistributedClockCycle"/>.
+    /// </summary>
+    public TimeSpan DistributedClockLead { get; set; } = TimeSpan.Zero;
 }
@@ -0,0 +1,144 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.Extensions.Logging;
+using Microsoft.Extensions.Logging.Abstractions;
+using XeryonEtherCAT.Core.Abstractions;
+using XeryonEtherCAT.Core.Internal.Soem;
+using XeryonEtherCAT.Core.Models;
+using XeryonEtherCAT.Core.Options;
+
+namespace XeryonEtherCAT.Core.Services;
+
+/// <summary>
+/// Several independent EtherCAT buses in one process. Every bus has its own <see cref="EthercatDriveService"/>,
+/// shim handle, options, slave numbering and logger; the shim keeps no state across handles except the log ring,
+/// whose records are routed back to the logger of the bus that wrote them.
+/// </summary>
+public sealed class EthercatBusHost : IAsyncDisposable
+{
+    private readonly EthercatBusOptions[] _buses;
+    private readonly EthercatDriveService[] _services;
+    private readonly string[] _names;
+
+    /// <param name="buses">One entry per bus; names and interfaces must be distinct, and so must pinned CPUs.</param>
+    /// <param name="loggerFactory">Creates one logger per bus, named after the service and the bus.</param>
+    /// <param name="clientFactory">Shim client per bus; a <see cref="SoemClient"/> when null.</param>
+    public EthercatBusHost(IEnumerable<EthercatBusOptions> buses, ILoggerFactory? loggerFactory = null, Func<EthercatBusOptions, ISoemClient>? clientFactory = null)
+    {
+        _buses = (buses ?? throw new ArgumentNullException(nameof(buses))).ToArray();
+        if (_buses.Length == 0)
+        {
+            throw new ArgumentException("At least one bus is required.", nameof(buses));
+        }
+
+        Validate(_buses);
+
+        _names = new string[_buses.Length];
+        _services = new EthercatDriveService[_buses.Length];
+        for (var i = 0; i < _buses.Length; i++)
+        {
+            var bus = _buses[i];
+            var logger = loggerFactory?.CreateLogger($"{typeof(EthercatDriveService).FullName}.{bus.Name}") ?? NullLogger.Instance;
+            _names[i] = bus.Name;
+            _services[i] = new EthercatDriveService(bus.Drive, logger, clientFactory?.Invoke(bus) ?? new SoemClient(logger));
+        }
+    }
+
+    private static void Validate(EthercatBusOptions[] buses)
+    {
+        var names = new HashSet<string>(StringComparer.Ordinal);
+        var interfaces = new HashSet<string>(StringComparer.Ordinal);
+        var cpus = new HashSet<int>();
+        foreach (var bus in buses)
+        {
+            if (bus is null || string.IsNullOrEmpty(bus.Name) || string.IsNullOrEmpty(bus.Interface) || bus.Drive is null)
+            {
+                throw new ArgumentException("Every bus needs a name, an interface and drive options.", nameof(buses));
+            }
+
+            if (!names.Add(bus.Name))
+            {
+                throw new ArgumentException($"Bus name '{bus.Name}' is used twice.", nameof(buses));
+            }
+
+            if (!interfaces.Add(bus.Interface))
+            {
+                throw new ArgumentException($"Interface '{bus.Interface}' is given to more than one bus.", nameof(buses));
+            }
+
+            if (bus.Drive.DedicatedIoThread && bus.Drive.IoThreadCpu >= 0 && !cpus.Add(bus.Drive.IoThreadCpu))
+            {
+                throw new ArgumentException($"CPU {bus.Drive.IoThreadCpu} is pinned by more than one bus.", nameof(buses));
+            }
+        }
+    }
+
+    public int Count => _services.Length;
+
+    public IReadOnlyList<string> Names => _names;
+
+    public IEthercatDriveService this[int index] => _services[index];
+
+    public IEthercatDriveService this[string name] => _services[IndexOf(name)];
+
+    private int IndexOf(string name)
+    {
+        var index = Array.IndexOf(_names, name);
+        return index >= 0 ? index : throw new KeyNotFoundException($"No bus named '{name}'.");
+    }
+
+    /// <summary>
+    /// Brings every bus up at once; SOEM's discovery and state changes are per handle, so the buses do not wait on
+    /// each other. When one fails the others stay up until the host is disposed, and the first failure is thrown.
+    /// </summary>
+    public async Task InitializeAsync(CancellationToken ct)
+    {
+        var starts = new Task[_services.Length];
+        for (var i = 0; i < _services.Length; i++)
+        {
+            var service = _services[i];
+            var bus = _buses[i];
+            starts[i] = Task.Run(async () =>
+            {
+                try
+                {
+                    await service.InitializeAsync(bus.Interface, ct).ConfigureAwait(false);
+                }
+                catch (Exception ex) when (ex is not OperationCanceledException)
+                {
+                    throw new InvalidOperationException($"Bus '{bus.Name}' on {bus.Interface} failed to initialize: {ex.Message}", ex);
+                }
+            }, CancellationToken.None);
+        }
+
+        await Task.WhenAll(starts).ConfigureAwait(false);
+    }
+
+    /// <summary>
+    /// Latest status of every bus and the totals across them.
+    /// </summary>
+    public SoemBusHostSnapshot GetStatus()
+    {
+        var snapshots = new SoemStatusSnapshot[_services.Length];
+        for (var i = 0; i < _services.Length; i++)
+        {
+            snapshots[i] = _services[i].GetStatus();
+        }
+
+        return new SoemBusHostSnapshot(DateTimeOffset.UtcNow, _names, snapshots);
+    }
+
+    public async ValueTask DisposeAsync()
+    {
+        var stops = new Task[_services.Length];
+        for (var i = 0; i < _services.Length; i++)
+        {
+            stops[i] = _services[i].DisposeAsync().AsTask();
+        }
+
+        await Task.WhenAll(stops).ConfigureAwait(false);
+    }
+}
@@ -1,7 +1,7 @@
 using System;
-using System.Buffers;
+using System.Collections.Generic;
 using System.Diagnostics;
-using System.Text;
+using System.Runtime.InteropServices;
 using System.Threading;
 using System.Threading.Channels;
 using System.Threading.Tasks;
@@ -26,7 +26,7 @@ public sealed class EthercatDriveService : IEthercatDriveService
     private readonly ISoemClient _soem;
     private readonly Channel<PendingCommand> _commandChannel;
     private readonly object _lifecycleGate = new();
-    private readonly StringBuilder _errorBuffer = new(4096);
+    private readonly SoemShim.SoemErrorRecord[] _errorRecords = new SoemShim.SoemErrorRecord[32];
     private DriveErrorCode[] _lastFaults = Array.Empty<DriveErrorCode>();
     private DateTimeOffset[] _lastFaultTimes = Array.Empty<DateTimeOffset>();
     private readonly TimeSpan _faultRepeatInterval = TimeSpan.FromSeconds(5);
@@ -44,14 +44,73 @@ public sealed class EthercatDriveService : IEthercatDriveService
     private bool _initialized;
 
     private SoemShim.DriveRxPDO[] _rxPdos = Array.Empty<SoemShim.DriveRxPDO>();
-    private SoemShim.DriveTxPDO[] _txPdos = Array.Empty<SoemShim.DriveTxPDO>();
-    private SoemShim.DriveTxPDO[] _previousTxPdos = Array.Empty<SoemShim.DriveTxPDO>();
+    private DriveStatusWord[] _txPdos = Array.Empty<DriveStatusWord>();
+    private DriveStatusWord[] _previousTxPdos = Array.Empty<DriveStatusWord>();
+    private DriveStatusWord[] _cycleTx = Array.Empty<DriveStatusWord>(); // statuses of the cycle being processed
+    private uint[] _changedAxes = Array.Empty<uint>(); // bit i: _cycleTx[i] differs from the last processed status
     private PendingCommand?[] _activeCommands = Array.Empty<PendingCommand?>();
     private SemaphoreSlim[] _axisLocks = Array.Empty<SemaphoreSlim>();
     private bool[] _stopLatch = Array.Empty<bool>();
-    private SoemStatusSnapshot _snapshot = new(DateTimeOffset.UtcNow, new SoemHealthSnapshot(0, 0, 0, 0, 0, 0, 0), Array.Empty<SoemShim.DriveTxPDO>(), TimeSpan.Zero, TimeSpan.Zero, TimeSpan.Zero);
+    private readonly StatusSnapshotStore _status = new(); // seqlock double buffer, written once per cycle without allocating
     private int _wkcStrikes;
+    private int _fatalErrorCount;
     private long _telemetrySequence;
+    private bool _errorPending = true; // drain once after startup, then only when the shim flags new errors
+    private bool _stateCheckDue;       // a cycle asked for an AL state read (WKC drop or StateCheckInterval)
+    private SoemShim.SoemSlaveState[] _slaveStates = Array.Empty<SoemShim.SoemSlaveState>();
+    private SoemSlaveState[] _publishedStates = Array.Empty<SoemSlaveState>();
+    private ulong _publishedStateReads = ulong.MaxValue;
+    private int _publishedStatesOp = -1;
+    private int _publishedStatesLost = -1;
+    private bool _publishedRecovering;
+    private bool[] _slaveLost = Array.Empty<bool>(); // axis skipped by ProcessStatuses until recovery finds it again
+    private bool _recovering;     // per-slave recovery armed; healthy axes keep cycling meanwhile
+    private long _recoveryStarted;
+    private SoemHealthSnapshot _healthBaseline;
+    private bool _dcActive; // SYNC0 running: every cycle's health carries the shim's DC statistics
+    private bool _redundant; // opened with SecondaryInterface: every cycle's health carries the ring status
+    private int _ringPath;   // SOEM_RED_PATH_* of the last cycle, 0 before the first
+    private readonly object _groupGate = new();
+    private readonly SoemShim.SoemGroupStatus[] _groupScratch = new SoemShim.SoemGroupStatus[SoemShim.SOEM_MAX_GROUPS];
+    private readonly SoemGroupStatus[] _groupStatus = new SoemGroupStatus[SoemShim.SOEM_MAX_GROUPS]; // guarded by _groupGate
+    private int _groupCount;      // guarded by _groupGate
+    private uint _groupsDegraded; // bit g: group g's last exchange came back with a low WKC
+    private readonly object _bootGate = new();
+    private SoemBootReport _coldStart;      // guarded by _bootGate
+    private SoemBootReport? _lastRecovery;  // guarded by _bootGate
+    private readonly object _cycleStatsGate = new();
+    private SoemCycleStatistics _cycleStatistics; // last closed CycleStatisticsWindow, guarded by _cycleStatsGate
+    private long _cycleStatsDue;
+    private ProcessImage? _image; // zero-copy IOmap view for the managed loop; null -> marshalled soem_cycle arrays
+
+    // SDO transfers (SdoWorkers): submitted from any thread, completed by the IO loop as the shim reports them.
+    private readonly object _sdoGate = new();
+    private readonly Dictionary<int, TaskCompletionSource<byte[]>> _sdoPending = new(); // by ticket, guarded by _sdoGate
+    private readonly SoemShim.SoemSdoCompletion[] _sdoCompletions = new SoemShim.SoemSdoCompletion[16];
+    private int _sdoOpen; // _sdoPending.Count, read by the IO loop without the lock
+
+    // Native cyclic engine state (UseNativeCycleEngine). The engine owns the bus; this loop feeds it.
+    private bool _nativeEngineActive;
+    private byte[] _sampleInputs = Array.Empty<byte>();
+
+    // Output dirty tracking: a slave's RxPDO is only rebuilt and written when its command or execute bit differs
+    // from what was last staged, or when _outputDirty forces it (new session, engine restart, ring full).
+    private PendingCommand?[] _stagedCommands = Array.Empty<PendingCommand?>();
+    private byte[] _stagedExecute = Array.Empty<byte>();
+    private bool[] _outputDirty = Array.Empty<bool>();
+    private bool _rxArrayDirty; // marshalled path: at least one entry of _rxPdos changed since the last soem_cycle
+
+    // Overlapped cycle (OverlapCycleProcessing): cycle N-1 is evaluated and N+1 staged while frame N is on the wire.
+    private bool _overlapStaged;   // the IOmap holds the outputs for the next send
+    private bool _framesInFlight;  // between SendCycle and ReceiveCycle: outputs wait in _rxPdos, not the IOmap
+    private bool[] _restage = Array.Empty<bool>(); // staged while in flight, written to the IOmap after the receive
+    private bool _overlapReceived; // _overlapWkc/_overlapResult describe a received cycle not evaluated yet
+    private int _overlapWkc;
+    private SoemShim.SoemCycleResult _overlapResult;
+    private TimeSpan _lastRoundTrip; // wire round trip of the cycle behind the current publication
+    private TimeSpan _lastBusWait;   // part of this iteration the loop spent blocked on the bus
+    private TimeSpan _minCycle;      // IO loop iteration extremes since the loop started
+    private TimeSpan _maxCycle;
 
     public EthercatDriveService(EthercatDriveOptions? options = null, ILogger? logger = null, ISoemClient? soemClient = null)
     {
@@ -87,7 +146,8 @@ public sealed class EthercatDriveService : IEthercatDriveService
             _interface = iface ?? throw new ArgumentNullException(nameof(iface));
         }
 
-        _handle = _soem.Initialize(iface);
+        var started = Stopwatch.GetTimestamp();
+        _handle = OpenBus(iface);
         if (_handle == IntPtr.Zero)
         {
             throw new InvalidOperationException("Unable to initialize soem_shim. Ensure the native library is accessible.");
@@ -102,8 +162,21 @@ public sealed class EthercatDriveService : IEthercatDriveService
         }
 
         AllocateBuffers(_slaveCount);
+        MapProcessImage();
+        _healthBaseline = ReadHealth();
+        InspectDistributedClock();
+        InspectNicBackend();
+        InspectCapture();
+        StartNativeEngine();
         _ioCts = CancellationTokenSource.CreateLinkedTokenSource(ct);
-        _ioTask = Task.Run(() => RunIoLoopAsync(_ioCts.Token), CancellationToken.None);
+        var ioToken = _ioCts.Token;
+        _ioTask = _options.DedicatedIoThread ? StartIoThread(ioToken) : Task.Run(() => RunIoLoopAsync(ioToken), CancellationToken.None);
+        var coldStart = InspectBoot(started);
+        lock (_bootGate)
+        {
+            _coldStart = coldStart;
+            _lastRecovery = null;
+        }
 
         lock (_lifecycleGate)
         {
@@ -123,8 +196,7 @@ public sealed class EthercatDriveService : IEthercatDriveService
     {
         EnsureInitialized();
         var axis = GetAxisIndex(slave);
-        var snapshot = GetStatus();
-        var status = snapshot.DriveStates.Length > axis ? snapshot.DriveStates[axis] : default;
+        var status = ReadDriveStatus(axis);
         EnsureAxisReadyForMotion(slave, status, requireEncoder: true);
         var timeout = settleTimeout > TimeSpan.Zero ? settleTimeout : _options.DefaultSettleTimeout;
         var command = PendingCommand.CreateMotion(axis, "DPOS", targetPos, vel, acc, dec, timeout, CommandCompletion.PositionReached, requiresAck: true, _logger);
@@ -140,8 +212,7 @@ public sealed class EthercatDriveService : IEthercatDriveService
         }
 
         var axis = GetAxisIndex(slave);
-        var snapshot = GetStatus();
-        var status = snapshot.DriveStates.Length > axis ? snapshot.DriveStates[axis] : default;
+        var status = ReadDriveStatus(axis);
         EnsureAxisReadyForMotion(slave, status, requireEncoder: false);
         var command = PendingCommand.CreateMotion(axis, "SCAN", direction, vel, acc, dec, TimeSpan.Zero, CommandCompletion.AckOnly, requiresAck: true, _logger);
         await ExecuteCommandAsync(axis, command, ct).ConfigureAwait(false);
@@ -156,11 +227,10 @@ public sealed class EthercatDriveService : IEthercatDriveService
         }
 
         var axis = GetAxisIndex(slave);
-        var snapshot = GetStatus();
-        var status = snapshot.DriveStates.Length > axis ? snapshot.DriveStates[axis] : default;
+        var status = ReadDriveStatus(axis);
 
         // If encoder is already valid, return immediately (idempotent behavior)
-        if (status.EncoderValid != 0)
+        if (status.EncoderValid)
         {
             _logger.LogDebug("Slave {Slave} encoder is already valid, skipping indexing command.", slave);
             return;
@@ -187,17 +257,16 @@ public sealed class EthercatDriveService : IEthercatDriveService
         var axis = GetAxisIndex(slave);
 
         // Check current state
-        var snapshot = GetStatus();
-        var status = snapshot.DriveStates.Length > axis ? snapshot.DriveStates[axis] : default;
+        var status = ReadDriveStatus(axis);
 
         // If already in target state, return immediately (idempotent behavior)
-        if (enable && status.AmplifiersEnabled != 0)
+        if (enable && status.AmplifiersEnabled)
         {
             _logger.LogDebug("Slave {Slave} is already enabled, skipping command.", slave);
             return;
         }
 
-        if (!enable && status.AmplifiersEnabled == 0)
+        if (!enable && !status.AmplifiersEnabled)
         {
             _logger.LogDebug("Slave {Slave} is already disabled, skipping command.", slave);
             return;
@@ -267,7 +336,121 @@ public sealed class EthercatDriveService : IEthercatDriveService
     }
 
     public SoemStatusSnapshot GetStatus()
-        => _snapshot;
+    {
+        var drives = new DriveStatus[_slaveCount];
+        var header = _status.Read(drives);
+        while (header.DriveCount > drives.Length)
+        {
+            drives = new DriveStatus[header.DriveCount];
+            header = _status.Read(drives);
+        }
+
+        var states = new DriveStatusWord[header.DriveCount];
+        for (var i = 0; i < states.Length; i++)
+        {
+            states[i] = drives[i].Word;
+        }
+
+        return new SoemStatusSnapshot(header.Timestamp, header.Health, states, header.CycleTime, header.MinCycleTime, header.MaxCycleTime, header.RoundTripTime, header.HostTime);
+    }
+
+    public SoemStatusHeader GetStatus(Span<DriveStatus> destination)
+        => _status.Read(destination);
+
+    public SoemCycleStatistics GetCycleStatistics()
+    {
+        lock (_cycleStatsGate)
+        {
+            return _cycleStatistics;
+        }
+    }
+
+    public int GetSlaveStates(Span<SoemSlaveState> destination)
+    {
+        var states = Volatile.Read(ref _publishedStates);
+        var count = Math.Min(states.Length, destination.Length);
+        states.AsSpan(0, count).CopyTo(destination);
+        return count;
+    }
+
+    public int GetGroupStatus(Span<SoemGroupStatus> destination)
+    {
+        lock (_groupGate)
+        {
+            _groupStatus.AsSpan(0, Math.Min(_groupCount, destination.Length)).CopyTo(destination);
+            return _groupCount;
+        }
+    }
+
+    public Task<byte[]> ReadSdoAsync(int slave, ushort index, byte subindex, CancellationToken ct = default)
+        => SubmitSdo(slave, index, subindex, null, ct);
+
+    public Task WriteSdoAsync(int slave, ushort index, byte subindex, ReadOnlyMemory<byte> data, CancellationToken ct = default)
+    {
+        if (data.IsEmpty || data.Length > SoemShim.SOEM_SDO_MAX_BYTES)
+        {
+            throw new ArgumentOutOfRangeException(nameof(data), $"SDO data must be 1 to {SoemShim.SOEM_SDO_MAX_BYTES} bytes.");
+        }
+
+        return SubmitSdo(slave, index, subindex, data, ct);
+    }
+
+    public SoemSdoStatistics GetSdoStatistics()
+    {
+        EnsureInitialized();
+        _soem.GetSdoStats(_handle, out var stats);
+        return SoemSdoStatistics.FromNative(stats);
+    }
+
+    public SoemNicStatistics GetNicStatistics()
+    {
+        EnsureInitialized();
+        _soem.GetNicStats(_handle, out var stats);
+        return SoemNicStatistics.FromNative(stats);
+    }
+
+    public int ExportCapture(string path)
+    {
+        if (string.IsNullOrWhiteSpace(path))
+        {
+            throw new ArgumentException("A file path must be provided.", nameof(path));
+        }
+
+        EnsureInitialized();
+        var frames = _soem.ExportCapture(_handle, path);
+        return frames switch
+        {
+            >= 0 => frames,
+            SoemErrorCodes.SOEM_ERR_UNSUPPORTED => throw new InvalidOperationException("Wire capture is off; set CaptureBytes on a Linux shim."),
+            SoemErrorCodes.SOEM_ERR_IO => throw new System.IO.IOException($"Capture could not be written to {path}."),
+            _ => throw new InvalidOperationException($"Capture export failed: {SoemErrorCodes.GetErrorDescription(frames)}")
+        };
+    }
+
+    public SoemCaptureStatistics GetCaptureStatistics()
+    {
+        EnsureInitialized();
+        _soem.GetCaptureStats(_handle, out var stats);
+        return SoemCaptureStatistics.FromNative(stats);
+    }
+
+    public SoemBootReport GetColdStartReport()
+    {
+        EnsureInitialized();
+        lock (_bootGate)
+        {
+            return _coldStart;
+        }
+    }
+
+    public SoemBootReport? GetLastRecoveryReport()
+    {
+        EnsureInitialized();
+        lock (_bootGate)
+        {
+            return _lastRecovery;
+        }
+    }
 
     public async ValueTask DisposeAsync()
     {
@@ -303,8 +486,12 @@ public sealed class EthercatDriveService : IEthercatDriveService
             }
         }
 
+        CancelSdoTransfers();
+
         if (_handle != IntPtr.Zero)
         {
+            StopNativeEngine();
+            _image = null;
             _soem.Shutdown(_handle);
             _handle = IntPtr.Zero;
         }
@@ -335,8 +522,13 @@ public sealed class EthercatDriveService : IEthercatDriveService
     private void AllocateBuffers(int slaveCount)
     {
         _rxPdos = new SoemShim.DriveRxPDO[slaveCount];
-        _txPdos = new SoemShim.DriveTxPDO[slaveCount];
-        _previousTxPdos = new SoemShim.DriveTxPDO[slaveCount]; // Add this
+        _txPdos = new DriveStatusWord[slaveCount];
+        _cycleTx = new DriveStatusWord[slaveCount];
+        _previousTxPdos = new DriveStatusWord[slaveCount]; // Add this
+        _changedAxes = new uint[(slaveCount + 31) / 32];
+        _slaveStates = new SoemShim.SoemSlaveState[slaveCount];
+        _publishedStateReads = ulong.MaxValue;
+        _slaveLost = new bool[slaveCount];
         _activeCommands = new PendingCommand?[slaveCount];
         _axisLocks = new SemaphoreSlim[slaveCount];
         _stopLatch = new bool[slaveCount];
@@ -348,6 +540,15 @@ public sealed class EthercatDriveService : IEthercatDriveService
             _stopLatch[i] = false;
         }
 
+        _sampleInputs = new byte[slaveCount * PdoCodec.TxBytes];
+        _stagedCommands = new PendingCommand?[slaveCount];
+        _stagedExecute = new byte[slaveCount];
+        _restage = new bool[slaveCount];
+        _outputDirty = new bool[slaveCount];
+        MarkOutputsDirty();
+        _overlapStaged = false;
+        _overlapReceived = false;
+
         _lastFaults = new DriveErrorCode[slaveCount];
         _lastFaultTimes = new DateTimeOffset[slaveCount];
         for (var i = 0; i < slaveCount; i++)
@@ -361,23 +562,109 @@ public sealed class EthercatDriveService : IEthercatDriveService
             slaveCount, _rxPdos.Length, _txPdos.Length, _activeCommands.Length, _axisLocks.Length, _stopLatch.Length);
     }
 
+    private static readonly SoemShim.DriveRxPDO NopPdo = CreateNopPdo();
+
     private static SoemShim.DriveRxPDO CreateNopPdo()
     {
         var pdo = new SoemShim.DriveRxPDO
         {
-            Command = new byte[32],
             Parameter = 0,
             Velocity = 0,
             Acceleration = 0,
             Deceleration = 0,
             Execute = 0
         };
-        PendingCommand.FillCommand(ref pdo, "NOP");
+        CommandKeywords.Write(ref pdo, CommandKeywords.Nop);
         return pdo;
     }
 
    
 
+    /// <summary>
+    /// Queues an SDO transfer in the shim and returns the task the IO loop completes once the shim reports it.
+    /// Cancelling <paramref name="ct"/> only stops the wait; the transfer itself still runs to its end.
+    /// </summary>
+    private Task<byte[]> SubmitSdo(int slave, ushort index, byte subindex, ReadOnlyMemory<byte>? data, CancellationToken ct)
+    {
+        EnsureInitialized();
+        GetAxisIndex(slave);
+        var done = new TaskCompletionSource<byte[]>(TaskCreationOptions.RunContinuationsAsynchronously);
+        int ticket;
+        lock (_sdoGate)
+        {
+            // Registered under the lock, so the IO loop cannot see the result before the ticket is known.
+            ticket = data is { } value
+                ? _soem.SdoWrite(_handle, slave, index, subindex, value.Span)
+                : _soem.SdoRead(_handle, slave, index, subindex);
+            if (ticket > 0)
+            {
+                _sdoPending.Add(ticket, done);
+                Volatile.Write(ref _sdoOpen, _sdoPending.Count);
+            }
+        }
+
+        return ticket switch
+        {
+            > 0 => done.Task.WaitAsync(ct),
+            0 => throw new InvalidOperationException("The shim's SDO queue is full; wait for open transfers to finish."),
+            SoemErrorCodes.SOEM_ERR_UNSUPPORTED => throw new NotSupportedException($"SDO access needs SdoWorkers > 0 and a CoE mailbox on slave {slave}."),
+            _ => throw new InvalidOperationException($"SDO request rejected: {SoemErrorCodes.GetErrorDescription(ticket)}")
+        };
+    }
+
+    private void CompleteSdoTransfers()
+    {
+        int count;
+        do
+        {
+            count = _soem.PollSdo(_handle, _sdoCompletions);
+            for (var i = 0; i < count; i++)
+            {
+                ref readonly var result = ref _sdoCompletions[i];
+                TaskCompletionSource<byte[]>? done;
+                lock (_sdoGate)
+                {
+                    _sdoPending.Remove((int)result.ticket, out done);
+                    Volatile.Write(ref _sdoOpen, _sdoPending.Count);
+                }
+
+                if (done is null)
+                {
+                    continue;
+                }
+
+                if (result.status >= 0)
+                {
+                    done.TrySetResult(result.write != 0 ? Array.Empty<byte>() : ((ReadOnlySpan<byte>)result.data)[..result.size].ToArray());
+                }
+                else
+                {
+                    // The abort code, if the slave sent one, reaches Faulted through the error list.
+                    done.TrySetException(new InvalidOperationException(
+                        $"SDO {(result.write != 0 ? "write" : "read")} of slave {result.slave} object 0x{result.index:X4}:{result.subindex} failed: {SoemErrorCodes.GetErrorDescription(result.status)}."));
+                }
+            }
+        }
+        while (count == _sdoCompletions.Length);
+    }
+
+    private void CancelSdoTransfers()
+    {
+        TaskCompletionSource<byte[]>[] open;
+        lock (_sdoGate)
+        {
+            open = new TaskCompletionSource<byte[]>[_sdoPending.Count];
+            _sdoPending.Values.CopyTo(open, 0);
+            _sdoPending.Clear();
+            Volatile.Write(ref _sdoOpen, 0);
+        }
+
+        foreach (var done in open)
+        {
+            done.TrySetCanceled();
+        }
+    }
+
     private void EnsureInitialized()
     {
         if (!_initialized)
@@ -396,7 +683,7 @@ public sealed class EthercatDriveService : IEthercatDriveService
         return slave - 1;
     }
 
-    private void EnsureAxisReadyForMotion(int slave, SoemShim.DriveTxPDO status, bool requireEncoder)
+    private void EnsureAxisReadyForMotion(int slave, DriveStatusWord status, bool requireEncoder)
     {
         var axis = GetAxisIndex(slave);
         if (_stopLatch.Length > axis && _stopLatch[axis])
@@ -404,95 +691,35 @@ public sealed class EthercatDriveService : IEthercatDriveService
             throw new InvalidOperationException($"Slave {slave} is latched by STOP. Issue ENBL=1 or RSET before motion.");
         }
 
-        if (status.AmplifiersEnabled == 0)
+        if (!status.AmplifiersEnabled)
         {
             throw new InvalidOperationException($"Slave {slave} is not enabled. Call EnableAsync before issuing motion commands.");
         }
 
-        if (requireEncoder && status.EncoderValid == 0)
+        if (requireEncoder && !status.EncoderValid)
         {
             throw new InvalidOperationException($"Slave {slave} encoder is not referenced. Run IndexAsync before absolute motion.");
         }
     }
 
+    private TimeSpan IoLoopPeriod()
+        => _options.CyclePeriod > TimeSpan.Zero ? _options.CyclePeriod : TimeSpan.FromMilliseconds(2);
+
+    private void BeginIoLoop()
+    {
+        _minCycle = TimeSpan.MaxValue;
+        _maxCycle = TimeSpan.Zero;
+        _cycleStatsDue = Stopwatch.GetTimestamp() + (long)(_options.CycleStatisticsWindow.TotalSeconds * Stopwatch.Frequency);
+    }
+
     private async Task RunIoLoopAsync(CancellationToken ct)
     {
-        var timerPeriod = _options.CyclePeriod > TimeSpan.Zero ? _options.CyclePeriod : TimeSpan.FromMilliseconds(2);
-        using var timer = new PeriodicTimer(timerPeriod);
-        var minCycle = TimeSpan.MaxValue;
-        var maxCycle = TimeSpan.Zero;
-        var lastCycle = TimeSpan.Zero;
+        using var timer = new PeriodicTimer(IoLoopPeriod());
+        BeginIoLoop();
 
         while (!ct.IsCancellationRequested)
         {
-            var cycleStart = Stopwatch.GetTimestamp();
-
-            ProcessIncomingCommands();
-            StageOutputs();
-
-            var wkc = _soem.ExchangeProcessData(_handle, _options.ExchangeTimeoutMicroseconds);
-            var health = ReadHealth();
-
-            // Handle different error codes from SOEM
-            if (wkc >= 0)
-            {
-                // Success - process normally
-                _fatalErrorCount = 0;
-                ProcessStatuses(health, wkc);
-            }
-            else if (wkc == SoemErrorCodes.SOEM_ERR_WKC_LOW)
-            {
-                // Recoverable: working counter low
-                _logger.LogWarning("Working counter low: {Description}", SoemErrorCodes.GetErrorDescription(wkc));
-                _fatalErrorCount = 0;
-                ProcessStatuses(health, wkc);
-            }
-            else if (SoemErrorCodes.IsFatalError(wkc))
-            {
-                // Fatal errors: bad args, send fail, recv fail
-                _fatalErrorCount++;
-                _logger.LogError("Fatal EtherCAT error (#{Count}): {Code} - {Description}",
-                    _fatalErrorCount, wkc, SoemErrorCodes.GetErrorDescription(wkc));
-
-                // Attempt immediate recovery for fatal errors
-                if (_fatalErrorCount >= 3)
-                {
-                    _logger.LogCritical("Too many consecutive fatal errors ({Count}). Force reinitializing.", _fatalErrorCount);
-                    Reinitialize();
-                    _fatalErrorCount = 0;
-                    _wkcStrikes = 0;
-                }
-                else
-                {
-                    HandleFaultyCycle(health, wkc, $"Fatal communication error: {SoemErrorCodes.GetErrorDescription(wkc)}");
-                }
-            }
-            else
-            {
-                // Unknown error code
-                _logger.LogError("Unknown SOEM error code: {Wkc} - {Description}", wkc, SoemErrorCodes.GetErrorDescription(wkc));
-                HandleFaultyCycle(health, wkc, $"Unknown error code: {wkc}");
-            }
-
-            DrainErrorSink();
-
-            lastCycle = Stopwatch.GetElapsedTime(cycleStart);
-            if (lastCycle < minCycle)
-            {
-                minCycle = lastCycle;
-            }
-
-            if (lastCycle > maxCycle)
-            {
-                maxCycle = lastCycle;
-            }
-
-            PublishSnapshot(health, lastCycle, minCycle, maxCycle);
-
-            if (_options.EnableCycleTraceLogging)
-            {
-                _logger.LogTrace("Cycle complete: wkc={Wkc} expected={Expected} op={Op} duration={Duration} min={Min} max={Max}", health.LastWkc, health.GroupExpectedWkc, health.SlavesOperational, lastCycle.TotalMilliseconds, minCycle.TotalMilliseconds, maxCycle.TotalMilliseconds);
-            }
+            RunIoIteration();
 
             try
             {
@@ -505,129 +732,1002 @@ public sealed class EthercatDriveService : IEthercatDriveService
         }
     }
 
-    private void ProcessIncomingCommands()
+    private Task StartIoThread(CancellationToken ct)
     {
-        while (_commandChannel.Reader.TryRead(out var command))
+        var done = new TaskCompletionSource(TaskCreationOptions.RunContinuationsAsynchronously);
+        var thread = new Thread(() =>
         {
-            if (command == null)
+            try
             {
-                continue;
+                RunIoThread(ct);
+                done.SetResult();
             }
-
-            if (command.Cancelled)
+            catch (Exception ex)
             {
-                continue;
+                done.SetException(ex);
             }
+        })
+        {
+            IsBackground = true,
+            Name = $"ethercat-io {_interface}"
+        };
+        thread.Start();
+        return done.Task;
+    }
 
-            var axis = command.SlaveIndex;
-            if (axis < 0 || axis >= _activeCommands.Length)
-            {
-                command.Fail(new DriveError(DriveErrorCode.UnknownFault, "Invalid slave index.", "Verify command arguments."));
-                continue;
-            }
+    /// <summary>
+    /// The IO loop on its own thread (<see cref="EthercatDriveOptions.DedicatedIoThread"/>): the same iteration as
+    /// <see cref="RunIoLoopAsync"/>, paced against absolute deadlines. A whole missed period is skipped rather than
+    /// caught up, as the native engine does.
+    /// </summary>
+    private void RunIoThread(CancellationToken ct)
+    {
+        if (_options.IoThreadCpu >= 0 && !_soem.PinCurrentThread(_options.IoThreadCpu))
+        {
+            _logger.LogWarning("Could not pin the IO thread of {Interface} to CPU {Cpu}; it runs unpinned.", _interface, _options.IoThreadCpu);
+        }
 
-            if (_activeCommands[axis] is not null)
+        var period = (long)(IoLoopPeriod().TotalSeconds * Stopwatch.Frequency);
+        BeginIoLoop();
+        var deadline = Stopwatch.GetTimestamp();
+
+        while (!ct.IsCancellationRequested)
+        {
+            RunIoIteration();
+
+            deadline += period;
+            var now = Stopwatch.GetTimestamp();
+            if (now - deadline > period)
             {
-                command.Fail(new DriveError(DriveErrorCode.UnknownFault, "Command already in-flight for slave.", "Wait for active command to complete."));
+                deadline = now;
                 continue;
             }
 
-            _activeCommands[axis] = command;
-            command.Start();
-            _logger.LogDebug("Staged {Command}={Parameter} for slave {Slave}.", command.Keyword, command.Parameter, axis + 1);
+            WaitUntil(deadline, ct);
         }
     }
 
-    private void StageOutputs()
+    /// <summary>
+    /// Sleeps in whole milliseconds while more than one is left, then spins (yielding) to the deadline.
+    /// </summary>
+    private static void WaitUntil(long deadline, CancellationToken ct)
     {
-        for (var i = 0; i < _rxPdos.Length; i++)
+        var sleepMs = (int)((deadline - Stopwatch.GetTimestamp()) * 1000 / Stopwatch.Frequency) - 1;
+        if (sleepMs > 0 && ct.WaitHandle.WaitOne(sleepMs))
         {
-            ref var pdo = ref _rxPdos[i];
-            var command = _activeCommands[i];
-            if (command is null)
-            {
-                pdo.Execute = 0;
-                PendingCommand.FillCommand(ref pdo, "NOP");
-                pdo.Parameter = 0;
-                pdo.Velocity = 0;
-                pdo.Acceleration = 0;
-                pdo.Deceleration = 0;
-            }
-            else
-            {
-                if (command.Cancelled)
-                {
-                    _activeCommands[i] = null;
-                    pdo.Execute = 0;
-                    PendingCommand.FillCommand(ref pdo, "NOP");
-                    pdo.Parameter = 0;
-                    pdo.Velocity = 0;
-                    pdo.Acceleration = 0;
-                    pdo.Deceleration = 0;
-                }
-                else
-                {
-                    command.Apply(ref pdo);
-                }
-            }
+            return;
+        }
 
-            var rc = _soem.WriteRxPdo(_handle, i + 1, ref pdo);
-            if (rc < 0)
-            {
-                _logger.LogWarning("Failed to write RX PDO for slave {Slave}: {Result}.", i + 1, rc);
-            }
+        var spinner = new SpinWait();
+        while (Stopwatch.GetTimestamp() < deadline && !ct.IsCancellationRequested)
+        {
+            spinner.SpinOnce(sleep1Threshold: -1);
         }
     }
 
-    private SoemHealthSnapshot ReadHealth()
+    private void RunIoIteration()
     {
-        if (_soem.GetHealth(_handle, out var health) != 0)
+        var cycleStart = Stopwatch.GetTimestamp();
+
+        SoemHealthSnapshot health;
+        if (_nativeEngineActive)
+        {
+            ProcessIncomingCommands();
+            StageOutputs();
+            health = ServiceNativeEngine();
+        }
+        else if (_options.OverlapCycleProcessing && _image is not null)
+        {
+            health = RunOverlappedCycle();
+        }
+        else
         {
-            return new SoemHealthSnapshot(health.slaves_found, health.group_expected_wkc, health.last_wkc, health.bytes_out, health.bytes_in, health.slaves_op, health.al_status_code);
+            ProcessIncomingCommands();
+            StageOutputs();
+            health = RunManagedCycle();
         }
 
-        return new SoemHealthSnapshot(0, 0, 0, 0, 0, 0, 0);
-    }
+        if (_errorPending)
+        {
+            _errorPending = false;
+            DrainErrorSink(health);
+        }
 
-    private void ProcessStatuses(SoemHealthSnapshot health, int wkc)
-    {
-        _logger.LogTrace(
-            "ProcessStatuses: rxPdos={RxPdos}, txPdos={TxPdos}, activeCommands={ActiveCommands}, axisLocks={AxisLocks}, stopLatch={StopLatch}",
-            _rxPdos.Length, _txPdos.Length, _activeCommands.Length, _axisLocks.Length, _stopLatch.Length);
+        if (_stateCheckDue)
+        {
+            // Outside the exchange: this is the only extra bus round trip, and only when a cycle asked for it.
+            _stateCheckDue = false;
+            _soem.CheckState(_handle, force: false);
+        }
 
-        if (health.LastWkc < health.GroupExpectedWkc)
+        if (_recovering)
         {
-            HandleFaultyCycle(health, wkc, "Work counter below expected");
+            // One bounded action on one slave per tick; the native engine steps it itself and answers BUSY.
+            _soem.RecoverStep(_handle);
         }
-        else
+
+        if (Volatile.Read(ref _sdoOpen) > 0)
         {
-            _wkcStrikes = 0;
+            // A bounded mailbox handler pass in the slack, like the recovery step; then hand out what finished.
+            _soem.ServiceSdo(_handle);
+            CompleteSdoTransfers();
         }
 
-        try
+        var stateInfo = RefreshSlaveStates();
+        if (_recovering)
         {
-            for (var i = 0; i < _txPdos.Length; i++)
+            CheckRecovery(stateInfo);
+        }
+
+        RefreshGroupStatus();
+
+        var lastCycle = Stopwatch.GetElapsedTime(cycleStart);
+        if (lastCycle < _minCycle)
+        {
+            _minCycle = lastCycle;
+        }
+
+        if (lastCycle > _maxCycle)
+        {
+            _maxCycle = lastCycle;
+        }
+
+        var hostTime = lastCycle - _lastBusWait;
+        PublishSnapshot(health, lastCycle, _minCycle, _maxCycle, _lastRoundTrip, hostTime);
+
+        if (_options.EnableCycleTraceLogging)
+        {
+            _logger.LogTrace("Cycle complete: wkc={Wkc} expected={Expected} op={Op} duration={Duration} min={Min} max={Max} roundTrip={RoundTrip} host={Host}", health.LastWkc, health.GroupExpectedWkc, health.SlavesOperational, lastCycle.TotalMilliseconds, _minCycle.TotalMilliseconds, _maxCycle.TotalMilliseconds, _lastRoundTrip.TotalMilliseconds, hostTime.TotalMilliseconds);
+        }
+
+        var statsWindow = _options.CycleStatisticsWindow;
+        if (statsWindow > TimeSpan.Zero && Stopwatch.GetTimestamp() >= _cycleStatsDue)
+        {
+            _cycleStatsDue += (long)(statsWindow.TotalSeconds * Stopwatch.Frequency);
+            CloseCycleStatisticsWindow();
+        }
+    }
+
+    /// <summary>
+    /// One bus cycle through <c>soem_cycle</c>: outputs, exchange, inputs, WKC and error flag in a single native call.
+    /// </summary>
+    private SoemHealthSnapshot RunManagedCycle()
+    {
+        int wkc;
+        SoemShim.SoemCycleResult result;
+        if (_image is { } image)
+        {
+            // StageOutputs already wrote the commands into the IOmap. The shim diffs the inputs in bulk and only
+            // rewrites the status words of axes that changed; the rest of _cycleTx is still current.
+            wkc = _soem.Cycle(_handle, Array.Empty<SoemShim.DriveRxPDO>(), Array.Empty<DriveStatusWord>(), _options.ExchangeTimeoutMicroseconds, out result);
+            if ((wkc >= 0 || wkc == SoemErrorCodes.SOEM_ERR_WKC_LOW) && _soem.ScanInputs(_handle, _changedAxes, _cycleTx) < 0)
             {
-                var slaveIndex = i + 1;
-                var rc = _soem.ReadTxPdo(_handle, slaveIndex, out var tx);
-                if (rc < 0)
+                for (var i = 0; i < _cycleTx.Length; i++)
                 {
-                    _logger.LogWarning("Failed to read TX PDO for slave {Slave}: {Result}.", slaveIndex, rc);
-                    continue;
+                    _cycleTx[i] = DriveStatusWord.FromWire(image.Inputs(i));
                 }
 
-                // Detect changes
-                var previous = _previousTxPdos[i];
-                var currentMask = DriveStateFormatter.ToBitMask(tx);
-                var previousMask = DriveStateFormatter.ToBitMask(previous);
-                var changedMask = currentMask ^ previousMask;
-                var positionChanged = tx.ActualPosition != previous.ActualPosition;
-
-                // Update stored state
-                _previousTxPdos[i] = tx;
-                _txPdos[i] = tx;
-                
+                FlagChangedAxes();
+            }
+        }
+        else
+        {
+            // Unchanged outputs are still in the IOmap from the last call; only ship the array when one changed.
+            var rx = _rxArrayDirty ? _rxPdos : Array.Empty<SoemShim.DriveRxPDO>();
+            _rxArrayDirty = false;
+            wkc = _soem.Cycle(_handle, rx, _cycleTx, _options.ExchangeTimeoutMicroseconds, out result);
+            FlagChangedAxes();
+        }
+
+        _lastBusWait = TimeSpan.FromTicks(result.exchange_ns / 100);
+        return CompleteCycle(wkc, result);
+    }
+
+    /// <summary>
+    /// One bus cycle split at the wire (IOmap path only): sends the outputs staged last time, evaluates the
+    /// previous cycle's statuses and stages the next outputs while the frames travel, then collects them.
+    /// Status processing therefore trails the bus by one cycle.
+    /// </summary>
+    private SoemHealthSnapshot RunOverlappedCycle()
+    {
+        var health = _status.LastHealth;
+        if (_overlapReceived && (_overlapWkc < 0 || _overlapResult.wkc < _overlapResult.expected_wkc))
+        {
+            // A degraded cycle may recover or reinitialize the bus, which must not happen with frames in flight.
+            _overlapReceived = false;
+            health = CompleteCycle(_overlapWkc, _overlapResult);
+        }
+
+        if (!_overlapStaged)
+        {
+            ProcessIncomingCommands();
+            StageOutputs();
+        }
+
+        var sendRc = _soem.SendCycle(_handle);
+        if (_overlapReceived)
+        {
+            _overlapReceived = false;
+            health = CompleteCycle(_overlapWkc, _overlapResult);
+        }
+
+        // Stage the next cycle's outputs while the frames travel. The receive copies each LRW payload back over
+        // the IOmap, outputs included, so they go to the IOmap only once the frames are back.
+        _framesInFlight = sendRc == 1;
+        ProcessIncomingCommands();
+        StageOutputs();
+        _overlapStaged = true;
+
+        if (sendRc != 1)
+        {
+            _lastBusWait = TimeSpan.Zero;
+            return CompleteCycle(sendRc, default);
+        }
+
+        var waitStart = Stopwatch.GetTimestamp();
+        var wkc = _soem.ReceiveCycle(_handle, Array.Empty<DriveStatusWord>(), _options.ExchangeTimeoutMicroseconds, out var result);
+        _framesInFlight = false;
+        WriteRestagedOutputs();
+        if ((wkc >= 0 || wkc == SoemErrorCodes.SOEM_ERR_WKC_LOW) && _soem.ScanInputs(_handle, _changedAxes, _cycleTx) < 0 && _image is { } image)
+        {
+            for (var i = 0; i < _cycleTx.Length; i++)
+            {
+                _cycleTx[i] = DriveStatusWord.FromWire(image.Inputs(i));
+            }
+
+            FlagChangedAxes();
+        }
+
+        _lastBusWait = Stopwatch.GetElapsedTime(waitStart);
+        _overlapWkc = wkc;
+        _overlapResult = result;
+        _overlapReceived = true;
+        return health;
+    }
+
+    /// <summary>
+    /// Evaluates one exchanged cycle: health from its WKC, then statuses, recovery or error handling by return code.
+    /// </summary>
+    private SoemHealthSnapshot CompleteCycle(int wkc, in SoemShim.SoemCycleResult result)
+    {
+        _lastRoundTrip = TimeSpan.FromTicks(result.exchange_ns / 100);
+        _errorPending |= result.error_pending != 0;
+        _stateCheckDue |= result.state_due != 0;
+        NoteRingPath(result.red_path);
+        SoemHealthSnapshot? degraded = null;
+        var health = HealthFromCycle(result.wkc, result.expected_wkc, ref degraded);
+
+        if (_options.EnableCycleTraceLogging)
+        {
+            _logger.LogTrace("soem_cycle: rc={Rc} wkc={Wkc}/{Expected} exchange={Exchange}us total={Total}us", wkc, result.wkc, result.expected_wkc, result.exchange_ns / 1000, result.total_ns / 1000);
+        }
+
+        // Handle different error codes from SOEM
+        if (wkc >= 0)
+        {
+            // Success - process normally
+            _fatalErrorCount = 0;
+            ProcessStatuses(health, wkc);
+        }
+        else if (wkc == SoemErrorCodes.SOEM_ERR_WKC_LOW)
+        {
+            // Recoverable: working counter low
+            _logger.LogWarning("Working counter low: {Description}", SoemErrorCodes.GetErrorDescription(wkc));
+            _fatalErrorCount = 0;
+            ProcessStatuses(health, wkc);
+        }
+        else if (SoemErrorCodes.IsFatalError(wkc))
+        {
+            // Fatal errors: bad args, send fail, recv fail
+            _fatalErrorCount++;
+            _logger.LogError("Fatal EtherCAT error (#{Count}): {Code} - {Description}",
+                _fatalErrorCount, wkc, SoemErrorCodes.GetErrorDescription(wkc));
+
+            // Attempt immediate recovery for fatal errors
+            if (_fatalErrorCount >= 3)
+            {
+                _logger.LogCritical("Too many consecutive fatal errors ({Count}). Force reinitializing.", _fatalErrorCount);
+                Reinitialize();
+                _fatalErrorCount = 0;
+                _wkcStrikes = 0;
+            }
+            else
+            {
+                HandleFaultyCycle(health, wkc, $"Fatal communication error: {SoemErrorCodes.GetErrorDescription(wkc)}");
+            }
+        }
+        else
+        {
+            // Unknown error code
+            _logger.LogError("Unknown SOEM error code: {Wkc} - {Description}", wkc, SoemErrorCodes.GetErrorDescription(wkc));
+            HandleFaultyCycle(health, wkc, $"Unknown error code: {wkc}");
+        }
+
+        return health;
+    }
+
+    /// <summary>
+    /// Consumes every sample the native engine produced since the last tick, oldest first, so no status edge
+    /// (ExecuteAck, PositionReached, ...) is lost even though this loop runs slower than the bus.
+    /// </summary>
+    private SoemHealthSnapshot ServiceNativeEngine()
+    {
+        var health = _status.LastHealth;
+        SoemHealthSnapshot? degraded = null;
+
+        _lastBusWait = TimeSpan.Zero;
+        while (_nativeEngineActive && _soem.PopSample(_handle, out var sample, _sampleInputs) == 1)
+        {
+            _errorPending |= sample.error_pending != 0;
+            NoteRingPath(sample.red_path);
+            _lastRoundTrip = TimeSpan.FromTicks(sample.exchange_ns / 100);
+            health = HealthFromCycle(sample.wkc, sample.expected_wkc, ref degraded);
+            for (var i = 0; i < _cycleTx.Length; i++)
+            {
+                _cycleTx[i] = DriveStatusWord.FromWire(_sampleInputs.AsSpan(i * PdoCodec.TxBytes, PdoCodec.TxBytes));
+            }
+
+            FlagChangedAxes();
+            ProcessStatuses(health, sample.wkc);
+        }
+
+        return health;
+    }
+
+    /// <summary>
+    /// Builds the cycle's health from its WKC. <c>soem_get_health</c> (OP count and AL status from the shim's state
+    /// cache, no bus traffic) is only consulted when the WKC says the bus is degraded, once per call site via
+    /// <paramref name="degraded"/>.
+    /// </summary>
+    private SoemHealthSnapshot HealthFromCycle(int wkc, int expected, ref SoemHealthSnapshot? degraded)
+    {
+        var dc = _dcActive && _soem.GetDcStats(_handle, out var stats) != 0 ? SoemDcStatus.FromNative(stats) : default;
+        var ring = _redundant && _soem.GetRedundancy(_handle, out var red) != 0 ? SoemRedundancyStatus.FromNative(red) : default;
+        if (expected > 0 && wkc >= expected)
+        {
+            return new SoemHealthSnapshot(_slaveCount, expected, wkc, _healthBaseline.BytesOut, _healthBaseline.BytesIn, _slaveCount, 0, dc, ring);
+        }
+
+        degraded ??= ReadHealth();
+        var state = degraded.Value;
+        return new SoemHealthSnapshot(_slaveCount, expected, wkc, _healthBaseline.BytesOut, _healthBaseline.BytesIn, state.SlavesOperational, state.AlStatusCode, dc, ring);
+    }
+
+    /// <summary>
+    /// Takes the shim's latency histograms for the window that just ended (snapshot-and-reset) and publishes them
+    /// for <see cref="GetCycleStatistics"/>.
+    /// </summary>
+    private void CloseCycleStatisticsWindow()
+    {
+        if (_handle == IntPtr.Zero || _soem.GetCycleStats(_handle, out var native) == 0)
+        {
+            return;
+        }
+
+        var stats = new SoemCycleStatistics(
+            DateTimeOffset.UtcNow,
+            TimeSpan.FromTicks(native.interval_ns / 100),
+            SoemLatencySummary.FromNative(native.round_trip),
+            SoemLatencySummary.FromNative(native.wake_lateness),
+            SoemLatencySummary.FromNative(native.total));
+        lock (_cycleStatsGate)
+        {
+            _cycleStatistics = stats;
+        }
+
+        _logger.LogDebug("Cycle statistics over {Interval} ms ({Count} cycles): roundTrip p99={RoundTripP99} us p99.9={RoundTripP999} us, lateness p99={LateP99} us p99.9={LateP999} us, total p99.9={TotalP999} us",
+            stats.Interval.TotalMilliseconds, stats.Total.Count, stats.RoundTrip.P99.TotalMicroseconds, stats.RoundTrip.P999.TotalMicroseconds,
+            stats.WakeLateness.P99.TotalMicroseconds, stats.WakeLateness.P999.TotalMicroseconds, stats.Total.P999.TotalMicroseconds);
+    }
+
+    /// <summary>
+    /// Opens the bus, with cable redundancy when <see cref="EthercatDriveOptions.SecondaryInterface"/> is set and
+    /// with the slaves split into <see cref="EthercatDriveOptions.SlaveGroups"/>.
+    /// </summary>
+    private IntPtr OpenBus(string iface)
+    {
+        var secondary = _options.SecondaryInterface;
+        _redundant = !string.IsNullOrWhiteSpace(secondary);
+        _ringPath = 0;
+        _groupsDegraded = 0;
+
+        var options = CreateInitOptions();
+        var groups = _options.SlaveGroups is { Length: > 0 } map ? Array.ConvertAll(map, g => (byte)Math.Clamp(g, 0, SoemShim.SOEM_MAX_GROUPS - 1)) : null;
+        var pin = groups is null ? default : GCHandle.Alloc(groups, GCHandleType.Pinned);
+        var captureDir = string.IsNullOrEmpty(_options.CaptureDirectory) ? IntPtr.Zero : Marshal.StringToCoTaskMemUTF8(_options.CaptureDirectory);
+        var configPath = string.IsNullOrEmpty(_options.StoredConfigurationPath) ? IntPtr.Zero : Marshal.StringToCoTaskMemUTF8(_options.StoredConfigurationPath);
+        var siiPath = string.IsNullOrEmpty(_options.SiiCachePath) ? IntPtr.Zero : Marshal.StringToCoTaskMemUTF8(_options.SiiCachePath);
+        try
+        {
+            options.capture_dir = captureDir;
+            options.config_path = configPath;
+            options.sii_cache_path = siiPath;
+            if (groups is not null)
+            {
+                options.slave_group = pin.AddrOfPinnedObject();
+                options.slave_group_count = groups.Length;
+            }
+
+            if (!_redundant)
+            {
+                return _soem.Initialize(iface, options);
+            }
+
+            _logger.LogInformation("Opening EtherCAT ring {Primary} <-> {Secondary} with cable redundancy.", iface, secondary);
+            return _soem.InitializeRedundant(iface, secondary!, options);
+        }
+        finally
+        {
+            if (pin.IsAllocated)
+            {
+                pin.Free();
+            }
+
+            Marshal.FreeCoTaskMem(captureDir);
+            Marshal.FreeCoTaskMem(configPath);
+            Marshal.FreeCoTaskMem(siiPath);
+        }
+    }
+
+    /// <summary>
+    /// Publishes the shim's per-group status for <see cref="GetGroupStatus"/> and logs a group whose WKC drops or
+    /// comes back, once per transition.
+    /// </summary>
+    private void RefreshGroupStatus()
+    {
+        var count = Math.Min(_soem.GetGroupStatus(_handle, _groupScratch), _groupScratch.Length);
+        var degraded = 0u;
+        lock (_groupGate)
+        {
+            for (var i = 0; i < count; i++)
+            {
+                ref readonly var native = ref _groupScratch[i];
+                _groupStatus[i] = SoemGroupStatus.FromNative(native);
+                if (native.last_wkc >= 0 && native.last_wkc < native.expected_wkc)
+                {
+                    degraded |= 1u << i;
+                }
+            }
+
+            _groupCount = count;
+        }
+
+        var changed = degraded ^ _groupsDegraded;
+        if (changed == 0)
+        {
+            return;
+        }
+
+        _groupsDegraded = degraded;
+        for (var i = 0; i < count; i++)
+        {
+            if ((changed & (1u << i)) == 0)
+            {
+                continue;
+            }
+
+            ref readonly var native = ref _groupScratch[i];
+            if ((degraded & (1u << i)) != 0)
+            {
+                _logger.LogWarning("Process-data group {Group} WKC low: {Wkc}/{Expected} ({Op}/{Slaves} slaves in OP).", i, native.last_wkc, native.expected_wkc, native.slaves_op, native.slave_count);
+            }
+            else
+            {
+                _logger.LogInformation("Process-data group {Group} WKC back to {Wkc}.", i, native.last_wkc);
+            }
+        }
+    }
+
+    /// <summary>
+    /// A ring path change is a topology event, not a fault: the redundant ring still reached every slave, so the
+    /// cycle is processed as usual and only the change is logged.
+    /// </summary>
+    private void NoteRingPath(int path)
+    {
+        if (path == _ringPath || path == 0)
+        {
+            return;
+        }
+
+        var previous = _ringPath;
+        _ringPath = path;
+        if (previous == 0 && path == SoemShim.SOEM_RED_PATH_RING)
+        {
+            return;
+        }
+
+        if (path == SoemShim.SOEM_RED_PATH_RING)
+        {
+            _logger.LogInformation("EtherCAT ring closed again ({Previous} -> {Path}).", (RingPath)previous, (RingPath)path);
+        }
+        else
+        {
+            _logger.LogWarning("EtherCAT ring topology changed ({Previous} -> {Path}); cycling continues over both ports.", (RingPath)previous, (RingPath)path);
+        }
+    }
+
+    private void InspectDistributedClock()
+    {
+        var dc = _healthBaseline.DistributedClock;
+        _dcActive = dc.Active;
+        if (_dcActive)
+        {
+            _logger.LogInformation("SYNC0 running on {Slaves} slaves: cycle={Cycle}ns shift={Shift}ns lead={Lead}ns.", dc.Sync0Slaves, dc.CycleNs, dc.ShiftNs, dc.LeadNs);
+        }
+        else if (_options.DistributedClockCycle > TimeSpan.Zero)
+        {
+            _logger.LogWarning("Distributed clock cycle requested but no slave runs SYNC0; cycling unsynchronized.");
+        }
+    }
+
+    private void InspectNicBackend()
+    {
+        if (_options.NicBackend == NicBackend.Socket)
+        {
+            return;
+        }
+
+        _soem.GetNicStats(_handle, out var nic);
+        if ((NicBackend)nic.backend == _options.NicBackend)
+        {
+            _logger.LogInformation("Cyclic frames on {Backend} ({Frames} slots per ring).", (NicBackend)nic.backend, nic.ring_frames);
+        }
+        else
+        {
+            _logger.LogWarning("{Backend} requested but unavailable on {Interface}; cyclic frames use SOEM's socket.", _options.NicBackend, _interface);
+        }
+    }
+
+    private void InspectCapture()
+    {
+        if (_options.CaptureBytes <= 0)
+        {
+            return;
+        }
+
+        _soem.GetCaptureStats(_handle, out var capture);
+        if (capture.enabled != 0)
+        {
+            _logger.LogInformation("Capturing cyclic frames into a {Bytes}-byte ring{OnFault}.", capture.ring_bytes,
+                _options.CaptureOnFault ? ", exported on WKC drops" : string.Empty);
+        }
+        else
+        {
+            _logger.LogWarning("Wire capture requested but unavailable on {Interface}; see the shim log.", _interface);
+        }
+    }
+
+    /// <summary>
+    /// Reads how the shim configured the bus opened at <paramref name="started"/> and logs it, with the reason when a
+    /// stored configuration could not be used.
+    /// </summary>
+    private SoemBootReport InspectBoot(long started)
+    {
+        _soem.GetBootReport(_handle, out var native);
+        var report = SoemBootReport.FromNative(native, Stopwatch.GetElapsedTime(started));
+        if (report.Configuration is not (StoredConfigurationStatus.Off or StoredConfigurationStatus.Used or StoredConfigurationStatus.Missing))
+        {
+            _logger.LogWarning("Stored configuration {Path} not used ({Reason}{Slave}); bus discovered{Written}.", _options.StoredConfigurationPath,
+                report.Configuration, report.MismatchSlave > 0 ? $" at slave {report.MismatchSlave}" : string.Empty,
+                report.ConfigurationWritten ? " and configuration rewritten" : string.Empty);
+        }
+
+        _logger.LogInformation("Bus up in {Startup:F1} ms: {Slaves} slave(s) {Source}, configured in {Configure:F1} ms.",
+            report.StartupTime.TotalMilliseconds, report.Slaves,
+            report.Source == BootSource.StoredConfiguration ? "from the stored configuration" : "discovered",
+            report.ConfigureTime.TotalMilliseconds);
+        var timeline = report.Timeline;
+        _logger.LogDebug("Startup timeline: NIC {Nic:F1} ms, discovery {Discovery:F1} ms, mapping {Mapping:F1} ms, DC {Dc:F1} ms, SAFE-OP {SafeOp:F1} ms, OP {Op:F1} ms.",
+            timeline.NicOpen.TotalMilliseconds, timeline.Discovery.TotalMilliseconds, timeline.Mapping.TotalMilliseconds,
+            timeline.DistributedClocks.TotalMilliseconds, timeline.SafeOp.TotalMilliseconds, timeline.Op.TotalMilliseconds);
+        if (report.SlavesInOp < report.Slaves)
+        {
+            _logger.LogWarning("Only {InOp} of {Slaves} slave(s) reached OP during startup; see the shim log for the others.", report.SlavesInOp, report.Slaves);
+        }
+
+        if (report.SiiCached + report.SiiRead > 0)
+        {
+            _logger.LogInformation("SII of {Cached} slave(s) from {Path}, {Read} read from the bus.", report.SiiCached, _options.SiiCachePath, report.SiiRead);
+        }
+
+        return report;
+    }
+
+    private SoemShim.SoemInitOptions CreateInitOptions()
+    {
+        var flags = 0u;
+        if (_options.LockProcessImage)
+        {
+            flags |= SoemShim.SOEM_IOMAP_LOCKED;
+        }
+
+        if (_options.UseHugePagesForProcessImage)
+        {
+            flags |= SoemShim.SOEM_IOMAP_HUGE_PAGES;
+        }
+
+        return new SoemShim.SoemInitOptions
+        {
+            iomap_flags = flags,
+            dc_cycle_ns = (uint)Math.Max(0, _options.DistributedClockCycle.TotalNanoseconds),
+            dc_shift_ns = (int)_options.DistributedClockShift.TotalNanoseconds,
+            dc_lead_ns = (int)Math.Max(0, _options.DistributedClockLead.TotalNanoseconds),
+            cycle_period_ns = (uint)Math.Clamp(_options.CyclePeriod.TotalNanoseconds, 0, uint.MaxValue),
+            state_check_ms = (uint)Math.Clamp(_options.StateCheckInterval.TotalMilliseconds, 0, uint.MaxValue),
+            sdo_workers = (uint)Math.Max(0, _options.SdoWorkers),
+            sdo_actions = (uint)Math.Max(0, _options.SdoMailboxesPerCycle),
+            nic_backend = (uint)_options.NicBackend,
+            nic_ring_frames = (uint)Math.Max(0, _options.NicRingFrames),
+            capture_bytes = (uint)Math.Max(0, _options.CaptureBytes),
+            capture_window_ms = (uint)Math.Clamp(_options.CaptureWindow.TotalMilliseconds, 0, uint.MaxValue),
+            capture_flags = _options.CaptureOnFault ? SoemShim.SOEM_CAPTURE_ON_FAULT : 0,
+            group_count = (uint)GroupCount(),
+            group_divider = GroupDividers()
+        };
+    }
+
+    private int GroupCount()
+    {
+        var count = 1;
+        foreach (var group in _options.SlaveGroups ?? Array.Empty<int>())
+        {
+            count = Math.Max(count, Math.Clamp(group, 0, SoemShim.SOEM_MAX_GROUPS - 1) + 1);
+        }
+
+        return count;
+    }
+
+    private SoemShim.GroupDividers GroupDividers()
+    {
+        var dividers = new SoemShim.GroupDividers();
+        var configured = _options.GroupCycleDividers ?? Array.Empty<int>();
+        for (var i = 0; i < SoemShim.SOEM_MAX_GROUPS; i++)
+        {
+            dividers[i] = i < configured.Length && configured[i] > 1 ? (uint)configured[i] : 1u;
+        }
+
+        return dividers;
+    }
+
+    private void MapProcessImage()
+    {
+        _image = ProcessImage.TryCreate(_soem, _handle, _slaveCount);
+        if (_image is null)
+        {
+            _logger.LogInformation("Process image not mappable; using marshalled PDO transfer.");
+            return;
+        }
+
+        _logger.LogInformation("Process image mapped: {Size} bytes for {Slaves} slaves.", _image.Size, _image.SlaveCount);
+    }
+
+    private void StartNativeEngine()
+    {
+        if (!_options.UseNativeCycleEngine || _handle == IntPtr.Zero)
+        {
+            return;
+        }
+
+        var cycleUs = (int)Math.Max(1, _options.NativeCyclePeriod.TotalMicroseconds);
+        var config = new SoemShim.SoemRtConfig
+        {
+            cycle_time_us = cycleUs,
+            priority = _options.NativeCyclePriority,
+            cpu = _options.NativeCycleCpu,
+            lock_memory = _options.NativeCycleLockMemory ? 1 : 0,
+            receive_timeout_us = Math.Min(_options.ExchangeTimeoutMicroseconds, cycleUs / 2),
+            ring_capacity = _options.NativeRingCapacity,
+            dc_sync = _dcActive ? 1 : 0
+        };
+
+        MarkOutputsDirty();
+        var rc = _soem.StartCycleEngine(_handle, ref config);
+        if (rc == 1)
+        {
+            _nativeEngineActive = true;
+            _logger.LogInformation("Native cycle engine started: period={Period}us priority={Priority} cpu={Cpu} dcSync={DcSync}.", config.cycle_time_us, config.priority, config.cpu, config.dc_sync != 0);
+            return;
+        }
+
+        _nativeEngineActive = false;
+        _logger.LogWarning("Native cycle engine unavailable ({Description}); using the managed IO loop.", SoemErrorCodes.GetErrorDescription(rc));
+    }
+
+    private void StopNativeEngine()
+    {
+        if (!_nativeEngineActive)
+        {
+            return;
+        }
+
+        if (_soem.GetCycleEngineStats(_handle, out var stats) != 0)
+        {
+            _logger.LogInformation(
+                "Native cycle engine stopping: cycles={Cycles} overruns={Overruns} wkcLow={WkcLow} dropped={Dropped} maxLatency={MaxLatency}us maxExchange={MaxExchange}us",
+                stats.cycles, stats.overruns, stats.wkc_low, stats.samples_dropped, stats.max_wake_latency_ns / 1000, stats.max_exchange_ns / 1000);
+        }
+
+        _soem.StopCycleEngine(_handle);
+        _nativeEngineActive = false;
+    }
+
+    private void MarkOutputsDirty()
+    {
+        Array.Fill(_outputDirty, true);
+        _rxArrayDirty = true;
+    }
+
+    private void ProcessIncomingCommands()
+    {
+        while (_commandChannel.Reader.TryRead(out var command))
+        {
+            if (command == null)
+            {
+                continue;
+            }
+
+            if (command.Cancelled)
+            {
+                continue;
+            }
+
+            var axis = command.SlaveIndex;
+            if (axis < 0 || axis >= _activeCommands.Length)
+            {
+                command.Fail(new DriveError(DriveErrorCode.UnknownFault, "Invalid slave index.", "Verify command arguments."));
+                continue;
+            }
+
+            if (_activeCommands[axis] is not null)
+            {
+                command.Fail(new DriveError(DriveErrorCode.UnknownFault, "Command already in-flight for slave.", "Wait for active command to complete."));
+                continue;
+            }
+
+            _activeCommands[axis] = command;
+            command.Start();
+            _logger.LogDebug("Staged {Command}={Parameter} for slave {Slave}.", command.Keyword, command.Parameter, axis + 1);
+        }
+    }
+
+    /// <summary>
+    /// Rebuilds and writes the RxPDO of every slave whose frame changed since it was last staged. An idle axis
+    /// costs a reference and a byte compare per cycle; the IOmap (or engine ring) keeps the last frame.
+    /// </summary>
+    private void StageOutputs()
+    {
+        for (var i = 0; i < _rxPdos.Length; i++)
+        {
+            var command = _activeCommands[i];
+            if (command is not null && command.Cancelled)
+            {
+                _activeCommands[i] = null;
+                command = null;
+            }
+
+            var execute = command?.Execute ?? 0;
+            if (!_outputDirty[i] && ReferenceEquals(command, _stagedCommands[i]) && execute == _stagedExecute[i])
+            {
+                continue;
+            }
+
+            ref var pdo = ref _rxPdos[i];
+            if (command is null)
+            {
+                pdo = NopPdo;
+            }
+            else
+            {
+                command.Apply(ref pdo);
+            }
+
+            _stagedCommands[i] = command;
+            _stagedExecute[i] = execute;
+            _outputDirty[i] = false;
+
+            // Straight into the IOmap when mapped, into the engine's ring when it runs, otherwise the staged
+            // array goes to the next soem_cycle.
+            if (_nativeEngineActive)
+            {
+                if (_soem.PushCommand(_handle, i + 1, ref pdo) != 1)
+                {
+                    // Ring full: stay dirty so the next tick retries.
+                    _outputDirty[i] = true;
+                    _logger.LogWarning("Native command ring full; RX PDO for slave {Slave} deferred.", i + 1);
+                }
+            }
+            else if (_image is not null)
+            {
+                if (_framesInFlight)
+                {
+                    _restage[i] = true;
+                }
+                else
+                {
+                    PdoCodec.EncodeRx(pdo, _image.Outputs(i));
+                }
+            }
+            else
+            {
+                _rxArrayDirty = true;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Writes the RxPDOs staged while frames were in flight into the IOmap, now that the receive has copied the
+    /// sent outputs back over it.
+    /// </summary>
+    private void WriteRestagedOutputs()
+    {
+        if (_image is not { } image)
+        {
+            return;
+        }
+
+        for (var i = 0; i < _restage.Length; i++)
+        {
+            if (_restage[i])
+            {
+                _restage[i] = false;
+                PdoCodec.EncodeRx(_rxPdos[i], image.Outputs(i));
+            }
+        }
+    }
+
+    private SoemHealthSnapshot ReadHealth()
+    {
+        if (_soem.GetHealth(_handle, out var health) != 0)
+        {
+            return new SoemHealthSnapshot(health.slaves_found, health.group_expected_wkc, health.last_wkc, health.bytes_out, health.bytes_in, health.slaves_op, health.al_status_code, SoemDcStatus.FromNative(health.dc));
+        }
+
+        return new SoemHealthSnapshot(0, 0, 0, 0, 0, 0, 0);
+    }
+
+    /// <summary>
+    /// Republishes the shim's AL state cache for <see cref="GetSlaveStates"/> when a state read ran, the OP or lost
+    /// count changed or recovery started or ended. Reading the cache is a memcpy; the array is only rebuilt on a
+    /// change, which is also when axes are marked lost or found again.
+    /// </summary>
+    private SoemShim.SoemStateInfo RefreshSlaveStates()
+    {
+        var count = _soem.GetSlaveStates(_handle, _slaveStates, out var info);
+        var recovering = info.recovering != 0;
+        if (info.reads == _publishedStateReads && info.slaves_op == _publishedStatesOp
+            && info.slaves_lost == _publishedStatesLost && recovering == _publishedRecovering)
+        {
+            return info;
+        }
+
+        _publishedStateReads = info.reads;
+        _publishedStatesOp = info.slaves_op;
+        _publishedStatesLost = info.slaves_lost;
+        _publishedRecovering = recovering;
+        var published = new SoemSlaveState[count];
+        for (var i = 0; i < count; i++)
+        {
+            published[i] = SoemSlaveState.FromNative(i + 1, _slaveStates[i]);
+            if (i < _slaveLost.Length && published[i].IsLost != _slaveLost[i])
+            {
+                MarkSlaveLost(i, published[i].IsLost);
+            }
+        }
+
+        Volatile.Write(ref _publishedStates, published);
+        return info;
+    }
+
+    /// <summary>
+    /// Takes a lost axis out of status processing, failing its command (its inputs are stale from here on), or
+    /// puts it back once recovery found the slave again.
+    /// </summary>
+    private void MarkSlaveLost(int index, bool lost)
+    {
+        _slaveLost[index] = lost;
+        var slaveIndex = index + 1;
+        if (!lost)
+        {
+            // Status changes while the axis was skipped were consumed by the input scan; take the current one as is.
+            _previousTxPdos[index] = _txPdos[index] = _cycleTx[index];
+            _outputDirty[index] = true;
+            _logger.LogInformation("Slave {Slave} is back; resuming status processing.", slaveIndex);
+            return;
+        }
+
+        _logger.LogWarning("Slave {Slave} lost; excluding it from command evaluation until it returns.", slaveIndex);
+        var error = new DriveError(DriveErrorCode.SlaveLost, $"Slave {slaveIndex} stopped answering on the bus.", "Check the cable and power of this axis; it rejoins automatically.");
+        if (_activeCommands[index] is { } command)
+        {
+            command.Fail(error);
+            _activeCommands[index] = null;
+        }
+
+        RaiseFault(slaveIndex, _txPdos[index], error, _status.LastHealth);
+    }
+
+    /// <summary>
+    /// Ends recovery once the shim reports every slave back in OP. Only a bus with no slave in OP after
+    /// <see cref="EthercatDriveOptions.RecoveryTimeoutMilliseconds"/> falls back to reinitializing the session.
+    /// </summary>
+    private void CheckRecovery(in SoemShim.SoemStateInfo info)
+    {
+        if (info.recovering == 0)
+        {
+            _recovering = false;
+            _wkcStrikes = 0;
+            _logger.LogInformation("Slave recovery complete: {Op} slaves in OP.", info.slaves_op);
+            return;
+        }
+
+        if (info.slaves_op == 0 && Stopwatch.GetElapsedTime(_recoveryStarted).TotalMilliseconds > _options.RecoveryTimeoutMilliseconds)
+        {
+            _logger.LogError("No slave back in OP after {Timeout} ms of recovery. Reinitializing EtherCAT session.", _options.RecoveryTimeoutMilliseconds);
+            _recovering = false;
+            Reinitialize();
+            _wkcStrikes = 0;
+        }
+    }
+
+    /// <summary>
+    /// Rebuilds <see cref="_changedAxes"/> for paths that decoded every status themselves.
+    /// </summary>
+    private void FlagChangedAxes()
+    {
+        Array.Clear(_changedAxes);
+        for (var i = 0; i < _cycleTx.Length; i++)
+        {
+            if (_cycleTx[i] != _previousTxPdos[i])
+            {
+                _changedAxes[i >> 5] |= 1u << (i & 31);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Evaluates the statuses the current cycle left in <see cref="_cycleTx"/>. Idle axes whose bit in
+    /// <see cref="_changedAxes"/> is clear are skipped outright.
+    /// </summary>
+    private void ProcessStatuses(SoemHealthSnapshot health, int wkc)
+    {
+        if (_options.EnableCycleTraceLogging)
+        {
+            _logger.LogTrace(
+                "ProcessStatuses: rxPdos={RxPdos}, txPdos={TxPdos}, activeCommands={ActiveCommands}, axisLocks={AxisLocks}, stopLatch={StopLatch}",
+                _rxPdos.Length, _txPdos.Length, _activeCommands.Length, _axisLocks.Length, _stopLatch.Length);
+        }
+
+        if (health.LastWkc < health.GroupExpectedWkc)
+        {
+            HandleFaultyCycle(health, wkc, "Work counter below expected");
+        }
+        else
+        {
+            _wkcStrikes = 0;
+        }
+
+        try
+        {
+            for (var i = 0; i < _txPdos.Length; i++)
+            {
                 var command = _activeCommands[i];
+                if (_slaveLost[i] || (command is null && (_changedAxes[i >> 5] & (1u << (i & 31))) == 0))
+                {
+                    continue;
+                }
+
+                var slaveIndex = i + 1;
+                var tx = _cycleTx[i];
+
+                // Detect changes
+                var previous = _previousTxPdos[i];
+                var changedMask = tx.Mask ^ previous.Mask;
+                var positionChanged = tx.ActualPosition != previous.ActualPosition;
+
+                // Update stored state
+                _previousTxPdos[i] = tx;
+                _txPdos[i] = tx;
+                
                 // Raise status change event if anything changed during command execution
                 if ((changedMask != 0 || positionChanged) && (command != null))
                 {
@@ -662,7 +1762,7 @@ public sealed class EthercatDriveService : IEthercatDriveService
                     continue;
                 }
 
-                if (!command.Acked && tx.ExecuteAck != 0)
+                if (!command.Acked && tx.ExecuteAck)
                 {
                     command.MarkAcked();
                     _logger.LogDebug("[{Timestamp:HH:mm:ss.fff}] Command {Command}={Param} acknowledged for slave {Slave}.", 
@@ -679,9 +1779,11 @@ public sealed class EthercatDriveService : IEthercatDriveService
                     _lastFaultTimes[i] = DateTimeOffset.MinValue;
                 }
 
-                if (health.AlStatusCode != 0)
+                // This slave's own AL status: another slave in error must not fail healthy axes.
+                var alStatus = _slaveStates[i].al_status_code;
+                if (alStatus != 0)
                 {
-                    var alError = new DriveError(DriveErrorCode.UnknownFault, $"AL status code {health.AlStatusCode}", "Inspect EtherCAT network and recover.");
+                    var alError = new DriveError(DriveErrorCode.UnknownFault, $"AL status code {alStatus}", "Inspect EtherCAT network and recover.");
                     command.Fail(alError);
                     RaiseFault(slaveIndex, tx, alError, health);
                     _activeCommands[i] = null;
@@ -715,26 +1817,28 @@ public sealed class EthercatDriveService : IEthercatDriveService
     // helper to classify recovery/control commands
     private void HandleFaultyCycle(SoemHealthSnapshot health, int wkc, string reason)
     {
+        if (_recovering)
+        {
+            return; // the degraded WKC is expected until the shim reports every slave back
+        }
+
         _wkcStrikes++;
         _logger.LogWarning("{Reason}: wkc={Wkc} expected={Expected} op={Op} strikes={Strikes}",
             reason, health.LastWkc, health.GroupExpectedWkc, health.SlavesOperational, _wkcStrikes);
 
         if (_wkcStrikes >= _options.WkcRecoveryThreshold)
         {
-            _logger.LogError("WKC below expected for {Strikes} cycles. Attempting recovery.", _wkcStrikes);
-
-            var recoveryResult = _soem.TryRecover(_handle, _options.RecoveryTimeoutMilliseconds);
-            if (recoveryResult > 0)
+            // Per-slave recovery runs one bounded step per cycle beside the exchange, so healthy axes keep
+            // cycling and the native engine keeps the bus.
+            _logger.LogError("WKC below expected for {Strikes} cycles. Recovering slaves without stopping the cycle.", _wkcStrikes);
+            if (_soem.StartRecovery(_handle))
             {
-                // Recovery succeeded - give slaves time to settle
-                Thread.Sleep(20); // 20ms post-recovery settling time
-
-                _logger.LogInformation("Recovery successful, resetting strike counter.");
-                _wkcStrikes = 0;
+                _recovering = true;
+                _recoveryStarted = Stopwatch.GetTimestamp();
             }
             else
             {
-                _logger.LogError("SOEM recovery failed. Reinitializing EtherCAT session.");
+                _logger.LogError("SOEM recovery unavailable. Reinitializing EtherCAT session.");
                 Reinitialize();
                 _wkcStrikes = 0;
             }
@@ -748,8 +1852,13 @@ public sealed class EthercatDriveService : IEthercatDriveService
         }
 
         Array.Clear(_activeCommands, 0, _activeCommands.Length);
+        Array.Clear(_slaveLost);
+        _recovering = false;
+        CancelSdoTransfers(); // their tickets die with the handle
         if (_handle != IntPtr.Zero)
         {
+            StopNativeEngine();
+            _image = null;
             _soem.Shutdown(_handle);
             _handle = IntPtr.Zero;
         }
@@ -764,7 +1873,8 @@ public sealed class EthercatDriveService : IEthercatDriveService
             Thread.Sleep(_options.ReinitializationDelay);
         }
 
-        _handle = _soem.Initialize(_interface);
+        var started = Stopwatch.GetTimestamp();
+        _handle = OpenBus(_interface);
         if (_handle == IntPtr.Zero)
         {
             _logger.LogCritical("Failed to reinitialize SOEM after recovery attempt.");
@@ -778,92 +1888,147 @@ public sealed class EthercatDriveService : IEthercatDriveService
             _slaveCount = count;
             AllocateBuffers(_slaveCount);
         }
-    }
 
-    private void DrainErrorSink()
-    {
-        var errors = _soem.DrainErrorList(_handle, _errorBuffer);
-        if (!string.IsNullOrWhiteSpace(errors))
+        MapProcessImage();
+        MarkOutputsDirty();
+        _healthBaseline = ReadHealth();
+        InspectDistributedClock();
+        InspectNicBackend();
+        InspectCapture();
+        _errorPending = true;
+
+        StartNativeEngine();
+        var report = InspectBoot(started);
+        lock (_bootGate)
         {
-            _logger.LogError("SOEM: {Errors}", errors);
+            _lastRecovery = report;
         }
     }
 
-    private void PublishSnapshot(SoemHealthSnapshot health, TimeSpan cycleDuration, TimeSpan minCycle, TimeSpan maxCycle)
+    private void DrainErrorSink(SoemHealthSnapshot health)
     {
-        var drives = ArrayPool<SoemShim.DriveTxPDO>.Shared.Rent(_txPdos.Length);
-        try
+        if (!_soem.HasErrors(_handle))
         {
-            Array.Copy(_txPdos, drives, _txPdos.Length);
-            _snapshot = new SoemStatusSnapshot(DateTimeOffset.UtcNow, health, drives[.._txPdos.Length].ToArray(), cycleDuration, minCycle, maxCycle);
+            return;
         }
-        finally
+
+        int count;
+        do
         {
-            ArrayPool<SoemShim.DriveTxPDO>.Shared.Return(drives);
+            count = _soem.PopErrors(_handle, _errorRecords);
+            for (var i = 0; i < count; i++)
+            {
+                ref readonly var record = ref _errorRecords[i];
+                var error = DecodeSoemError(record);
+                if (record.slave >= 1 && record.slave <= _slaveCount)
+                {
+                    RaiseFault(record.slave, ReadDriveStatus(record.slave - 1), error, health);
+                }
+                else
+                {
+                    _logger.LogError("SOEM master error: {Error}", error);
+                }
+            }
         }
+        while (count == _errorRecords.Length);
     }
 
-    private static bool TryDecodeError(SoemShim.DriveTxPDO status, out DriveError error)
+    private static DriveError DecodeSoemError(in SoemShim.SoemErrorRecord record) => record.type switch
+    {
+        SoemShim.SOEM_ERRT_EMERGENCY => new DriveError(DriveErrorCode.Emergency,
+            $"CoE emergency 0x{record.error_code:X4} (error register 0x{record.error_reg:X2}, data {record.emergency_b1:X2} {record.emergency_w1:X4} {record.emergency_w2:X4}).",
+            "Clear the cause reported by the drive, then issue RSET."),
+        SoemShim.SOEM_ERRT_SDO or SoemShim.SOEM_ERRT_SDOINFO => new DriveError(DriveErrorCode.SdoAbort,
+            $"SDO abort 0x{record.abort_code:X8} on 0x{record.index:X4}:{record.subindex:X2}.",
+            "Check the object index, its access rights and the slave state."),
+        SoemShim.SOEM_ERRT_MBX or SoemShim.SOEM_ERRT_PACKET => new DriveError(DriveErrorCode.MailboxError,
+            $"Mailbox error 0x{record.error_code:X4} (type {record.type}).",
+            "Check the slave's mailbox configuration; recover the slave if it persists."),
+        _ => new DriveError(DriveErrorCode.UnknownFault,
+            $"SOEM error type {record.type}, code 0x{record.abort_code:X8} on 0x{record.index:X4}:{record.subindex:X2}.",
+            "Inspect EtherCAT network and recover.")
+    };
+
+    private void PublishSnapshot(SoemHealthSnapshot health, TimeSpan cycleDuration, TimeSpan minCycle, TimeSpan maxCycle, TimeSpan roundTrip, TimeSpan hostTime)
+        => _status.Publish(_txPdos, health, cycleDuration, minCycle, maxCycle, roundTrip, hostTime);
+
+    private DriveStatusWord ReadDriveStatus(int axis)
+        => _status.TryReadDrive(axis, out var status) ? status.Word : default;
+
+    // Bits that can produce a DriveError; a status with none of them set is decoded with one AND.
+    private const DriveStatusFlags FaultFlags = DriveStatusFlags.ThermalProtection1 | DriveStatusFlags.ThermalProtection2
+        | DriveStatusFlags.EncoderError | DriveStatusFlags.ErrorLimit | DriveStatusFlags.SafetyTimeout
+        | DriveStatusFlags.EmergencyStop | DriveStatusFlags.PositionFail | DriveStatusFlags.EndStop;
+
+    private static readonly DriveError NoError = new(DriveErrorCode.None, string.Empty, string.Empty);
+
+    private static bool TryDecodeError(DriveStatusWord status, out DriveError error)
     {
-        if (status.ThermalProtection1 != 0)
+        if (!status.HasAny(FaultFlags))
+        {
+            error = NoError;
+            return false;
+        }
+
+        if (status.ThermalProtection1)
         {
             error = new DriveError(DriveErrorCode.ThermalProtection, "Thermal overload of the piezo amplifier 1.", "Allow drive to cool; issue ENBL=1 or RSET.");
             return true;
         }
 
-        if (status.ThermalProtection2 != 0)
+        if (status.ThermalProtection2)
         {
             error = new DriveError(DriveErrorCode.ThermalProtection, "Thermal overload of the piezo amplifier 2.", "Allow drive to cool; issue ENBL=1 or RSET.");
             return true;
         }
 
-        if (status.EncoderError != 0)
+        if (status.EncoderError)
         {
             error = new DriveError(DriveErrorCode.EncoderError, "Encoder read error.", "Avoid touching the encoder strip. Check encoder wiring; perform RSET then INDX.");
             return true;
         }
 
-        if (status.ErrorLimit != 0)
+        if (status.ErrorLimit)
         {
             error = new DriveError(DriveErrorCode.FollowError, "Following error has reached the limit set by ELIM. This can indicate a collision, or the motor not strong enough to produce the acceleration and speed required by the trajectory.", "Reduce speed/acceleration; issue ENBL=1 to clear. Increase ELIM or disable by setting ELIM=0");
             return true;
         }
 
-        if (status.SafetyTimeout != 0)
+        if (status.SafetyTimeout)
         {
             error = new DriveError(DriveErrorCode.SafetyTimeout, "Motor was on for a time longer that the value set by TOU2", "Perform RSET or ENBL=1. Issue STOP or HALT to avoid. TOU2=0 disables this timeout. ");
             return true;
         }
 
-        if (status.EmergencyStop != 0)
+        if (status.EmergencyStop)
         {
             error = new DriveError(DriveErrorCode.EmergencyStop, "The STOP command was issued." , "Set ENBL=1 or RSET. Use HALT to avoid this error.");
             return true;
         }
 
-        if (status.PositionFail != 0)
+        if (status.PositionFail)
         {
             error = new DriveError(DriveErrorCode.PositionFail, "The actuator did not settle at the target position within the specified time (TOU3).", "Increase TOU3, PTOL or PTO2. Issue ENBL=1 or RSET");
             return true;
         }
            
-        if (status.EndStop != 0 & status.LeftEndStop != 0)
+        if (status.Has(DriveStatusFlags.EndStop | DriveStatusFlags.LeftEndStop))
         {
             error = new DriveError(DriveErrorCode.EndStopHit, "Left End-stop detected.", "Jog away from the left limit.");
             return true;
         }
         
-        if (status.EndStop != 0 & status.RightEndStop != 0 )
+        if (status.Has(DriveStatusFlags.EndStop | DriveStatusFlags.RightEndStop))
         {
             error = new DriveError(DriveErrorCode.EndStopHit, "Right End-stop detected.", "Jog away from the right limit.");
             return true;
         }  
 
-        error = new DriveError(DriveErrorCode.None, string.Empty, string.Empty);
+        error = NoError;
         return false;
     }
 
-    private void RaiseFault(int slave, SoemShim.DriveTxPDO status, DriveError error, SoemHealthSnapshot health)
+    private void RaiseFault(int slave, DriveStatusWord status, DriveError error, SoemHealthSnapshot health)
     {
         try
         {
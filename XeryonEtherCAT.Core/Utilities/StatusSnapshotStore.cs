@@ -0,0 +1,127 @@
+using System;
+using System.Threading;
+using XeryonEtherCAT.Core.Models;
+
+namespace XeryonEtherCAT.Core.Utilities;
+
+/// <summary>
+/// Preallocated, double-buffered status snapshot guarded by a per-slot sequence lock. The IO loop is the only
+/// writer and publishes without allocating; any number of readers copy out a consistent view without locking.
+/// </summary>
+/// <remarks>
+/// The writer always fills the back slot and then swaps it to the front, so a reader normally copies a slot
+/// nobody is writing. It only retries when it is still holding a slot two publications later, which the
+/// version check detects (odd while being written, changed after).
+/// </remarks>
+internal sealed class StatusSnapshotStore
+{
+    private sealed class Slot
+    {
+        public long Version;
+        public long Sequence;
+        public DateTimeOffset Timestamp;
+        public SoemHealthSnapshot Health;
+        public TimeSpan CycleTime;
+        public TimeSpan MinCycleTime;
+        public TimeSpan MaxCycleTime;
+        public TimeSpan RoundTripTime;
+        public TimeSpan HostTime;
+        public int Count;
+        public DriveStatus[] Drives = Array.Empty<DriveStatus>();
+    }
+
+    private volatile Slot _front = new();
+    private Slot _back = new();
+    private long _sequence;
+
+    /// <summary>
+    /// Health of the last publication. Writer thread only.
+    /// </summary>
+    public SoemHealthSnapshot LastHealth => _front.Health;
+
+    /// <summary>
+    /// Publishes one cycle. Allocates only when <paramref name="drives"/> is longer than any previous publication.
+    /// Must only be called from a single writer thread.
+    /// </summary>
+    public void Publish(ReadOnlySpan<DriveStatusWord> drives, SoemHealthSnapshot health, TimeSpan cycleTime, TimeSpan minCycle, TimeSpan maxCycle, TimeSpan roundTrip = default, TimeSpan hostTime = default)
+    {
+        var slot = _back;
+        Interlocked.Increment(ref slot.Version); // odd: readers of this slot retry from here on
+
+        if (slot.Drives.Length < drives.Length)
+        {
+            slot.Drives = new DriveStatus[drives.Length];
+        }
+
+        for (var i = 0; i < drives.Length; i++)
+        {
+            slot.Drives[i] = new DriveStatus(drives[i]);
+        }
+
+        slot.Count = drives.Length;
+        slot.Sequence = ++_sequence;
+        slot.Timestamp = DateTimeOffset.UtcNow;
+        slot.Health = health;
+        slot.CycleTime = cycleTime;
+        slot.MinCycleTime = minCycle;
+        slot.MaxCycleTime = maxCycle;
+        slot.RoundTripTime = roundTrip;
+        slot.HostTime = hostTime;
+
+        Volatile.Write(ref slot.Version, slot.Version + 1);
+        _back = _front;
+        _front = slot;
+    }
+
+    /// <summary>
+    /// Copies the latest drive statuses into <paramref name="destination"/> (as many as fit) and returns the
+    /// matching header. <see cref="SoemStatusHeader.DriveCount"/> tells the caller whether the span was too short.
+    /// </summary>
+    public SoemStatusHeader Read(Span<DriveStatus> destination)
+        => Read(0, destination);
+
+    /// <summary>
+    /// Reads one drive's status from the latest snapshot. Returns <c>false</c> when the snapshot has no such drive.
+    /// </summary>
+    public bool TryReadDrive(int index, out DriveStatus status)
+    {
+        status = default;
+        if (index < 0)
+        {
+            return false;
+        }
+
+        var header = Read(index, new Span<DriveStatus>(ref status));
+        return index < header.DriveCount;
+    }
+
+    private SoemStatusHeader Read(int start, Span<DriveStatus> destination)
+    {
+        var spinner = new SpinWait();
+        while (true)
+        {
+            var slot = _front;
+            var version = Volatile.Read(ref slot.Version);
+            if ((version & 1) == 0)
+            {
+                var drives = slot.Drives;
+                var count = slot.Count;
+                var available = Math.Min(count, drives.Length) - start;
+                if (available > 0)
+                {
+                    drives.AsSpan(start, Math.Min(available, destination.Length)).CopyTo(destination);
+                }
+
+                var header = new SoemStatusHeader(slot.Sequence, slot.Timestamp, slot.Health, count, slot.CycleTime, slot.MinCycleTime, slot.MaxCycleTime, slot.RoundTripTime, slot.HostTime);
+
+                Interlocked.MemoryBarrier();
+                if (Volatile.Read(ref slot.Version) == version)
+                {
+                    return header;
+                }
+            }
+
+            spinner.SpinOnce(sleep1Threshold: -1);
+        }
+    }
+}
@@ -229,31 +229,31 @@ internal sealed class EthercatGrpcService : EthercatControl.EthercatControlBase
         Sequence = change.Sequence > 0 ? (ulong)change.Sequence : 0
     };
 
-    private static DriveStatusSnapshot MapStatus(SoemShim.DriveTxPDO status) => new()
+    private static DriveStatusSnapshot MapStatus(DriveStatusWord status) => new()
     {
         ActualPosition = status.ActualPosition,
-        AmplifiersEnabled = status.AmplifiersEnabled != 0,
-        EndStop = status.EndStop != 0,
-        ThermalProtection1 = status.ThermalProtection1 != 0,
-        ThermalProtection2 = status.ThermalProtection2 != 0,
-        ForceZero = status.ForceZero != 0,
-        MotorOn = status.MotorOn != 0,
-        ClosedLoop = status.ClosedLoop != 0,
-        EncoderIndex = status.EncoderIndex != 0,
-        EncoderValid = status.EncoderValid != 0,
-        SearchingIndex = status.SearchingIndex != 0,
-        PositionReached = status.PositionReached != 0,
-        ErrorCompensation = status.ErrorCompensation != 0,
-        EncoderError = status.EncoderError != 0,
-        Scanning = status.Scanning != 0,
-        LeftEndStop = status.LeftEndStop != 0,
-        RightEndStop = status.RightEndStop != 0,
-        ErrorLimit = status.ErrorLimit != 0,
-        SearchingOptimalFrequency = status.SearchingOptimalFrequency != 0,
-        SafetyTimeout = status.SafetyTimeout != 0,
-        ExecuteAck = status.ExecuteAck != 0,
-        EmergencyStop = status.EmergencyStop != 0,
-        PositionFail = status.PositionFail != 0,
+        AmplifiersEnabled = status.AmplifiersEnabled,
+        EndStop = status.EndStop,
+        ThermalProtection1 = status.ThermalProtection1,
+        ThermalProtection2 = status.ThermalProtection2,
+        ForceZero = status.ForceZero,
+        MotorOn = status.MotorOn,
+        ClosedLoop = status.ClosedLoop,
+        EncoderIndex = status.EncoderIndex,
+        EncoderValid = status.EncoderValid,
+        SearchingIndex = status.SearchingIndex,
+        PositionReached = status.PositionReached,
+        ErrorCompensation = status.ErrorCompensation,
+        EncoderError = status.EncoderError,
+        Scanning = status.Scanning,
+        LeftEndStop = status.LeftEndStop,
+        RightEndStop = status.RightEndStop,
+        ErrorLimit = status.ErrorLimit,
+        SearchingOptimalFrequency = status.SearchingOptimalFrequency,
+        SafetyTimeout = status.SafetyTimeout,
+        ExecuteAck = status.ExecuteAck,
+        EmergencyStop = status.EmergencyStop,
+        PositionFail = status.PositionFail,
         Slot = status.Slot
     };
 }
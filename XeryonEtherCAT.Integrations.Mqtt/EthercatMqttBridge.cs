@@ -334,6 +334,10 @@ public sealed class EthercatMqttBridge : IAsyncDisposable
         return int.TryParse(segments[rootSegments.Length + 1], out slave);
     }
 
+    // Expanded to one field per flag so the JSON keeps its 0/1 shape.
+    private static object ToDto(in DriveStatusWord status)
+        => ToDto(status.ToPdo());
+
     private static object ToDto(in SoemShim.DriveTxPDO status)
         => new
         {
@@ -0,0 +1,360 @@
+/* SOEM_NIC_RING against SOEM's socket path on a veth pair. A responder thread on the peer end plays a line of
+   slaves: it answers every EtherCAT frame with the working counter a full bus would give and fresh input bytes.
+   The socket mode drives the same frames the way SOEM's Linux nicdrv does (a raw packet socket with 1 us
+   send/receive timeouts, one send() per frame and a recv() loop until the frame is back); the ring mode runs
+   soem_ring.c on a handle whose group 0 is laid out like the shim's Xeryon image (20 output and 8 input bytes
+   per slave). Both cycle at a fixed period and report round trip percentiles and thread CPU time per cycle.
+   The ring then runs twice more with the wire capture (soem_cap.c) on: once alone, once with another thread
+   exporting the capture to pcapng every 100 ms, to show what the copy costs the cycle and that an export does not
+   hold it up. Last, the capture is exported once more and the file read back block by block: every enhanced
+   packet block must carry matching leading and trailing lengths, a padded frame, a caplen equal to its length, an
+   epb_flags direction and a timestamp that does not go backwards, and both directions must be there.
+
+   Needs CAP_NET_RAW and a veth pair:
+     ip link add ecat0 type veth peer name ecat1 && ip link set ecat0 up && ip link set ecat1 up
+     ./soem_ring_bench ecat0 ecat1 [slaves=16] [cycles=10000] [period_us=500] */
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include "soem_shim.h"
+#include "soem_shim_internal.h"
+
+#define BENCH_SOCKET_TIMEOUT_US 2000
+#define BENCH_MAX_FRAMES 16
+
+static volatile int g_run = 1;
+static volatile int g_exporting;
+static int g_slaves;
+
+static int64_t bench_now(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int bench_socket(const char* ifname, int soem_timeouts)
+{
+    int fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ECAT));
+    if (fd < 0) return -1;
+    if (soem_timeouts) {
+        // As in SOEM's ecx_setupnic.
+        struct timeval tv = { 0, 1 };
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_DONTROUTE, &one, sizeof(one));
+    }
+    struct sockaddr_ll addr = { 0 };
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ECAT);
+    addr.sll_ifindex = (int)if_nametoindex(ifname);
+    if (!addr.sll_ifindex || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+    return fd;
+}
+
+/* The slaves: every datagram gets the WKC of g_slaves Xeryon drives, input bytes get a counter. */
+static void* bench_responder(void* arg)
+{
+    int fd = *(int*)arg;
+    uint8_t frame[2048];
+    uint8_t tick = 0;
+    while (g_run) {
+        ssize_t n = recv(fd, frame, sizeof(frame), 0);
+        if (n < 16 + 12) continue;
+        int at = 16;
+        for (;;) {
+            uint8_t cmd = frame[at];
+            uint16_t len;
+            memcpy(&len, frame + at + 6, 2);
+            int more = (len & EC_DATAGRAMFOLLOWS) != 0;
+            len &= 0x07FF;
+            if (at + 10 + len + 2 > n) break;
+            uint16_t wkc = cmd == EC_CMD_LRW ? (uint16_t)(3 * g_slaves) : cmd == EC_CMD_FRMW ? 1 : (uint16_t)g_slaves;
+            if (cmd == EC_CMD_LRW || cmd == EC_CMD_LRD) memset(frame + at + 10 + len / 2, ++tick, len - len / 2);
+            memcpy(frame + at + 10 + len, &wkc, 2);
+            at += 10 + len + 2;
+            if (!more) break;
+        }
+        frame[6] |= 0x02;  // the first slave marks the source MAC, as on the wire
+        send(fd, frame, (size_t)n, 0);
+    }
+    return NULL;
+}
+
+/* Exports the capture every 100 ms while g_exporting is set. */
+static void* bench_exporter(void* arg)
+{
+    soem_handle_t* h = (soem_handle_t*)arg;
+    int exports = 0, frames = 0;
+    while (g_exporting) {
+        struct timespec ts = { 0, 100 * 1000000L };
+        nanosleep(&ts, NULL);
+        int n = soem_capture_export(h, "/tmp/soem_ring_bench.pcapng");
+        if (n > 0) {
+            ++exports;
+            frames += n;
+        }
+    }
+    printf("exporter: %d pcapng file(s), %d frames on average\n", exports, exports ? frames / exports : 0);
+    return NULL;
+}
+
+static uint32_t bench_u32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/* Reads an exported pcapng back: SHB and IDB, then nothing but enhanced packet blocks laid out as pcapng_packet
+   writes them. Returns the number of packet blocks, or -1 with the reason on stderr. */
+static int bench_check_pcapng(const char* path, int* out, int* in)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    static uint8_t file[64u << 20];
+    size_t size = fread(file, 1, sizeof(file), f);
+    fclose(f);
+    *out = *in = 0;
+    if (size < 60 || bench_u32(file) != 0x0A0D0D0A || bench_u32(file + 28) != 1 || bench_u32(file + 32) != 32) {
+        fprintf(stderr, "pcapng: bad section or interface header\n");
+        return -1;
+    }
+    int64_t last = 0;
+    int packets = 0;
+    for (size_t at = 60; at < size; ++packets) {
+        const uint8_t* b = file + at;
+        uint32_t total = at + 12 <= size ? bench_u32(b + 4) : 0;
+        if (total < 44 || at + total > size || bench_u32(b) != 6 || bench_u32(b + total - 4) != total) {
+            fprintf(stderr, "pcapng: block %d at %zu is not a whole enhanced packet block\n", packets, at);
+            return -1;
+        }
+        uint32_t caplen = bench_u32(b + 20), len = bench_u32(b + 24), padded = (caplen + 3u) & ~3u;
+        if (bench_u32(b + 8) != 0 || caplen != len || caplen < 14 || total != 28 + padded + 16) {
+            fprintf(stderr, "pcapng: block %d has caplen %u, length %u in a %u byte block\n", packets, caplen, len, total);
+            return -1;
+        }
+        for (uint32_t pad = caplen; pad < padded; ++pad)
+            if (b[28 + pad]) {
+                fprintf(stderr, "pcapng: block %d has non-zero padding\n", packets);
+                return -1;
+            }
+        const uint8_t* opt = b + 28 + padded;
+        uint32_t dir = bench_u32(opt + 4);
+        if (opt[0] != 2 || opt[1] != 0 || opt[2] != 4 || opt[3] != 0 || (dir != 1 && dir != 2) || bench_u32(opt + 8)) {
+            fprintf(stderr, "pcapng: block %d has no epb_flags direction\n", packets);
+            return -1;
+        }
+        // Outgoing frames carry the master's source MAC; the first slave sets bit 1 on the way back.
+        if ((dir == 2) != !(b[28 + 6] & 0x02)) {
+            fprintf(stderr, "pcapng: block %d is flagged %s but its source MAC says otherwise\n", packets,
+                dir == 2 ? "outbound" : "inbound");
+            return -1;
+        }
+        int64_t ts = (int64_t)((uint64_t)bench_u32(b + 12) << 32 | bench_u32(b + 16));
+        if (ts <= 0 || ts < last) {
+            fprintf(stderr, "pcapng: block %d stamped %lld after %lld\n", packets, (long long)ts, (long long)last);
+            return -1;
+        }
+        last = ts;
+        ++*(dir == 2 ? out : in);
+        at += total;
+    }
+    if (!*out || !*in) {
+        fprintf(stderr, "pcapng: %d outbound and %d inbound frames\n", *out, *in);
+        return -1;
+    }
+    return packets;
+}
+
+/* One cycle the way SOEM's nicdrv puts it on the wire: a send() per frame, then a recv() loop per frame. */
+static int bench_socket_cycle(int fd, uint8_t frames[][EC_BUFSIZE], const int* lengths, int count, uint8_t* rx)
+{
+    for (int f = 0; f < count; ++f)
+        if (send(fd, frames[f], (size_t)lengths[f], 0) < 0) return -1;
+    int64_t deadline = bench_now(CLOCK_MONOTONIC) + BENCH_SOCKET_TIMEOUT_US * 1000LL;
+    for (int got = 0; got < count;) {
+        ssize_t n = recv(fd, rx, EC_BUFSIZE, 0);
+        if (n > 0) ++got;
+        else if (bench_now(CLOCK_MONOTONIC) > deadline) return -1;
+    }
+    return 1;
+}
+
+static int cmp64(const void* a, const void* b)
+{
+    int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+static void bench_report(const char* mode, int frames, int64_t* rtt, int cycles, int lost, int64_t cpu_ns)
+{
+    qsort(rtt, (size_t)cycles, sizeof(*rtt), cmp64);
+    printf("%-8s | %6d | %8.1f | %8.1f | %8.1f | %8.1f | %5d\n", mode, frames, rtt[cycles / 2] / 1000.0,
+        rtt[cycles * 99 / 100] / 1000.0, rtt[cycles - 1] / 1000.0, (double)cpu_ns / cycles / 1000.0, lost);
+}
+
+static void bench_sleep_until(int64_t* deadline, int period_us)
+{
+    *deadline += period_us * 1000LL;
+    struct timespec ts = { (time_t)(*deadline / 1000000000LL), (long)(*deadline % 1000000000LL) };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <ifname> <peer-ifname> [slaves=16] [cycles=10000] [period_us=500]\n", argv[0]);
+        return 2;
+    }
+    const char* ifname = argv[1];
+    g_slaves = argc > 3 ? atoi(argv[3]) : 16;
+    int cycles = argc > 4 ? atoi(argv[4]) : 10000;
+    int period_us = argc > 5 ? atoi(argv[5]) : 500;
+
+    int peer = bench_socket(argv[2], 0);
+    int soem = bench_socket(ifname, 1);
+    if (peer < 0 || soem < 0) {
+        fprintf(stderr, "packet sockets on %s/%s failed (errno=%d); run as root on a veth pair\n", ifname, argv[2], errno);
+        return 1;
+    }
+    pthread_t responder;
+    pthread_create(&responder, NULL, bench_responder, &peer);
+
+    // Group 0 as ecx_config_map_group lays it out for the drives: outputs, then inputs, segmented by frame.
+    soem_handle_t* h = (soem_handle_t*)calloc(1, sizeof(*h));
+    ec_groupt* grp = &h->context.grouplist[0];
+    grp->Obytes = (uint32)(20 * g_slaves);
+    grp->Ibytes = (uint32)(8 * g_slaves);
+    grp->outputsWKC = (uint16)g_slaves;
+    grp->inputsWKC = (uint16)g_slaves;
+    grp->logstartaddr = 0x10000;
+    h->IOmap = (uint8*)calloc(1, grp->Obytes + grp->Ibytes);
+    grp->outputs = h->IOmap;
+    grp->inputs = h->IOmap + grp->Obytes;
+    for (uint32 left = grp->Obytes + grp->Ibytes; left; ) {
+        uint32 seg = left < EC_MAXLRWDATA ? left : EC_MAXLRWDATA;
+        grp->IOsegment[grp->nsegments++] = seg;
+        left -= seg;
+    }
+    h->context.port.sockhandle = soem;
+
+    int64_t* rtt = (int64_t*)calloc((size_t)cycles, sizeof(int64_t));
+    printf("%d slaves (%u+%u bytes), %d cycles every %d us\n", g_slaves, grp->Obytes, grp->Ibytes, cycles, period_us);
+    printf("%-8s | %6s | %8s | %8s | %8s | %8s | %5s\n", "mode", "frames", "p50 us", "p99 us", "max us", "cpu us", "lost");
+
+    // SOEM's socket path, with the LRW frames the ring would build.
+    static uint8_t frames[BENCH_MAX_FRAMES][EC_BUFSIZE];
+    int lengths[BENCH_MAX_FRAMES], count = 0;
+    for (uint32 pos = 0, s = 0; s < grp->nsegments && count < BENCH_MAX_FRAMES; pos += grp->IOsegment[s++], ++count) {
+        uint8_t* f = frames[count];
+        uint16 len = (uint16)grp->IOsegment[s];
+        memset(f, 0xFF, 6);
+        memcpy(f + 6, priMAC, 6);
+        f[12] = 0x88; f[13] = 0xA4;
+        uint16 ecat = (uint16)((10 + len + 2) | (1 << 12));
+        memcpy(f + 14, &ecat, 2);
+        f[16] = EC_CMD_LRW;
+        f[17] = (uint8_t)count;
+        uint32 logical = grp->logstartaddr + pos;
+        memcpy(f + 18, &logical, 4);
+        memcpy(f + 22, &len, 2);
+        lengths[count] = 16 + 10 + len + 2 < 60 ? 60 : 16 + 10 + len + 2;
+    }
+    uint8_t rx[EC_BUFSIZE];
+    int lost = 0;
+    int64_t deadline = bench_now(CLOCK_MONOTONIC);
+    int64_t cpu = bench_now(CLOCK_THREAD_CPUTIME_ID);
+    for (int i = 0; i < cycles; ++i) {
+        bench_sleep_until(&deadline, period_us);
+        int64_t t0 = bench_now(CLOCK_MONOTONIC);
+        if (bench_socket_cycle(soem, frames, lengths, count, rx) < 0) ++lost;
+        rtt[i] = bench_now(CLOCK_MONOTONIC) - t0;
+    }
+    bench_report("socket", count, rtt, cycles, lost, bench_now(CLOCK_THREAD_CPUTIME_ID) - cpu);
+
+    // The shim's ring.
+    if (soem_ring_open(h, ifname, 0) <= 0) {
+        fprintf(stderr, "soem_ring_open failed on %s\n", ifname);
+        return 1;
+    }
+    // Ring alone, ring with the capture, ring with the capture while another thread exports it.
+    static const char* const modes[] = { "ring", "ring+cap", "+export" };
+    pthread_t exporter;
+    for (int mode = 0; mode < 3; ++mode) {
+        if (mode == 1) {
+            soem_init_options_t opts = { 0 };
+            opts.capture_bytes = 16u << 20;
+            opts.capture_dir = "/tmp";
+            if (!soem_cap_open(h, &opts)) {
+                fprintf(stderr, "soem_cap_open failed in /tmp\n");
+                break;
+            }
+        }
+        if (mode == 2) {
+            // An ordinary thread, as the service's caller would be, even when the bench runs under chrt.
+            pthread_attr_t attr;
+            struct sched_param normal = { 0 };
+            pthread_attr_init(&attr);
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+            pthread_attr_setschedparam(&attr, &normal);
+            g_exporting = 1;
+            pthread_create(&exporter, &attr, bench_exporter, h);
+            pthread_attr_destroy(&attr);
+        }
+        lost = 0;
+        deadline = bench_now(CLOCK_MONOTONIC);
+        cpu = bench_now(CLOCK_THREAD_CPUTIME_ID);
+        for (int i = 0; i < cycles; ++i) {
+            bench_sleep_until(&deadline, period_us);
+            int64_t t0 = bench_now(CLOCK_MONOTONIC);
+            int expected = 0;
+            int wkc = soem_ring_send(h, &expected) > 0 ? soem_ring_receive(h, BENCH_SOCKET_TIMEOUT_US) : EC_NOFRAME;
+            soem_cap_received(h, wkc, expected);
+            if (wkc < expected) ++lost;
+            rtt[i] = bench_now(CLOCK_MONOTONIC) - t0;
+        }
+        bench_report(modes[mode], count, rtt, cycles, lost, bench_now(CLOCK_THREAD_CPUTIME_ID) - cpu);
+        if (mode == 2) {
+            g_exporting = 0;
+            pthread_join(exporter, NULL);
+        }
+    }
+
+    soem_nic_stats_t stats;
+    soem_get_nic_stats(h, &stats);
+    printf("ring: %llu frames out, %llu back, %llu dropped, %llu busy, %llu send() calls\n",
+        (unsigned long long)stats.tx_frames, (unsigned long long)stats.rx_frames, (unsigned long long)stats.rx_dropped,
+        (unsigned long long)stats.tx_busy, (unsigned long long)stats.kicks);
+    soem_capture_stats_t cap;
+    soem_capture_get_stats(h, &cap);
+    printf("capture: %llu frames, %llu bytes, %llu overwritten, %llu export(s)\n", (unsigned long long)cap.frames,
+        (unsigned long long)cap.bytes, (unsigned long long)cap.overwritten, (unsigned long long)cap.exports);
+
+    int out = 0, in = 0, packets = soem_capture_export(h, "/tmp/soem_ring_bench.pcapng") > 0
+        ? bench_check_pcapng("/tmp/soem_ring_bench.pcapng", &out, &in) : -1;
+    if (packets > 0) printf("pcapng: %d packet blocks checked, %d out, %d in\n", packets, out, in);
+
+    g_run = 0;
+    soem_cap_release(h);
+    soem_ring_release(h);
+    return packets > 0 ? 0 : 1;
+}
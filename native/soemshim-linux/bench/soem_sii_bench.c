@@ -0,0 +1,233 @@
+/* The SII traffic of a discovery, with and without soem_sii.c's cache, against xeryon_vslave on a veth pair.
+   SOEM itself is not linked: the bench replays the datagrams and EEPROM busy polls that ecx_config_init (SOEM 2.0)
+   and soem_sii_config_init put on the wire up to the PRE-OP request, with SOEM's 200 us poll interval as a real
+   sleep, so the Windows-only SOEM build of the lab is no obstacle. Four replays per run:
+     no cache  identity rounds, mailbox words, and a category walk of slave 1 (identical drives: SOEM reuses it);
+     cache     identity rounds and the check word; mailbox words and categories come from the image;
+   and the same two with every slave walked as its own type ("mixed"), as on a line of different terminals.
+   A cold cache costs a no-cache run plus the check-word round, and is left out of the table.
+
+   Needs CAP_NET_RAW and the virtual line on the peer end, busy for 250 us per SII read:
+     ip link add ecat0 type veth peer name ecat1 && ip link set ecat0 up && ip link set ecat1 up
+     xeryon_vslave -n 32 -e 250 ecat1 &
+     ./soem_sii_bench ecat0 32 [runs=5]
+   and prints one row of the README's table: the median of the runs for each replay, in ms. */
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include "soem/soem.h"
+
+#define SII_BENCH_POLL_US 200   // EC_LOCALDELAY between EEPROM busy polls
+#define SII_BENCH_MAX_RUNS 32
+#define SII_CHECK_WORD ECT_SII_START  // first category header, soem_sii.c's check word
+
+static int g_fd;
+static uint8_t g_idx;
+static int g_frames;
+
+static int64_t bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* One datagram in its own frame, as SOEM's blocking ecx_*RD/WR do; waits for the reply with the same index.
+   Returns the WKC, or -1 on timeout, with the reply data in data. */
+static int bench_datagram(uint8_t cmd, uint16_t adp, uint16_t ado, void* data, uint16_t len)
+{
+    uint8_t frame[128] = { 0 };
+    memset(frame, 0xFF, 6);
+    memset(frame + 6, 0x01, 6);
+    frame[12] = 0x88;
+    frame[13] = 0xA4;
+    uint16_t ecat = (uint16_t)((10 + len + 2) | (1 << 12));
+    memcpy(frame + 14, &ecat, 2);
+    frame[16] = cmd;
+    frame[17] = ++g_idx;
+    memcpy(frame + 18, &adp, 2);
+    memcpy(frame + 20, &ado, 2);
+    memcpy(frame + 22, &len, 2);
+    memcpy(frame + 26, data, len);
+    size_t size = 16 + 10 + len + 2;
+    if (send(g_fd, frame, size < 60 ? 60 : size, 0) < 0) return -1;
+    ++g_frames;
+    uint8_t rx[1514];
+    for (;;) {
+        ssize_t n = recv(g_fd, rx, sizeof(rx), 0);
+        if (n < 0) return -1;
+        // Our own frame comes by on the way out; the reply has the first slave's bit in the source MAC.
+        if (n >= 28 + len && (rx[6] & 0x02) && rx[17] == g_idx) break;
+    }
+    memcpy(data, rx + 26, len);
+    uint16_t wkc;
+    memcpy(&wkc, rx + 26 + len, 2);
+    return wkc;
+}
+
+static uint16_t bench_ap(int slave) { return (uint16_t)(1 - slave); }
+static uint16_t bench_fp(int slave) { return (uint16_t)(0x1000 + slave); }
+
+/* ecx_eeprom_waitnotbusyAP/FP: read the EEPROM control word until it is not busy, sleeping between polls. */
+static void bench_notbusy(uint8_t cmd, uint16_t adp)
+{
+    for (int n = 0;; ++n) {
+        if (n) usleep(SII_BENCH_POLL_US);
+        uint16_t ctl = 0;
+        if (bench_datagram(cmd, adp, ECT_REG_EEPCTL, &ctl, 2) < 0 || !(ctl & 0x8000)) return;
+    }
+}
+
+/* ecx_readeeprom1 to every slave, then ecx_readeeprom2 from each: one word of all slaves in parallel. */
+static void bench_round(int slaves, uint16_t word)
+{
+    for (int i = 1; i <= slaves; ++i) {
+        bench_notbusy(EC_CMD_APRD, bench_ap(i));
+        uint16_t req[3] = { 0x0100, word, 0 };
+        bench_datagram(EC_CMD_APWR, bench_ap(i), ECT_REG_EEPCTL, req, sizeof(req));
+    }
+    for (int i = 1; i <= slaves; ++i) {
+        bench_notbusy(EC_CMD_APRD, bench_ap(i));
+        uint32_t value = 0;
+        bench_datagram(EC_CMD_APRD, bench_ap(i), ECT_REG_EEPDAT, &value, sizeof(value));
+    }
+}
+
+/* ecx_readeepromFP: eight bytes from one slave. */
+static void bench_read8(int slave, uint16_t word, uint8_t out[8])
+{
+    bench_notbusy(EC_CMD_FPRD, bench_fp(slave));
+    uint16_t req[3] = { 0x0100, word, 0 };
+    bench_datagram(EC_CMD_FPWR, bench_fp(slave), ECT_REG_EEPCTL, req, sizeof(req));
+    bench_notbusy(EC_CMD_FPRD, bench_fp(slave));
+    memset(out, 0, 8);
+    bench_datagram(EC_CMD_FPRD, bench_fp(slave), ECT_REG_EEPDAT, out, 8);
+}
+
+/* The category walk ecx_siifind and SOEM's parsers do through esibuf: every eight-byte block once. */
+static int bench_walk(int slave)
+{
+    int blocks = 0;
+    uint8_t b[8];
+    for (uint16_t at = SII_CHECK_WORD;;) {
+        bench_read8(slave, at, b);
+        ++blocks;
+        uint16_t type, words;
+        memcpy(&type, b, 2);
+        memcpy(&words, b + 2, 2);
+        if (type == 0xFFFF) break;
+        for (uint16_t k = (uint16_t)(at + 4); k < at + 2 + words; k = (uint16_t)(k + 4)) {
+            bench_read8(slave, k, b);
+            ++blocks;
+        }
+        at = (uint16_t)(at + 2 + words);
+    }
+    return blocks;
+}
+
+/* One discovery up to the PRE-OP request. Returns its time in ms, or -1 when the line did not answer. */
+static double bench_discovery(int slaves, int cached, int types)
+{
+    int64_t t0 = bench_now();
+    uint16_t zero = 0;
+    if (bench_datagram(EC_CMD_BRD, 0, ECT_REG_TYPE, &zero, 2) != slaves) return -1;
+    bench_datagram(EC_CMD_BWR, 0, ECT_REG_EEPCFG, &zero, 2);
+    for (int i = 1; i <= slaves; ++i) {
+        uint16_t v = 0, station = bench_fp(i);
+        bench_datagram(EC_CMD_APRD, bench_ap(i), ECT_REG_PDICTL, &v, 2);
+        bench_datagram(EC_CMD_APWR, bench_ap(i), ECT_REG_STADR, &station, 2);
+        v = 0;
+        bench_datagram(EC_CMD_APWR, bench_ap(i), ECT_REG_DLCTL, &v, 2);
+        bench_datagram(EC_CMD_APRD, bench_ap(i), ECT_REG_STADR, &v, 2);
+        bench_datagram(EC_CMD_FPRD, station, ECT_REG_ALIAS, &v, 2);
+        bench_datagram(EC_CMD_FPRD, station, ECT_REG_EEPSTAT, &v, 2);
+    }
+    static const uint16_t identity[] = { ECT_SII_MANUF, ECT_SII_ID, ECT_SII_REV, ECT_SII_SER };
+    for (size_t w = 0; w < sizeof(identity) / sizeof(identity[0]); ++w) bench_round(slaves, identity[w]);
+    if (cached) {
+        bench_round(slaves, SII_CHECK_WORD);
+    } else {
+        bench_round(slaves, ECT_SII_RXMBXADR);
+        for (int i = 1; i <= types; ++i) bench_walk(i);
+    }
+    for (int i = 1; i <= slaves; ++i) {
+        uint16_t station = bench_fp(i), v = 0;
+        bench_datagram(EC_CMD_FPRD, station, ECT_REG_ESCSUP, &v, 2);
+        bench_datagram(EC_CMD_FPRD, station, ECT_REG_DLSTAT, &v, 2);
+        bench_datagram(EC_CMD_FPRD, station, ECT_REG_PORTDES, &v, 2);
+        bench_datagram(EC_CMD_FPRD, station, ECT_REG_ALSTAT, &v, 2);
+        v = 1;
+        bench_datagram(EC_CMD_FPWR, station, ECT_REG_EEPCFG, &v, 2);
+        v = EC_STATE_PRE_OP | EC_STATE_ACK;
+        bench_datagram(EC_CMD_FPWR, station, ECT_REG_ALCTL, &v, 2);
+    }
+    return (bench_now() - t0) / 1e6;
+}
+
+static int cmpd(const void* a, const void* b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <ifname> <slaves> [runs=5]\n", argv[0]);
+        return 2;
+    }
+    int slaves = atoi(argv[2]);
+    int runs = argc > 3 ? atoi(argv[3]) : 5;
+    if (slaves < 1 || runs < 1 || runs > SII_BENCH_MAX_RUNS) {
+        fprintf(stderr, "slaves must be positive and runs 1..%d\n", SII_BENCH_MAX_RUNS);
+        return 2;
+    }
+
+    g_fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ECAT));
+    struct sockaddr_ll addr = { 0 };
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ECAT);
+    addr.sll_ifindex = (int)if_nametoindex(argv[1]);
+    struct timeval tv = { 0, 500000 };
+    if (g_fd < 0 || !addr.sll_ifindex || bind(g_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0
+        || setsockopt(g_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
+        fprintf(stderr, "packet socket on %s failed (errno=%d); run as root on a veth pair\n", argv[1], errno);
+        return 1;
+    }
+
+    // Identical drives walk slave 1 only; mixed walks every slave.
+    static const struct { int cached, mixed; } replays[] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 1, 1 } };
+    double median[4];
+    int frames[4];
+    for (int r = 0; r < 4; ++r) {
+        double ms[SII_BENCH_MAX_RUNS];
+        g_frames = 0;
+        for (int run = 0; run < runs; ++run) {
+            ms[run] = bench_discovery(slaves, replays[r].cached, replays[r].mixed ? slaves : 1);
+            if (ms[run] < 0) {
+                fprintf(stderr, "no answer from %d slave(s) on %s; is xeryon_vslave -n %d running on the peer?\n",
+                    slaves, argv[1], slaves);
+                return 1;
+            }
+        }
+        qsort(ms, (size_t)runs, sizeof(ms[0]), cmpd);
+        median[r] = ms[runs / 2];
+        frames[r] = g_frames / runs;
+    }
+
+    printf("| Slaves | Identical: no cache | Identical: cache | Mixed: no cache | Mixed: cache |\n");
+    printf("|-------:|--------------------:|-----------------:|----------------:|-------------:|\n");
+    printf("| %-6d | %-19.0f | %-16.0f | %-15.0f | %-12.0f |\n", slaves, median[0], median[1], median[2], median[3]);
+    printf("frames per discovery: %d, %d, %d, %d\n", frames[0], frames[1], frames[2], frames[3]);
+    close(g_fd);
+    return 0;
+}
@@ -0,0 +1,516 @@
+/* Wire capture of the cyclic frames (capture_bytes > 0). Every process-data frame the shim sends and every reply
+   it takes back is copied, with a CLOCK_MONOTONIC stamp, into a ring in a memory-mapped file (by default in
+   /dev/shm). The cycle path does nothing but that memcpy: the ring is preallocated and touched at open, and there
+   is no lock, no syscall and no allocation per frame. Turning the ring into a pcapng file happens elsewhere:
+   soem_capture_export on the caller's thread, or a background thread after a WKC drop (SOEM_CAPTURE_ON_FAULT).
+
+   Records are variable length and never wrap: one that does not fit at the end of the area leaves a zero size
+   word and starts again at the front. head and tail count bytes ever written, so a record's place in the area is
+   its offset modulo the capacity. The single writer (the bus thread) moves tail past the records it is about to
+   overwrite before it writes; a reader copies [tail, head) out, then reads tail again and drops every record that
+   starts before it. That keeps exports consistent without ever making the bus thread wait.
+
+   The file outlives the process. A ring left behind by a process that died is renamed to <name>.prev at the
+   next open, and soem_capture_convert turns either into pcapng without a handle. Linux only. */
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "soem_shim.h"
+#include "soem_shim_internal.h"
+
+#define CAP_MAGIC          0x50414353u  // "SCAP"
+#define CAP_VERSION        1
+#define CAP_HEADER_BYTES   4096          // file header page; records follow
+#define CAP_MIN_BYTES      (64 * 1024)
+#define CAP_RECORD_HEADER  16
+#define CAP_ETH_HEADER     14
+#define CAP_DEFAULT_DIR    "/dev/shm"
+#define CAP_FAULT_AFTER_MS 100           // a fault export waits this long so the file shows the aftermath too
+#define CAP_FAULT_HOLD_MS  1000          // at least this long between fault exports (or the window, if longer)
+
+#define CAP_DIR_OUT 0
+#define CAP_DIR_IN  1
+
+/* The mapped file's first page. Everything after it is the record area. */
+typedef struct cap_file {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;            // bytes of record area
+    int64_t  realtime_offset_ns;  // CLOCK_REALTIME - CLOCK_MONOTONIC at open: record stamp + this = wall time
+    uint32_t bus_id;
+    uint32_t reserved;
+    _Atomic uint64_t head;        // bytes ever written
+    _Atomic uint64_t tail;        // start of the oldest intact record, same count
+    _Atomic uint64_t frames;
+    _Atomic uint64_t bytes;
+    _Atomic uint64_t overwritten;
+} cap_file_t;
+
+/* One frame in the area, 8-byte aligned. size 0 marks the unused end of the area before a wrap. */
+typedef struct cap_record {
+    uint32_t size;                // header + frame, rounded up to 8
+    uint16_t len;                 // frame bytes
+    uint8_t  dir;                 // CAP_DIR_*
+    uint8_t  reserved;
+    int64_t  ts_ns;               // CLOCK_MONOTONIC
+} cap_record_t;
+
+struct soem_cap {
+    cap_file_t* file;
+    uint8_t* area;
+    size_t map_size;
+    uint64_t capacity;
+    char path[256];
+    char dir[200];
+    uint32_t window_ms;
+    uint32_t flags;
+    uint32_t bus_id;
+
+    // socket-path frames of the cycle in flight (soem_cap_sent -> soem_cap_received)
+    int frames;
+    uint8 idx[EC_MAXBUF];
+    uint8 eth[CAP_ETH_HEADER];    // Ethernet header of the cycle's frames, for rebuilding the replies'
+
+    // fault trigger (bus thread) and the exporter thread
+    int armed;
+    int64_t last_fault_ns;
+    _Atomic int64_t fault_ns;     // non-zero: a fault export is wanted, for the fault at this time
+    _Atomic int run;
+    int thread_started;
+    pthread_t thread;
+    sem_t wake;
+
+    _Atomic uint64_t exports;
+    _Atomic uint64_t fault_exports;
+};
+
+static int64_t cap_now_ns(clockid_t clock)
+{
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static uint32_t cap_record_size(uint32_t len) { return (CAP_RECORD_HEADER + len + 7u) & ~7u; }
+
+/* ---- writer (bus thread) ---- */
+
+/* Moves tail past every record that ends before new_head - capacity, i.e. that the next write covers. */
+static void cap_reclaim(struct soem_cap* c, uint64_t new_head)
+{
+    cap_file_t* f = c->file;
+    uint64_t tail = atomic_load_explicit(&f->tail, memory_order_relaxed);
+    uint64_t dropped = 0;
+    while (tail + c->capacity < new_head) {
+        uint64_t at = tail % c->capacity;
+        uint32_t size;
+        memcpy(&size, c->area + at, sizeof(size));
+        if (size == 0) {
+            tail += c->capacity - at;  // wrap marker
+        } else {
+            tail += size;
+            ++dropped;
+        }
+    }
+    if (!dropped && tail == atomic_load_explicit(&f->tail, memory_order_relaxed)) return;
+    atomic_store_explicit(&f->tail, tail, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);  // the new tail is visible before the bytes it frees are reused
+    if (dropped) atomic_fetch_add_explicit(&f->overwritten, dropped, memory_order_relaxed);
+}
+
+/* Appends one frame: eth (CAP_ETH_HEADER bytes, or NULL when data already starts with it) followed by data. */
+static void cap_put(struct soem_cap* c, int dir, const uint8_t* eth, const uint8_t* data, uint32_t len, int64_t ts)
+{
+    cap_file_t* f = c->file;
+    uint32_t frame = len + (eth ? CAP_ETH_HEADER : 0);
+    uint32_t size = cap_record_size(frame);
+    uint64_t head = atomic_load_explicit(&f->head, memory_order_relaxed);
+    uint64_t at = head % c->capacity;
+
+    if (at + size > c->capacity) {
+        cap_reclaim(c, head + (c->capacity - at));
+        memset(c->area + at, 0, sizeof(uint32_t));
+        head += c->capacity - at;
+        at = 0;
+    }
+    cap_reclaim(c, head + size);
+
+    cap_record_t* r = (cap_record_t*)(c->area + at);
+    r->size = size;
+    r->len = (uint16_t)frame;
+    r->dir = (uint8_t)dir;
+    r->reserved = 0;
+    r->ts_ns = ts;
+    uint8_t* out = (uint8_t*)(r + 1);
+    if (eth) {
+        memcpy(out, eth, CAP_ETH_HEADER);
+        out += CAP_ETH_HEADER;
+    }
+    memcpy(out, data, len);
+
+    atomic_store_explicit(&f->head, head + size, memory_order_release);
+    atomic_store_explicit(&f->frames, atomic_load_explicit(&f->frames, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_store_explicit(&f->bytes, atomic_load_explicit(&f->bytes, memory_order_relaxed) + frame, memory_order_relaxed);
+}
+
+void soem_cap_frame(soem_handle_t* h, int outgoing, const uint8* frame, uint32_t len, int64_t ts)
+{
+    struct soem_cap* c = h->cap;
+    if (!c || len > EC_BUFSIZE) return;
+    cap_put(c, outgoing ? CAP_DIR_OUT : CAP_DIR_IN, NULL, frame, len, ts);
+}
+
+/* Socket path, right after the send: the frames SOEM just put on the wire are in its TX buffers, whole. Their
+   return stamps (rxsa) are cleared so soem_cap_received can tell which came back. */
+void soem_cap_sent(soem_handle_t* h)
+{
+    struct soem_cap* c = h->cap;
+    if (!c || h->ring) return;
+    ecx_portt* port = &h->context.port;
+    const ec_idxstackT* stack = &h->context.idxstack;
+    int64_t ts = cap_now_ns(CLOCK_MONOTONIC);
+    c->frames = stack->pushed < EC_MAXBUF ? stack->pushed : EC_MAXBUF;
+    for (int i = 0; i < c->frames; ++i) {
+        uint8 idx = stack->idx[i];
+        c->idx[i] = idx;
+        port->rxsa[idx] = 0;
+        int len = port->txbuflength[idx];
+        if (len <= CAP_ETH_HEADER || len > EC_BUFSIZE) continue;
+        if (i == 0) memcpy(c->eth, port->txbuf[idx], CAP_ETH_HEADER);
+        cap_put(c, CAP_DIR_OUT, NULL, port->txbuf[idx], (uint32_t)len, ts);
+    }
+}
+
+/* After the receive, on either path: the socket path's replies (SOEM keeps them without the Ethernet header,
+   which is rebuilt from the request and the source word SOEM saw), then the fault trigger. */
+void soem_cap_received(soem_handle_t* h, int wkc, int expected)
+{
+    struct soem_cap* c = h->cap;
+    if (!c) return;
+    int64_t now = cap_now_ns(CLOCK_MONOTONIC);
+
+    if (!h->ring) {
+        ecx_portt* port = &h->context.port;
+        uint8 eth[CAP_ETH_HEADER];
+        memcpy(eth, c->eth, sizeof(eth));
+        eth[6] |= 0x02;  // the first slave marks the source MAC as it sends the frame back
+        for (int i = 0; i < c->frames; ++i) {
+            uint8 idx = c->idx[i];
+            int len = port->txbuflength[idx] - CAP_ETH_HEADER;
+            if (!port->rxsa[idx] || len <= 0) continue;
+            uint16 sa1 = htons((uint16)port->rxsa[idx]);
+            memcpy(eth + 8, &sa1, sizeof(sa1));
+            cap_put(c, CAP_DIR_IN, eth, port->rxbuf[idx], (uint32_t)len, now);
+        }
+        c->frames = 0;
+    }
+
+    if (!(c->flags & SOEM_CAPTURE_ON_FAULT) || expected <= 0) return;
+    if (wkc >= expected) {
+        c->armed = 1;
+        return;
+    }
+    if (!c->armed) return;
+    c->armed = 0;
+    int64_t hold = (int64_t)(c->window_ms > CAP_FAULT_HOLD_MS ? c->window_ms : CAP_FAULT_HOLD_MS) * 1000000LL;
+    if (c->last_fault_ns && now - c->last_fault_ns < hold) return;
+    c->last_fault_ns = now;
+    atomic_store_explicit(&c->fault_ns, now, memory_order_release);
+    sem_post(&c->wake);
+}
+
+/* ---- readers ---- */
+
+static void put_u16(uint8_t* b, uint16_t v) { memcpy(b, &v, 2); }
+static void put_u32(uint8_t* b, uint32_t v) { memcpy(b, &v, 4); }
+
+/* Section header and one Ethernet interface with nanosecond timestamps. */
+static int pcapng_begin(FILE* out)
+{
+    uint8_t shb[28] = { 0 }, idb[32] = { 0 };
+    put_u32(shb, 0x0A0D0D0A);
+    put_u32(shb + 4, sizeof(shb));
+    put_u32(shb + 8, 0x1A2B3C4D);
+    put_u16(shb + 12, 1);
+    put_u16(shb + 14, 0);
+    memset(shb + 16, 0xFF, 8);  // section length unknown
+    put_u32(shb + 24, sizeof(shb));
+
+    put_u32(idb, 1);
+    put_u32(idb + 4, sizeof(idb));
+    put_u16(idb + 8, 1);        // LINKTYPE_ETHERNET
+    put_u32(idb + 12, 0);       // no snap length
+    put_u16(idb + 16, 9);       // if_tsresol: 10^-9
+    put_u16(idb + 18, 1);
+    idb[20] = 9;
+    put_u32(idb + 28, sizeof(idb));  // opt_endofopt at 24 stays zero
+    return fwrite(shb, sizeof(shb), 1, out) == 1 && fwrite(idb, sizeof(idb), 1, out) == 1;
+}
+
+/* An enhanced packet block with its direction in epb_flags. */
+static int pcapng_packet(FILE* out, const cap_record_t* r, int64_t realtime_offset_ns)
+{
+    static const uint8_t pad[4] = { 0 };
+    uint32_t padded = ((uint32_t)r->len + 3u) & ~3u;
+    uint32_t total = 28 + padded + 12 + 4;
+    uint64_t ts = (uint64_t)(r->ts_ns + realtime_offset_ns);
+    uint8_t head[28], tail[16] = { 0 };
+    put_u32(head, 6);
+    put_u32(head + 4, total);
+    put_u32(head + 8, 0);
+    put_u32(head + 12, (uint32_t)(ts >> 32));
+    put_u32(head + 16, (uint32_t)ts);
+    put_u32(head + 20, r->len);
+    put_u32(head + 24, r->len);
+    put_u16(tail, 2);           // epb_flags
+    put_u16(tail + 2, 4);
+    put_u32(tail + 4, r->dir == CAP_DIR_IN ? 1u : 2u);
+    put_u32(tail + 12, total);  // opt_endofopt at 8 stays zero
+    return fwrite(head, sizeof(head), 1, out) == 1
+        && fwrite(r + 1, r->len, 1, out) == 1
+        && (padded == r->len || fwrite(pad, padded - r->len, 1, out) == 1)
+        && fwrite(tail, sizeof(tail), 1, out) == 1;
+}
+
+/* Copies the ring out (without stopping the writer), keeps the records that were intact for the whole copy and
+   newer than window_ms before the newest, and writes them to path. Returns the frames written, SOEM_ERR_IO when
+   the copy buffer or the file failed. */
+static int cap_export(const cap_file_t* f, const uint8_t* area, uint32_t window_ms, const char* path)
+{
+    uint64_t capacity = f->capacity;
+    uint64_t tail = atomic_load_explicit(&f->tail, memory_order_acquire);
+    uint64_t head = atomic_load_explicit(&f->head, memory_order_acquire);
+    if (head - tail > capacity) tail = head - capacity;
+    uint64_t span = head - tail;
+
+    uint8_t* copy = (uint8_t*)malloc(span ? (size_t)span : 1);
+    if (!copy) return SOEM_ERR_IO;
+    uint64_t at = tail % capacity;
+    uint64_t first = capacity - at < span ? capacity - at : span;
+    memcpy(copy, area + at, (size_t)first);
+    memcpy(copy + first, area, (size_t)(span - first));
+    atomic_thread_fence(memory_order_acquire);
+    // Records before the tail as it is now were overwritten while we copied; the tail is always a record start.
+    uint64_t start = atomic_load_explicit(&f->tail, memory_order_relaxed);
+    if (start < tail) start = tail;
+
+    // Find the newest stamp first, for the window.
+    int64_t newest = 0;
+    for (uint64_t pos = start; pos < head;) {
+        const cap_record_t* r = (const cap_record_t*)(copy + (pos - tail));
+        uint64_t in_area = pos % capacity;
+        if (r->size == 0 || r->size > capacity - in_area) { pos += capacity - in_area; continue; }
+        if (r->ts_ns > newest) newest = r->ts_ns;
+        pos += r->size;
+    }
+    int64_t cutoff = window_ms ? newest - (int64_t)window_ms * 1000000LL : INT64_MIN;
+
+    FILE* out = fopen(path, "wb");
+    if (!out) {
+        free(copy);
+        return SOEM_ERR_IO;
+    }
+    int written = 0, ok = pcapng_begin(out);
+    for (uint64_t pos = start; ok && pos < head;) {
+        const cap_record_t* r = (const cap_record_t*)(copy + (pos - tail));
+        uint64_t in_area = pos % capacity;
+        if (r->size == 0 || r->size > capacity - in_area) { pos += capacity - in_area; continue; }
+        if (r->ts_ns >= cutoff && r->len <= r->size - CAP_RECORD_HEADER) {
+            ok = pcapng_packet(out, r, f->realtime_offset_ns);
+            ++written;
+        }
+        pos += r->size;
+    }
+    ok = fclose(out) == 0 && ok;
+    free(copy);
+    return ok ? written : SOEM_ERR_IO;
+}
+
+static void cap_fault_path(const struct soem_cap* c, int64_t fault_ns, char* path, size_t size)
+{
+    int64_t wall = fault_ns + c->file->realtime_offset_ns;
+    time_t secs = (time_t)(wall / 1000000000LL);
+    struct tm tm;
+    gmtime_r(&secs, &tm);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &tm);
+    snprintf(path, size, "%s/soemshim-bus%u-%s.%03dZ.pcapng", c->dir, c->bus_id, stamp, (int)(wall / 1000000 % 1000));
+}
+
+/* Waits for the bus thread's fault signal, lets the aftermath land, then writes the file. */
+static void* cap_thread(void* arg)
+{
+    struct soem_cap* c = (struct soem_cap*)arg;
+    soem_log_bind(c->bus_id);
+    for (;;) {
+        while (sem_wait(&c->wake) != 0 && errno == EINTR) { }
+        if (!atomic_load_explicit(&c->run, memory_order_acquire)) break;
+        int64_t fault = atomic_exchange_explicit(&c->fault_ns, 0, memory_order_acq_rel);
+        if (!fault) continue;
+
+        struct timespec after = { 0, CAP_FAULT_AFTER_MS * 1000000L };
+        while (nanosleep(&after, &after) != 0 && errno == EINTR) { }
+        char path[512];
+        cap_fault_path(c, fault, path, sizeof(path));
+        int n = cap_export(c->file, c->area, c->window_ms, path);
+        if (n >= 0) {
+            atomic_fetch_add_explicit(&c->exports, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&c->fault_exports, 1, memory_order_relaxed);
+            LOGW("capture: WKC dropped; %d frame(s) written to %s", n, path);
+        } else {
+            LOGE("capture: WKC dropped but %s could not be written (errno=%d)", path, errno);
+        }
+    }
+    return NULL;
+}
+
+/* ---- lifetime ---- */
+
+int soem_cap_open(soem_handle_t* h, const soem_init_options_t* opts)
+{
+    if (!opts->capture_bytes) return 0;
+    struct soem_cap* c = (struct soem_cap*)calloc(1, sizeof(*c));
+    if (!c) return 0;
+
+    const char* dir = opts->capture_dir && *opts->capture_dir ? opts->capture_dir : CAP_DEFAULT_DIR;
+    snprintf(c->dir, sizeof(c->dir), "%s", dir);
+    snprintf(c->path, sizeof(c->path), "%s/soemshim-bus%u.cap", c->dir, h->bus_id);
+    c->capacity = opts->capture_bytes < CAP_MIN_BYTES ? CAP_MIN_BYTES : ((uint64_t)opts->capture_bytes + 7) & ~7ull;
+    c->window_ms = opts->capture_window_ms;
+    c->flags = opts->capture_flags;
+    c->bus_id = h->bus_id;
+    c->armed = 1;
+    c->map_size = CAP_HEADER_BYTES + (size_t)c->capacity;
+
+    // A ring a dead process left behind is evidence; keep one generation of it.
+    char prev[sizeof(c->path) + 8];
+    snprintf(prev, sizeof(prev), "%s.prev", c->path);
+    rename(c->path, prev);
+
+    const char* step = "open";
+    void* map = MAP_FAILED;
+    int fd = open(c->path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) goto fail;
+    step = "ftruncate";
+    if (ftruncate(fd, (off_t)c->map_size) < 0) goto fail;
+    step = "mmap";
+    map = mmap(NULL, c->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+    if (map == MAP_FAILED) goto fail;
+    close(fd);
+    fd = -1;
+
+    // Touch every page now so the bus thread never takes a fault on them; lock them when the limits allow.
+    memset(map, 0, c->map_size);
+    mlock(map, c->map_size);
+
+    c->file = (cap_file_t*)map;
+    c->area = (uint8_t*)map + CAP_HEADER_BYTES;
+    c->file->version = CAP_VERSION;
+    c->file->capacity = c->capacity;
+    c->file->realtime_offset_ns = cap_now_ns(CLOCK_REALTIME) - cap_now_ns(CLOCK_MONOTONIC);
+    c->file->bus_id = h->bus_id;
+    atomic_thread_fence(memory_order_release);
+    c->file->magic = CAP_MAGIC;
+
+    if (c->flags & SOEM_CAPTURE_ON_FAULT) {
+        step = "exporter thread";
+        atomic_store(&c->run, 1);
+        if (sem_init(&c->wake, 0, 0) != 0) goto fail_mapped;
+        if (pthread_create(&c->thread, NULL, cap_thread, c) != 0) {
+            sem_destroy(&c->wake);
+            goto fail_mapped;
+        }
+        c->thread_started = 1;
+    }
+
+    h->cap = c;
+    LOGI("capture: %llu-byte ring in %s, window %u ms%s", (unsigned long long)c->capacity, c->path, c->window_ms,
+        (c->flags & SOEM_CAPTURE_ON_FAULT) ? ", pcapng into the same directory on a WKC drop" : "");
+    return 1;
+
+fail_mapped:
+    munmap(map, c->map_size);
+    unlink(c->path);
+fail:
+    LOGW("capture: %s failed for %s (errno=%d); capture stays off", step, c->path, errno);
+    if (fd >= 0) {
+        close(fd);
+        unlink(c->path);
+    }
+    free(c);
+    return 0;
+}
+
+void soem_cap_release(soem_handle_t* h)
+{
+    if (!h || !h->cap) return;
+    struct soem_cap* c = h->cap;
+    h->cap = NULL;
+    if (c->thread_started) {
+        atomic_store_explicit(&c->run, 0, memory_order_release);
+        sem_post(&c->wake);
+        pthread_join(c->thread, NULL);
+        sem_destroy(&c->wake);
+    }
+    // A clean shutdown leaves nothing to investigate; export first to keep the frames.
+    munmap(c->file, c->map_size);
+    unlink(c->path);
+    free(c);
+}
+
+SOEMSHIM_EXPORT int soem_capture_export(soem_handle_t* h, const char* path)
+{
+    if (!h || !path || !*path) return SOEM_ERR_BAD_ARGS;
+    struct soem_cap* c = h->cap;
+    if (!c) return SOEM_ERR_UNSUPPORTED;
+    int n = cap_export(c->file, c->area, c->window_ms, path);
+    if (n >= 0) atomic_fetch_add_explicit(&c->exports, 1, memory_order_relaxed);
+    return n;
+}
+
+SOEMSHIM_EXPORT int soem_capture_convert(const char* ring_path, const char* path, uint32_t window_ms)
+{
+    if (!ring_path || !path || !*path) return SOEM_ERR_BAD_ARGS;
+    int fd = open(ring_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return SOEM_ERR_IO;
+    struct stat st;
+    void* map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > CAP_HEADER_BYTES)
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return SOEM_ERR_IO;
+
+    const cap_file_t* f = (const cap_file_t*)map;
+    int n = SOEM_ERR_BAD_ARGS;  // not a capture ring, or one cut short
+    if (f->magic == CAP_MAGIC && f->version == CAP_VERSION && f->capacity <= (uint64_t)st.st_size - CAP_HEADER_BYTES)
+        n = cap_export(f, (const uint8_t*)map + CAP_HEADER_BYTES, window_ms, path);
+    munmap(map, (size_t)st.st_size);
+    return n;
+}
+
+SOEMSHIM_EXPORT int soem_capture_get_stats(soem_handle_t* h, soem_capture_stats_t* out)
+{
+    if (!h || !out) return 0;
+    memset(out, 0, sizeof(*out));
+    struct soem_cap* c = h->cap;
+    if (!c) return 1;
+    out->enabled = 1;
+    out->window_ms = c->window_ms;
+    out->ring_bytes = c->capacity;
+    out->frames = atomic_load_explicit(&c->file->frames, memory_order_relaxed);
+    out->bytes = atomic_load_explicit(&c->file->bytes, memory_order_relaxed);
+    out->overwritten = atomic_load_explicit(&c->file->overwritten, memory_order_relaxed);
+    out->exports = atomic_load_explicit(&c->exports, memory_order_relaxed);
+    out->fault_exports = atomic_load_explicit(&c->fault_exports, memory_order_relaxed);
+    return 1;
+}
@@ -0,0 +1,249 @@
+/* Process-data groups. Slaves are assigned to groups before mapping; every group gets its own IOmap region (and
+   SOEM its own logical address window), so a cycle only frames the groups that are due. soem_group_send puts the
+   due groups on the wire back to back and remembers which frames belong to which group; one receive then
+   collects them all, and soem_group_note reads each frame's working counter from its receive buffer to grade the
+   groups separately. A transport that frames the groups itself (the Linux ring) takes the schedule from
+   soem_group_next and hands its counts over with soem_group_take_wkc. Shared verbatim by the Windows and Linux
+   shims. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define GROUP_FENCE() _ReadWriteBarrier()
+#else
+#define GROUP_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define GROUP_LIMIT (SOEM_MAX_GROUPS < EC_MAXGROUP ? SOEM_MAX_GROUPS : EC_MAXGROUP)
+
+typedef struct soem_group_state {
+    int count;                     // configured groups, >= 1
+    uint32_t divider[SOEM_MAX_GROUPS];
+    uint64_t tick;                 // cycles sent
+    uint32_t due;                  // bit g: group g is in the cycle on the wire
+    int frames;                    // frames of that cycle
+    uint8 frame_idx[EC_MAXBUF];
+    uint8 frame_group[EC_MAXBUF];
+    uint16 frame_wkc_at[EC_MAXBUF]; // offset of the frame's working counter in its receive buffer
+    uint8 frame_lwr[EC_MAXBUF];     // LWR frames count double, as in ecx_receive_processdata_group
+    int taken;                     // taken_wkc holds this cycle's counts (soem_group_take_wkc)
+    int taken_wkc[SOEM_MAX_GROUPS];
+    volatile uint32_t seq;         // odd while the bus thread rewrites status
+    soem_group_status_t status[SOEM_MAX_GROUPS];
+} soem_group_state_t;
+
+void log_message(soem_log_level_t lvl, const char* fmt, ...);  // soem_log.c
+
+/* After ecx_config_init, before mapping: tag every slave with its group. Returns the group count, 0 on
+   allocation failure (the caller then maps everything into group 0 as before). */
+int soem_group_assign(soem_handle_t* h, const soem_init_options_t* opts)
+{
+    soem_group_state_t* g = (soem_group_state_t*)calloc(1, sizeof(*g));
+    if (!g) return 0;
+
+    ecx_contextt* ctx = &h->context;
+    int count = opts->group_count > 1 ? (int)opts->group_count : 1;
+    if (count > GROUP_LIMIT) {
+        log_message(SOEM_LOG_WARN, "group_count=%d exceeds the limit (%d, EC_MAXGROUP=%d); extra groups fold into group 0",
+            count, GROUP_LIMIT, EC_MAXGROUP);
+        count = GROUP_LIMIT;
+    }
+    g->count = count;
+    for (int i = 0; i < count; ++i) {
+        g->divider[i] = opts->group_divider[i] > 1 ? opts->group_divider[i] : 1;
+        g->status[i].group = i;
+        g->status[i].divider = (int32_t)g->divider[i];
+        g->status[i].last_wkc = -1;
+    }
+
+    for (int i = 1; i <= ctx->slavecount; ++i) {
+        int grp = (opts->slave_group && i - 1 < opts->slave_group_count) ? opts->slave_group[i - 1] : 0;
+        if (grp >= count) grp = 0;
+        ctx->slavelist[i].group = (uint8)grp;
+        g->status[grp].slave_count++;
+    }
+
+    h->groups = g;
+    return count;
+}
+
+/* Map every group into consecutive regions of iomap. Returns the total size, or the failing group's rc.
+   soem_group_mapped fills in the status once the image has moved to its final place. */
+int soem_group_map(soem_handle_t* h, uint8* iomap, size_t capacity)
+{
+    soem_group_state_t* g = h->groups;
+    ecx_contextt* ctx = &h->context;
+    if (!g || g->count == 1) return ecx_config_map_group(ctx, iomap, 0);
+
+    size_t used = 0;
+    for (int i = 0; i < g->count; ++i) {
+        if (!g->status[i].slave_count) continue;
+        int size = ecx_config_map_group(ctx, iomap + used, (uint8)i);
+        if (size <= 0) {
+            log_message(SOEM_LOG_ERR, "ecx_config_map_group failed for group %d: rc=%d", i, size);
+            return size;
+        }
+        used += (size_t)size;
+        if (used > capacity) return (int)used;  // caller reports the overflow
+    }
+    return (int)used;
+}
+
+/* Once the groups are mapped (by soem_group_map or restored by soem_boot_restore), fill in their status. */
+void soem_group_mapped(soem_handle_t* h)
+{
+    soem_group_state_t* g = h->groups;
+    if (!g) return;
+    for (int i = 0; i < g->count; ++i) {
+        if (g->count > 1 && !g->status[i].slave_count) continue;
+        ec_groupt* grp = &h->context.grouplist[i];
+        g->status[i].expected_wkc = (int32_t)(grp->outputsWKC * 2 + grp->inputsWKC);
+        g->status[i].bytes_out = (int32_t)grp->Obytes;
+        g->status[i].bytes_in = (int32_t)grp->Ibytes;
+        if (g->count > 1)
+            log_message(SOEM_LOG_INFO, "Group %d: %d slave(s), every %u cycle(s), Obytes=%u Ibytes=%u expected WKC=%d",
+                i, g->status[i].slave_count, g->divider[i], grp->Obytes, grp->Ibytes, g->status[i].expected_wkc);
+    }
+}
+
+void soem_group_release(soem_handle_t* h)
+{
+    if (!h || !h->groups) return;
+    free(h->groups);
+    h->groups = NULL;
+}
+
+/* Advances the schedule by one cycle and returns the groups due on it, bit g for group g (just bit 0 for a single
+   group). Group g is due when (tick + g) % divider[g] == 0, so two slow groups with the same divider land on
+   different cycles. */
+uint32_t soem_group_next(soem_handle_t* h)
+{
+    soem_group_state_t* g = h->groups;
+    if (!g || g->count == 1) return 1;
+
+    uint64_t tick = g->tick++;
+    uint32_t due = 0;
+    for (int i = 0; i < g->count; ++i)
+        if (g->status[i].slave_count && (tick + (uint64_t)i) % g->divider[i] == 0) due |= 1u << i;
+    g->due = due;
+    g->frames = 0;
+    g->taken = 0;
+    return due;
+}
+
+/* Sends the groups due on this cycle (soem_group_next). *expected receives the cycle's expected WKC. Returns what
+   ecx_send_processdata_group returned for the last group sent, negative on the first failure. */
+int soem_group_send(soem_handle_t* h, int* expected)
+{
+    soem_group_state_t* g = h->groups;
+    ecx_contextt* ctx = &h->context;
+    if (!g || g->count == 1) {
+        ec_groupt* grp = &ctx->grouplist[0];
+        *expected = (int)(grp->outputsWKC * 2 + grp->inputsWKC);
+        return ecx_send_processdata(ctx);
+    }
+
+    ecx_portt* port = &ctx->port;
+    uint32_t due = soem_group_next(h);
+    int rc = 0;
+    *expected = 0;
+    for (int i = 0; i < g->count; ++i) {
+        if (!(due & (1u << i))) continue;
+
+        int first = ctx->idxstack.pushed;
+        rc = ecx_send_processdata_group(ctx, (uint8)i);
+        if (rc < 0) return rc;
+        *expected += g->status[i].expected_wkc;
+
+        for (int pos = first; pos < ctx->idxstack.pushed && g->frames < EC_MAXBUF; ++pos) {
+            uint8 idx = ctx->idxstack.idx[pos];
+            uint16 at = (uint16)(EC_HEADERSIZE + ctx->idxstack.length[pos]);
+            int f = g->frames++;
+            g->frame_idx[f] = idx;
+            g->frame_group[f] = (uint8)i;
+            g->frame_wkc_at[f] = at;
+            g->frame_lwr[f] = ctx->idxstack.type[pos] == EC_CMD_LWR;
+            // A frame that never comes back must read as WKC 0, not as last cycle's count.
+            memset(&port->rxbuf[idx][at], 0, EC_WKCSIZE);
+        }
+    }
+    return rc;
+}
+
+/* Between the receive and soem_group_note: per-group counts read by a transport that framed the groups itself,
+   group_wkc[g] for every group soem_group_next returned as due. */
+void soem_group_take_wkc(soem_handle_t* h, const int* group_wkc)
+{
+    soem_group_state_t* g = h->groups;
+    if (!g) return;
+    memcpy(g->taken_wkc, group_wkc, sizeof(g->taken_wkc));
+    g->taken = 1;
+}
+
+/* After the receive: per-group WKC from the frames' receive buffers (or soem_group_take_wkc), published under the
+   sequence lock. Runs on the bus thread and never blocks. */
+void soem_group_note(soem_handle_t* h, int wkc, int64_t now_ns)
+{
+    soem_group_state_t* g = h->groups;
+    if (!g) return;
+    ecx_contextt* ctx = &h->context;
+
+    int group_wkc[SOEM_MAX_GROUPS] = { 0 };
+    if (g->count == 1) {
+        g->due = 1;
+        group_wkc[0] = wkc;
+    } else if (g->taken) {
+        memcpy(group_wkc, g->taken_wkc, sizeof(group_wkc));
+        g->taken = 0;
+        if (wkc < 0) memset(group_wkc, 0, sizeof(group_wkc));
+    } else {
+        for (int f = 0; f < g->frames; ++f) {
+            uint16 le_wkc;
+            memcpy(&le_wkc, &ctx->port.rxbuf[g->frame_idx[f]][g->frame_wkc_at[f]], EC_WKCSIZE);
+            int fw = etohs(le_wkc);
+            group_wkc[g->frame_group[f]] += g->frame_lwr[f] ? fw * 2 : fw;
+        }
+        if (wkc < 0) memset(group_wkc, 0, sizeof(group_wkc));
+    }
+
+    g->seq++;
+    GROUP_FENCE();
+    for (int i = 0; i < g->count; ++i) {
+        if (!(g->due & (1u << i))) continue;
+        soem_group_status_t* s = &g->status[i];
+        s->last_wkc = group_wkc[i];
+        s->exchanges++;
+        s->last_exchange_ns = now_ns;
+        if (group_wkc[i] < s->expected_wkc) {
+            s->wkc_low++;
+            int op = 0;
+            for (int k = 1; k <= ctx->slavecount; ++k)
+                if (ctx->slavelist[k].group == i && ctx->slavelist[k].state == EC_STATE_OPERATIONAL) ++op;
+            s->slaves_op = op;
+        } else {
+            s->slaves_op = s->slave_count;
+        }
+    }
+    GROUP_FENCE();
+    g->seq++;
+}
+
+SOEMSHIM_EXPORT int soem_get_group_status(soem_handle_t* h, soem_group_status_t* out, int max)
+{
+    if (!h || !h->groups) return 0;
+    soem_group_state_t* g = h->groups;
+    int n = g->count < max ? g->count : max;
+    if (!out || n <= 0) return g->count;
+
+    uint32_t seq;
+    do {
+        seq = g->seq;
+        GROUP_FENCE();
+        memcpy(out, (const void*)g->status, (size_t)n * sizeof(*out));
+        GROUP_FENCE();
+    } while ((seq & 1) || seq != g->seq);
+    return g->count;
+}
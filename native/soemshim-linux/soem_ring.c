@@ -0,0 +1,458 @@
+/* Memory-mapped AF_PACKET rings for the cyclic frames (SOEM_NIC_RING). SOEM's Linux driver sends and receives
+   every frame with its own send()/recv() on a raw socket, one copy and one syscall each way per frame. Here the
+   shim opens a second packet socket on the same interface with a TX and an RX ring shared with the kernel: a
+   cycle's process-data frames are built straight into TX slots and go out with a single send(), and replies are
+   read in place from RX slots, yielding for a short while and then sleeping in ppoll until they land. Everything
+   else (mailboxes, state reads, recovery, SOEM's own bring-up cycles) keeps using SOEM's socket.
+
+   The two sockets split the traffic by the EtherCAT frame index: SOEM allocates indices below EC_MAXBUF, the
+   ring uses RING_IDX_BASE and above, and a classic BPF filter on each socket drops the other's frames, so
+   neither receive queue fills with replies it will never read.
+
+   TPACKET_V2 rather than V3: a V3 RX block is handed to user space only when it fills or its retire timer runs
+   out (1 ms at the least), which puts up to a millisecond on every round trip of a cyclic frame; V2 releases
+   each frame as it lands. Linux only. */
+#include <errno.h>
+#include <poll.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include "soem_shim.h"
+#include "soem_shim_internal.h"
+
+#define RING_IDX_BASE      0x80   // frame indices at or above belong to the ring; SOEM's stay below EC_MAXBUF
+#define RING_MAX_FRAMES    16     // per cycle: the low 4 bits of the index
+#define RING_GENERATIONS   8      // bits 4..6: a late frame from an earlier cycle never matches the current one
+#define RING_DEFAULT_SLOTS 256
+#define RING_SLOT_SIZE     2048   // holds EC_MAXECATFRAME plus the tpacket header
+#define RING_IDX_OFFSET    17     // Ethernet header (14) + EtherCAT header (2) + command (1)
+#define RING_ETH_HEADER    14
+#define RING_DG_HEADER     10     // command, index, address, length, interrupt
+#define RING_MIN_FRAME     60
+#define RING_SPIN_NS       20000  // yield this long before sleeping in ppoll: a short line answers within it
+
+/* One process-data datagram, planned at open: SOEM's segmentation of the group's IOmap region. */
+typedef struct ring_frame {
+    uint8 cmd;          // EC_CMD_LRW / LWR / LRD
+    uint8 group;
+    uint16 len;         // data bytes
+    uint32 logical;     // logical address
+    uint8* data;        // IOmap bytes the datagram carries
+    uint16 in_skip;     // leading output bytes, not copied back
+} ring_frame_t;
+
+struct soem_ring {
+    int fd;
+    uint8_t* map;
+    size_t map_size;
+    uint8_t* rx;
+    uint8_t* tx;
+    unsigned slots;            // per ring
+    unsigned rx_next;
+    unsigned tx_next;
+
+    ring_frame_t plan[RING_MAX_FRAMES];
+    int planned;               // frames of all groups
+    int expected[SOEM_MAX_GROUPS];
+
+    // the cycle in flight
+    uint8 gen;
+    int frames;
+    uint8 frame_plan[RING_MAX_FRAMES];  // plan entry of frame f
+    uint32_t back;             // bit f: frame f came back
+    int wkc[RING_MAX_FRAMES];
+    int dc_frame;              // frame carrying the DC datagram, -1 = none
+    int64 dc_time;
+
+    _Atomic uint64_t tx_frames;
+    _Atomic uint64_t rx_frames;
+    _Atomic uint64_t rx_dropped;
+    _Atomic uint64_t tx_busy;
+    _Atomic uint64_t kicks;
+};
+
+static int64_t ring_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/* Accept (reject = 0) or drop (reject = 1) frames whose index is the ring's. */
+static int ring_attach_filter(int fd, int reject)
+{
+    struct sock_filter code[] = {
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS, RING_IDX_OFFSET),
+        BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, RING_IDX_BASE, 0, 1),
+        BPF_STMT(BPF_RET | BPF_K, reject ? 0 : 0xFFFF),
+        BPF_STMT(BPF_RET | BPF_K, reject ? 0xFFFF : 0),
+    };
+    struct sock_fprog prog = { (unsigned short)(sizeof(code) / sizeof(code[0])), code };
+    return setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog));
+}
+
+/* Split group g's IOmap region into frames the way SOEM's send does: one datagram per IO segment, LRW when the
+   group has outputs and inputs, otherwise LWR for the output part and LRD for the input part. Returns the
+   frames added, -1 when they do not fit in RING_MAX_FRAMES. */
+static int ring_plan_group(struct soem_ring* r, ec_groupt* grp, int g)
+{
+    uint32 total = grp->Obytes + grp->Ibytes;
+    int lrw = grp->Obytes && grp->Ibytes && !grp->blockLRW;
+    uint8* base = grp->Obytes ? grp->outputs : grp->inputs;
+    uint32 pos = 0;
+    int added = 0;
+
+    for (int s = 0; pos < total; ++s) {
+        uint32 seg = (s < grp->nsegments && grp->IOsegment[s]) ? grp->IOsegment[s] : total - pos;
+        if (seg > EC_MAXLRWDATA) seg = EC_MAXLRWDATA;
+        if (seg > total - pos) seg = total - pos;
+
+        // Without LRW a segment straddling the output/input boundary becomes two datagrams.
+        while (seg) {
+            uint32 len = seg;
+            uint8 cmd = EC_CMD_LRW;
+            if (!lrw) {
+                int output = pos < grp->Obytes;
+                cmd = output ? EC_CMD_LWR : EC_CMD_LRD;
+                if (output && pos + len > grp->Obytes) len = grp->Obytes - pos;
+            }
+            if (r->planned >= RING_MAX_FRAMES) return -1;
+            ring_frame_t* f = &r->plan[r->planned++];
+            f->cmd = cmd;
+            f->group = (uint8)g;
+            f->len = (uint16)len;
+            f->logical = grp->logstartaddr + pos;
+            f->data = base + pos;
+            f->in_skip = (uint16)(cmd == EC_CMD_LWR ? len : (pos < grp->Obytes ? grp->Obytes - pos : 0));
+            pos += len;
+            seg -= len;
+            ++added;
+        }
+    }
+    return added;
+}
+
+int soem_ring_open(soem_handle_t* h, const char* ifname, int slots)
+{
+    if (h->red) {
+        LOGW("nic_backend=ring: not available with cable redundancy; cycling over SOEM's sockets");
+        return 0;
+    }
+    if (h->sdo) {
+        LOGW("nic_backend=ring: the cyclic mailbox handler reads its status from SOEM's own frames; cycling over SOEM's socket");
+        return 0;
+    }
+
+    struct soem_ring* r = (struct soem_ring*)calloc(1, sizeof(*r));
+    if (!r) return 0;
+    r->fd = -1;
+
+    ecx_contextt* ctx = &h->context;
+    int groups = SOEM_MAX_GROUPS < EC_MAXGROUP ? SOEM_MAX_GROUPS : EC_MAXGROUP;
+    for (int g = 0; g < groups; ++g) {
+        ec_groupt* grp = &ctx->grouplist[g];
+        if (!grp->Obytes && !grp->Ibytes) continue;
+        if (grp->Obytes && grp->Ibytes && grp->inputs != grp->outputs + grp->Obytes) {
+            LOGW("nic_backend=ring: group %d is mapped with overlapping IO; cycling over SOEM's socket", g);
+            free(r);
+            return 0;
+        }
+        if (ring_plan_group(r, grp, g) < 0) {
+            LOGW("nic_backend=ring: the process image needs more than %d frames per cycle; cycling over SOEM's socket", RING_MAX_FRAMES);
+            free(r);
+            return 0;
+        }
+        r->expected[g] = (int)(grp->outputsWKC * 2 + grp->inputsWKC);
+    }
+
+    long page = sysconf(_SC_PAGESIZE);
+    unsigned block = page > RING_SLOT_SIZE ? (unsigned)page : RING_SLOT_SIZE;
+    unsigned per_block = block / RING_SLOT_SIZE;
+    r->slots = (unsigned)(slots > 0 ? slots : RING_DEFAULT_SLOTS);
+    r->slots = (r->slots + per_block - 1) / per_block * per_block;
+
+    int version = TPACKET_V2, one = 1;
+    struct tpacket_req req = { block, r->slots / per_block, RING_SLOT_SIZE, r->slots };
+    struct sockaddr_ll addr = { 0 };
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ECAT);
+    addr.sll_ifindex = (int)if_nametoindex(ifname);
+
+    const char* step = "socket";
+    r->fd = socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ECAT));
+    if (r->fd < 0) goto fail;
+    step = "PACKET_VERSION";
+    if (setsockopt(r->fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0) goto fail;
+    step = "PACKET_RX_RING";
+    if (setsockopt(r->fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0) goto fail;
+    step = "PACKET_TX_RING";
+    if (setsockopt(r->fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0) goto fail;
+    step = "mmap";
+    r->map_size = (size_t)2 * block * req.tp_block_nr;
+    r->map = (uint8_t*)mmap(NULL, r->map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_LOCKED, r->fd, 0);
+    if (r->map == MAP_FAILED)  // MAP_LOCKED needs RLIMIT_MEMLOCK; the ring works without it
+        r->map = (uint8_t*)mmap(NULL, r->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, r->fd, 0);
+    if (r->map == MAP_FAILED) { r->map = NULL; goto fail; }
+    r->rx = r->map;
+    r->tx = r->map + r->map_size / 2;
+    step = "filter";
+    if (ring_attach_filter(r->fd, 0) < 0) goto fail;
+    step = "bind";
+    if (!addr.sll_ifindex || bind(r->fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) goto fail;
+
+    // Best effort: skip the qdisc like SOEM's frames never need one, and do not read our own frames back.
+    setsockopt(r->fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));
+    setsockopt(r->fd, SOL_PACKET, PACKET_IGNORE_OUTGOING, &one, sizeof(one));
+
+    // Last: from here on SOEM's socket no longer sees the ring's frames.
+    step = "SOEM socket filter";
+    if (ring_attach_filter(ctx->port.sockhandle, 1) < 0) goto fail;
+
+    r->dc_frame = -1;
+    h->ring = r;
+    LOGI("nic_backend=ring on '%s': %u slots per ring, %d frame(s) per cycle", ifname, r->slots, r->planned);
+    return (int)r->slots;
+
+fail:
+    LOGW("nic_backend=ring: %s failed on '%s' (errno=%d); cycling over SOEM's socket", step, ifname ? ifname : "(null)", errno);
+    if (r->map) munmap(r->map, r->map_size);
+    if (r->fd >= 0) close(r->fd);
+    free(r);
+    return 0;
+}
+
+void soem_ring_release(soem_handle_t* h)
+{
+    if (!h || !h->ring) return;
+    struct soem_ring* r = h->ring;
+    h->ring = NULL;
+    munmap(r->map, r->map_size);
+    close(r->fd);
+    free(r);
+}
+
+/* Appends a datagram at *at and returns a pointer to its data. The previous datagram's "more follows" bit is the
+   caller's business. */
+static uint8* ring_put_datagram(uint8* frame, int* at, uint8 cmd, uint8 idx, uint32 address, uint16 len)
+{
+    uint8* d = frame + *at;
+    uint32 le_address = htoel(address);
+    uint16 le_len = htoes(len);
+    d[0] = cmd;
+    d[1] = idx;
+    memcpy(d + 2, &le_address, 4);
+    memcpy(d + 6, &le_len, 2);
+    d[8] = d[9] = 0;
+    memset(d + RING_DG_HEADER + len, 0, EC_WKCSIZE);
+    *at += RING_DG_HEADER + len + EC_WKCSIZE;
+    return d + RING_DG_HEADER;
+}
+
+/* Builds the due groups' frames into the TX ring and sends them with one send(). Returns 1, or -1 when a TX slot
+   is still the kernel's or the send failed. */
+int soem_ring_send(soem_handle_t* h, int* expected)
+{
+    struct soem_ring* r = h->ring;
+    ecx_contextt* ctx = &h->context;
+    uint32_t due = soem_group_next(h);
+
+    // A cycle that was never collected leaves its frames to the generation check.
+    r->gen = (uint8)((r->gen + 1) % RING_GENERATIONS);
+    r->frames = 0;
+    r->back = 0;
+    r->dc_frame = -1;
+    *expected = 0;
+    for (int p = 0; p < r->planned; ++p) {
+        if (!(due & (1u << r->plan[p].group))) continue;
+        r->frame_plan[r->frames++] = (uint8)p;
+    }
+    for (int g = 0; g < SOEM_MAX_GROUPS; ++g)
+        if (due & (1u << g)) *expected += r->expected[g];
+
+    for (int f = 0; f < r->frames; ++f) {
+        struct tpacket2_hdr* slot = (struct tpacket2_hdr*)(r->tx + (size_t)((r->tx_next + f) % r->slots) * RING_SLOT_SIZE);
+        uint32_t status = __atomic_load_n(&slot->tp_status, __ATOMIC_ACQUIRE);
+        if (status != TP_STATUS_AVAILABLE && status != TP_STATUS_WRONG_FORMAT) {
+            atomic_fetch_add_explicit(&r->tx_busy, 1, memory_order_relaxed);
+            r->frames = 0;
+            return -1;
+        }
+    }
+
+    int64_t sent_ns = h->cap ? ring_now_ns() : 0;
+    for (int f = 0; f < r->frames; ++f) {
+        const ring_frame_t* plan = &r->plan[r->frame_plan[f]];
+        struct tpacket2_hdr* slot = (struct tpacket2_hdr*)(r->tx + (size_t)r->tx_next * RING_SLOT_SIZE);
+        uint8* frame = (uint8*)slot + TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+        r->tx_next = (r->tx_next + 1) % r->slots;
+
+        // Ethernet: broadcast from SOEM's primary MAC, EtherType 0x88A4.
+        memset(frame, 0xFF, 6);
+        for (int w = 0; w < 3; ++w) memcpy(frame + 6 + 2 * w, &priMAC[w], 2);
+        frame[12] = (uint8)(ETH_P_ECAT >> 8);
+        frame[13] = (uint8)(ETH_P_ECAT & 0xFF);
+
+        uint8 idx = (uint8)(RING_IDX_BASE | (r->gen << 4) | f);
+        int at = RING_ETH_HEADER + EC_ELENGTHSIZE;
+        uint8* data = ring_put_datagram(frame, &at, plan->cmd, idx, plan->logical, plan->len);
+        if (plan->cmd == EC_CMD_LRD) memset(data, 0, plan->len);
+        else memcpy(data, plan->data, plan->len);
+
+        // The first frame of a group with distributed clocks also reads the reference clock, as SOEM's does.
+        ec_groupt* grp = &ctx->grouplist[plan->group];
+        if (r->dc_frame < 0 && grp->hasdc) {
+            uint16 more = htoes((uint16)(plan->len | EC_DATAGRAMFOLLOWS));
+            memcpy(frame + RING_ETH_HEADER + EC_ELENGTHSIZE + 6, &more, 2);
+            uint32 adp_ado = (uint32)ctx->slavelist[grp->DCnext].configadr | ((uint32)ECT_REG_DCSYSTIME << 16);
+            memset(ring_put_datagram(frame, &at, EC_CMD_FRMW, idx, adp_ado, sizeof(int64)), 0, sizeof(int64));
+            r->dc_frame = f;
+        }
+
+        uint16 ecat = htoes((uint16)((at - RING_ETH_HEADER - EC_ELENGTHSIZE) | (1 << 12)));
+        memcpy(frame + RING_ETH_HEADER, &ecat, 2);
+        if (at < RING_MIN_FRAME) {
+            memset(frame + at, 0, (size_t)(RING_MIN_FRAME - at));
+            at = RING_MIN_FRAME;
+        }
+        slot->tp_len = (uint32_t)at;
+        soem_cap_frame(h, 1, frame, (uint32_t)at, sent_ns);
+        __atomic_store_n(&slot->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+    }
+
+    atomic_fetch_add_explicit(&r->kicks, 1, memory_order_relaxed);
+    if (send(r->fd, NULL, 0, MSG_DONTWAIT) < 0 && errno != EAGAIN && errno != ENOBUFS) {
+        r->frames = 0;
+        return -1;
+    }
+    atomic_fetch_add_explicit(&r->tx_frames, (uint64_t)r->frames, memory_order_relaxed);
+    return 1;
+}
+
+/* Takes one returned frame of the cycle in flight: inputs into the IOmap, its WKC and the DC time aside. */
+static void ring_take(struct soem_ring* r, const uint8* frame, uint32_t len)
+{
+    if (len <= RING_IDX_OFFSET) goto drop;
+    uint8 idx = frame[RING_IDX_OFFSET];
+    int f = idx & (RING_MAX_FRAMES - 1);
+    if ((idx & RING_IDX_BASE) == 0 || ((idx >> 4) & (RING_GENERATIONS - 1)) != r->gen || f >= r->frames || (r->back & (1u << f)))
+        goto drop;
+
+    const ring_frame_t* plan = &r->plan[r->frame_plan[f]];
+    int data_at = RING_ETH_HEADER + EC_ELENGTHSIZE + RING_DG_HEADER;
+    int wkc_at = data_at + plan->len;
+    if ((int)len < wkc_at + (int)EC_WKCSIZE) goto drop;
+
+    if (plan->cmd != EC_CMD_LWR && plan->len > plan->in_skip)
+        memcpy(plan->data + plan->in_skip, frame + data_at + plan->in_skip, (size_t)(plan->len - plan->in_skip));
+    uint16 le_wkc;
+    memcpy(&le_wkc, frame + wkc_at, EC_WKCSIZE);
+    r->wkc[f] = plan->cmd == EC_CMD_LWR ? etohs(le_wkc) * 2 : etohs(le_wkc);
+
+    int dc_at = wkc_at + EC_WKCSIZE + RING_DG_HEADER;
+    if (f == r->dc_frame && (int)len >= dc_at + (int)sizeof(int64)) {
+        int64 le_time;
+        memcpy(&le_time, frame + dc_at, sizeof(le_time));
+        r->dc_time = etohll(le_time);
+    }
+
+    r->back |= 1u << f;
+    atomic_fetch_add_explicit(&r->rx_frames, 1, memory_order_relaxed);
+    return;
+
+drop:
+    atomic_fetch_add_explicit(&r->rx_dropped, 1, memory_order_relaxed);
+}
+
+/* Hands every ready RX slot back to the kernel after taking what belongs to this cycle (and capturing it all). */
+static void ring_drain(soem_handle_t* h)
+{
+    struct soem_ring* r = h->ring;
+    int64_t taken_ns = 0;
+    for (;;) {
+        struct tpacket2_hdr* slot = (struct tpacket2_hdr*)(r->rx + (size_t)r->rx_next * RING_SLOT_SIZE);
+        if (!(__atomic_load_n(&slot->tp_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER)) return;
+
+        const struct sockaddr_ll* from = (const struct sockaddr_ll*)((uint8*)slot + TPACKET_ALIGN(sizeof(struct tpacket2_hdr)));
+        if (from->sll_pkttype != PACKET_OUTGOING) {  // kernels without PACKET_IGNORE_OUTGOING show our own sends
+            ring_take(r, (const uint8*)slot + slot->tp_mac, slot->tp_snaplen);
+            if (h->cap) {
+                if (!taken_ns) taken_ns = ring_now_ns();
+                soem_cap_frame(h, 0, (const uint8*)slot + slot->tp_mac, slot->tp_snaplen, taken_ns);
+            }
+        }
+
+        __atomic_store_n(&slot->tp_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        r->rx_next = (r->rx_next + 1) % r->slots;
+    }
+}
+
+/* Waits up to timeout_us for the rest of the cycle's frames. Returns 1 once all are back, 0 otherwise. */
+int soem_ring_wait(soem_handle_t* h, int timeout_us)
+{
+    struct soem_ring* r = h->ring;
+    uint32_t all = r->frames ? (1u << r->frames) - 1 : 0;
+    int64_t start = ring_now_ns();
+    int64_t deadline = start + (int64_t)timeout_us * 1000;
+    for (;;) {
+        ring_drain(h);
+        if (r->back == all) return 1;
+        int64_t now = ring_now_ns();
+        int64_t left = deadline - now;
+        if (left <= 0) return 0;
+        if (now - start < RING_SPIN_NS) {
+            sched_yield();
+            continue;
+        }
+        struct pollfd pfd = { r->fd, POLLIN | POLLERR, 0 };
+        struct timespec ts = { (time_t)(left / 1000000000LL), (long)(left % 1000000000LL) };
+        ppoll(&pfd, 1, &ts, NULL);
+    }
+}
+
+/* The receive half of a ring cycle, in place of ecx_receive_processdata: waits, then returns the WKC of the frames
+   that came back (EC_NOFRAME when none did), hands the per-group counts to soem_group_note and the reference
+   clock's time to the DC tracking. */
+int soem_ring_receive(soem_handle_t* h, int timeout_us)
+{
+    struct soem_ring* r = h->ring;
+    soem_ring_wait(h, timeout_us);
+
+    int wkc = r->back ? 0 : EC_NOFRAME;
+    int group_wkc[SOEM_MAX_GROUPS] = { 0 };
+    for (int f = 0; f < r->frames; ++f) {
+        if (!(r->back & (1u << f))) continue;
+        wkc += r->wkc[f];
+        group_wkc[r->plan[r->frame_plan[f]].group] += r->wkc[f];
+    }
+    soem_group_take_wkc(h, group_wkc);
+    if (r->dc_frame >= 0 && (r->back & (1u << r->dc_frame))) h->context.DCtime = r->dc_time;
+    r->frames = 0;
+    return wkc;
+}
+
+SOEMSHIM_EXPORT int soem_get_nic_stats(soem_handle_t* h, soem_nic_stats_t* out)
+{
+    if (!h || !out) return 0;
+    memset(out, 0, sizeof(*out));
+    struct soem_ring* r = h->ring;
+    if (!r) return 1;
+    out->backend = SOEM_NIC_RING;
+    out->ring_frames = (int32_t)r->slots;
+    out->tx_frames = atomic_load_explicit(&r->tx_frames, memory_order_relaxed);
+    out->rx_frames = atomic_load_explicit(&r->rx_frames, memory_order_relaxed);
+    out->rx_dropped = atomic_load_explicit(&r->rx_dropped, memory_order_relaxed);
+    out->tx_busy = atomic_load_explicit(&r->tx_busy, memory_order_relaxed);
+    out->kicks = atomic_load_explicit(&r->kicks, memory_order_relaxed);
+    return 1;
+}
@@ -0,0 +1,346 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE  // pthread_attr_setaffinity_np
+#endif
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include "soem_shim.h"
+#include "soem_shim_internal.h"
+#include "soem_spsc.h"
+
+#define RT_NSEC_PER_SEC 1000000000LL
+#define RT_DEFAULT_RING 256
+
+typedef struct rt_command_slot {
+    int32_t slave;
+    DriveRxPDO pdo;
+} rt_command_slot_t;
+
+struct soem_rt_engine {
+    soem_handle_t* h;
+    soem_rt_config_t cfg;
+    pthread_t thread;
+    atomic_int run;
+    int slave_count;
+
+    soem_spsc_t commands;   // managed -> RT thread
+    soem_spsc_t samples;    // RT thread -> managed
+
+    // written by the RT thread only, read with relaxed loads from anywhere
+    _Atomic uint64_t cycles;
+    _Atomic uint64_t overruns;
+    _Atomic uint64_t wkc_low;
+    _Atomic uint64_t samples_dropped;
+    _Atomic uint64_t commands_applied;
+    _Atomic int64_t last_wake_latency_ns;
+    _Atomic int64_t max_wake_latency_ns;
+    _Atomic int64_t max_exchange_ns;
+};
+
+static inline int64_t rt_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * RT_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+static inline void rt_ns_to_timespec(int64_t ns, struct timespec* ts)
+{
+    ts->tv_sec = (time_t)(ns / RT_NSEC_PER_SEC);
+    ts->tv_nsec = (long)(ns % RT_NSEC_PER_SEC);
+}
+
+static inline void rt_store_max(_Atomic int64_t* slot, int64_t value)
+{
+    if (value > atomic_load_explicit(slot, memory_order_relaxed))
+        atomic_store_explicit(slot, value, memory_order_relaxed);
+}
+
+static void rt_apply_commands(struct soem_rt_engine* e)
+{
+    ecx_contextt* ctx = &e->h->context;
+    const rt_command_slot_t* cmd;
+    while ((cmd = (const rt_command_slot_t*)soem_spsc_peek(&e->commands)) != NULL) {
+        if (cmd->slave > 0 && cmd->slave <= ctx->slavecount) {
+            ec_slavet* slave = &ctx->slavelist[cmd->slave];
+            if (slave->outputs && (int)slave->Obytes >= IO_RX_BYTES) {
+                soem_pack_rxpdo((uint8_t*)slave->outputs, &cmd->pdo);
+                atomic_fetch_add_explicit(&e->commands_applied, 1, memory_order_relaxed);
+            }
+        }
+        soem_spsc_release(&e->commands);
+    }
+}
+
+static void rt_publish_sample(struct soem_rt_engine* e, uint64_t cycle, int64_t stamp, int wkc, int expected, int64_t latency, int64_t exchange)
+{
+    uint8_t* slot = (uint8_t*)soem_spsc_reserve(&e->samples);
+    if (!slot) {
+        atomic_fetch_add_explicit(&e->samples_dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    soem_rt_sample_t* s = (soem_rt_sample_t*)slot;
+    s->cycle = cycle;
+    s->timestamp_ns = stamp;
+    s->wkc = wkc;
+    s->expected_wkc = expected;
+    s->wake_latency_ns = (int32_t)(latency > INT32_MAX ? INT32_MAX : latency);
+    s->exchange_ns = (int32_t)(exchange > INT32_MAX ? INT32_MAX : exchange);
+    s->slave_count = e->slave_count;
+    s->error_pending = ecx_iserror(&e->h->context) ? 1 : 0;
+    s->red_path = soem_red_path(e->h);
+    s->reserved = 0;
+
+    uint8_t* dst = slot + sizeof(soem_rt_sample_t);
+    ecx_contextt* ctx = &e->h->context;
+    for (int i = 1; i <= e->slave_count; ++i, dst += IO_TX_BYTES) {
+        ec_slavet* slave = &ctx->slavelist[i];
+        if (slave->inputs && (int)slave->Ibytes >= IO_TX_BYTES)
+            memcpy(dst, slave->inputs, IO_TX_BYTES);
+        else
+            memset(dst, 0, IO_TX_BYTES);
+    }
+
+    soem_spsc_commit(&e->samples);
+}
+
+/* No logging in here: the log callback crosses into managed code and would reintroduce the jitter we are avoiding. */
+static void* rt_thread_main(void* arg)
+{
+    struct soem_rt_engine* e = (struct soem_rt_engine*)arg;
+    ecx_contextt* ctx = &e->h->context;
+    const int64_t period = (int64_t)e->cfg.cycle_time_us * 1000;
+    const int timeout_us = e->cfg.receive_timeout_us;
+
+    int64_t deadline = rt_now_ns();
+    int64_t correction = 0;  // DC phase correction for the next wake-up (dc_sync only)
+    uint64_t cycle = 0;
+
+    soem_log_bind(e->h->bus_id);  // state refreshes and recovery steps in the slack log for this bus
+    while (atomic_load_explicit(&e->run, memory_order_acquire)) {
+        deadline += period + correction;
+        struct timespec ts;
+        rt_ns_to_timespec(deadline, &ts);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) { }
+
+        int64_t woke = rt_now_ns();
+        int64_t latency = woke - deadline;
+
+        rt_apply_commands(e);
+
+        int expected = 0;
+        int wkc = e->h->ring ? soem_ring_send(e->h, &expected) : soem_group_send(e->h, &expected);
+        if (wkc >= 0) {
+            soem_red_arm(e->h);
+            soem_cap_sent(e->h);
+            wkc = e->h->ring ? soem_ring_receive(e->h, timeout_us) : ecx_receive_processdata(ctx, timeout_us);
+        } else {
+            wkc = SOEM_ERR_SEND_FAIL;
+        }
+        int64_t done = rt_now_ns();
+        soem_group_note(e->h, wkc, done);
+        soem_red_note(e->h, done);
+        soem_cap_received(e->h, wkc, expected);
+        correction = wkc >= 0 ? soem_dc_track(e->h, done, e->cfg.dc_sync) : 0;
+
+        e->h->last_wkc = wkc;
+        e->h->last_expected_wkc = expected;
+
+        rt_publish_sample(e, ++cycle, done, wkc, expected, latency, done - woke);
+        soem_stats_record(e->h, latency, wkc >= 0 ? done - woke : -1, rt_now_ns() - woke);
+
+        // A due AL state read, or one recovery action, goes into this period's slack after the sample is out;
+        // so does a redundancy probe after the ring changed shape, and otherwise a bounded mailbox handler pass
+        // while SDO transfers are open.
+        int state_due = soem_state_note(e->h, wkc, expected, done);
+        if (soem_state_recovering(e->h)) soem_state_recover_step(e->h);
+        else if (state_due) soem_state_refresh(e->h);
+        else if (soem_red_due(e->h)) soem_red_probe(e->h);
+        else if (soem_sdo_due(e->h)) soem_sdo_step(e->h);
+
+        atomic_store_explicit(&e->cycles, cycle, memory_order_relaxed);
+        atomic_store_explicit(&e->last_wake_latency_ns, latency, memory_order_relaxed);
+        rt_store_max(&e->max_wake_latency_ns, latency);
+        rt_store_max(&e->max_exchange_ns, done - woke);
+        if (wkc < expected)
+            atomic_fetch_add_explicit(&e->wkc_low, 1, memory_order_relaxed);
+
+        // Missed a whole period: skip ahead instead of bursting to catch up.
+        if (done - deadline > period) {
+            atomic_fetch_add_explicit(&e->overruns, 1, memory_order_relaxed);
+            deadline = done;
+        }
+    }
+
+    return NULL;
+}
+
+static void rt_free(struct soem_rt_engine* e)
+{
+    soem_spsc_free(&e->commands);
+    soem_spsc_free(&e->samples);
+    free(e);
+}
+
+int soem_rt_is_running(const soem_handle_t* h)
+{
+    return h && h->rt && atomic_load_explicit(&h->rt->run, memory_order_acquire);
+}
+
+void soem_rt_release(soem_handle_t* h)
+{
+    if (!h || !h->rt) return;
+    struct soem_rt_engine* e = h->rt;
+    atomic_store_explicit(&e->run, 0, memory_order_release);
+    pthread_join(e->thread, NULL);
+    LOGI("cyclic engine stopped: cycles=%llu overruns=%llu wkc_low=%llu dropped=%llu max_latency_us=%lld max_exchange_us=%lld",
+        (unsigned long long)atomic_load(&e->cycles), (unsigned long long)atomic_load(&e->overruns),
+        (unsigned long long)atomic_load(&e->wkc_low), (unsigned long long)atomic_load(&e->samples_dropped),
+        (long long)(atomic_load(&e->max_wake_latency_ns) / 1000), (long long)(atomic_load(&e->max_exchange_ns) / 1000));
+    h->rt = NULL;
+    rt_free(e);
+}
+
+SOEMSHIM_EXPORT int soem_rt_start(soem_handle_t* h, const soem_rt_config_t* cfg)
+{
+    if (!h || !cfg || cfg->cycle_time_us <= 0) return SOEM_ERR_BAD_ARGS;
+    if (h->rt) return SOEM_ERR_BUSY;
+    soem_log_bind(h->bus_id);
+
+    struct soem_rt_engine* e = (struct soem_rt_engine*)calloc(1, sizeof(*e));
+    if (!e) return SOEM_ERR_RT_START;
+
+    e->h = h;
+    e->cfg = *cfg;
+    if (e->cfg.receive_timeout_us <= 0) e->cfg.receive_timeout_us = e->cfg.cycle_time_us / 2;
+    if (e->cfg.ring_capacity <= 0) e->cfg.ring_capacity = RT_DEFAULT_RING;
+    e->slave_count = h->context.slavecount;
+    if (e->cfg.dc_sync) {
+        soem_dc_stats_t dc;
+        soem_get_dc_stats(h, &dc);
+        if (!dc.active || (int64_t)dc.cycle_ns != (int64_t)e->cfg.cycle_time_us * 1000) {
+            LOGW("soem_rt_start: dc_sync needs SYNC0 running at the engine cycle (sync0=%d cycle=%dns); not steering",
+                dc.active, dc.cycle_ns);
+            e->cfg.dc_sync = 0;
+        }
+    }
+
+    uint32_t sample_size = (uint32_t)(sizeof(soem_rt_sample_t) + (size_t)e->slave_count * IO_TX_BYTES);
+    if (!soem_spsc_init(&e->commands, (uint32_t)e->cfg.ring_capacity, sizeof(rt_command_slot_t)) ||
+        !soem_spsc_init(&e->samples, (uint32_t)e->cfg.ring_capacity, sample_size)) {
+        LOGE("soem_rt_start: ring allocation failed (capacity=%d)", e->cfg.ring_capacity);
+        rt_free(e);
+        return SOEM_ERR_RT_START;
+    }
+
+    if (e->cfg.lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        LOGW("soem_rt_start: mlockall failed (errno=%d); page faults may add latency", errno);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (e->cfg.priority > 0) {
+        struct sched_param param = { 0 };
+        param.sched_priority = e->cfg.priority;
+        pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        pthread_attr_setschedparam(&attr, &param);
+    }
+    if (e->cfg.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(e->cfg.cpu, &set);
+        pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+    }
+
+    atomic_store(&e->run, 1);
+    int rc = pthread_create(&e->thread, &attr, rt_thread_main, e);
+    if (rc == EPERM && e->cfg.priority > 0) {
+        // No CAP_SYS_NICE / rtprio limit: run anyway, just without SCHED_FIFO.
+        LOGW("soem_rt_start: SCHED_FIFO priority %d not permitted, falling back to the default scheduler", e->cfg.priority);
+        pthread_attr_setinheritsched(&attr, PTHREAD_INHERIT_SCHED);
+        rc = pthread_create(&e->thread, &attr, rt_thread_main, e);
+    }
+    pthread_attr_destroy(&attr);
+
+    if (rc != 0) {
+        LOGE("soem_rt_start: pthread_create failed rc=%d", rc);
+        rt_free(e);
+        return SOEM_ERR_RT_START;
+    }
+
+    pthread_setname_np(e->thread, "soem-rt");
+    h->rt = e;
+    LOGI("cyclic engine started: cycle=%dus priority=%d cpu=%d mlock=%d slaves=%d dc_sync=%d",
+        e->cfg.cycle_time_us, e->cfg.priority, e->cfg.cpu, e->cfg.lock_memory, e->slave_count, e->cfg.dc_sync);
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_rt_stop(soem_handle_t* h)
+{
+    if (!h) return SOEM_ERR_BAD_ARGS;
+    soem_log_bind(h->bus_id);
+    soem_rt_release(h);
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_pin_thread(int cpu)
+{
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return 0;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+SOEMSHIM_EXPORT int soem_rt_push_command(soem_handle_t* h, int slave_index, const DriveRxPDO* in)
+{
+    if (!h || !in || !h->rt) return SOEM_ERR_BAD_ARGS;
+    rt_command_slot_t* slot = (rt_command_slot_t*)soem_spsc_reserve(&h->rt->commands);
+    if (!slot) return 0;
+    slot->slave = slave_index;
+    memcpy(&slot->pdo, in, sizeof(DriveRxPDO));
+    soem_spsc_commit(&h->rt->commands);
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_rt_pop_sample(soem_handle_t* h, soem_rt_sample_t* out, uint8_t* inputs, int inputs_len)
+{
+    if (!h || !out || !h->rt) return SOEM_ERR_BAD_ARGS;
+    const uint8_t* slot = (const uint8_t*)soem_spsc_peek(&h->rt->samples);
+    if (!slot) return 0;
+
+    memcpy(out, slot, sizeof(*out));
+    if (inputs && inputs_len > 0) {
+        int n = out->slave_count * IO_TX_BYTES;
+        memcpy(inputs, slot + sizeof(soem_rt_sample_t), (size_t)(inputs_len < n ? inputs_len : n));
+    }
+    soem_spsc_release(&h->rt->samples);
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_rt_get_stats(soem_handle_t* h, soem_rt_stats_t* out)
+{
+    if (!h || !out) return 0;
+    memset(out, 0, sizeof(*out));
+    struct soem_rt_engine* e = h->rt;
+    if (!e) return 1;
+
+    out->running = atomic_load_explicit(&e->run, memory_order_relaxed);
+    out->cycle_time_us = e->cfg.cycle_time_us;
+    out->cycles = atomic_load_explicit(&e->cycles, memory_order_relaxed);
+    out->overruns = atomic_load_explicit(&e->overruns, memory_order_relaxed);
+    out->wkc_low = atomic_load_explicit(&e->wkc_low, memory_order_relaxed);
+    out->samples_dropped = atomic_load_explicit(&e->samples_dropped, memory_order_relaxed);
+    out->commands_applied = atomic_load_explicit(&e->commands_applied, memory_order_relaxed);
+    out->last_wake_latency_ns = atomic_load_explicit(&e->last_wake_latency_ns, memory_order_relaxed);
+    out->max_wake_latency_ns = atomic_load_explicit(&e->max_wake_latency_ns, memory_order_relaxed);
+    out->max_exchange_ns = atomic_load_explicit(&e->max_exchange_ns, memory_order_relaxed);
+    return 1;
+}
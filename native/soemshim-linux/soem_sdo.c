@@ -0,0 +1,316 @@
+/* Asynchronous CoE SDO access alongside the cyclic exchange. At init every CoE slave is handed to SOEM's cyclic
+   mailbox handler (ecx_slavembxcyclic, ecx_initmbxqueue), which maps its mailbox-full bit into the group's
+   process-data frame. From then on ecx_SDOread/ecx_SDOwrite never touch the wire themselves: they queue the
+   request mailbox and wait for the reply that ecx_mbxhandler fetches. The shim runs those blocking calls on a few
+   worker threads, one transfer per slave at a time, and the bus thread calls soem_sdo_step after each cycle to
+   let ecx_mbxhandler move at most sdo_actions mailboxes, so mailbox traffic only ever sits in the slack between
+   cycles. Callers submit with soem_sdo_read/soem_sdo_write and collect results with soem_sdo_poll; nothing in the
+   API blocks. Shared verbatim by the Windows and Linux shims. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SDO_SLOTS          64          // requests queued or in flight per handle
+#define SDO_MAX_WORKERS    8
+#define SDO_DEFAULT_ACTIONS 2          // mailboxes ecx_mbxhandler may move per soem_sdo_step
+#define SDO_IDLE_US        1000        // worker poll interval while the queue is empty
+#define SDO_TIMEOUT_US     EC_TIMEOUTRXM
+
+#if defined(_WIN32)
+typedef HANDLE sdo_thread_t;     // what osal_thread_create stores: CreateThread's handle
+#else
+typedef pthread_t sdo_thread_t;  // pthread_create's thread, joinable
+#endif
+
+#define SDO_FREE   0
+#define SDO_QUEUED 1
+#define SDO_ACTIVE 2
+#define SDO_DONE   3
+
+typedef struct sdo_slot {
+    int state;                 // SDO_*
+    soem_sdo_completion_t c;   // request fields on submit, result once SDO_DONE
+    int64_t submitted_ns;
+} sdo_slot_t;
+
+typedef struct soem_sdo_engine {
+    soem_handle_t* h;
+    void* mutex;               // guards everything below except the bus-thread statistics
+    volatile int run;
+    int workers;
+    int actions;
+    uint32_t next_ticket;
+    volatile int in_flight;    // queued + active; read unlocked by soem_sdo_step to skip idle cycles
+    uint8_t* busy;             // busy[slave]: a worker is talking to that slave
+    sdo_slot_t slots[SDO_SLOTS];
+    sdo_thread_t threads[SDO_MAX_WORKERS];  // joined by soem_sdo_release
+    uint64_t submitted;
+    uint64_t completed;
+    uint64_t failed;
+    int64_t max_latency_ns;
+    // bus thread only
+    volatile uint64_t service_calls;
+    volatile int64_t max_service_ns;
+} soem_sdo_engine_t;
+
+void log_message(soem_log_level_t lvl, const char* fmt, ...);  // soem_log.c
+void soem_log_event(soem_log_level_t lvl, int code, const int64_t* args, int argc);
+void soem_log_bind(uint32_t bus);
+
+static int64_t sdo_now_ns(void)
+{
+    ec_timet t;
+    osal_get_monotonic_time(&t);
+    return (int64_t)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static int sdo_is_cyclic(const ecx_contextt* ctx, int slave)
+{
+    return slave >= 1 && slave <= ctx->slavecount && ctx->slavelist[slave].mbxhandlerstate == ECT_MBXH_CYCLIC;
+}
+
+/* After soem_group_assign, before mapping: put every CoE slave under the cyclic mailbox handler and set up the
+   transmit queue of each group that has one. Returns the number of slaves handed over. */
+int soem_sdo_prepare(soem_handle_t* h)
+{
+    ecx_contextt* ctx = &h->context;
+    int handed = 0;
+    uint32_t groups = 0;
+    for (int i = 1; i <= ctx->slavecount; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        if (!s->mbx_l || !(s->mbx_proto & ECT_MBXPROT_COE)) continue;
+        ecx_slavembxcyclic(ctx, (uint16)i);
+        if (s->mbxhandlerstate != ECT_MBXH_CYCLIC) continue;
+        groups |= 1u << s->group;
+        ++handed;
+    }
+    for (int g = 0; g < EC_MAXGROUP; ++g)
+        if (groups & (1u << g)) ecx_initmbxqueue(ctx, (uint8)g);
+    return handed;
+}
+
+/* Runs one queued transfer whose slave is not already busy. Returns 0 when there was none. */
+static int sdo_run_one(soem_sdo_engine_t* e)
+{
+    ecx_contextt* ctx = &e->h->context;
+    sdo_slot_t* slot = NULL;
+
+    osal_mutex_lock(e->mutex);
+    for (int i = 0; i < SDO_SLOTS; ++i) {
+        sdo_slot_t* s = &e->slots[i];
+        if (s->state != SDO_QUEUED || e->busy[s->c.slave]) continue;
+        if (!slot || (int32_t)(s->c.ticket - slot->c.ticket) < 0) slot = s;  // oldest first
+    }
+    if (slot) {
+        slot->state = SDO_ACTIVE;
+        e->busy[slot->c.slave] = 1;
+    }
+    osal_mutex_unlock(e->mutex);
+    if (!slot) return 0;
+
+    soem_sdo_completion_t* c = &slot->c;
+    int wkc;
+    if (c->write) {
+        wkc = ecx_SDOwrite(ctx, c->slave, c->index, c->subindex, FALSE, c->size, c->data, SDO_TIMEOUT_US);
+    } else {
+        int size = SOEM_SDO_MAX_BYTES;
+        wkc = ecx_SDOread(ctx, c->slave, c->index, c->subindex, FALSE, &size, c->data, SDO_TIMEOUT_US);
+        if (wkc > 0) c->size = (uint16_t)size;
+    }
+    if (wkc <= 0) LOG_EVENT(SOEM_LOG_WARN, SOEM_LOGC_SDO_FAIL, c->slave, c->index, c->subindex, c->write, wkc);
+    int64_t latency = sdo_now_ns() - slot->submitted_ns;
+
+    osal_mutex_lock(e->mutex);
+    c->status = wkc > 0 ? (int32_t)c->size : SOEM_ERR_SDO;
+    c->elapsed_ns = latency;
+    e->busy[c->slave] = 0;
+    e->completed++;
+    if (wkc <= 0) e->failed++;
+    if (latency > e->max_latency_ns) e->max_latency_ns = latency;
+    e->in_flight--;
+    slot->state = SDO_DONE;
+    osal_mutex_unlock(e->mutex);
+    return 1;
+}
+
+static OSAL_THREAD_FUNC sdo_worker(void* arg)
+{
+    soem_sdo_engine_t* e = (soem_sdo_engine_t*)arg;
+    soem_log_bind(e->h->bus_id);
+    while (e->run) {
+        if (!sdo_run_one(e)) osal_usleep(SDO_IDLE_US);
+    }
+}
+
+/* SOEM's OSAL creates threads but cannot join them; without this every release leaks the workers' stacks (Linux)
+   or handles (Windows). */
+static void sdo_join(sdo_thread_t thread)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+/* After the bus reached OP: start the workers. Returns the worker count, 0 when the engine could not start. */
+int soem_sdo_start(soem_handle_t* h, int workers, int actions)
+{
+    soem_sdo_engine_t* e = (soem_sdo_engine_t*)calloc(1, sizeof(*e));
+    if (!e) return 0;
+    e->busy = (uint8_t*)calloc((size_t)h->context.slavecount + 1, 1);
+    e->mutex = osal_mutex_create();
+    if (!e->busy || !e->mutex) {
+        if (e->mutex) osal_mutex_destroy(e->mutex);
+        free(e->busy);
+        free(e);
+        return 0;
+    }
+
+    e->h = h;
+    e->actions = actions > 0 ? actions : SDO_DEFAULT_ACTIONS;
+    e->next_ticket = 1;
+    e->run = 1;
+    if (workers > SDO_MAX_WORKERS) workers = SDO_MAX_WORKERS;
+    for (int i = 0; i < workers; ++i) {
+        if (!osal_thread_create(&e->threads[i], 0, (void*)sdo_worker, e)) {
+            log_message(SOEM_LOG_WARN, "SDO worker %d of %d could not be started", i + 1, workers);
+            break;
+        }
+        e->workers++;
+    }
+    h->sdo = e;
+    return e->workers;
+}
+
+/* Stops and joins the workers. A transfer still waiting for its reply has to finish first; once nobody steps the
+   mailbox handler that means its timeout (EC_TIMEOUTRXM), so soem_shutdown can take that long with SDOs open. */
+void soem_sdo_release(soem_handle_t* h)
+{
+    if (!h || !h->sdo) return;
+    soem_sdo_engine_t* e = h->sdo;
+    e->run = 0;
+    for (int i = 0; i < e->workers; ++i) sdo_join(e->threads[i]);
+    osal_mutex_destroy(e->mutex);
+    free(e->busy);
+    free(e);
+    h->sdo = NULL;
+}
+
+/* Bus thread, between cycles: lets ecx_mbxhandler move at most e->actions mailboxes per group that has any.
+   Returns the mailboxes moved, 0 without work in flight (one unlocked load, so idle cycles cost nothing). */
+int soem_sdo_step(soem_handle_t* h)
+{
+    soem_sdo_engine_t* e = h->sdo;
+    if (!e || !e->in_flight) return 0;
+
+    ecx_contextt* ctx = &h->context;
+    int64_t t0 = sdo_now_ns();
+    int moved = 0;
+    for (int g = 0; g < EC_MAXGROUP; ++g)
+        if (ctx->grouplist[g].mbxstatuslength > 0) moved += ecx_mbxhandler(ctx, (uint8)g, e->actions);
+    int64_t spent = sdo_now_ns() - t0;
+
+    e->service_calls++;
+    if (spent > e->max_service_ns) e->max_service_ns = spent;
+    return moved;
+}
+
+int soem_sdo_due(const soem_handle_t* h)
+{
+    return h->sdo && h->sdo->in_flight;
+}
+
+static int sdo_submit(soem_handle_t* h, int slave, uint16_t index, uint8_t subindex, int write, const uint8_t* data, int size)
+{
+    if (!h || (write && (size <= 0 || size > SOEM_SDO_MAX_BYTES || !data))) return SOEM_ERR_BAD_ARGS;
+    soem_sdo_engine_t* e = h->sdo;
+    if (!e || !e->workers) return SOEM_ERR_UNSUPPORTED;
+    if (slave < 1 || slave > h->context.slavecount) return SOEM_ERR_BAD_ARGS;
+    if (!sdo_is_cyclic(&h->context, slave)) return SOEM_ERR_UNSUPPORTED;  // no CoE mailbox on that slave
+
+    int ticket = 0;
+    osal_mutex_lock(e->mutex);
+    for (int i = 0; i < SDO_SLOTS; ++i) {
+        sdo_slot_t* s = &e->slots[i];
+        if (s->state != SDO_FREE) continue;
+        memset(&s->c, 0, sizeof(s->c));
+        ticket = (int)(e->next_ticket & 0x7FFFFFFF);
+        e->next_ticket = ticket == 0x7FFFFFFF ? 1 : (uint32_t)ticket + 1;
+        s->c.ticket = (uint32_t)ticket;
+        s->c.slave = (uint16_t)slave;
+        s->c.index = index;
+        s->c.subindex = subindex;
+        s->c.write = (uint8_t)(write != 0);
+        if (write) {
+            s->c.size = (uint16_t)size;
+            memcpy(s->c.data, data, (size_t)size);
+        }
+        s->submitted_ns = sdo_now_ns();
+        s->state = SDO_QUEUED;
+        e->submitted++;
+        e->in_flight++;
+        break;
+    }
+    osal_mutex_unlock(e->mutex);
+    return ticket;  // 0: every slot is taken
+}
+
+SOEMSHIM_EXPORT int soem_sdo_read(soem_handle_t* h, int slave, uint16_t index, uint8_t subindex)
+{
+    return sdo_submit(h, slave, index, subindex, 0, NULL, 0);
+}
+
+SOEMSHIM_EXPORT int soem_sdo_write(soem_handle_t* h, int slave, uint16_t index, uint8_t subindex, const uint8_t* data, int size)
+{
+    return sdo_submit(h, slave, index, subindex, 1, data, size);
+}
+
+SOEMSHIM_EXPORT int soem_sdo_poll(soem_handle_t* h, soem_sdo_completion_t* out, int max)
+{
+    if (!h || !out || max <= 0) return 0;
+    soem_sdo_engine_t* e = h->sdo;
+    if (!e) return 0;
+
+    int n = 0;
+    osal_mutex_lock(e->mutex);
+    for (int i = 0; i < SDO_SLOTS && n < max; ++i) {
+        sdo_slot_t* s = &e->slots[i];
+        if (s->state != SDO_DONE) continue;
+        memcpy(&out[n++], &s->c, sizeof(s->c));
+        s->state = SDO_FREE;
+    }
+    osal_mutex_unlock(e->mutex);
+    return n;
+}
+
+SOEMSHIM_EXPORT int soem_sdo_service(soem_handle_t* h)
+{
+    if (!h) return SOEM_ERR_BAD_ARGS;
+    if (!h->sdo) return SOEM_ERR_UNSUPPORTED;
+    if (h->rt || h->cycle_in_flight) return SOEM_ERR_BUSY;  // the engine steps it itself
+    soem_log_bind(h->bus_id);
+    return soem_sdo_step(h);
+}
+
+SOEMSHIM_EXPORT int soem_sdo_get_stats(soem_handle_t* h, soem_sdo_stats_t* out)
+{
+    if (!h || !out) return 0;
+    memset(out, 0, sizeof(*out));
+    soem_sdo_engine_t* e = h->sdo;
+    if (!e) return 1;
+
+    osal_mutex_lock(e->mutex);
+    out->workers = e->workers;
+    out->in_flight = e->in_flight;
+    out->submitted = e->submitted;
+    out->completed = e->completed;
+    out->failed = e->failed;
+    out->max_latency_ns = e->max_latency_ns;
+    osal_mutex_unlock(e->mutex);
+    out->service_calls = e->service_calls;
+    out->max_service_ns = e->max_service_ns;
+    return 1;
+}
@@ -3,8 +3,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <errno.h>
+#include <sys/mman.h>
 #include "soem_shim.h"
+#include "soem_shim_internal.h"
 #include "soem/soem.h"
 
 #if defined(_WIN32)
@@ -26,53 +30,7 @@ extern "C" {
 #endif
 
 
-// Expected raw IO byte sizes according to slaveinfo mapping, confirmed from 'EtherCAT commands - Xeryon.pdf'
-#define IO_RX_BYTES 20  // "Output size: 160bits" -> 20 bytes
-#define IO_TX_BYTES 8   // "Input size: 64bits"  -> 8 bytes
-
-typedef void (*soem_log_callback_t)(soem_log_level_t level, const char* message);
-static soem_log_callback_t log_cb = NULL;
-SOEMSHIM_EXPORT void soem_set_log_callback(soem_log_callback_t cb)
- {
-    log_cb = cb;
-}
-static void log_message(soem_log_level_t lvl, const char* fmt, ...)
-{
-    if (!log_cb) return;
-
-    va_list ap;
-    va_start(ap, fmt);
-
-    // First, determine the required size (excluding null terminator)
-    int needed = vsnprintf(NULL, 0, fmt, ap);
-    va_end(ap);
-
-    if (needed < 0) {
-        // Fallback: formatting error, use a static message
-        log_cb(lvl, "log_message: formatting error");
-        return;
-    }
-
-    // Allocate buffer for the formatted message (+1 for null terminator)
-    size_t bufsize = (size_t)needed + 1;
-    char* buf = (bufsize <= 512) ? (char[512]){0} : (char*)malloc(bufsize);
-
-    if (!buf) {
-        log_cb(lvl, "log_message: out of memory");
-        return;
-    }
-
-    va_start(ap, fmt);
-    vsnprintf(buf, bufsize, fmt, ap);
-    va_end(ap);
-
-    log_cb(lvl, buf);
-
-    if (bufsize > 512) {
-        free(buf);
-    }
-}
-
+static void iomap_free(soem_handle_t* h);
 
 SOEMSHIM_EXPORT int soem_drain_error_list(soem_handle_t* h, char* buf, int buf_sz)
 {
@@ -81,6 +39,11 @@ SOEMSHIM_EXPORT int soem_drain_error_list(soem_handle_t* h, char* buf, int buf_s
         return 0;
     }
 
+    if (!ecx_iserror(&h->context)) {
+        buf[0] = '\0';
+        return 1;
+    }
+
     char* err = ecx_elist2string(&h->context);
     if (!err) {
         LOGE("No error string available.\n");
@@ -97,13 +60,53 @@ SOEMSHIM_EXPORT int soem_drain_error_list(soem_handle_t* h, char* buf, int buf_s
     return 1;
 }
 
+SOEMSHIM_EXPORT int soem_has_errors(soem_handle_t* h)
+{
+    return h && ecx_iserror(&h->context) ? 1 : 0;
+}
+
+SOEMSHIM_EXPORT int soem_pop_errors(soem_handle_t* h, soem_error_record_t* buf, int max)
+{
+    if (!h || !buf || max <= 0) return 0;
+
+    int n = 0;
+    ec_errort e;
+    while (n < max && ecx_poperror(&h->context, &e)) {
+        soem_error_record_t* r = &buf[n++];
+        memset(r, 0, sizeof(*r));
+        r->timestamp_ns = (int64_t)e.Time.tv_sec * 1000000000LL + (int64_t)e.Time.tv_nsec;
+        r->type = (int32_t)e.Etype;
+        r->abort_code = e.AbortCode;
+        r->slave = e.Slave;
+        r->index = e.Index;
+        r->subindex = e.SubIdx;
+        r->error_code = e.ErrorCode;
+        r->error_reg = e.ErrorReg;
+        r->emergency_b1 = e.b1;
+        r->emergency_w1 = e.w1;
+        r->emergency_w2 = e.w2;
+    }
+    return n;
+}
+
 SOEMSHIM_EXPORT void soem_shutdown(soem_handle_t *handle)
 {
     if (!handle) return;
+    soem_log_bind(handle->bus_id);
+    soem_sdo_release(handle);  // first: a running engine still steps the mailboxes of open transfers
+    soem_rt_release(handle);
+    soem_ring_release(handle);
+    soem_cap_release(handle);
+    soem_scan_release(handle);
+    soem_dc_release(handle);
+    soem_stats_release(handle);
+    soem_state_release(handle);
+    soem_group_release(handle);
     handle->context.slavelist[0].state = EC_STATE_INIT;
     ecx_writestate(&handle->context, 0);
     ecx_close(&handle->context);
-    free(handle->IOmap);   
+    soem_red_release(handle);
+    iomap_free(handle);
     free(handle);
 }
 
@@ -160,6 +163,66 @@ SOEMSHIM_EXPORT int soem_scan_slaves(soem_handle_t *handle, soem_slave_info_t *b
 SOEMSHIM_EXPORT int soem_expected_rx_bytes(void) { return IO_RX_BYTES; }
 SOEMSHIM_EXPORT int soem_expected_tx_bytes(void) { return IO_TX_BYTES; }
 
+static void unpack_txpdo(const uint8_t* buf, DriveTxPDO* out);
+static void read_status_word(const uint8_t* buf, soem_status_word_t* out);
+
+#define SOEM_IOMAP_SCRATCH   (64 * 1024)
+#define SOEM_IOMAP_ALIGN     64
+#define SOEM_STARTUP_PERIOD_NS 1000000LL                    // bring-up cycle without cycle_period_ns or dc_cycle_ns
+#define SOEM_STARTUP_TIMEOUT_NS (EC_TIMEOUTSTATE * 5 * 1000LL)  // mapping to OP, all slaves
+#define SOEM_HUGE_PAGE_SIZE  (2u * 1024u * 1024u)
+
+/* Allocate h->IOmap for size bytes: cache-line aligned and rounded, optionally a huge page and/or mlock'ed. */
+static int iomap_alloc(soem_handle_t* h, size_t size, uint32_t flags)
+{
+    size_t capacity = (size + SOEM_IOMAP_ALIGN - 1) & ~(size_t)(SOEM_IOMAP_ALIGN - 1);
+    void* p = NULL;
+
+    if (flags & SOEM_IOMAP_HUGE_PAGES) {
+        size_t huge = (size + SOEM_HUGE_PAGE_SIZE - 1) & ~(size_t)(SOEM_HUGE_PAGE_SIZE - 1);
+        p = mmap(NULL, huge, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) {
+            LOGW("IOmap: MAP_HUGETLB failed (errno=%d), using regular pages", errno);
+            p = NULL;
+        } else {
+            capacity = huge;
+            h->iomap_kind = SOEM_IOMAP_KIND_PAGES;
+        }
+    }
+
+    if (!p) {
+        if (posix_memalign(&p, SOEM_IOMAP_ALIGN, capacity) != 0) return 0;
+        h->iomap_kind = SOEM_IOMAP_KIND_HEAP;
+    }
+    memset(p, 0, capacity);
+
+    if (flags & SOEM_IOMAP_LOCKED) {
+        if (mlock(p, capacity) == 0) h->iomap_locked = 1;
+        else LOGW("IOmap: mlock failed (errno=%d), process image stays pageable", errno);
+    }
+
+    h->IOmap = (uint8*)p;
+    h->iomap_size = size;
+    h->iomap_capacity = capacity;
+    return 1;
+}
+
+static void iomap_free(soem_handle_t* h)
+{
+    if (!h->IOmap) return;
+    if (h->iomap_locked) munlock(h->IOmap, h->iomap_capacity);
+    if (h->iomap_kind == SOEM_IOMAP_KIND_PAGES) munmap(h->IOmap, h->iomap_capacity);
+    else free(h->IOmap);
+    h->IOmap = NULL;
+}
+
+static int64_t now_ns(void)
+{
+    ec_timet t;
+    osal_get_monotonic_time(&t);
+    return (int64_t)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
 /* Read and unpack TX PDO (input) into high-level DriveTxPDO.
    Returns 1 on success, 0 on failure. */
 SOEMSHIM_EXPORT int soem_read_txpdo(soem_handle_t* handle, int slave_index, DriveTxPDO* out)
@@ -169,14 +232,36 @@ SOEMSHIM_EXPORT int soem_read_txpdo(soem_handle_t* handle, int slave_index, Driv
     ec_slavet* slave = &handle->context.slavelist[slave_index];
     if (!slave || !slave->inputs) return 0;
 
-    // Explicit bounds check to prevent buffer overflow
-    if ((int)slave->Ibytes < IO_TX_BYTES) {
-        LOGE("soem_read_txpdo: slave %d Ibytes too small (%d < %d)", slave_index, (int)slave->Ibytes, IO_TX_BYTES);
-        return 0;
-    }
+    // Explicit bounds check to prevent buffer overflow. No logging here: this is bound with
+    // SuppressGCTransition, which forbids calling back into managed code; soem_initialize reports it.
+    if ((int)slave->Ibytes < IO_TX_BYTES) return 0;
+
+    unpack_txpdo((const uint8_t*)slave->inputs, out);
+    return 1;
+}
+
+/* Read the TX PDO (input) as a packed status word. Same checks as soem_read_txpdo.
+   Returns 1 on success, 0 on failure. */
+SOEMSHIM_EXPORT int soem_read_status(soem_handle_t* handle, int slave_index, soem_status_word_t* out)
+{
+    if (!handle || !out || slave_index <= 0 || slave_index > handle->context.slavecount) return 0;
+
+    ec_slavet* slave = &handle->context.slavelist[slave_index];
+    if (!slave->inputs || (int)slave->Ibytes < IO_TX_BYTES) return 0;
 
-    uint8_t* buf = (uint8_t*)slave->inputs;
+    read_status_word((const uint8_t*)slave->inputs, out);
+    return 1;
+}
+
+static void read_status_word(const uint8_t* buf, soem_status_word_t* out)
+{
+    // little-endian on the wire; assemble explicitly so the word is host-order everywhere
+    out->actual_position = (int32_t)((uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24));
+    out->flags_slot = (uint32_t)buf[4] | ((uint32_t)buf[5] << 8) | ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 24);
+}
 
+static void unpack_txpdo(const uint8_t* buf, DriveTxPDO* out)
+{
     // little-endian; copy to avoid aliasing issues
     int32_t pos;
     memcpy(&pos, &buf[0], sizeof(pos));
@@ -215,8 +300,6 @@ SOEMSHIM_EXPORT int soem_read_txpdo(soem_handle_t* handle, int slave_index, Driv
 
     // slot at byte 7
     out->Slot = buf[7];
-
-    return 1;
 }
 
 /* Pack and write RX PDO (output) from high-level DriveRxPDO.
@@ -228,14 +311,15 @@ SOEMSHIM_EXPORT int soem_write_rxpdo(soem_handle_t* handle, int slave_index, con
     ec_slavet* slave = &handle->context.slavelist[slave_index];
     if (!slave || !slave->outputs) return 0;
 
-    // Explicit bounds check to prevent buffer overflow
-    if ((int)slave->Obytes < IO_RX_BYTES) {
-        LOGE("soem_write_rxpdo: slave %d Obytes too small (%d < %d)", slave_index, (int)slave->Obytes, IO_RX_BYTES);
-        return 0;
-    }
+    // Explicit bounds check to prevent buffer overflow (silent, see soem_read_txpdo)
+    if ((int)slave->Obytes < IO_RX_BYTES) return 0;
 
-    uint8_t* buf = (uint8_t*)slave->outputs;
+    soem_pack_rxpdo((uint8_t*)slave->outputs, in);
+    return 1;
+}
 
+void soem_pack_rxpdo(uint8_t* buf, const DriveRxPDO* in)
+{
     // Command: 4 bytes at offset 0
     memcpy(&buf[0], in->Command, 4);
 
@@ -255,16 +339,74 @@ SOEMSHIM_EXPORT int soem_write_rxpdo(soem_handle_t* handle, int slave_index, con
     buf[16] = in->Execute;
 
     // The remaining bytes up to IO_RX_BYTES are left unchanged or can be zeroed if desired.
+}
+
+/* Send half of a cycle: frames the IOmap outputs of the groups due on this cycle and puts them on the wire. */
+static int cycle_send(soem_handle_t* h)
+{
+    int expected = 0;
+    int wkc = h->ring ? soem_ring_send(h, &expected) : soem_group_send(h, &expected);
+    h->last_expected_wkc = expected;
+    if (wkc < 0) {
+        LOG_EVENT(SOEM_LOG_ERR, SOEM_LOGC_SEND_FAIL, wkc, expected);
+        return SOEM_ERR_SEND_FAIL;
+    }
+    soem_red_arm(h);
+    soem_cap_sent(h);
     return 1;
 }
 
-SOEMSHIM_EXPORT int soem_exchange_process_data(
+/* Receive half: waits up to timeout_us for the frames, copies the inputs into the IOmap and grades the WKC. */
+static int cycle_receive(soem_handle_t* h, int timeout_us)
+{
+    ec_groupt* g = &h->context.grouplist[0];
+    int expected = h->last_expected_wkc;  // of the groups cycle_send put on the wire
+
+    int wkc = h->ring ? soem_ring_receive(h, timeout_us) : ecx_receive_processdata(&h->context, timeout_us);
+    h->last_wkc = wkc;  
+    int64_t now = now_ns();
+    soem_group_note(h, wkc, now);
+    if (wkc >= 0 && h->dc) soem_dc_track(h, now, 0);  // statistics only, this loop cannot steer its timer
+    soem_state_note(h, wkc, expected, now);
+    soem_red_note(h, now);
+    soem_cap_received(h, wkc, expected);
+
+    if (wkc < 0) {
+        LOG_EVENT(SOEM_LOG_ERR, SOEM_LOGC_RECV_FAIL, wkc, expected, timeout_us);
+        return SOEM_ERR_RECV_FAIL;
+    }
+
+    // If expected is zero (misconfigured group), don't false-trigger; just log once.
+    if (expected <= 0) {
+        LOG_EVENT(SOEM_LOG_WARN, SOEM_LOGC_WKC_ZERO, expected, wkc);
+        return wkc; // best-effort
+    }
+
+    if (wkc < expected) {
+        LOG_EVENT(SOEM_LOG_ERR, SOEM_LOGC_WKC_LOW, wkc, expected, g->Obytes, g->Ibytes, g->outputsWKC, g->inputsWKC);
+        return SOEM_ERR_WKC_LOW;
+    }
+
+    return wkc;  // OK
+}
+
+/* One cycle into the latency histograms. entry_ns is when the cycle started (its lateness is graded against the
+   cycle_period_ns schedule); received_ns is 0 when the frames never came back. */
+static void record_cycle(soem_handle_t* h, int64_t entry_ns, int64_t sent_ns, int64_t received_ns)
+{
+    if (!h->stats || !sent_ns) return;
+    soem_stats_record(h, soem_stats_lateness(h, entry_ns), received_ns ? received_ns - sent_ns : -1, now_ns() - entry_ns);
+}
+
+/* Body of soem_exchange_process_data. *sent_ns / *received_ns are set once the frames went out / came back. */
+static int exchange_io(
     soem_handle_t* h,
     const uint8_t* outputs, int outputs_len,
     uint8_t* inputs, int inputs_len,
-    int timeout_us)
+    int timeout_us, int64_t* sent_ns, int64_t* received_ns)
 {
-    if (!h) return SOEM_ERR_BAD_ARGS;
+    if (soem_rt_is_running(h)) return SOEM_ERR_BUSY; // the RT thread owns the bus
+    if (h->cycle_in_flight) return SOEM_ERR_BUSY;   // a split cycle owns the frames on the wire
 
     ec_groupt* g = &h->context.grouplist[0];
 
@@ -281,105 +423,356 @@ SOEMSHIM_EXPORT int soem_exchange_process_data(
         // else: leave IOmap outputs as-is (e.g., set by soem_write_rxpdo)
     }
 
-    int wkc = ecx_send_processdata(&h->context);
-    int expected = (int)(g->outputsWKC * 2 + g->inputsWKC);
+    *sent_ns = now_ns();
+    int rc = cycle_send(h);
+    if (rc < 0) return rc;
 
-    if (wkc < 0) {
-        LOGE("ecx_send_processdata failed rc=%d (expected WKC=%d)", wkc, expected);
-        return SOEM_ERR_SEND_FAIL;
+    rc = cycle_receive(h, timeout_us);
+    if (rc == SOEM_ERR_RECV_FAIL) return rc;
+    *received_ns = now_ns();
+
+    // Copy inputs up to Ibytes (also on a low WKC: the healthy slaves' inputs are valid)
+    if (inputs && inputs_len > 0 && g->Ibytes) {
+        int copy = inputs_len < (int)g->Ibytes ? inputs_len : (int)g->Ibytes;
+        if (copy > 0) memcpy(inputs, g->inputs, (size_t)copy);
     }
 
-    wkc = ecx_receive_processdata(&h->context, timeout_us);
-    h->last_wkc = wkc;  
-    h->last_expected_wkc = expected;
+    return rc;
+}
 
-    if (wkc < 0) {
-        LOGE("ecx_receive_processdata failed rc=%d (expected WKC=%d, timeout_us=%d)", wkc, expected, timeout_us);
-        return SOEM_ERR_RECV_FAIL;
+SOEMSHIM_EXPORT int soem_exchange_process_data(
+    soem_handle_t* h,
+    const uint8_t* outputs, int outputs_len,
+    uint8_t* inputs, int inputs_len,
+    int timeout_us)
+{
+    if (!h) return SOEM_ERR_BAD_ARGS;
+    soem_log_bind(h->bus_id);
+    int64_t entry = now_ns(), sent = 0, received = 0;
+    int rc = exchange_io(h, outputs, outputs_len, inputs, inputs_len, timeout_us, &sent, &received);
+    record_cycle(h, entry, sent, received);
+    return rc;
+}
+
+/* Status words of slaves 1..tx_count from the IOmap inputs. Returns how many slaves had a full TxPDO. */
+static int read_cycle_statuses(soem_handle_t* h, soem_status_word_t* tx, int tx_count)
+{
+    ecx_contextt* ctx = &h->context;
+    if (tx_count > ctx->slavecount) tx_count = ctx->slavecount;
+
+    int unpacked = 0;
+    for (int i = 0; i < tx_count; ++i) {
+        ec_slavet* slave = &ctx->slavelist[i + 1];
+        if (slave->inputs && (int)slave->Ibytes >= IO_TX_BYTES) {
+            read_status_word((const uint8_t*)slave->inputs, &tx[i]);
+            ++unpacked;
+        }
     }
+    return unpacked;
+}
 
-    // Copy inputs up to Ibytes
-    if (inputs && inputs_len > 0 && g->Ibytes) {
-        int copy = inputs_len < (int)g->Ibytes ? inputs_len : (int)g->Ibytes;
-        if (copy > 0) memcpy(inputs, g->inputs, (size_t)copy);
+SOEMSHIM_EXPORT int soem_cycle(soem_handle_t* h, const DriveRxPDO* rx, int rx_count, soem_status_word_t* tx, int tx_count,
+    int timeout_us, soem_cycle_result_t* res)
+{
+    if (!h || rx_count < 0 || tx_count < 0 || (rx_count > 0 && !rx) || (tx_count > 0 && !tx)) return SOEM_ERR_BAD_ARGS;
+    soem_log_bind(h->bus_id);
+
+    int64_t t0 = now_ns();
+    ecx_contextt* ctx = &h->context;
+    int n = ctx->slavecount;
+    if (rx_count > n) rx_count = n;
+    if (tx_count > n) tx_count = n;
+
+    for (int i = 0; i < rx_count; ++i) {
+        ec_slavet* slave = &ctx->slavelist[i + 1];
+        if (slave->outputs && (int)slave->Obytes >= IO_RX_BYTES)
+            soem_write_rxpdo(h, i + 1, &rx[i]);
     }
 
-    // If expected is zero (misconfigured group), don't false-trigger; just log once.
-    if (expected <= 0) {
-        LOGW("Expected WKC is %d (check mapping). Returning wkc=%d", expected, wkc);
-        return wkc; // best-effort
+    int64_t t1 = now_ns(), sent = 0, received = 0;
+    int rc = exchange_io(h, NULL, 0, NULL, 0, timeout_us, &sent, &received);
+    int64_t t2 = now_ns();
+
+    // Unpack even on WKC_LOW so callers see whatever the healthy slaves reported.
+    int unpacked = (rc >= 0 || rc == SOEM_ERR_WKC_LOW) ? read_cycle_statuses(h, tx, tx_count) : 0;
+
+    if (res) {
+        res->status = rc;
+        res->wkc = h->last_wkc;
+        res->expected_wkc = h->last_expected_wkc;
+        res->error_pending = ecx_iserror(ctx) ? 1 : 0;
+        res->state_due = soem_state_due(h) || soem_red_due(h);
+        res->red_path = soem_red_path(h);
+        res->slave_count = n;
+        res->tx_count = unpacked;
+        res->exchange_ns = t2 - t1;
+        res->total_ns = now_ns() - t0;
     }
 
-    if (wkc < expected) {
-        LOGE("WKC low: got=%d expected=%d (Obytes=%u Ibytes=%u, oWKC=%u iWKC=%u)",
-            wkc, expected, (unsigned)g->Obytes, (unsigned)g->Ibytes,
-            (unsigned)g->outputsWKC, (unsigned)g->inputsWKC);
-        return SOEM_ERR_WKC_LOW;
+    record_cycle(h, t0, sent, received);
+    return rc;
+}
+
+SOEMSHIM_EXPORT int soem_send_cycle(soem_handle_t* h)
+{
+    if (!h) return SOEM_ERR_BAD_ARGS;
+    if (soem_rt_is_running(h)) return SOEM_ERR_BUSY;
+    if (h->cycle_in_flight) return SOEM_ERR_BUSY;
+    soem_log_bind(h->bus_id);
+
+    h->cycle_sent_ns = now_ns();
+    h->cycle_done_ns = 0;
+    int rc = cycle_send(h);
+    if (rc < 0) return rc;
+    h->cycle_in_flight = 1;
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_poll_cycle(soem_handle_t* h)
+{
+    if (!h || !h->cycle_in_flight) return SOEM_ERR_BAD_ARGS;
+    if (h->cycle_done_ns) return 1;
+
+    if (h->ring) {
+        if (!soem_ring_wait(h, 0)) return 0;
+        h->cycle_done_ns = now_ns();
+        return 1;
     }
 
-    return wkc;  // OK
+    // Frames of this cycle are idxstack entries [pulled, pushed). A zero-timeout ecx_waitinframe makes one
+    // attempt to read the socket; a frame it returns is handed back as EC_BUF_RCVD, the state SOEM uses for
+    // frames that arrived while it waited on another index, so ecx_receive_processdata still consumes it.
+    ecx_contextt* ctx = &h->context;
+    for (int pos = ctx->idxstack.pulled; pos < ctx->idxstack.pushed; ++pos) {
+        uint8 idx = ctx->idxstack.idx[pos];
+        if (ctx->port.rxbufstat[idx] == EC_BUF_RCVD) continue;
+        if (ecx_waitinframe(&ctx->port, idx, 0) <= EC_NOFRAME) return 0;
+        ecx_setbufstat(&ctx->port, idx, EC_BUF_RCVD);
+    }
+
+    h->cycle_done_ns = now_ns();
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_receive_cycle(soem_handle_t* h, soem_status_word_t* tx, int tx_count, int timeout_us, soem_cycle_result_t* res)
+{
+    if (!h || !h->cycle_in_flight || tx_count < 0 || (tx_count > 0 && !tx)) return SOEM_ERR_BAD_ARGS;
+    if (timeout_us < 0) timeout_us = 0;
+    soem_log_bind(h->bus_id);
+
+    int rc = cycle_receive(h, timeout_us);
+    h->cycle_in_flight = 0;
+    int64_t done = h->cycle_done_ns ? h->cycle_done_ns : now_ns();
+
+    int unpacked = (rc >= 0 || rc == SOEM_ERR_WKC_LOW) ? read_cycle_statuses(h, tx, tx_count) : 0;
+
+    if (res) {
+        res->status = rc;
+        res->wkc = h->last_wkc;
+        res->expected_wkc = h->last_expected_wkc;
+        res->error_pending = ecx_iserror(&h->context) ? 1 : 0;
+        res->state_due = soem_state_due(h) || soem_red_due(h);
+        res->red_path = soem_red_path(h);
+        res->slave_count = h->context.slavecount;
+        res->tx_count = unpacked;
+        res->exchange_ns = done - h->cycle_sent_ns;
+        res->total_ns = now_ns() - h->cycle_sent_ns;
+    }
+
+    record_cycle(h, h->cycle_sent_ns, h->cycle_sent_ns, rc == SOEM_ERR_RECV_FAIL ? 0 : done);
+
+    return rc;
+}
+
+/* Move every slave/group process data pointer that points into [from, from + size) over to the same offset in to. */
+static void iomap_rebase(ecx_contextt* ctx, const uint8* from, uint8* to, size_t size)
+{
+#define IOMAP_REBASE(p) \
+    do { if ((p) && (const uint8*)(p) >= from && (const uint8*)(p) <= from + size) (p) = to + ((const uint8*)(p) - from); } while (0)
+
+    for (int i = 0; i <= ctx->slavecount; ++i) {
+        IOMAP_REBASE(ctx->slavelist[i].outputs);
+        IOMAP_REBASE(ctx->slavelist[i].inputs);
+        IOMAP_REBASE(ctx->slavelist[i].mbxstatus);
+    }
+    for (int g = 0; g < EC_MAXGROUP; ++g) {
+        IOMAP_REBASE(ctx->grouplist[g].outputs);
+        IOMAP_REBASE(ctx->grouplist[g].inputs);
+        IOMAP_REBASE(ctx->grouplist[g].mbxstatus);
+    }
+#undef IOMAP_REBASE
 }
 
 SOEMSHIM_EXPORT soem_handle_t* soem_initialize(const char* ifname)
 {
+    return soem_initialize_ex(ifname, NULL);
+}
+
+static soem_handle_t* initialize(const char* ifname, const char* if2name, const soem_init_options_t* options);
+
+SOEMSHIM_EXPORT soem_handle_t* soem_initialize_ex(const char* ifname, const soem_init_options_t* options)
+{
+    return initialize(ifname, NULL, options);
+}
+
+SOEMSHIM_EXPORT soem_handle_t* soem_initialize_redundant(const char* ifname, const char* if2name, const soem_init_options_t* options)
+{
+    if (!if2name || !*if2name) {
+        int tagged = options && options->struct_size >= offsetof(soem_init_options_t, bus_id) + sizeof(uint32_t);
+        soem_log_bind(tagged ? options->bus_id : 0);
+        LOGE("soem_initialize_redundant: no secondary interface given");
+        return NULL;
+    }
+    return initialize(ifname, if2name, options);
+}
+
+static soem_handle_t* initialize(const char* ifname, const char* if2name, const soem_init_options_t* options)
+{
+    // Callers built against an older header pass a shorter struct; missing fields stay zero.
+    soem_init_options_t opts = { 0 };
+    if (options) {
+        size_t n = options->struct_size < sizeof(opts) ? options->struct_size : sizeof(opts);
+        memcpy(&opts, options, n);
+    }
+
+    // Bound before anything logs, so even a failed initialization reaches the caller's sink for this bus.
+    uint32_t bus = opts.bus_id ? opts.bus_id : soem_log_new_bus();
+    soem_log_bind(bus);
+    int64_t started = now_ns();
+
     soem_handle_t* handle = (soem_handle_t*)calloc(1, sizeof(soem_handle_t));
     if (!handle) return NULL;
 
+    handle->bus_id = bus;
     handle->last_wkc = -1;
     handle->last_expected_wkc = 0;
 
     // returns greater than 0 if successful
-    if (!ecx_init(&handle->context, ifname))
+    if (if2name) {
+        ecx_redportt* redport = soem_red_create(handle);
+        if (!redport || !ecx_init_redundant(&handle->context, redport, ifname, (char*)if2name))
+        {
+            LOGE("ecx_init_redundant failed for interfaces '%s' / '%s'", ifname ? ifname : "(null)", if2name);
+            soem_red_release(handle);
+            free(handle);
+            return NULL;
+        }
+        LOGI("Cable redundancy: primary '%s', secondary '%s'", ifname, if2name);
+    }
+    else if (!ecx_init(&handle->context, ifname))
     {
         LOGE("ecx_init failed for interface '%s'", ifname ? ifname : "(null)");
         free(handle);
         return NULL;
     }
 
-    // returns number of slaves found, if <=0 no slaves found, shutdown.
-    int slave_count = ecx_config_init(&handle->context);
-    if (slave_count <= 0)
+    handle->boot.nic_ns = now_ns() - started;
+
+    // SOEM can only tell us the IOmap size by mapping into a buffer, so map into a scratch buffer first
+    // (64 KiB is conservative), then move the image into an exactly sized, cache-line aligned allocation.
+    size_t scratch_size = SOEM_IOMAP_SCRATCH;
+    uint8* scratch = (uint8*)calloc(1, scratch_size);
+    if (!scratch)
     {
-        LOGE("ecx_config_init failed: no slaves found or error (rc=%d)", slave_count);
+        LOGE("IOmap allocation failed (size=%zu)", scratch_size);
         ecx_close(&handle->context);
+        soem_red_release(handle);
         free(handle);
         return NULL;
     }
 
-    // allocate a comfortably sized IOmap (you can tune this; 64 KiB is conservative)
-    size_t iomap_size = 64 * 1024;
-    handle->IOmap = (uint8*)malloc(iomap_size);
+    // A stored configuration that matches the bus stands in for the discovery and the mapping below.
+    int64_t configure_started = now_ns();
+    int actual_size = 0;
+    handle->boot.config = soem_boot_restore(handle, &opts, scratch, scratch_size, &actual_size, &handle->boot.mismatch_slave);
+    int cached = handle->boot.config == SOEM_CONFIG_USED;
 
-    // if allocation failed, cleanup and exit
-    if (!handle->IOmap)
+    // returns number of slaves found, if <=0 no slaves found, shutdown.
+    int slave_count = cached ? handle->context.slavecount : soem_sii_config_init(handle, &opts);
+    if (slave_count <= 0)
     {
-        LOGE("IOmap allocation failed (size=%zu)", iomap_size);
+        LOGE("ecx_config_init failed: no slaves found or error (rc=%d)", slave_count);
         ecx_close(&handle->context);
+        soem_red_release(handle);
+        free(scratch);
         free(handle);
         return NULL;
     }
-    memset(handle->IOmap, 0, iomap_size); // Zero IOmap after alloc.
+    int64_t mapping_started = now_ns();
+    handle->boot.discovery_ns = mapping_started - configure_started;
+
+    if (!soem_group_assign(handle, &opts))
+        LOGW("process-data group state unavailable (allocation failed); mapping every slave into group 0");
+
+    // Before mapping: the cyclic mailbox handler needs each slave's mailbox status in the process-data frame.
+    int mailbox_slaves = opts.sdo_workers ? soem_sdo_prepare(handle) : 0;
+    if (opts.sdo_workers && !mailbox_slaves)
+        LOGW("sdo_workers=%u requested but no slave has a CoE mailbox; SDO access stays off", opts.sdo_workers);
 
     // returns IO map size, if <=0 no IO map configured, shutdown.
-    int actual_size = ecx_config_map_group(&handle->context, handle->IOmap, 0);
+    if (!cached) actual_size = soem_group_map(handle, scratch, scratch_size);
     if (actual_size <= 0)
     {
         LOGE("ecx_config_map_group failed: rc=%d", actual_size);
         ecx_close(&handle->context);
-        free(handle->IOmap);
+        soem_red_release(handle);
+        soem_group_release(handle);
+        free(scratch);
         free(handle);
         return NULL;
     }
-    if ((size_t)actual_size > iomap_size)
+    if ((size_t)actual_size > scratch_size)
     {
-        LOGE("ecx_config_map_group: actual IOmap size (%d) exceeds allocated size (%zu). Aborting to prevent memory corruption.", actual_size, iomap_size);
+        LOGE("ecx_config_map_group: actual IOmap size (%d) exceeds allocated size (%zu). Aborting to prevent memory corruption.", actual_size, scratch_size);
         ecx_close(&handle->context);
-        free(handle->IOmap);
+        soem_red_release(handle);
+        soem_group_release(handle);
+        free(scratch);
         free(handle);
         return NULL;
     }
 
+    if (!iomap_alloc(handle, (size_t)actual_size, opts.iomap_flags))
+    {
+        LOGE("IOmap allocation failed (size=%d)", actual_size);
+        ecx_close(&handle->context);
+        soem_red_release(handle);
+        soem_group_release(handle);
+        free(scratch);
+        free(handle);
+        return NULL;
+    }
+    memcpy(handle->IOmap, scratch, (size_t)actual_size);
+    iomap_rebase(&handle->context, scratch, handle->IOmap, (size_t)actual_size);
+    free(scratch);
+    soem_group_mapped(handle);
+    LOGI("IOmap: %d bytes at %p (capacity=%zu locked=%d huge=%d)", actual_size, (void*)handle->IOmap,
+        handle->iomap_capacity, handle->iomap_locked, handle->iomap_kind == SOEM_IOMAP_KIND_PAGES);
+
+    handle->boot.source = cached ? SOEM_BOOT_CACHED : SOEM_BOOT_DISCOVERED;
+    handle->boot.slaves = slave_count;
+    handle->boot.configure_ns = now_ns() - configure_started;
+    LOGI("Bus configured %s in %.1f ms (%d slaves)", cached ? "from the stored configuration" : "by discovery",
+        handle->boot.configure_ns / 1e6, slave_count);
+    // Before ecx_configdc, which fills in the DC fields from the live bus on every start anyway.
+    if (!cached && opts.config_path && *opts.config_path)
+        handle->boot.config_written = soem_boot_save(handle, &opts);
+
+    int64_t dc_started = now_ns();
+    handle->boot.mapping_ns = dc_started - mapping_started;
     ecx_configdc(&handle->context);
+    if (opts.dc_cycle_ns > 0) {
+        int synced = soem_dc_enable(handle, opts.dc_cycle_ns, opts.dc_shift_ns, opts.dc_lead_ns);
+        soem_dc_stats_t dc;
+        soem_get_dc_stats(handle, &dc);
+        if (synced > 0)
+            LOGI("SYNC0 on %d slave(s): cycle=%uns shift=%dns lead=%dns", synced, opts.dc_cycle_ns, dc.shift_ns, dc.lead_ns);
+        else if (synced == 0)
+            LOGW("dc_cycle_ns=%u requested but no slave has distributed clocks; cycling unsynchronized", opts.dc_cycle_ns);
+        else
+            LOGE("DC state allocation failed; cycling unsynchronized");
+    }
+    handle->boot.dc_ns = now_ns() - dc_started;
 
     int count = soem_get_slave_count(handle);
 
@@ -389,39 +782,64 @@ SOEMSHIM_EXPORT soem_handle_t* soem_initialize(const char* ifname)
         memcpy(rx.Command, "NOP", 3);           // dont copy the '\0' unless your field expects it
         // Execute stays 0
         if (!soem_write_rxpdo(handle, i, &rx)) {
-            LOGE("write_rxpdo failed for slave %d", i);
+            LOGE("write_rxpdo failed for slave %d (Obytes=%d, need %d)", i, (int)handle->context.slavelist[i].Obytes, IO_RX_BYTES);
         }
     }
 
-    // One actual bus cycle (send+recv). No outputs buffer -> uses staged IOmap.
-    int rc = soem_exchange_process_data(handle, NULL, 0, NULL, 0, 2000);
-    if (rc < 0) LOGE("probe exchange failed rc=%d", rc);
-
+    // Cyclic exchange of the staged outputs from here to OP; each slave is requested to OP once it reports SAFE-OP.
+    int64_t period_ns = opts.cycle_period_ns ? opts.cycle_period_ns : opts.dc_cycle_ns ? opts.dc_cycle_ns : SOEM_STARTUP_PERIOD_NS;
+    handle->boot.op_slaves = soem_state_bringup(handle, period_ns, SOEM_STARTUP_TIMEOUT_NS, &handle->boot.safeop_ns, &handle->boot.op_ns);
 
     // Now read inputs that were received
     for (int i = 1; i <= count; ++i) {
         DriveTxPDO tx = { 0 };
         if (soem_read_txpdo(handle, i, &tx)) {
             LOGI("Slave %d ActualPosition=%d", i, tx.ActualPosition);
+        } else {
+            LOGE("read_txpdo failed for slave %d (Ibytes=%d, need %d)", i, (int)handle->context.slavelist[i].Ibytes, IO_TX_BYTES);
         }
     }
 
-    ecx_statecheck(&handle->context, 0, EC_STATE_SAFE_OP, EC_TIMEOUTSTATE * 4);
-
-    handle->context.slavelist[0].state = EC_STATE_OPERATIONAL;
-    ecx_writestate(&handle->context, 0);
-    ecx_statecheck(&handle->context, 0, EC_STATE_OPERATIONAL, EC_TIMEOUTSTATE);
+    for (int g = 0; g < EC_MAXGROUP; ++g) {
+        handle->output_length += (int)handle->context.grouplist[g].Obytes;
+        handle->input_length  += (int)handle->context.grouplist[g].Ibytes;
+    }
 
-    ec_groupt *group = &handle->context.grouplist[0];
-    handle->output_length = (int)group->Obytes;
-    handle->input_length  = (int)group->Ibytes;
+    if (mailbox_slaves) {
+        int workers = soem_sdo_start(handle, (int)opts.sdo_workers, (int)opts.sdo_actions);
+        if (workers > 0)
+            LOGI("SDO engine: %d CoE slave(s) on the cyclic mailbox handler, %d worker(s)", mailbox_slaves, workers);
+        else
+            LOGE("SDO engine could not be started; SDO access stays off");
+    }
 
+    // After bring-up, so SOEM's own cycles above had the interface to themselves.
+    if (opts.nic_backend == SOEM_NIC_RING)
+        soem_ring_open(handle, ifname, (int)opts.nic_ring_frames);
+    soem_cap_open(handle, &opts);
+
+    // Bring-up cycles above stay out of the latency histograms.
+    if (!soem_stats_init(handle, opts.cycle_period_ns))
+        LOGW("cycle statistics unavailable (allocation failed)");
+    if (!soem_state_init(handle, (int64_t)opts.state_check_ms * 1000000))
+        LOGW("AL state cache unavailable (allocation failed); soem_get_health reads states on every call");
+
+    handle->boot.total_ns = now_ns() - started;
+    LOGI("Startup %.1f ms: NIC %.1f, discovery %.1f, mapping %.1f, DC %.1f, SAFE-OP %.1f, OP %.1f ms; %d/%d slave(s) in OP",
+        handle->boot.total_ns / 1e6, handle->boot.nic_ns / 1e6, handle->boot.discovery_ns / 1e6, handle->boot.mapping_ns / 1e6,
+        handle->boot.dc_ns / 1e6, handle->boot.safeop_ns / 1e6, handle->boot.op_ns / 1e6, handle->boot.op_slaves, slave_count);
     return handle;
 }
 
 SOEMSHIM_EXPORT int soem_try_recover(soem_handle_t* h, int timeout_ms)
 {
     if (!h) return 0;
+    soem_log_bind(h->bus_id);
+    if (soem_rt_is_running(h)) {
+        LOGW("soem_try_recover: stop the cyclic engine before recovering");
+        return 0;
+    }
+    soem_state_invalidate(h);  // states change under recovery; the next cycle reports a read as due
     ecx_readstate(&h->context);
 
     for (int i = 1; i <= h->context.slavecount; ++i) {
@@ -459,36 +877,89 @@ SOEMSHIM_EXPORT int soem_try_recover(soem_handle_t* h, int timeout_ms)
     return ok;
 }
 
+SOEMSHIM_EXPORT uint8_t* soem_get_iomap(soem_handle_t* h, int* size)
+{
+    if (!h || !h->IOmap) {
+        if (size) *size = 0;
+        return NULL;
+    }
+    if (size) *size = (int)h->iomap_size;
+    return (uint8_t*)h->IOmap;
+}
+
+SOEMSHIM_EXPORT int soem_get_io_layout(soem_handle_t* h, soem_slave_io_t* out, int max_count)
+{
+    if (!h || !out || max_count <= 0 || !h->IOmap) return 0;
+
+    int count = h->context.slavecount < max_count ? h->context.slavecount : max_count;
+    for (int i = 0; i < count; ++i) {
+        ec_slavet* s = &h->context.slavelist[i + 1];
+        out[i].out_offset = (s->outputs && s->Obytes) ? (int32_t)(s->outputs - h->IOmap) : -1;
+        out[i].out_bytes = s->outputs ? (int32_t)s->Obytes : 0;
+        out[i].in_offset = (s->inputs && s->Ibytes) ? (int32_t)(s->inputs - h->IOmap) : -1;
+        out[i].in_bytes = s->inputs ? (int32_t)s->Ibytes : 0;
+    }
+    return count;
+}
+
 SOEMSHIM_EXPORT int soem_get_health(soem_handle_t* h, soem_health_t* out)
 {
     if (!h || !out) return 0;
     memset(out, 0, sizeof(*out));
-    ec_groupt* g = &h->context.grouplist[0];
     out->slaves_found = h->context.slavecount;
-    out->group_expected_wkc = (int)((g->outputsWKC * 2) + g->inputsWKC);
+    for (int i = 0; i < EC_MAXGROUP; ++i) {  // every group; one cycle may carry only some of them
+        ec_groupt* g = &h->context.grouplist[i];
+        out->group_expected_wkc += (int)((g->outputsWKC * 2) + g->inputsWKC);
+        out->bytes_out += (int)g->Obytes;
+        out->bytes_in += (int)g->Ibytes;
+    }
     out->last_wkc = h->last_wkc; // set in exchange
-    out->bytes_out = (int)g->Obytes;
-    out->bytes_in = (int)g->Ibytes;
 
-    ecx_readstate(&h->context);
-    int op = 0;
-    for (int i = 1; i <= h->context.slavecount; ++i)
-        if (h->context.slavelist[i].state == EC_STATE_OPERATIONAL) ++op;
-    out->slaves_op = op;
-
-    // best-effort AL status from first slave (optional)
-    if (h->context.slavecount >= 1)
-        out->al_status_code = h->context.slavelist[1].ALstatuscode;
+    if (!soem_state_summary(h, &out->slaves_op, &out->al_status_code)) {
+        // No state cache (allocation failed at init): read on the spot as before.
+        ecx_readstate(&h->context);
+        int op = 0;
+        for (int i = 1; i <= h->context.slavecount; ++i)
+            if (h->context.slavelist[i].state == EC_STATE_OPERATIONAL) ++op;
+        out->slaves_op = op;
+        if (h->context.slavecount >= 1)
+            out->al_status_code = h->context.slavelist[1].ALstatuscode;
+    }
 
+    soem_get_dc_stats(h, &out->dc);
     return 1;
 }
 
+SOEMSHIM_EXPORT int soem_check_state(soem_handle_t* h, int force)
+{
+    if (!h) return 0;
+    if (soem_rt_is_running(h) || h->cycle_in_flight) return SOEM_ERR_BUSY;
+    soem_log_bind(h->bus_id);
+    if (soem_red_due(h)) soem_red_probe(h);
+    if (!force && !soem_state_due(h)) return 0;
+    return soem_state_refresh(h);
+}
+
+SOEMSHIM_EXPORT int soem_recover_step(soem_handle_t* h)
+{
+    if (!h) return 0;
+    if (soem_rt_is_running(h) || h->cycle_in_flight) return SOEM_ERR_BUSY;
+    soem_log_bind(h->bus_id);
+    return soem_state_recover_step(h);
+}
+
+SOEMSHIM_EXPORT uint32_t soem_get_bus_id(soem_handle_t* h)
+{
+    return h ? h->bus_id : 0;
+}
+
 SOEMSHIM_EXPORT int soem_get_network_adapters()
 {
     
     ec_adaptert* adapter = NULL;
     ec_adaptert* head = NULL;
 
+    soem_log_bind(0);
     LOGI("\nAvailable adapters:\n");
     head = adapter = ec_find_adapters();
     while (adapter != NULL)
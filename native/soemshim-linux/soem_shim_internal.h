@@ -0,0 +1,113 @@
+#pragma once
+/* Declarations shared between the soemshim translation units. Nothing in here is exported. */
+#include "soem_shim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Expected raw IO byte sizes according to slaveinfo mapping, confirmed from 'EtherCAT commands - Xeryon.pdf'
+#define IO_RX_BYTES 20  // "Output size: 160bits" -> 20 bytes
+#define IO_TX_BYTES 8   // "Input size: 64bits"  -> 8 bytes
+
+/* Logging (soem_log.c): LOGI/LOGW/LOGE and LOG_EVENT land here. Neither blocks; a full ring drops the record. */
+void log_message(soem_log_level_t lvl, const char* fmt, ...);
+void soem_log_event(soem_log_level_t lvl, int code, const int64_t* args, int argc);
+void soem_log_bind(uint32_t bus);
+
+/* Pack a DriveRxPDO into its 20-byte wire image. Does not log, safe to call from the RT thread. */
+void soem_pack_rxpdo(uint8_t* buf, const DriveRxPDO* in);
+
+/* Input scan state (soem_scan.c) */
+void soem_scan_release(soem_handle_t* h);
+
+/* Distributed clocks (soem_dc.c). soem_dc_enable returns the SYNC0 slave count, -1 on allocation failure. */
+int     soem_dc_enable(soem_handle_t* h, uint32_t cycle_ns, int32_t shift_ns, int32_t lead_ns);
+int64_t soem_dc_track(soem_handle_t* h, int64_t host_ns, int steer);
+void    soem_dc_rearm_slave(soem_handle_t* h, int slave);
+void    soem_dc_release(soem_handle_t* h);
+
+/* Cycle latency histograms (soem_stats.c). Negative values passed to soem_stats_record are skipped. */
+int     soem_stats_init(soem_handle_t* h, int64_t period_ns);
+void    soem_stats_release(soem_handle_t* h);
+int64_t soem_stats_lateness(soem_handle_t* h, int64_t entry_ns);
+void    soem_stats_record(soem_handle_t* h, int64_t wake_lateness_ns, int64_t round_trip_ns, int64_t total_ns);
+
+/* Cable redundancy (soem_red.c). soem_red_arm goes right after ecx_send_processdata, soem_red_note right after
+   the receive; soem_red_probe reads every slave's DL status, so call it only between cycles. */
+ecx_redportt* soem_red_create(soem_handle_t* h);
+void soem_red_release(soem_handle_t* h);
+void soem_red_arm(soem_handle_t* h);
+int  soem_red_note(soem_handle_t* h, int64_t now_ns);
+int  soem_red_due(const soem_handle_t* h);
+int  soem_red_path(const soem_handle_t* h);
+int  soem_red_probe(soem_handle_t* h);
+
+/* Fast boot (soem_boot.c). soem_boot_restore runs right after the NIC is open, in place of ecx_config_init and
+   soem_group_map when it returns SOEM_CONFIG_USED; soem_boot_save runs after a discovery once the IOmap is final. */
+int  soem_boot_restore(soem_handle_t* h, const soem_init_options_t* opts, uint8* iomap, size_t capacity, int* size,
+    int* mismatch_slave);
+int  soem_boot_save(soem_handle_t* h, const soem_init_options_t* opts);
+
+/* SII cache (soem_sii.c): ecx_config_init, with the SII of known slaves served from opts->sii_cache_path. */
+int  soem_sii_config_init(soem_handle_t* h, const soem_init_options_t* opts);
+
+/* Process-data groups (soem_group.c). soem_group_assign and soem_group_map run at init between ecx_config_init
+   (or soem_boot_restore) and the first exchange; soem_group_send replaces ecx_send_processdata and soem_group_note goes right after the
+   receive. */
+int  soem_group_assign(soem_handle_t* h, const soem_init_options_t* opts);
+int  soem_group_map(soem_handle_t* h, uint8* iomap, size_t capacity);
+void soem_group_mapped(soem_handle_t* h);
+void soem_group_release(soem_handle_t* h);
+int  soem_group_send(soem_handle_t* h, int* expected);
+void soem_group_note(soem_handle_t* h, int wkc, int64_t now_ns);
+uint32_t soem_group_next(soem_handle_t* h);
+void soem_group_take_wkc(soem_handle_t* h, const int* group_wkc);
+
+/* CoE SDO engine (soem_sdo.c). soem_sdo_prepare runs at init between soem_group_assign and soem_group_map,
+   soem_sdo_start once the bus is in OP; soem_sdo_step drives the mailbox handler, so call it only between cycles. */
+int  soem_sdo_prepare(soem_handle_t* h);
+int  soem_sdo_start(soem_handle_t* h, int workers, int actions);
+void soem_sdo_release(soem_handle_t* h);
+int  soem_sdo_step(soem_handle_t* h);
+int  soem_sdo_due(const soem_handle_t* h);
+
+/* Memory-mapped frame rings (soem_ring.c, Linux only). soem_ring_open runs at the end of init; from then on
+   soem_ring_send/soem_ring_receive replace soem_group_send/ecx_receive_processdata for the cyclic frames.
+   soem_ring_wait(h, 0) is the non-blocking check of soem_poll_cycle. */
+int  soem_ring_open(soem_handle_t* h, const char* ifname, int frames);
+void soem_ring_release(soem_handle_t* h);
+int  soem_ring_send(soem_handle_t* h, int* expected);
+int  soem_ring_wait(soem_handle_t* h, int timeout_us);
+int  soem_ring_receive(soem_handle_t* h, int timeout_us);
+
+/* Wire capture (soem_cap.c, Linux only). soem_cap_open runs at the end of init. On the socket path
+   soem_cap_sent goes right after the send and soem_cap_received right after the receive; the ring path hands its
+   slots to soem_cap_frame itself and calls soem_cap_received only for the fault trigger. */
+int  soem_cap_open(soem_handle_t* h, const soem_init_options_t* opts);
+void soem_cap_release(soem_handle_t* h);
+void soem_cap_sent(soem_handle_t* h);
+void soem_cap_received(soem_handle_t* h, int wkc, int expected);
+void soem_cap_frame(soem_handle_t* h, int outgoing, const uint8* frame, uint32_t len, int64_t ts);
+
+/* AL state cache (soem_state.c). soem_state_note grades a cycle's WKC and returns non-zero when a read is due;
+   soem_state_refresh runs ecx_readstate, so call it only between cycles. */
+int  soem_state_init(soem_handle_t* h, int64_t interval_ns);
+void soem_state_release(soem_handle_t* h);
+int  soem_state_note(soem_handle_t* h, int wkc, int expected, int64_t now_ns);
+int  soem_state_due(const soem_handle_t* h);
+void soem_state_invalidate(soem_handle_t* h);
+int  soem_state_refresh(soem_handle_t* h);
+int  soem_state_summary(soem_handle_t* h, int* slaves_op, uint32_t* al_status_code);
+/* Per-slave recovery: one bounded action per call, between cycles only. */
+int  soem_state_recover_step(soem_handle_t* h);
+int  soem_state_recovering(const soem_handle_t* h);
+int  soem_state_bringup(soem_handle_t* h, int64_t period_ns, int64_t timeout_ns, int64_t* safeop_ns, int64_t* op_ns);
+
+/* Cyclic engine (soem_rt.c) */
+int  soem_rt_is_running(const soem_handle_t* h);
+void soem_rt_release(soem_handle_t* h);
+
+#ifdef __cplusplus
+}
+#endif
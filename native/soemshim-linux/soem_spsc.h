@@ -0,0 +1,76 @@
+#pragma once
+/* Single-producer/single-consumer ring of fixed-size slots.
+   The producer reserves a slot, fills it in place and commits; the consumer peeks and releases.
+   Exactly one thread may produce and one thread may consume; no locks, no allocation after init. */
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOEM_CACHELINE 64
+
+typedef struct soem_spsc {
+    _Alignas(SOEM_CACHELINE) _Atomic uint32_t head;   // next slot to write, owned by the producer
+    _Alignas(SOEM_CACHELINE) _Atomic uint32_t tail;   // next slot to read, owned by the consumer
+    _Alignas(SOEM_CACHELINE) uint32_t mask;
+    uint32_t slot_size;
+    uint8_t* slots;
+} soem_spsc_t;
+
+static inline uint32_t soem_spsc_round_pow2(uint32_t v)
+{
+    uint32_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+static inline int soem_spsc_init(soem_spsc_t* r, uint32_t capacity, uint32_t slot_size)
+{
+    capacity = soem_spsc_round_pow2(capacity < 2 ? 2 : capacity);
+    slot_size = (slot_size + 7u) & ~7u;
+    void* mem = NULL;
+    if (posix_memalign(&mem, SOEM_CACHELINE, (size_t)capacity * slot_size) != 0) return 0;
+    memset(mem, 0, (size_t)capacity * slot_size);
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    r->mask = capacity - 1;
+    r->slot_size = slot_size;
+    r->slots = (uint8_t*)mem;
+    return 1;
+}
+
+static inline void soem_spsc_free(soem_spsc_t* r)
+{
+    free(r->slots);
+    r->slots = NULL;
+}
+
+/* Producer: slot to fill, or NULL when the ring is full. */
+static inline void* soem_spsc_reserve(soem_spsc_t* r)
+{
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    if (head - tail > r->mask) return NULL;
+    return r->slots + (size_t)(head & r->mask) * r->slot_size;
+}
+
+static inline void soem_spsc_commit(soem_spsc_t* r)
+{
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+}
+
+/* Consumer: oldest committed slot, or NULL when the ring is empty. */
+static inline const void* soem_spsc_peek(soem_spsc_t* r)
+{
+    uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    if (tail == head) return NULL;
+    return r->slots + (size_t)(tail & r->mask) * r->slot_size;
+}
+
+static inline void soem_spsc_release(soem_spsc_t* r)
+{
+    uint32_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+}
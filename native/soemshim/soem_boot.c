@@ -0,0 +1,452 @@
+/* Fast boot from a stored slave map. A full bring-up (ecx_config_init + ecx_config_map_group) reads every slave's
+   SII and PDO assignment over the bus, slave after slave, and on a line that has not changed all of it comes out
+   the same every time. soem_boot_save writes the configured slave and group lists to config_path once discovery
+   has mapped them; soem_boot_restore checks the bus against that file - the slave count, each slave's
+   vendor/product/revision from the SII identity words and its open ports - and when everything matches it puts
+   the lists back and writes the stored SM and FMMU settings straight to the slaves, skipping the discovery
+   traffic. On any mismatch it returns why and the caller runs the full discovery, which rewrites the file.
+   The file is a snapshot of this build's ec_slavet/ec_groupt in host byte order: only the shim build that wrote
+   it reads it back, anything else is rejected as stale. Shared verbatim by the Windows and Linux shims. */
+#include "soem_shim.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BOOT_MAGIC   0x50414D53u  // "SMAP"
+#define BOOT_VERSION 1u
+
+typedef struct boot_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slave_size;   // sizeof(ec_slavet) of the writing build
+    uint32_t group_size;   // sizeof(ec_groupt)
+    uint32_t groups;       // EC_MAXGROUP
+    uint32_t slavecount;
+    uint32_t options;      // boot_options_key of the options the mapping depends on
+    uint32_t iomap_size;
+    uint32_t checksum;     // FNV-1a over everything after the header
+    uint32_t reserved;
+} boot_header_t;
+
+// Where a slave's or group's process image pointers pointed, as offsets into the IOmap; -1 = NULL.
+typedef struct boot_offsets {
+    int32_t outputs;
+    int32_t inputs;
+    int32_t mbxstatus;
+} boot_offsets_t;
+
+// Body: boot_offsets_t[slavecount + 1], ec_slavet[slavecount + 1], boot_offsets_t[EC_MAXGROUP], ec_groupt[EC_MAXGROUP].
+typedef struct boot_map {
+    boot_header_t hdr;
+    uint8_t* body;
+    boot_offsets_t* slave_at;
+    ec_slavet* slaves;
+    boot_offsets_t* group_at;
+    ec_groupt* groups;
+} boot_map_t;
+
+void log_message(soem_log_level_t lvl, const char* fmt, ...);  // soem_log.c
+
+// FNV-1a; the SII cache (soem_sii.c) checks its file with it too.
+uint32_t soem_boot_fnv(uint32_t hash, const void* data, size_t size)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i) hash = (hash ^ p[i]) * 16777619u;
+    return hash;
+}
+
+/* The options that change the mapping: the group layout and whether mailbox status is mapped for the SDO engine. */
+static uint32_t boot_options_key(const soem_init_options_t* opts)
+{
+    uint32_t groups = opts->group_count > 1 ? opts->group_count : 1;
+    uint32_t sdo = opts->sdo_workers ? 1 : 0;
+    int32_t n = opts->slave_group ? opts->slave_group_count : 0;
+    uint32_t hash = soem_boot_fnv(2166136261u, &groups, sizeof(groups));
+    hash = soem_boot_fnv(hash, &sdo, sizeof(sdo));
+    hash = soem_boot_fnv(hash, &n, sizeof(n));
+    return n > 0 ? soem_boot_fnv(hash, opts->slave_group, (size_t)n) : hash;
+}
+
+static size_t boot_body_size(uint32_t slavecount)
+{
+    return (size_t)(slavecount + 1) * (sizeof(boot_offsets_t) + sizeof(ec_slavet))
+        + (size_t)EC_MAXGROUP * (sizeof(boot_offsets_t) + sizeof(ec_groupt));
+}
+
+static void boot_layout(boot_map_t* m)
+{
+    size_t n = (size_t)m->hdr.slavecount + 1;
+    m->slave_at = (boot_offsets_t*)m->body;
+    m->slaves = (ec_slavet*)(m->slave_at + n);
+    m->group_at = (boot_offsets_t*)(m->slaves + n);
+    m->groups = (ec_groupt*)(m->group_at + EC_MAXGROUP);
+}
+
+/* Runtime state a fresh configuration starts without. The IOmap pointers travel as boot_offsets_t. */
+static void boot_scrub_slave(ec_slavet* s)
+{
+    s->state = 0;
+    s->ALstatuscode = 0;
+    s->outputs = s->inputs = s->mbxstatus = NULL;
+    s->PO2SOconfig = NULL;
+    s->mbx_cnt = 0;
+    s->eep_pdi = 0;  // so ecx_eeprom2pdi hands the EEPROM to the PDI again
+    s->DCactive = 0;
+    s->islost = FALSE;
+    s->mbxhandlerstate = 0;
+    s->mbxrmpstate = 0;
+    s->mbxinstateex = 0;
+    s->coembxin = s->soembxin = s->foembxin = s->eoembxin = s->voembxin = s->aoembxin = NULL;
+    s->coembxinfull = s->soembxinfull = s->foembxinfull = s->eoembxinfull = s->voembxinfull = s->aoembxinfull = FALSE;
+    s->coembxoverrun = s->soembxoverrun = s->foembxoverrun = s->eoembxoverrun = s->voembxoverrun = s->aoembxoverrun = 0;
+}
+
+static int32_t boot_offset(const uint8* base, size_t size, const uint8* p)
+{
+    return p && p >= base && p <= base + size ? (int32_t)(p - base) : -1;
+}
+
+static uint8* boot_pointer(uint8* base, int32_t offset)
+{
+    return offset >= 0 ? base + offset : NULL;
+}
+
+/* Read and check config_path. Returns SOEM_CONFIG_USED with m filled in, or why it cannot be used. */
+static int boot_load(const char* path, const soem_init_options_t* opts, size_t capacity, boot_map_t* m)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        log_message(SOEM_LOG_INFO, "No stored configuration at %s yet; discovering the bus", path);
+        return SOEM_CONFIG_MISSING;
+    }
+
+    const char* why = NULL;
+    memset(m, 0, sizeof(*m));
+    if (fread(&m->hdr, sizeof(m->hdr), 1, f) != 1 || m->hdr.magic != BOOT_MAGIC) {
+        why = "not a stored configuration";
+    } else if (m->hdr.version != BOOT_VERSION || m->hdr.slave_size != sizeof(ec_slavet) || m->hdr.group_size != sizeof(ec_groupt)
+        || m->hdr.groups != EC_MAXGROUP) {
+        why = "written by another shim build";
+    } else if (m->hdr.slavecount < 1 || m->hdr.slavecount >= EC_MAXSLAVE || m->hdr.iomap_size == 0 || m->hdr.iomap_size > capacity) {
+        why = "slave count or IOmap size out of range";
+    } else if (m->hdr.options != boot_options_key(opts)) {
+        why = "mapped with other group or SDO options";
+    } else {
+        size_t size = boot_body_size(m->hdr.slavecount);
+        m->body = (uint8_t*)malloc(size);
+        if (!m->body || fread(m->body, size, 1, f) != 1 || soem_boot_fnv(2166136261u, m->body, size) != m->hdr.checksum)
+            why = "truncated or corrupt";
+    }
+    fclose(f);
+
+    if (why) {
+        log_message(SOEM_LOG_WARN, "Stored configuration %s not used (%s); rediscovering", path, why);
+        free(m->body);
+        m->body = NULL;
+        return SOEM_CONFIG_STALE;
+    }
+    boot_layout(m);
+    return SOEM_CONFIG_USED;
+}
+
+/* What ecx_init_context and ecx_detect_slaves do at the top of ecx_config_init, here and in soem_sii.c. Returns the
+   slaves answering. */
+int soem_boot_detect(ecx_contextt* ctx)
+{
+    ctx->slavecount = 0;
+    memset(ctx->slavelist, 0, sizeof(ctx->slavelist));
+    memset(ctx->grouplist, 0, sizeof(ctx->grouplist));
+    ecx_siigetbyte(ctx, 0, EC_MAXEEPBUF);  // clears SOEM's SII cache
+    for (int g = 0; g < EC_MAXGROUP; ++g) {
+        ctx->grouplist[g].logstartaddr = (uint32)g << EC_LOGGROUPOFFSET;
+        ecx_initmbxqueue(ctx, (uint8)g);
+    }
+
+    uint8 b = 0;
+    uint16 w = htoes(EC_STATE_INIT | EC_STATE_ACK);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DLALIAS, sizeof(b), &b, EC_TIMEOUTRET3);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_ALCTL, sizeof(w), &w, EC_TIMEOUTRET3);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_ALCTL, sizeof(w), &w, EC_TIMEOUTRET3);  // second time for older slaves
+    int wkc = ecx_BRD(&ctx->port, 0x0000, ECT_REG_TYPE, sizeof(w), &w, EC_TIMEOUTSAFE);
+    return wkc < EC_MAXSLAVE ? wkc : -1;
+}
+
+/* The register defaults ecx_set_slaves_to_default broadcasts before any slave is addressed. */
+void soem_boot_defaults(ecx_contextt* ctx)
+{
+    uint8 zero[64] = { 0 };
+    uint8 b;
+    uint16 w;
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DLPORT, 1, zero, EC_TIMEOUTRET3);        // deact loop manual
+    w = htoes(0x0004);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_IRQMASK, sizeof(w), &w, EC_TIMEOUTRET3);  // set IRQ mask
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_RXERR, 8, zero, EC_TIMEOUTRET3);          // reset CRC counters
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_FMMU0, 16 * 3, zero, EC_TIMEOUTRET3);     // reset FMMUs
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_SM0, 8 * 4, zero, EC_TIMEOUTRET3);        // reset SMs
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DCSYNCACT, 1, zero, EC_TIMEOUTRET3);      // reset activation register
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DCSYSTIME, 4, zero, EC_TIMEOUTRET3);      // reset system time + offset
+    w = htoes(0x1000);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DCSPEEDCNT, sizeof(w), &w, EC_TIMEOUTRET3); // DC speedstart
+    w = htoes(0x0c00);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DCTIMEFILT, sizeof(w), &w, EC_TIMEOUTRET3); // DC filt expr
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_DLALIAS, 1, zero, EC_TIMEOUTRET3);        // ignore alias register
+    w = htoes(EC_STATE_INIT | EC_STATE_ACK);
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_ALCTL, sizeof(w), &w, EC_TIMEOUTRET3);    // reset all slaves to init
+    b = 2;
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_EEPCFG, sizeof(b), &b, EC_TIMEOUTRET3);   // force EEPROM from PDI
+    ecx_BWR(&ctx->port, 0x0000, ECT_REG_EEPCFG, 1, zero, EC_TIMEOUTRET3);         // set EEPROM to master
+}
+
+/* One SII word pair of every slave, read in parallel as ecx_config_init does. Returns the first slave whose value
+   differs from the stored one, 0 when all match. */
+static int boot_check_sii(ecx_contextt* ctx, const boot_map_t* m, uint16 address, size_t field)
+{
+    int n = ctx->slavecount;
+    for (int i = 1; i <= n; ++i) ecx_readeeprom1(ctx, (uint16)i, address);
+    int mismatch = 0;
+    for (int i = 1; i <= n; ++i) {
+        uint32 value = etohl(ecx_readeeprom2(ctx, (uint16)i, EC_TIMEOUTEEP));
+        uint32 stored;
+        memcpy(&stored, (const uint8*)&m->slaves[i] + field, sizeof(stored));
+        if (value != stored && !mismatch) mismatch = i;
+    }
+    return mismatch;
+}
+
+static uint8 boot_active_ports(uint16 dlstat)
+{
+    uint8 ports = 0;
+    if ((dlstat & 0x0300) == 0x0200) ports |= 0x01;  // port 0 open and communication established
+    if ((dlstat & 0x0c00) == 0x0800) ports |= 0x02;
+    if ((dlstat & 0x3000) == 0x2000) ports |= 0x04;
+    if ((dlstat & 0xc000) == 0x8000) ports |= 0x08;
+    return ports;
+}
+
+/* Puts the stored slave and group lists into the context, pointing into iomap. */
+static void boot_apply(ecx_contextt* ctx, const boot_map_t* m, uint8* iomap)
+{
+    int n = (int)m->hdr.slavecount;
+    for (int i = 0; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        memcpy(s, &m->slaves[i], sizeof(*s));
+        boot_scrub_slave(s);
+        s->outputs = boot_pointer(iomap, m->slave_at[i].outputs);
+        s->inputs = boot_pointer(iomap, m->slave_at[i].inputs);
+        s->mbxstatus = boot_pointer(iomap, m->slave_at[i].mbxstatus);
+    }
+    // Field by field: the live groups keep the mailbox queues soem_boot_detect created.
+    for (int g = 0; g < EC_MAXGROUP; ++g) {
+        ec_groupt* dst = &ctx->grouplist[g];
+        const ec_groupt* src = &m->groups[g];
+        dst->logstartaddr = src->logstartaddr;
+        dst->Obytes = src->Obytes;
+        dst->Ibytes = src->Ibytes;
+        dst->outputs = boot_pointer(iomap, m->group_at[g].outputs);
+        dst->inputs = boot_pointer(iomap, m->group_at[g].inputs);
+        dst->mbxstatus = boot_pointer(iomap, m->group_at[g].mbxstatus);
+        dst->hasdc = src->hasdc;
+        dst->DCnext = src->DCnext;
+        dst->Ebuscurrent = src->Ebuscurrent;
+        dst->blockLRW = src->blockLRW;
+        dst->nsegments = src->nsegments;
+        dst->Isegment = src->Isegment;
+        dst->Ioffset = src->Ioffset;
+        dst->outputsWKC = src->outputsWKC;
+        dst->inputsWKC = src->inputsWKC;
+        dst->docheckstate = src->docheckstate;
+        memcpy(dst->IOsegment, src->IOsegment, sizeof(dst->IOsegment));
+        dst->mbxstatuslength = src->mbxstatuslength;
+        memcpy(dst->mbxstatuslookup, src->mbxstatuslookup, sizeof(dst->mbxstatuslookup));
+        dst->lastmbxpos = 0;
+    }
+    ctx->slavecount = n;
+}
+
+/* INIT -> PRE-OP -> SAFE-OP with the stored settings: the register writes ecx_config_init and
+   ecx_config_map_group make once they know the slave, without the SII and PDO reads that got them there.
+   Returns the first slave that did not take a write, 0 on success. */
+static int boot_configure(ecx_contextt* ctx)
+{
+    int n = ctx->slavecount;
+    int failed = 0;
+    ecx_statecheck(ctx, 0, EC_STATE_INIT, EC_TIMEOUTSTATE);
+    for (int i = 1; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        if (s->mbx_l && ecx_FPWR(&ctx->port, s->configadr, ECT_REG_SM0, sizeof(ec_smt) * 2, &s->SM[0], EC_TIMEOUTRET3) <= 0 && !failed)
+            failed = i;
+        ecx_eeprom2pdi(ctx, (uint16)i);
+        if (ecx_FPWRw(&ctx->port, s->configadr, ECT_REG_ALCTL, htoes(EC_STATE_PRE_OP | EC_STATE_ACK), EC_TIMEOUTRET3) <= 0 && !failed)
+            failed = i;
+    }
+    if (failed) return failed;
+
+    ecx_statecheck(ctx, 0, EC_STATE_PRE_OP, EC_TIMEOUTSTATE);
+    for (int i = 1; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        if (ctx->ENI) ecx_mbxENIinitcmds(ctx, (uint16)i, ECT_ESMTRANS_PS);
+        for (int sm = 0; sm < EC_MAXSM; ++sm) {
+            if (!s->SM[sm].StartAddr || (sm < 2 && s->mbx_l)) continue;  // mailbox SMs went out above
+            if (ecx_FPWR(&ctx->port, s->configadr, (uint16)(ECT_REG_SM0 + sm * sizeof(ec_smt)), sizeof(ec_smt), &s->SM[sm],
+                    EC_TIMEOUTRET3) <= 0 && !failed)
+                failed = i;
+        }
+        for (int f = 0; f < s->FMMUunused && f < EC_MAXFMMU; ++f) {
+            if (ecx_FPWR(&ctx->port, s->configadr, (uint16)(ECT_REG_FMMU0 + f * sizeof(ec_fmmut)), sizeof(ec_fmmut), &s->FMMU[f],
+                    EC_TIMEOUTRET3) <= 0 && !failed)
+                failed = i;
+        }
+        ecx_eeprom2pdi(ctx, (uint16)i);
+        if (ecx_FPWRw(&ctx->port, s->configadr, ECT_REG_ALCTL, htoes(EC_STATE_SAFE_OP), EC_TIMEOUTRET3) <= 0 && !failed)
+            failed = i;
+    }
+    return failed;
+}
+
+/* Instead of ecx_config_init + mapping, when opts->config_path holds a configuration that matches the bus.
+   Returns SOEM_CONFIG_USED with the slave and group lists restored, their process data pointing into iomap and
+   *size set to the image size; otherwise why not (SOEM_CONFIG_*), with *mismatch_slave naming the slave that
+   failed the check, and the caller runs the full discovery. */
+int soem_boot_restore(soem_handle_t* h, const soem_init_options_t* opts, uint8* iomap, size_t capacity, int* size,
+    int* mismatch_slave)
+{
+    *mismatch_slave = 0;
+    if (!opts->config_path || !*opts->config_path) return SOEM_CONFIG_OFF;
+
+    const char* path = opts->config_path;
+    boot_map_t m;
+    int rc = boot_load(path, opts, capacity, &m);
+    if (rc != SOEM_CONFIG_USED) return rc;
+
+    ecx_contextt* ctx = &h->context;
+    int found = soem_boot_detect(ctx);
+    if (found != (int)m.hdr.slavecount) {
+        log_message(SOEM_LOG_WARN, "Stored configuration %s has %u slave(s), the bus %d; rediscovering", path, m.hdr.slavecount, found);
+        free(m.body);
+        return SOEM_CONFIG_COUNT;
+    }
+    ctx->slavecount = found;
+    soem_boot_defaults(ctx);
+
+    // Station addresses as ecx_config_init hands them out; the first slave drops non-EtherCAT frames.
+    for (int i = 1; i <= found; ++i) {
+        uint16 adp = (uint16)(1 - i);
+        ctx->slavelist[i].configadr = m.slaves[i].configadr;
+        ecx_APWRw(&ctx->port, adp, ECT_REG_STADR, htoes(m.slaves[i].configadr), EC_TIMEOUTRET3);
+        ecx_APWRw(&ctx->port, adp, ECT_REG_DLCTL, htoes(i == 1 ? 1 : 0), EC_TIMEOUTRET3);
+    }
+
+    int bad = boot_check_sii(ctx, &m, ECT_SII_MANUF, offsetof(ec_slavet, eep_man));
+    if (!bad) bad = boot_check_sii(ctx, &m, ECT_SII_ID, offsetof(ec_slavet, eep_id));
+    if (!bad) bad = boot_check_sii(ctx, &m, ECT_SII_REV, offsetof(ec_slavet, eep_rev));
+    if (bad) {
+        log_message(SOEM_LOG_WARN, "Stored configuration %s: slave %d is not %08x:%08x rev %08x; rediscovering", path, bad,
+            m.slaves[bad].eep_man, m.slaves[bad].eep_id, m.slaves[bad].eep_rev);
+        *mismatch_slave = bad;
+        free(m.body);
+        return SOEM_CONFIG_IDENTITY;
+    }
+    for (int i = 1; i <= found && !bad; ++i) {
+        uint16 dlstat = etohs(ecx_FPRDw(&ctx->port, m.slaves[i].configadr, ECT_REG_DLSTAT, EC_TIMEOUTRET3));
+        if (boot_active_ports(dlstat) != m.slaves[i].activeports) bad = i;
+    }
+    if (bad) {
+        log_message(SOEM_LOG_WARN, "Stored configuration %s: slave %d is cabled differently; rediscovering", path, bad);
+        *mismatch_slave = bad;
+        free(m.body);
+        return SOEM_CONFIG_TOPOLOGY;
+    }
+
+    boot_apply(ctx, &m, iomap);
+    *size = (int)m.hdr.iomap_size;
+    free(m.body);
+
+    bad = boot_configure(ctx);
+    if (bad) {
+        log_message(SOEM_LOG_WARN, "Stored configuration %s: slave %d did not take the stored settings; rediscovering", path, bad);
+        *mismatch_slave = bad;
+        return SOEM_CONFIG_FAILED;
+    }
+    return SOEM_CONFIG_USED;
+}
+
+/* After a full discovery, once the process image sits in h->IOmap: store the slave and group lists at
+   opts->config_path. Written to a temporary file and renamed, so a crash never leaves half a file behind.
+   Returns 1, or 0 (logged) when the file could not be written. */
+int soem_boot_save(soem_handle_t* h, const soem_init_options_t* opts)
+{
+    const char* path = opts->config_path;
+    ecx_contextt* ctx = &h->context;
+    int n = ctx->slavecount;
+    if (!path || !*path || n < 1 || n >= EC_MAXSLAVE) return 0;
+
+    boot_map_t m;
+    memset(&m, 0, sizeof(m));
+    m.hdr.magic = BOOT_MAGIC;
+    m.hdr.version = BOOT_VERSION;
+    m.hdr.slave_size = sizeof(ec_slavet);
+    m.hdr.group_size = sizeof(ec_groupt);
+    m.hdr.groups = EC_MAXGROUP;
+    m.hdr.slavecount = (uint32_t)n;
+    m.hdr.options = boot_options_key(opts);
+    m.hdr.iomap_size = (uint32_t)h->iomap_size;
+
+    size_t size = boot_body_size(m.hdr.slavecount);
+    size_t len = strlen(path);
+    char* tmp = (char*)malloc(len + 5);
+    m.body = (uint8_t*)calloc(1, size);
+    if (!m.body || !tmp) {
+        free(m.body);
+        free(tmp);
+        return 0;
+    }
+    boot_layout(&m);
+
+    for (int i = 0; i <= n; ++i) {
+        const ec_slavet* s = &ctx->slavelist[i];
+        m.slave_at[i].outputs = boot_offset(h->IOmap, h->iomap_size, s->outputs);
+        m.slave_at[i].inputs = boot_offset(h->IOmap, h->iomap_size, s->inputs);
+        m.slave_at[i].mbxstatus = boot_offset(h->IOmap, h->iomap_size, s->mbxstatus);
+        memcpy(&m.slaves[i], s, sizeof(*s));
+        boot_scrub_slave(&m.slaves[i]);
+    }
+    for (int g = 0; g < EC_MAXGROUP; ++g) {
+        const ec_groupt* grp = &ctx->grouplist[g];
+        m.group_at[g].outputs = boot_offset(h->IOmap, h->iomap_size, grp->outputs);
+        m.group_at[g].inputs = boot_offset(h->IOmap, h->iomap_size, grp->inputs);
+        m.group_at[g].mbxstatus = boot_offset(h->IOmap, h->iomap_size, grp->mbxstatus);
+        memcpy(&m.groups[g], grp, sizeof(*grp));
+        m.groups[g].outputs = m.groups[g].inputs = m.groups[g].mbxstatus = NULL;
+        memset(&m.groups[g].mbxtxqueue, 0, sizeof(m.groups[g].mbxtxqueue));  // holds a live mutex
+        m.groups[g].lastmbxpos = 0;
+    }
+    m.hdr.checksum = soem_boot_fnv(2166136261u, m.body, size);
+
+    memcpy(tmp, path, len);
+    memcpy(tmp + len, ".tmp", 5);
+    FILE* f = fopen(tmp, "wb");
+    int ok = f && fwrite(&m.hdr, sizeof(m.hdr), 1, f) == 1 && fwrite(m.body, size, 1, f) == 1;
+    if (f && fclose(f) != 0) ok = 0;
+#if defined(_WIN32)
+    if (ok) remove(path);  // rename does not replace an existing file here
+#endif
+    if (ok && rename(tmp, path) != 0) ok = 0;
+    if (!ok) {
+        remove(tmp);
+        log_message(SOEM_LOG_WARN, "Stored configuration %s could not be written; the next start discovers the bus again", path);
+    } else {
+        log_message(SOEM_LOG_INFO, "Stored configuration %s written: %d slave(s), %u-byte IOmap", path, n, m.hdr.iomap_size);
+    }
+    free(tmp);
+    free(m.body);
+    return ok;
+}
+
+SOEMSHIM_EXPORT int soem_get_boot_report(soem_handle_t* h, soem_boot_report_t* out)
+{
+    if (!h || !out) return 0;
+    *out = h->boot;
+    return 1;
+}
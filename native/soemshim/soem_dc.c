@@ -0,0 +1,152 @@
+/* Distributed clocks: SYNC0 activation, per-cycle phase/drift tracking against the reference clock and the PI
+   controller the cyclic engine uses to keep its frames a fixed lead ahead of SYNC0.
+   Shared verbatim by the Windows and Linux shims. soem_dc_track runs on the bus thread and does not log or block. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define DC_FENCE() _ReadWriteBarrier()  // x86/x64 keep store/store and load/load order; stop the compiler reordering
+#else
+#define DC_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define DC_KP_DIV        8              // proportional gain 1/8: a phase step is worked off over ~20 cycles
+#define DC_KI_DIV        256            // integral gain 1/256: absorbs the steady host/DC rate difference
+#define DC_DRIFT_WINDOW  1000000000LL   // drift is measured over >= 1 s of DC time so receive jitter averages out
+#define DC_DRIFT_EMA     4              // smoothing of successive drift windows (1/4 new)
+
+typedef struct soem_dc_state {
+    volatile uint32_t seq;  // odd while the bus thread rewrites stats
+    soem_dc_stats_t stats;
+    int64_t integral;       // sum of phase errors, clamped so the integral term stays within a quarter cycle
+    int64_t drift_host_ns;  // start of the current drift window
+    int64_t drift_dc_ns;
+    int drift_windows;      // completed drift windows
+    int64_t last_dc_ns;     // DC time of the previous sample; an unchanged value means no new DC datagram came back
+} soem_dc_state_t;
+
+static int64_t dc_clamp(int64_t v, int64_t limit)
+{
+    return v > limit ? limit : (v < -limit ? -limit : v);
+}
+
+int soem_dc_enable(soem_handle_t* h, uint32_t cycle_ns, int32_t shift_ns, int32_t lead_ns)
+{
+    if (!h || cycle_ns == 0 || cycle_ns > INT32_MAX) return 0;
+
+    soem_dc_state_t* dc = h->dc;
+    if (!dc) {
+        dc = (soem_dc_state_t*)calloc(1, sizeof(*dc));
+        if (!dc) return -1;
+        h->dc = dc;
+    }
+
+    int slaves = 0;
+    for (int i = 1; i <= h->context.slavecount; ++i) {
+        if (!h->context.slavelist[i].hasdc) continue;
+        ecx_dcsync0(&h->context, (uint16)i, TRUE, cycle_ns, shift_ns);
+        ++slaves;
+    }
+
+    memset(&dc->stats, 0, sizeof(dc->stats));
+    dc->stats.active = slaves > 0;
+    dc->stats.sync0_slaves = slaves;
+    dc->stats.cycle_ns = (int32_t)cycle_ns;
+    dc->stats.shift_ns = shift_ns;
+    dc->stats.lead_ns = lead_ns > 0 ? lead_ns % (int32_t)cycle_ns : (int32_t)(cycle_ns / 4);
+    dc->stats.offset_min_ns = INT32_MAX;
+    dc->stats.offset_max_ns = INT32_MIN;
+    dc->integral = 0;
+    dc->drift_host_ns = 0;
+    dc->drift_windows = 0;
+    dc->last_dc_ns = 0;
+    return slaves;
+}
+
+/* Feed the DC time of the cycle that just came back (host_ns: monotonic time it arrived). With steer set, returns
+   the PI correction to add to the next wake-up; positive phase error (frame late) yields a negative correction. */
+int64_t soem_dc_track(soem_handle_t* h, int64_t host_ns, int steer)
+{
+    soem_dc_state_t* dc = h ? h->dc : NULL;
+    if (!dc || !dc->stats.active) return 0;
+
+    int64_t ref = h->context.DCtime;
+    if (ref == 0 || ref == dc->last_dc_ns) return 0;
+    dc->last_dc_ns = ref;
+
+    const int64_t cycle = dc->stats.cycle_ns;
+    // SYNC0 fires at k * cycle + shift in DC time; the frame should pass lead_ns before that.
+    int64_t delta = (ref - (dc->stats.shift_ns - dc->stats.lead_ns)) % cycle;
+    if (delta < 0) delta += cycle;
+    if (delta >= cycle / 2) delta -= cycle;
+
+    int64_t correction = 0;
+    if (steer) {
+        dc->integral = dc_clamp(dc->integral + delta, (cycle / 4) * DC_KI_DIV);
+        correction = dc_clamp(-(delta / DC_KP_DIV + dc->integral / DC_KI_DIV), cycle / 4);
+    }
+
+    int32_t drift = dc->stats.drift_ppb;
+    if (dc->drift_host_ns == 0) {
+        dc->drift_host_ns = host_ns;
+        dc->drift_dc_ns = ref;
+    } else if (ref - dc->drift_dc_ns >= DC_DRIFT_WINDOW) {
+        int64_t dc_span = ref - dc->drift_dc_ns;
+        int64_t ppb = (host_ns - dc->drift_host_ns - dc_span) * 1000000000LL / dc_span;
+        drift = (int32_t)(dc->drift_windows++ ? drift + (ppb - drift) / DC_DRIFT_EMA : ppb);
+        dc->drift_host_ns = host_ns;
+        dc->drift_dc_ns = ref;
+    }
+
+    dc->seq++;
+    DC_FENCE();
+    dc->stats.offset_ns = (int32_t)delta;
+    if (delta < dc->stats.offset_min_ns) dc->stats.offset_min_ns = (int32_t)delta;
+    if (delta > dc->stats.offset_max_ns) dc->stats.offset_max_ns = (int32_t)delta;
+    dc->stats.drift_ppb = drift;
+    dc->stats.correction_ns = (int32_t)correction;
+    dc->stats.dc_time_ns = ref;
+    dc->stats.samples++;
+    DC_FENCE();
+    dc->seq++;
+    return correction;
+}
+
+/* Re-arm SYNC0 on a slave that ecx_reconfig_slave reprogrammed; a no-op without DC. */
+void soem_dc_rearm_slave(soem_handle_t* h, int slave)
+{
+    soem_dc_state_t* dc = h ? h->dc : NULL;
+    if (!dc || !dc->stats.active || slave < 1 || slave > h->context.slavecount || !h->context.slavelist[slave].hasdc) return;
+    ecx_dcsync0(&h->context, (uint16)slave, TRUE, (uint32)dc->stats.cycle_ns, dc->stats.shift_ns);
+}
+
+void soem_dc_release(soem_handle_t* h)
+{
+    if (!h || !h->dc) return;
+    free(h->dc);
+    h->dc = NULL;
+}
+
+SOEMSHIM_EXPORT int soem_get_dc_stats(soem_handle_t* h, soem_dc_stats_t* out)
+{
+    if (!h || !out) return 0;
+    soem_dc_state_t* dc = h->dc;
+    if (!dc) {
+        memset(out, 0, sizeof(*out));
+        return 1;
+    }
+
+    uint32_t seq;
+    do {
+        seq = dc->seq;
+        DC_FENCE();
+        memcpy(out, (const void*)&dc->stats, sizeof(*out));
+        DC_FENCE();
+    } while ((seq & 1) || seq != dc->seq);
+
+    if (out->samples == 0) out->offset_min_ns = out->offset_max_ns = 0;
+    return 1;
+}
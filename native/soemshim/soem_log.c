@@ -0,0 +1,239 @@
+/* Asynchronous logging. Call sites push fixed-size records into a lock-free multi-producer ring and return;
+   soem_log_drain formats them and invokes the registered callback on the draining thread. The cycle path uses
+   coded records (integer arguments, formatted at drain time); one-off paths (init, recovery) format their text
+   into the record at the call site. Every record carries the bus id the writing thread last bound (soem_log_bind,
+   called by the exports that touch a handle), so one drainer can route the records of several handles to their
+   own sinks. Shared verbatim by the Windows and Linux shims. */
+#include "soem_shim.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static uint64_t log_load(volatile uint64_t* p) { uint64_t v = *p; _ReadWriteBarrier(); return v; }
+static void log_store(volatile uint64_t* p, uint64_t v) { _ReadWriteBarrier(); *p = v; }
+static int log_cas(volatile uint64_t* p, uint64_t expected, uint64_t desired)
+{
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64*)p, (__int64)desired, (__int64)expected) == expected;
+}
+static void log_add(volatile uint64_t* p, uint64_t v) { _InterlockedExchangeAdd64((volatile __int64*)p, (__int64)v); }
+static uint32_t log_next_bus(volatile long* p) { return (uint32_t)_InterlockedIncrement(p); }
+#define LOG_THREAD __declspec(thread)
+#else
+static uint64_t log_load(volatile uint64_t* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static void log_store(volatile uint64_t* p, uint64_t v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static int log_cas(volatile uint64_t* p, uint64_t expected, uint64_t desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+static void log_add(volatile uint64_t* p, uint64_t v) { __atomic_fetch_add(p, v, __ATOMIC_RELAXED); }
+static uint32_t log_next_bus(volatile long* p) { return (uint32_t)__atomic_add_fetch(p, 1, __ATOMIC_RELAXED); }
+#define LOG_THREAD _Thread_local
+#endif
+
+#define LOG_RING_BITS 10
+#define LOG_RING_SIZE (1u << LOG_RING_BITS)
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+/* Bounded MPMC queue in the style of D. Vyukov's. Cell turn: 2 * round = free for the producer of that round,
+   2 * round + 1 = filled for the consumer. All zero is a valid empty ring, so no init call is needed. */
+typedef struct log_cell {
+    volatile uint64_t turn;
+    soem_log_record_t rec;
+} log_cell_t;
+
+static log_cell_t log_ring[LOG_RING_SIZE];
+static volatile uint64_t log_head;      // next position producers claim
+static volatile uint64_t log_tail;      // next position the consumer reads
+static volatile uint64_t log_dropped;   // records lost to a full ring
+static uint64_t log_dropped_reported;   // consumer side: dropped count already announced
+static volatile uint64_t log_draining;  // 1 while a thread is inside soem_log_drain
+
+static soem_log_callback_t log_cb = NULL;
+static soem_log_bus_callback_t log_bus_cb = NULL;  // takes precedence over log_cb when set
+static volatile long log_bus_count;                 // last bus id handed out
+static LOG_THREAD uint32_t log_bus;                 // bus the calling thread works for, 0 = none
+
+static const char* const log_formats[] = {
+    /* SOEM_LOGC_TEXT      */ NULL,
+    /* SOEM_LOGC_SEND_FAIL */ "ecx_send_processdata failed rc=%lld (expected WKC=%lld)",
+    /* SOEM_LOGC_RECV_FAIL */ "ecx_receive_processdata failed rc=%lld (expected WKC=%lld, timeout_us=%lld)",
+    /* SOEM_LOGC_WKC_ZERO  */ "Expected WKC is %lld (check mapping). Returning wkc=%lld",
+    /* SOEM_LOGC_WKC_LOW   */ "WKC low: got=%lld expected=%lld (Obytes=%lld Ibytes=%lld, oWKC=%lld iWKC=%lld)",
+    /* SOEM_LOGC_DROPPED   */ "%lld log records dropped (ring full)",
+    /* SOEM_LOGC_SLAVE_LOST     */ "Slave %lld lost; its process data is excluded until it returns",
+    /* SOEM_LOGC_SLAVE_FOUND    */ "Slave %lld found again",
+    /* SOEM_LOGC_SLAVE_RECONFIG */ "Slave %lld reconfigured",
+    /* SOEM_LOGC_RECOVERED      */ "All slaves back in OP (state reads: %lld)",
+    /* SOEM_LOGC_TOPOLOGY       */ "Ring topology changed: path %lld -> %lld (1 ring, 2 primary side, 3 secondary side, 4 split, 5 no frame)",
+    /* SOEM_LOGC_RED_PROBE      */ "Ring path %lld: %lld slave(s) via primary, %lld via secondary, break after slave %lld",
+    /* SOEM_LOGC_SDO_FAIL       */ "SDO transfer to slave %lld failed: object 0x%04llx:%lld write=%lld wkc=%lld",
+};
+
+static int64_t log_now_ns(void)
+{
+    ec_timet t;
+    osal_get_monotonic_time(&t);
+    return (int64_t)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/* Claim the next free cell, or NULL when the ring is full. *pos receives the claimed position. */
+static log_cell_t* log_claim(uint64_t* pos)
+{
+    uint64_t p = log_load(&log_head);
+    for (;;) {
+        log_cell_t* cell = &log_ring[p & LOG_RING_MASK];
+        int64_t dif = (int64_t)(log_load(&cell->turn) - 2 * (p >> LOG_RING_BITS));
+        if (dif == 0) {
+            if (log_cas(&log_head, p, p + 1)) {
+                *pos = p;
+                return cell;
+            }
+            p = log_load(&log_head);
+        } else if (dif < 0) {
+            log_add(&log_dropped, 1);
+            return NULL;
+        } else {
+            p = log_load(&log_head);
+        }
+    }
+}
+
+static void log_publish(log_cell_t* cell, uint64_t pos)
+{
+    log_store(&cell->turn, 2 * (pos >> LOG_RING_BITS) + 1);
+}
+
+SOEMSHIM_EXPORT void soem_set_log_callback(soem_log_callback_t cb)
+{
+    log_cb = cb;
+}
+
+SOEMSHIM_EXPORT void soem_set_log_bus_callback(soem_log_bus_callback_t cb)
+{
+    log_bus_cb = cb;
+}
+
+SOEMSHIM_EXPORT uint32_t soem_log_new_bus(void)
+{
+    return log_next_bus(&log_bus_count);
+}
+
+/* Tag the calling thread's records with bus until the next bind. A thread-local store, cheap enough for every
+   cycle call; an id outliving its handle only misroutes, it never touches freed memory. */
+void soem_log_bind(uint32_t bus)
+{
+    log_bus = bus;
+}
+
+void soem_log_event(soem_log_level_t lvl, int code, const int64_t* args, int argc)
+{
+    if (!log_cb && !log_bus_cb) return;
+
+    uint64_t pos;
+    log_cell_t* cell = log_claim(&pos);
+    if (!cell) return;
+
+    soem_log_record_t* rec = &cell->rec;
+    rec->timestamp_ns = log_now_ns();
+    rec->level = (int32_t)lvl;
+    rec->code = code;
+    rec->bus = log_bus;
+    if (argc > SOEM_LOG_ARGS) argc = SOEM_LOG_ARGS;
+    for (int i = 0; i < SOEM_LOG_ARGS; ++i) rec->args[i] = i < argc ? args[i] : 0;
+    rec->text[0] = '\0';
+    log_publish(cell, pos);
+}
+
+void log_message(soem_log_level_t lvl, const char* fmt, ...)
+{
+    if (!log_cb && !log_bus_cb) return;
+
+    uint64_t pos;
+    log_cell_t* cell = log_claim(&pos);
+    if (!cell) return;
+
+    soem_log_record_t* rec = &cell->rec;
+    rec->timestamp_ns = log_now_ns();
+    rec->level = (int32_t)lvl;
+    rec->code = SOEM_LOGC_TEXT;
+    rec->bus = log_bus;
+    memset(rec->args, 0, sizeof(rec->args));
+
+    // Formatted straight into the record; longer messages are truncated to SOEM_LOG_TEXT - 1 characters.
+    va_list ap;
+    va_start(ap, fmt);
+    if (vsnprintf(rec->text, sizeof(rec->text), fmt, ap) < 0)
+        snprintf(rec->text, sizeof(rec->text), "log_message: formatting error");
+    va_end(ap);
+
+    log_publish(cell, pos);
+}
+
+static void log_emit(const soem_log_record_t* rec, const char* text)
+{
+    soem_log_bus_callback_t bus_cb = log_bus_cb;
+    if (bus_cb) bus_cb((soem_log_level_t)rec->level, rec->bus, text);
+    else if (log_cb) log_cb((soem_log_level_t)rec->level, text);
+}
+
+static void log_deliver(const soem_log_record_t* rec)
+{
+    if (rec->code == SOEM_LOGC_TEXT) {
+        log_emit(rec, rec->text);
+        return;
+    }
+
+    char buf[256];
+    const char* fmt = (rec->code > 0 && rec->code < (int)(sizeof(log_formats) / sizeof(log_formats[0])))
+        ? log_formats[rec->code] : NULL;
+    if (fmt) {
+        const int64_t* a = rec->args;
+        snprintf(buf, sizeof(buf), fmt, (long long)a[0], (long long)a[1], (long long)a[2], (long long)a[3], (long long)a[4], (long long)a[5]);
+    } else {
+        snprintf(buf, sizeof(buf), "log code %d: %lld %lld %lld %lld %lld %lld", (int)rec->code,
+            (long long)rec->args[0], (long long)rec->args[1], (long long)rec->args[2],
+            (long long)rec->args[3], (long long)rec->args[4], (long long)rec->args[5]);
+    }
+    log_emit(rec, buf);
+}
+
+SOEMSHIM_EXPORT int soem_log_drain(int max_records)
+{
+    if ((!log_cb && !log_bus_cb) || max_records <= 0) return 0;
+    if (!log_cas(&log_draining, 0, 1)) return 0;  // another thread is draining
+
+    int delivered = 0;
+    uint64_t dropped = log_load(&log_dropped);
+    if (dropped != log_dropped_reported) {
+        soem_log_record_t notice = { 0 };
+        notice.level = SOEM_LOG_WARN;
+        notice.code = SOEM_LOGC_DROPPED;
+        notice.args[0] = (int64_t)(dropped - log_dropped_reported);
+        log_dropped_reported = dropped;
+        log_deliver(&notice);
+        ++delivered;
+    }
+
+    while (delivered < max_records) {
+        uint64_t pos = log_tail;
+        log_cell_t* cell = &log_ring[pos & LOG_RING_MASK];
+        if (log_load(&cell->turn) != 2 * (pos >> LOG_RING_BITS) + 1) break;  // empty, or next record not yet published
+
+        soem_log_record_t rec = cell->rec;
+        log_store(&cell->turn, 2 * (pos >> LOG_RING_BITS) + 2);
+        log_tail = pos + 1;
+        log_deliver(&rec);
+        ++delivered;
+    }
+
+    log_store(&log_draining, 0);
+    return delivered;
+}
+
+SOEMSHIM_EXPORT uint64_t soem_log_dropped(void)
+{
+    return log_load(&log_dropped);
+}
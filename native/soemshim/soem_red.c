@@ -0,0 +1,214 @@
+/* Cable redundancy: a ring opened with ecx_init_redundant sends every frame out of both ports. SOEM stamps the
+   source MAC word of each returned frame into port->rxsa / redport->rxsa, which tells where it travelled: on an
+   intact ring the primary frame comes back on the secondary port and vice versa; after a cable break each side's
+   frame bounces back on its own port and SOEM resends the primary half through the secondary port, so the cycle
+   still reaches every slave. soem_red_note grades each cycle from those words and flags a path change;
+   soem_red_probe then reads the DL status of every slave (between cycles) to find the break and count the slaves
+   reachable per side. Shared verbatim by the Windows and Linux shims. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define RED_FENCE() _ReadWriteBarrier()
+#else
+#define RED_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define RED_PROBE_TIMEOUT_US 2000
+
+typedef struct soem_red_state {
+    ecx_redportt redport;      // handed to ecx_init_redundant, must outlive ecx_close
+    volatile uint32_t seq;     // odd while the bus thread rewrites info
+    soem_redundancy_t info;
+    int frames;                // frames of the cycle in flight
+    uint8 idx[SOEM_RED_MAX_FRAMES];
+    volatile int probe_due;
+} soem_red_state_t;
+
+void soem_log_event(soem_log_level_t lvl, int code, const int64_t* args, int argc);  // soem_log.c
+
+/* Allocate the redundancy state before ecx_init_redundant; returns the port buffers SOEM should use. */
+ecx_redportt* soem_red_create(soem_handle_t* h)
+{
+    if (!h) return NULL;
+    soem_red_state_t* r = (soem_red_state_t*)calloc(1, sizeof(*r));
+    if (!r) return NULL;
+    r->info.enabled = 1;
+    h->red = r;
+    return &r->redport;
+}
+
+/* After ecx_close: SOEM closes the secondary socket but does not own the buffers. */
+void soem_red_release(soem_handle_t* h)
+{
+    if (!h || !h->red) return;
+    free(h->red);
+    h->red = NULL;
+}
+
+/* Right after ecx_send_processdata: remember the frame indices and clear their return stamps, so a frame that
+   never comes back reads as 0 rather than as last cycle's port. Nothing reads the sockets until the receive. */
+void soem_red_arm(soem_handle_t* h)
+{
+    soem_red_state_t* r = h ? h->red : NULL;
+    if (!r) return;
+    ecx_portt* port = &h->context.port;
+    const ec_idxstackT* stack = &h->context.idxstack;
+    int frames = stack->pushed < SOEM_RED_MAX_FRAMES ? stack->pushed : SOEM_RED_MAX_FRAMES;
+    for (int i = 0; i < frames; ++i) {
+        uint8 idx = stack->idx[i];
+        r->idx[i] = idx;
+        port->rxsa[idx] = 0;
+        port->redport->rxsa[idx] = 0;
+    }
+    r->frames = frames;
+}
+
+static int red_frame_path(int primrx, int secrx)
+{
+    const int prim = priMAC[1], sec = secMAC[1];
+    if (primrx == sec && secrx == prim) return SOEM_RED_PATH_RING;
+    if (primrx == prim && secrx == prim) return SOEM_RED_PATH_SPLIT;      // both halves, then SOEM's resend
+    if (primrx == prim && secrx == 0) return SOEM_RED_PATH_PRIMARY;
+    if (primrx == 0 && secrx == prim) return SOEM_RED_PATH_SECONDARY;    // primary link down, resent via secondary
+    if (primrx == prim && secrx == sec) return SOEM_RED_PATH_SPLIT;      // the resend did not come back
+    return SOEM_RED_PATH_LOST;
+}
+
+/* After ecx_receive_processdata: grade every frame of the cycle and publish. Returns the cycle's path (the most
+   degraded frame), 0 when the handle is not redundant. A change of path logs a topology event and asks for a
+   probe (soem_red_due). Runs on the bus thread; never blocks. */
+int soem_red_note(soem_handle_t* h, int64_t now_ns)
+{
+    soem_red_state_t* r = h ? h->red : NULL;
+    if (!r) return 0;
+    ecx_portt* port = &h->context.port;
+
+    uint8 paths[SOEM_RED_MAX_FRAMES];
+    int path = r->frames ? SOEM_RED_PATH_RING : SOEM_RED_PATH_LOST;
+    for (int i = 0; i < r->frames; ++i) {
+        uint8 idx = r->idx[i];
+        paths[i] = (uint8)red_frame_path(port->rxsa[idx], port->redport->rxsa[idx]);
+        if (paths[i] > path) path = paths[i];
+    }
+
+    int previous = r->info.path;
+    r->seq++;
+    RED_FENCE();
+    r->info.frames = r->frames;
+    memcpy(r->info.frame_path, paths, (size_t)r->frames);
+    r->info.path = path;
+    r->info.cycles++;
+    if (path != SOEM_RED_PATH_RING) r->info.degraded_cycles++;
+    if (path != previous && previous != 0) {
+        r->info.topology_changes++;
+        r->info.changed_ns = now_ns;
+    }
+    RED_FENCE();
+    r->seq++;
+
+    if (path != previous && previous != 0) {
+        LOG_EVENT(path == SOEM_RED_PATH_RING ? SOEM_LOG_INFO : SOEM_LOG_WARN, SOEM_LOGC_TOPOLOGY, previous, path);
+    }
+    if (path != previous) r->probe_due = 1;
+    return path;
+}
+
+int soem_red_due(const soem_handle_t* h)
+{
+    return h && h->red ? h->red->probe_due : 0;
+}
+
+int soem_red_path(const soem_handle_t* h)
+{
+    return h && h->red ? h->red->info.path : 0;
+}
+
+/* ESC loop order is 0 -> 3 -> 1 -> 2; a frame leaves a slave through the first active port after its entry port. */
+static int red_out_port(const ec_slavet* s)
+{
+    static const int next[4] = { 3, 2, 0, 1 };
+    int p = s->entryport & 3;
+    for (int i = 0; i < 3; ++i) {
+        p = next[p];
+        if (s->activeports & (1 << p)) return p;
+    }
+    return -1;
+}
+
+/* Reads the DL status of every slave and publishes how many each port reaches. On a closed ring both reach all;
+   otherwise the break sits after the first slave whose outgoing port lost communication. Costs one round trip
+   per slave, so it only runs after a path change, between cycles. Returns the slave before the break, 0 if none. */
+int soem_red_probe(soem_handle_t* h)
+{
+    soem_red_state_t* r = h ? h->red : NULL;
+    if (!r) return 0;
+    r->probe_due = 0;
+
+    ecx_contextt* ctx = &h->context;
+    int n = ctx->slavecount, path = r->info.path;
+    int primary = 0, secondary = 0, break_after = 0;
+
+    if (path == SOEM_RED_PATH_RING) {
+        primary = secondary = n;
+    } else if (path == SOEM_RED_PATH_PRIMARY) {
+        primary = n;
+    } else if (path == SOEM_RED_PATH_SECONDARY) {
+        secondary = n;
+    } else if (path == SOEM_RED_PATH_SPLIT) {
+        int past_break = 0;
+        for (int i = 1; i <= n; ++i) {
+            ec_slavet* s = &ctx->slavelist[i];
+            uint16 dl = 0;
+            int wkc = ecx_FPRD(&ctx->port, s->configadr, ECT_REG_DLSTAT, sizeof(dl), &dl, RED_PROBE_TIMEOUT_US);
+            if (wkc <= 0) {
+                past_break = 1;  // silent slave: neither side reaches it
+                continue;
+            }
+            dl = etohs(dl);
+            if (past_break) {
+                ++secondary;
+                continue;
+            }
+            ++primary;
+            int out = red_out_port(s);
+            if (out >= 0 && !(dl & (1 << (9 + 2 * out)))) {  // DL status bit 9 + 2p: communication on port p
+                break_after = i;
+                past_break = 1;
+            }
+        }
+    }
+
+    r->seq++;
+    RED_FENCE();
+    r->info.primary_slaves = primary;
+    r->info.secondary_slaves = secondary;
+    r->info.break_after = break_after;
+    RED_FENCE();
+    r->seq++;
+
+    LOG_EVENT(SOEM_LOG_INFO, SOEM_LOGC_RED_PROBE, path, primary, secondary, break_after);
+    return break_after;
+}
+
+SOEMSHIM_EXPORT int soem_get_redundancy(soem_handle_t* h, soem_redundancy_t* out)
+{
+    if (!h || !out) return 0;
+    soem_red_state_t* r = h->red;
+    if (!r) {
+        memset(out, 0, sizeof(*out));
+        return 1;
+    }
+
+    uint32_t seq;
+    do {
+        seq = r->seq;
+        RED_FENCE();
+        memcpy(out, (const void*)&r->info, sizeof(*out));
+        RED_FENCE();
+    } while ((seq & 1) || seq != r->seq);
+    return 1;
+}
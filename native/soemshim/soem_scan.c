@@ -0,0 +1,310 @@
+/* Bulk TxPDO scanning: per-slave input change bitmap and status expansion.
+   Shared verbatim by the Windows and Linux shims. Kernels are picked at run time (AVX2, SSE2 or scalar);
+   nothing here logs, blocks or calls back, so every export is SuppressGCTransition-safe. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SCAN_TARGET_AVX2
+#else
+#define SCAN_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+#define SCAN_TX_BYTES 8  // IO_TX_BYTES: position (4) + flag bytes (3) + slot (1)
+
+typedef struct soem_scan_state {
+    int slaves;          // slaves tracked by prev/stage
+    int primed;          // prev holds the inputs of the last call
+    int contiguous;      // slave inputs are back to back in the IOmap (the usual all-Xeryon layout)
+    const uint8_t* block;// first slave's inputs when contiguous
+    uint8_t* prev;       // slaves * 8 bytes
+    uint8_t* stage;      // gather buffer for non-contiguous layouts
+} soem_scan_state_t;
+
+/* ---- ISA selection ---- */
+
+static int scan_detect_isa(void)
+{
+#if defined(SCAN_X86)
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] >= 7) {
+        __cpuid(r, 1);
+        int osxsave = (r[2] >> 27) & 1, avx = (r[2] >> 28) & 1;
+        __cpuidex(r, 7, 0);
+        if (osxsave && avx && ((r[1] >> 5) & 1) && (_xgetbv(0) & 0x6) == 0x6) return SOEM_ISA_AVX2;
+    }
+    return SOEM_ISA_SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SOEM_ISA_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SOEM_ISA_SSE2;
+    return SOEM_ISA_SCALAR;
+#endif
+#else
+    return SOEM_ISA_SCALAR;
+#endif
+}
+
+static int scan_best_isa(void)
+{
+    static volatile int best = -1;
+    if (best < 0) best = scan_detect_isa();  // idempotent, a race only repeats the probe
+    return best;
+}
+
+static int scan_resolve_isa(int isa)
+{
+    int best = scan_best_isa();
+    return (isa <= SOEM_ISA_AUTO || isa > best) ? best : isa;
+}
+
+static int popcount32(uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555u);
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    return (int)((((v + (v >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24);
+}
+
+/* Collapse a "byte equal" mask (bit per byte, 8 bytes per slave) to one "changed" bit per slave. */
+static uint32_t fold_slave_bits(uint32_t eq, int slaves)
+{
+    uint32_t ne = ~eq, out = 0;
+    for (int k = 0; k < slaves; ++k)
+        out |= (((ne >> (8 * k)) & 0xFFu) != 0) << k;
+    return out;
+}
+
+/* ---- diff kernels: compare cur against prev, copy cur into prev, OR changed bits into changed[] ---- */
+
+static void diff_scalar(const uint8_t* cur, uint8_t* prev, int first, int count, uint32_t* changed)
+{
+    for (int i = first; i < count; ++i) {
+        uint64_t a, b;
+        memcpy(&a, cur + (size_t)i * SCAN_TX_BYTES, sizeof(a));
+        memcpy(&b, prev + (size_t)i * SCAN_TX_BYTES, sizeof(b));
+        if (a != b) {
+            memcpy(prev + (size_t)i * SCAN_TX_BYTES, &a, sizeof(a));
+            changed[i >> 5] |= 1u << (i & 31);
+        }
+    }
+}
+
+#if defined(SCAN_X86)
+static int diff_sse2(const uint8_t* cur, uint8_t* prev, int count, uint32_t* changed)
+{
+    int i = 0;
+    for (; i + 2 <= count; i += 2) {  // 16 bytes = 2 slaves
+        __m128i a = _mm_loadu_si128((const __m128i*)(cur + (size_t)i * SCAN_TX_BYTES));
+        __m128i b = _mm_loadu_si128((const __m128i*)(prev + (size_t)i * SCAN_TX_BYTES));
+        uint32_t eq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        if (eq != 0xFFFFu) {
+            _mm_storeu_si128((__m128i*)(prev + (size_t)i * SCAN_TX_BYTES), a);
+            changed[i >> 5] |= fold_slave_bits(eq | 0xFFFF0000u, 2) << (i & 31);
+        }
+    }
+    return i;
+}
+
+static SCAN_TARGET_AVX2 int diff_avx2(const uint8_t* cur, uint8_t* prev, int count, uint32_t* changed)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {  // 32 bytes = 4 slaves
+        __m256i a = _mm256_loadu_si256((const __m256i*)(cur + (size_t)i * SCAN_TX_BYTES));
+        __m256i b = _mm256_loadu_si256((const __m256i*)(prev + (size_t)i * SCAN_TX_BYTES));
+        uint32_t eq = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+        if (eq != 0xFFFFFFFFu) {
+            _mm256_storeu_si256((__m256i*)(prev + (size_t)i * SCAN_TX_BYTES), a);
+            changed[i >> 5] |= fold_slave_bits(eq, 4) << (i & 31);
+        }
+    }
+    return i;
+}
+#endif
+
+static int diff_block(const uint8_t* cur, uint8_t* prev, int count, uint32_t* changed, int isa)
+{
+    int words = (count + 31) / 32;
+    memset(changed, 0, (size_t)words * sizeof(uint32_t));
+
+    int done = 0;
+#if defined(SCAN_X86)
+    switch (scan_resolve_isa(isa)) {
+    case SOEM_ISA_AVX2: done = diff_avx2(cur, prev, count, changed); break;
+    case SOEM_ISA_SSE2: done = diff_sse2(cur, prev, count, changed); break;
+    default: break;
+    }
+#else
+    (void)isa;
+#endif
+    diff_scalar(cur, prev, done, count, changed);
+
+    int n = 0;
+    for (int w = 0; w < words; ++w) n += popcount32(changed[w]);
+    return n;
+}
+
+SOEMSHIM_EXPORT int soem_simd_level(void)
+{
+    return scan_best_isa();
+}
+
+SOEMSHIM_EXPORT int soem_diff_inputs(const uint8_t* cur, uint8_t* prev, int count, uint32_t* changed, int changed_words, int isa)
+{
+    if (!cur || !prev || !changed || count < 0 || changed_words < (count + 31) / 32) return SOEM_ERR_BAD_ARGS;
+    return diff_block(cur, prev, count, changed, isa);
+}
+
+/* ---- status expansion ---- */
+
+static void expand_scalar(const soem_status_word_t* in, DriveTxPDO* out)
+{
+    uint8_t* dst = (uint8_t*)out;
+    memcpy(dst, &in->actual_position, 4);
+    for (int bit = 0; bit < 22; ++bit)
+        dst[4 + bit] = (uint8_t)((in->flags_slot >> bit) & 1u);
+    dst[26] = (uint8_t)(in->flags_slot >> 24);
+}
+
+#if defined(SCAN_X86)
+static void expand_sse2(const soem_status_word_t* in, DriveTxPDO* out, const __m128i bits)
+{
+    // Spread flag byte k over lanes 8k..8k+7, isolate bit (lane % 8), normalise to 0/1.
+    __m128i x = _mm_cvtsi32_si128((int)in->flags_slot);
+    x = _mm_unpacklo_epi8(x, x);    // b4 b4 b5 b5 b6 b6 s s
+    x = _mm_unpacklo_epi16(x, x);   // b4 x4, b5 x4, b6 x4, slot x4
+    __m128i lo = _mm_unpacklo_epi32(x, x);  // b4 x8, b5 x8
+    __m128i hi = _mm_unpackhi_epi32(x, x);  // b6 x8, slot x8
+    const __m128i one = _mm_set1_epi8(1);
+    lo = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(lo, bits), bits), one);
+    hi = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(hi, bits), bits), one);
+
+    uint8_t* dst = (uint8_t*)out;
+    uint8_t tail[16];
+    _mm_storeu_si128((__m128i*)tail, hi);
+    memcpy(dst, &in->actual_position, 4);
+    _mm_storeu_si128((__m128i*)(dst + 4), lo);  // flags 0..15
+    memcpy(dst + 20, tail, 6);                  // flags 16..21
+    dst[26] = (uint8_t)(in->flags_slot >> 24);
+}
+#endif
+
+SOEMSHIM_EXPORT int soem_expand_status(const soem_status_word_t* in, DriveTxPDO* out, int count, int isa)
+{
+    if (!in || !out || count < 0) return SOEM_ERR_BAD_ARGS;
+#if defined(SCAN_X86)
+    if (scan_resolve_isa(isa) >= SOEM_ISA_SSE2) {
+        const __m128i bits = _mm_set_epi8((char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                          (char)0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+        for (int i = 0; i < count; ++i) expand_sse2(&in[i], &out[i], bits);
+        return count;
+    }
+#else
+    (void)isa;
+#endif
+    for (int i = 0; i < count; ++i) expand_scalar(&in[i], &out[i]);
+    return count;
+}
+
+/* ---- handle-level scan ---- */
+
+void soem_scan_release(soem_handle_t* h)
+{
+    if (!h || !h->scan) return;
+    free(h->scan->prev);
+    free(h->scan->stage);
+    free(h->scan);
+    h->scan = NULL;
+}
+
+static soem_scan_state_t* scan_prepare(soem_handle_t* h)
+{
+    ecx_contextt* ctx = &h->context;
+    int n = ctx->slavecount;
+    soem_scan_state_t* s = h->scan;
+    if (s && s->slaves == n) return s;
+
+    soem_scan_release(h);
+    s = (soem_scan_state_t*)calloc(1, sizeof(*s));
+    if (!s) return NULL;
+    s->slaves = n;
+    s->prev = (uint8_t*)calloc((size_t)(n > 0 ? n : 1), SCAN_TX_BYTES);
+    s->stage = (uint8_t*)calloc((size_t)(n > 0 ? n : 1), SCAN_TX_BYTES);
+    if (!s->prev || !s->stage) {
+        free(s->prev); free(s->stage); free(s);
+        return NULL;
+    }
+
+    s->contiguous = n > 0;
+    for (int i = 1; i <= n && s->contiguous; ++i) {
+        ec_slavet* sl = &ctx->slavelist[i];
+        if (!sl->inputs || (int)sl->Ibytes < SCAN_TX_BYTES || sl->inputs != ctx->slavelist[1].inputs + (size_t)(i - 1) * SCAN_TX_BYTES)
+            s->contiguous = 0;
+    }
+    s->block = s->contiguous ? ctx->slavelist[1].inputs : NULL;
+    h->scan = s;
+    return s;
+}
+
+SOEMSHIM_EXPORT int soem_scan_inputs(soem_handle_t* h, uint32_t* changed, int changed_words, soem_status_word_t* status, int status_count)
+{
+    if (!h || !changed || status_count < 0 || (status_count > 0 && !status)) return SOEM_ERR_BAD_ARGS;
+
+    int n = h->context.slavecount;
+    if (changed_words < (n + 31) / 32) return SOEM_ERR_BAD_ARGS;
+
+    soem_scan_state_t* s = scan_prepare(h);
+    if (!s) return SOEM_ERR_BAD_ARGS;
+
+    const uint8_t* cur = s->block;
+    if (!s->contiguous) {
+        for (int i = 0; i < n; ++i) {
+            ec_slavet* sl = &h->context.slavelist[i + 1];
+            uint8_t* dst = s->stage + (size_t)i * SCAN_TX_BYTES;
+            if (sl->inputs && (int)sl->Ibytes >= SCAN_TX_BYTES) memcpy(dst, sl->inputs, SCAN_TX_BYTES);
+            else memset(dst, 0, SCAN_TX_BYTES);
+        }
+        cur = s->stage;
+    }
+
+    int count;
+    if (!s->primed) {
+        // First scan of this handle: everything counts as changed.
+        memcpy(s->prev, cur, (size_t)n * SCAN_TX_BYTES);
+        memset(changed, 0, (size_t)((n + 31) / 32) * sizeof(uint32_t));
+        for (int i = 0; i < n; ++i) changed[i >> 5] |= 1u << (i & 31);
+        s->primed = 1;
+        count = n;
+    } else {
+        count = diff_block(cur, s->prev, n, changed, SOEM_ISA_AUTO);
+    }
+
+    // Words of unchanged slaves are already in the caller's array from an earlier call.
+    int m = status_count < n ? status_count : n;
+    for (int w = 0; w * 32 < m; ++w) {
+        uint32_t bits = changed[w];
+        while (bits) {
+            int i = w * 32;
+#if defined(_MSC_VER)
+            unsigned long tz; _BitScanForward(&tz, bits); i += (int)tz;
+#else
+            i += __builtin_ctz(bits);
+#endif
+            bits &= bits - 1;
+            if (i >= m) break;
+            const uint8_t* b = s->prev + (size_t)i * SCAN_TX_BYTES;
+            status[i].actual_position = (int32_t)((uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24));
+            status[i].flags_slot = (uint32_t)b[4] | ((uint32_t)b[5] << 8) | ((uint32_t)b[6] << 16) | ((uint32_t)b[7] << 24);
+        }
+    }
+
+    return count;
+}
@@ -21,17 +21,97 @@ typedef enum { SOEM_LOG_INFO = 0, SOEM_LOG_WARN = 1, SOEM_LOG_ERR = 2 } soem_log
 #define SOEM_ERR_SEND_FAIL  (-11)
 #define SOEM_ERR_RECV_FAIL  (-12)
 #define SOEM_ERR_WKC_LOW    (-10)
+#define SOEM_ERR_UNSUPPORTED (-14)  // not available on this platform/build
+#define SOEM_ERR_BUSY       (-15)  // the cyclic engine owns the bus
+#define SOEM_ERR_RT_START   (-16)  // cyclic engine thread could not be started
+#define SOEM_ERR_SDO        (-17)  // SDO transfer aborted or timed out; an abort code is in the error list
+#define SOEM_ERR_IO         (-18)  // a file could not be read or written
 #endif
 
-    // log_message(level, fmt, ...)
+    // log_message(level, fmt, ...): formats into a ring record at the call site. Keep it off the cycle path.
 #ifndef LOGI
 #define LOGI(...) log_message(SOEM_LOG_INFO, __VA_ARGS__)
 #define LOGW(...) log_message(SOEM_LOG_WARN, __VA_ARGS__)
 #define LOGE(...) log_message(SOEM_LOG_ERR,  __VA_ARGS__)
 #endif
 
+    // LOG_EVENT(level, SOEM_LOGC_*, args...): up to SOEM_LOG_ARGS integers, formatted only when drained.
+#ifndef LOG_EVENT
+#define LOG_EVENT(lvl, code, ...) soem_log_event((lvl), (code), (const int64_t[]){ __VA_ARGS__ }, \
+    (int)(sizeof((const int64_t[]){ __VA_ARGS__ }) / sizeof(int64_t)))
+#endif
+
+typedef void (*soem_log_callback_t)(soem_log_level_t level, const char* message);
+// bus: soem_get_bus_id of the handle the record was written for, 0 for records outside any handle.
+typedef void (*soem_log_bus_callback_t)(soem_log_level_t level, uint32_t bus, const char* message);
+
+/* Log record codes (soem_log.c). SOEM_LOGC_TEXT carries text formatted by LOGI/LOGW/LOGE; the others are raised
+   on the cycle path with the integer arguments listed and formatted by soem_log_drain. */
+#define SOEM_LOGC_TEXT      0
+#define SOEM_LOGC_SEND_FAIL 1  // rc, expected_wkc
+#define SOEM_LOGC_RECV_FAIL 2  // rc, expected_wkc, timeout_us
+#define SOEM_LOGC_WKC_ZERO  3  // expected_wkc, wkc
+#define SOEM_LOGC_WKC_LOW   4  // wkc, expected_wkc, Obytes, Ibytes, outputsWKC, inputsWKC
+#define SOEM_LOGC_DROPPED   5  // records lost since the previous drain (raised by soem_log_drain itself)
+#define SOEM_LOGC_SLAVE_LOST     6  // slave
+#define SOEM_LOGC_SLAVE_FOUND    7  // slave
+#define SOEM_LOGC_SLAVE_RECONFIG 8  // slave
+#define SOEM_LOGC_RECOVERED      9  // state reads so far
+#define SOEM_LOGC_TOPOLOGY      10  // old path, new path (SOEM_RED_PATH_*)
+#define SOEM_LOGC_RED_PROBE     11  // path, primary_slaves, secondary_slaves, break_after
+#define SOEM_LOGC_SDO_FAIL      12  // slave, index, subindex, write, wkc
+
+#define SOEM_LOG_ARGS 6
+#define SOEM_LOG_TEXT 128
+
+typedef struct soem_log_record {
+    int64_t timestamp_ns;  // monotonic time the record was written
+    int32_t level;         // soem_log_level_t
+    int32_t code;          // SOEM_LOGC_*
+    uint32_t bus;          // bus id the writing thread was bound to (soem_log_bind), 0 = none
+    int32_t reserved;
+    int64_t args[SOEM_LOG_ARGS];
+    char text[SOEM_LOG_TEXT];  // SOEM_LOGC_TEXT only, truncated to SOEM_LOG_TEXT - 1 characters
+} soem_log_record_t;
+
 typedef struct soem_handle soem_handle_t;
 
+// How soem_initialize configured the bus (soem_get_boot_report).
+#define SOEM_BOOT_DISCOVERED 0  // ecx_config_init + ecx_config_map_group: every slave's SII and PDO mapping read
+#define SOEM_BOOT_CACHED     1  // from the stored configuration at config_path, after checking the bus against it
+// What became of the stored configuration (soem_boot_report_t.config).
+#define SOEM_CONFIG_OFF      0  // no config_path
+#define SOEM_CONFIG_USED     1
+#define SOEM_CONFIG_MISSING  2  // no file yet; discovery writes it
+#define SOEM_CONFIG_STALE    3  // unreadable, from another shim build, or mapped with other group/SDO options
+#define SOEM_CONFIG_COUNT    4  // the bus has a different number of slaves
+#define SOEM_CONFIG_IDENTITY 5  // mismatch_slave has another vendor, product or revision
+#define SOEM_CONFIG_TOPOLOGY 6  // mismatch_slave has other ports open
+#define SOEM_CONFIG_FAILED   7  // mismatch_slave did not take the stored SM/FMMU settings
+
+typedef struct soem_boot_report {
+    int32_t source;           // SOEM_BOOT_*
+    int32_t config;           // SOEM_CONFIG_*
+    int32_t mismatch_slave;   // slave that failed the check, 0 = none
+    int32_t config_written;   // discovery (re)wrote config_path
+    int32_t slaves;
+    int32_t sii_cached;       // slaves whose SII came from sii_cache_path
+    int32_t sii_read;         // slaves whose SII was read from the bus into sii_cache_path
+    int32_t op_slaves;        // slaves in OP at the end; fewer than slaves = the bring-up timed out
+    int64_t configure_ns;     // discovery and mapping, or check and restore
+    int64_t total_ns;         // whole initialization, NIC open to OP
+    // Startup timeline, one phase after the other; together they make up total_ns but for allocations and logging.
+    int64_t nic_ns;           // ecx_init: opening the interface(s)
+    int64_t discovery_ns;     // ecx_config_init, or the check and restore of the stored configuration
+    int64_t mapping_ns;       // group assignment, ecx_config_map_group and the IOmap (0 when restored)
+    int64_t dc_ns;            // ecx_configdc and SYNC0
+    int64_t safeop_ns;        // cycling until the last slave reported SAFE-OP
+    int64_t op_ns;            // from there until the last slave reported OP (or the bring-up gave up)
+} soem_boot_report_t;
+
+#define SOEM_IOMAP_KIND_HEAP  0  // aligned heap block
+#define SOEM_IOMAP_KIND_PAGES 1  // huge/large page mapping
+
 // NOTE: soem_handle_t and all soemshim functions operating on a given handle are NOT thread-safe.
 // If multiple threads need to access the same soem_handle_t, all access must be externally serialized
 // (e.g., using a mutex or critical section). Concurrent use from multiple threads may result in
@@ -39,11 +119,30 @@ typedef struct soem_handle soem_handle_t;
 typedef struct soem_handle
 {
     ecx_contextt context;
-    uint8* IOmap;            // <-- pointer, not fixed array
+    uint8* IOmap;            // exact-size, 64-byte aligned process image (see soem_get_iomap)
+    size_t iomap_size;       // bytes used by ecx_config_map_group
+    size_t iomap_capacity;   // bytes allocated (rounded to the cache line or page size)
+    int iomap_kind;          // SOEM_IOMAP_KIND_*
+    int iomap_locked;        // mlock/VirtualLock succeeded
     int output_length;
     int input_length;
     int last_wkc;
     int last_expected_wkc;
+    struct soem_rt_engine* rt; // cyclic engine, NULL unless soem_rt_start was called
+    struct soem_scan_state* scan; // input change tracker, NULL until soem_scan_inputs is first called
+    int cycle_in_flight;     // soem_send_cycle sent frames that soem_receive_cycle has not collected yet
+    int64_t cycle_sent_ns;   // monotonic time of the last soem_send_cycle
+    int64_t cycle_done_ns;   // when soem_poll_cycle first saw every frame back, 0 until then
+    struct soem_dc_state* dc; // distributed clock tracking, NULL unless SYNC0 was enabled at init
+    struct soem_stats_state* stats; // cycle latency histograms (soem_get_cycle_stats)
+    struct soem_state_cache* al_state; // per-slave AL state cache (soem_get_slave_states)
+    struct soem_red_state* red; // cable redundancy, NULL unless opened with soem_initialize_redundant
+    struct soem_group_state* groups; // process-data groups and their rates (soem_get_group_status)
+    struct soem_sdo_engine* sdo; // CoE mailbox queue and workers, NULL unless opened with sdo_workers > 0
+    struct soem_ring* ring;  // memory-mapped cyclic frame rings, NULL unless opened with SOEM_NIC_RING (Linux only)
+    struct soem_cap* cap;    // wire capture ring, NULL unless opened with capture_bytes > 0 (Linux only)
+    uint32_t bus_id;         // tags this handle's log records (soem_get_bus_id)
+    soem_boot_report_t boot; // how the bus was configured and how long it took (soem_get_boot_report)
 } soem_handle_t;
 
 //determined from running slaveinfo from the SOEM package on the NIC connected to the backplane
@@ -133,6 +232,75 @@ typedef struct soem_slave_info
 } soem_slave_info_t;
 
 
+// Distributed clocks (soem_dc.c). Phase is where in the SYNC0 period a cycle's frame passed the reference clock,
+// measured against the target of lead_ns before SYNC0. All zero unless SYNC0 was enabled at init.
+typedef struct soem_dc_stats {
+    int32_t  active;          // SYNC0 is running on sync0_slaves slaves
+    int32_t  sync0_slaves;
+    int32_t  cycle_ns;        // SYNC0 period
+    int32_t  shift_ns;        // SYNC0 shift from the DC period boundary
+    int32_t  lead_ns;         // target: frames reach the reference clock this long before SYNC0
+    int32_t  offset_ns;       // last phase error against the target, > 0 = frame later than wanted
+    int32_t  offset_min_ns;   // since SYNC0 was enabled
+    int32_t  offset_max_ns;
+    int32_t  drift_ppb;       // host clock rate minus reference clock rate (smoothed), > 0 = host runs fast
+    int32_t  correction_ns;   // last PI adjustment of the cyclic engine's wake-up, 0 when not steering
+    int64_t  dc_time_ns;      // reference clock at the last sample (ns since 2000-01-01)
+    uint64_t samples;         // cycles that came back with a DC time
+} soem_dc_stats_t;
+
+// Cable redundancy (soem_red.c): where a cycle's frames travelled, graded from the port each came back on.
+#define SOEM_RED_PATH_RING      1  // ring closed: each port's frame came back on the other port
+#define SOEM_RED_PATH_PRIMARY   2  // line from the primary port; the secondary side is open
+#define SOEM_RED_PATH_SECONDARY 3  // line from the secondary port; the primary link is down
+#define SOEM_RED_PATH_SPLIT     4  // ring broken between slaves: each side reached its half
+#define SOEM_RED_PATH_LOST      5  // a frame came back on neither port
+#define SOEM_RED_MAX_FRAMES     16
+
+typedef struct soem_redundancy {
+    int32_t  enabled;          // opened with a secondary interface
+    int32_t  path;             // SOEM_RED_PATH_* of the last cycle (its most degraded frame)
+    int32_t  primary_slaves;   // slaves the primary port reaches, as of the last probe
+    int32_t  secondary_slaves; // slaves the secondary port reaches
+    int32_t  break_after;      // slave whose outgoing link is down on a split ring, 0 = none
+    int32_t  frames;           // frames in the last cycle
+    uint8_t  frame_path[SOEM_RED_MAX_FRAMES]; // SOEM_RED_PATH_* per frame of the last cycle
+    uint64_t cycles;
+    uint64_t degraded_cycles;  // cycles not on a closed ring
+    uint64_t topology_changes;
+    int64_t  changed_ns;       // monotonic time of the last path change
+} soem_redundancy_t;
+
+// SOEM error list entry types (ec_err_type).
+#define SOEM_ERRT_SDO          0   // CoE SDO abort: abort_code
+#define SOEM_ERRT_EMERGENCY    1   // CoE emergency: error_code, error_reg, emergency_b1/w1/w2
+#define SOEM_ERRT_PACKET       3   // unexpected mailbox frame: error_code
+#define SOEM_ERRT_SDOINFO      4   // SDO information abort: abort_code
+#define SOEM_ERRT_FOE          5   // FoE error: abort_code
+#define SOEM_ERRT_FOE_BUF2SMALL 6
+#define SOEM_ERRT_FOE_PACKETNO 7
+#define SOEM_ERRT_SOE          8   // SoE error: error_code
+#define SOEM_ERRT_MBX          9   // mailbox error reply: error_code
+#define SOEM_ERRT_FOE_NOTFOUND 10
+#define SOEM_ERRT_EOE_RX       11
+
+// One ec_errort from SOEM's error list, flattened to fixed offsets (32 bytes). abort_code is the raw 32-bit
+// union, so for emergencies it also holds error_code and error_reg.
+typedef struct soem_error_record {
+    int64_t  timestamp_ns;    // ec_errort.Time as SOEM stamped it
+    int32_t  type;            // SOEM_ERRT_*
+    int32_t  abort_code;
+    uint16_t slave;           // 1-based, 0 = master
+    uint16_t index;           // CoE object index / SoE IDN
+    uint16_t error_code;
+    uint16_t emergency_w1;
+    uint16_t emergency_w2;
+    uint8_t  subindex;
+    uint8_t  error_reg;
+    uint8_t  emergency_b1;
+    uint8_t  reserved[3];
+} soem_error_record_t;
+
 typedef struct soem_health {
     int slaves_found;
     int group_expected_wkc;
@@ -141,10 +309,237 @@ typedef struct soem_health {
     int bytes_in;
     int slaves_op;            // count currently OP
     uint32_t al_status_code;  // 0 if unknown
+    soem_dc_stats_t dc;
 } soem_health_t;
 
+#define SOEM_MAX_GROUPS 4
+
+// Options for soem_initialize_ex. Always set struct_size = sizeof(soem_init_options_t); fields added later
+// are appended so older callers keep working.
+#define SOEM_IOMAP_LOCKED     0x1u  // lock the process image in RAM (mlock / VirtualLock)
+#define SOEM_IOMAP_HUGE_PAGES 0x2u  // back it with a huge/large page when the OS allows it
+#define SOEM_NIC_SOCKET 0  // every frame through SOEM's own NIC driver (raw socket on Linux, pcap on Windows)
+#define SOEM_NIC_RING   1  // cyclic frames through memory-mapped AF_PACKET rings (Linux only; others stay on SOEM's)
+#define SOEM_CAPTURE_ON_FAULT 0x1u  // write a pcapng into capture_dir when a cycle's WKC drops (at most once a second)
+typedef struct soem_init_options {
+    uint32_t struct_size;
+    uint32_t iomap_flags;   // SOEM_IOMAP_*
+    uint32_t dc_cycle_ns;   // > 0: start SYNC0 with this period on every DC-capable slave
+    int32_t  dc_shift_ns;   // SYNC0 shift from the DC period boundary
+    int32_t  dc_lead_ns;    // how long before SYNC0 frames should pass the reference clock, 0 = a quarter cycle
+    uint32_t cycle_period_ns; // caller's cycle period; grades wake-up lateness of exchange calls (0 = not recorded)
+    uint32_t state_check_ms;  // periodic AL state read while the WKC is full (0 = 1000 ms); a WKC drop reads at once
+    uint32_t group_count;     // process-data groups, 0 or 1 = everything in group 0 (at most SOEM_MAX_GROUPS and EC_MAXGROUP)
+    uint32_t group_divider[SOEM_MAX_GROUPS]; // group g is exchanged every group_divider[g]-th cycle (0 = every cycle)
+    const uint8_t* slave_group; // group of slave i + 1 at [i], read during initialize only; NULL = all in group 0
+    int32_t  slave_group_count; // entries in slave_group; later slaves stay in group 0
+    uint32_t bus_id;          // log tag for the handle's records, from soem_log_new_bus; 0 = the shim takes a new one
+    uint32_t sdo_workers;     // > 0: run CoE slaves' mailboxes through the cyclic handler, with this many SDO threads
+    uint32_t sdo_actions;     // mailboxes moved per soem_sdo_service / engine cycle, 0 = 2
+    uint32_t nic_backend;     // SOEM_NIC_*; a ring the shim cannot open falls back to SOEM_NIC_SOCKET with a warning
+    uint32_t nic_ring_frames; // slots per RX and TX ring, 0 = 256
+    const char* capture_dir;  // capture ring file and fault pcapng files (Linux only), NULL = /dev/shm
+    uint32_t capture_bytes;   // > 0: copy every cyclic frame into a capture ring of this size (at least 64 KiB)
+    uint32_t capture_window_ms; // exports keep the frames of the last this-many ms, 0 = the whole ring
+    uint32_t capture_flags;   // SOEM_CAPTURE_*
+    const char* config_path;  // stored configuration: used when the bus matches it, written after a discovery; NULL = off
+    const char* sii_cache_path; // SII images by vendor/product/revision/serial, for the discovery; NULL = off
+} soem_init_options_t;
+
+// Cyclic frame transport counters (soem_get_nic_stats), all zero but backend for SOEM_NIC_SOCKET.
+typedef struct soem_nic_stats {
+    int32_t  backend;         // SOEM_NIC_* actually in use
+    int32_t  ring_frames;     // slots per RX and TX ring
+    uint64_t tx_frames;       // cyclic frames queued in the TX ring
+    uint64_t rx_frames;       // cyclic frames taken from the RX ring
+    uint64_t rx_dropped;      // ring frames that did not belong to the cycle in flight (late returns)
+    uint64_t tx_busy;         // sends refused because the kernel still owned the next TX slot
+    uint64_t kicks;           // send() calls, one per cycle
+} soem_nic_stats_t;
+
+// Wire capture counters (soem_capture_get_stats), all zero without a capture ring.
+typedef struct soem_capture_stats {
+    int32_t  enabled;         // a capture ring is open
+    uint32_t window_ms;
+    uint64_t ring_bytes;
+    uint64_t frames;          // frames copied into the ring, sent and received
+    uint64_t bytes;           // frame bytes copied into the ring
+    uint64_t overwritten;     // frames the ring has since dropped to make room
+    uint64_t exports;         // pcapng files written, on demand and on fault
+    uint64_t fault_exports;   // of those, written after a WKC drop
+} soem_capture_stats_t;
+
+#define SOEM_SDO_MAX_BYTES 256
+
+// A submitted SDO transfer and, once soem_sdo_poll returns it, its result (288 bytes).
+typedef struct soem_sdo_completion {
+    uint32_t ticket;          // as returned by soem_sdo_read / soem_sdo_write
+    int32_t  status;          // bytes transferred, or SOEM_ERR_SDO
+    uint16_t slave;
+    uint16_t index;
+    uint8_t  subindex;
+    uint8_t  write;           // 1 = download (write), 0 = upload (read)
+    uint16_t size;            // bytes in data: read result, or the written value
+    int64_t  reserved;
+    int64_t  elapsed_ns;      // submit to completion
+    uint8_t  data[SOEM_SDO_MAX_BYTES];
+} soem_sdo_completion_t;
+
+typedef struct soem_sdo_stats {
+    int32_t  workers;
+    int32_t  in_flight;       // queued or on the wire
+    uint64_t submitted;
+    uint64_t completed;       // including failures
+    uint64_t failed;
+    uint64_t service_calls;   // mailbox handler passes that had work in flight
+    int64_t  max_service_ns;  // longest of those passes, i.e. the most the slack after a cycle was used
+    int64_t  max_latency_ns;  // longest submit-to-completion
+} soem_sdo_stats_t;
 
+// Per-group process-data status (soem_get_group_status). A group's WKC is taken from its own frames, so a
+// slow group's dropout does not hide behind the fast group's count.
+typedef struct soem_group_status {
+    int32_t  group;
+    int32_t  divider;          // exchanged every divider-th cycle
+    int32_t  slave_count;
+    int32_t  expected_wkc;
+    int32_t  last_wkc;         // of the last exchange that included the group, -1 before the first
+    int32_t  slaves_op;        // all slaves while the WKC is full, otherwise from the last AL state read
+    int32_t  bytes_out;
+    int32_t  bytes_in;
+    uint64_t exchanges;
+    uint64_t wkc_low;          // exchanges with last_wkc < expected_wkc
+    int64_t  last_exchange_ns; // monotonic time the group's frames last came back
+} soem_group_status_t;
+
+// Where a slave's process data lives inside the IOmap returned by soem_get_iomap. Offsets are -1 when absent.
+typedef struct soem_slave_io {
+    int32_t out_offset;
+    int32_t out_bytes;
+    int32_t in_offset;
+    int32_t in_bytes;
+} soem_slave_io_t;
+
+// A drive's TxPDO in wire form: position plus the three flag bytes and the slot, packed into one 32-bit word.
+// flags_slot bit n (n < 24) is bit n % 8 of input byte 4 + n / 8, i.e. the DriveTxPDO flag order; bits 24..31 are
+// the slot. Two statuses compare with one XOR of (flags_slot & SOEM_STATUS_FLAGS_MASK).
+#define SOEM_STATUS_FLAGS_MASK 0x00FFFFFFu
+typedef struct soem_status_word {
+    int32_t  actual_position;
+    uint32_t flags_slot;
+} soem_status_word_t;
+
+// Result of soem_cycle: everything the managed loop needs from one bus cycle.
+typedef struct soem_cycle_result {
+    int32_t status;         // same as the return value: wkc, or a SOEM_ERR_* code
+    int32_t wkc;            // raw working counter of this cycle
+    int32_t expected_wkc;
+    int32_t error_pending;  // non-zero when the SOEM error list has entries (drain it)
+    int32_t slave_count;
+    int32_t tx_count;       // status words written to the caller's array
+    int64_t exchange_ns;    // send + receive (split cycle: send until the frames were back)
+    int64_t total_ns;       // whole call including pack/unpack (split cycle: send until soem_receive_cycle returned)
+    int32_t state_due;      // an AL state read is due: call soem_check_state once the cycle's work is done
+    int32_t red_path;       // SOEM_RED_PATH_* of this cycle, 0 without cable redundancy
+} soem_cycle_result_t;
+
+#define SOEM_SLAVE_LOST       0x1  // stopped answering; its process data is stale until recovery finds it again
+#define SOEM_SLAVE_RECOVERING 0x2  // out of OP and queued for per-slave recovery
+
+// AL state of one slave as of the last state read, or OP for every slave once a full WKC follows a degraded cycle.
+typedef struct soem_slave_state {
+    uint16_t state;           // EC_STATE_*; EC_STATE_ERROR (0x10) is or'ed in while the slave flags an AL error
+    uint16_t al_status_code;  // 0 = none
+    uint16_t flags;           // SOEM_SLAVE_*
+    uint16_t reserved;
+} soem_slave_state_t;
+
+typedef struct soem_state_info {
+    int32_t  slaves_op;
+    uint32_t al_status_code;  // first non-zero AL status code among the slaves
+    int64_t  read_ns;         // monotonic time of the last ecx_readstate
+    uint64_t reads;           // ecx_readstate calls since init
+    int32_t  recovering;      // per-slave recovery is armed
+    int32_t  slaves_lost;     // slaves flagged SOEM_SLAVE_LOST
+} soem_state_info_t;
+
+// Latency distribution of one metric over a soem_get_cycle_stats window. Percentiles are the top of their
+// histogram bucket (within 3.1 %), clamped to [min_ns, max_ns]. All zero when count is 0.
+typedef struct soem_latency_summary {
+    uint64_t count;
+    int64_t  min_ns;
+    int64_t  max_ns;
+    int64_t  mean_ns;
+    int64_t  p50_ns;
+    int64_t  p90_ns;
+    int64_t  p99_ns;
+    int64_t  p999_ns;
+    int64_t  p9999_ns;
+} soem_latency_summary_t;
+
+typedef struct soem_cycle_stats {
+    int64_t interval_ns;                  // window covered: since the previous soem_get_cycle_stats (or init)
+    soem_latency_summary_t round_trip;    // send until the frames were back
+    soem_latency_summary_t wake_lateness; // cycle start behind its deadline (engine deadline or cycle_period_ns schedule)
+    soem_latency_summary_t total;         // cycle start until the call returned (engine: until the sample was published)
+} soem_cycle_stats_t;
+
+// Native cyclic engine (Linux only). A dedicated thread runs send/receive on absolute deadlines;
+// managed code exchanges RxPDO commands and TxPDO samples through single-producer/single-consumer rings.
+typedef struct soem_rt_config {
+    int cycle_time_us;       // bus cycle period
+    int priority;            // SCHED_FIFO priority 1..99, 0 = leave the default scheduler
+    int cpu;                 // CPU to pin the thread to, -1 = no affinity
+    int lock_memory;         // non-zero: mlockall(MCL_CURRENT | MCL_FUTURE) before starting
+    int receive_timeout_us;  // ecx_receive_processdata timeout, 0 = half the cycle
+    int ring_capacity;       // slots per ring, rounded up to a power of two (0 = 256)
+    int dc_sync;             // non-zero: steer wake-ups so frames keep the SYNC0 lead (needs SYNC0 at cycle_time_us)
+} soem_rt_config_t;
+
+// One captured cycle. soem_rt_pop_sample copies slave_count * soem_expected_tx_bytes() raw input bytes alongside it.
+typedef struct soem_rt_sample {
+    uint64_t cycle;           // engine cycle counter
+    int64_t  timestamp_ns;    // CLOCK_MONOTONIC after receive
+    int32_t  wkc;             // working counter, negative on send failure
+    int32_t  expected_wkc;
+    int32_t  wake_latency_ns; // how late the thread woke relative to its deadline
+    int32_t  exchange_ns;     // send + receive duration
+    int32_t  slave_count;
+    int32_t  error_pending;   // SOEM error list had entries after this cycle
+    int32_t  red_path;        // SOEM_RED_PATH_*, 0 without cable redundancy
+    int32_t  reserved;
+} soem_rt_sample_t;
+
+typedef struct soem_rt_stats {
+    int32_t  running;
+    int32_t  cycle_time_us;
+    uint64_t cycles;
+    uint64_t overruns;           // deadlines missed by more than one period
+    uint64_t wkc_low;            // cycles with wkc < expected
+    uint64_t samples_dropped;    // sample ring full (consumer too slow)
+    uint64_t commands_applied;
+    int64_t  last_wake_latency_ns;
+    int64_t  max_wake_latency_ns;
+    int64_t  max_exchange_ns;
+} soem_rt_stats_t;
+
+// Kernel selection for the bulk scan helpers (soem_scan.c). AUTO picks the best the CPU supports; a request
+// above that is clamped down.
+#define SOEM_ISA_AUTO   0
+#define SOEM_ISA_SCALAR 1
+#define SOEM_ISA_SSE2   2
+#define SOEM_ISA_AVX2   3
+
+/* Non-blocking accessors (soem_get_slave_count, soem_expected_*_bytes, soem_read_txpdo, soem_read_status, soem_write_rxpdo,
+   soem_get_iomap, soem_get_io_layout, soem_scan_inputs, soem_diff_inputs, soem_expand_status, soem_simd_level,
+   soem_get_dc_stats, soem_get_redundancy, soem_get_group_status, soem_get_bus_id, soem_log_dropped, soem_has_errors, soem_pop_errors, soem_get_slave_states, soem_recover_start, soem_rt_push_command,
+   soem_rt_pop_sample, soem_rt_get_stats, soem_get_nic_stats, soem_capture_get_stats, soem_get_boot_report) never log, block or call back, so the managed side binds them with SuppressGCTransition. Keep it that way. */
 SOEMSHIM_EXPORT soem_handle_t* soem_initialize(const char* ifname);
+SOEMSHIM_EXPORT soem_handle_t* soem_initialize_ex(const char* ifname, const soem_init_options_t* options);
+/* soem_initialize_ex on a ring wired back to a second NIC (ecx_init_redundant). Every frame goes out of both
+   ports, so a single cable break loses no cycle: soem_cycle_result_t.red_path and soem_get_redundancy report
+   where the frames travelled, and a path change is logged as a topology event. options may be NULL. */
+SOEMSHIM_EXPORT soem_handle_t* soem_initialize_redundant(const char* ifname, const char* if2name, const soem_init_options_t* options);
 SOEMSHIM_EXPORT void soem_shutdown(soem_handle_t* handle);
 SOEMSHIM_EXPORT int  soem_get_slave_count(soem_handle_t* handle);
 SOEMSHIM_EXPORT int  soem_get_process_sizes(soem_handle_t* h, int* outputs, int* inputs);
@@ -152,17 +547,157 @@ SOEMSHIM_EXPORT int  soem_scan_slaves(soem_handle_t* h, soem_slave_info_t* buf,
 SOEMSHIM_EXPORT int  soem_expected_rx_bytes(void);
 SOEMSHIM_EXPORT int  soem_expected_tx_bytes(void);
 SOEMSHIM_EXPORT int  soem_read_txpdo(soem_handle_t* h, int slave_index, DriveTxPDO* out);
+/* Same input bytes as soem_read_txpdo, packed instead of expanded to one byte per flag. Returns 1 or 0. */
+SOEMSHIM_EXPORT int  soem_read_status(soem_handle_t* h, int slave_index, soem_status_word_t* out);
 SOEMSHIM_EXPORT int  soem_write_rxpdo(soem_handle_t* h, int slave_index, const DriveRxPDO* in);
 SOEMSHIM_EXPORT int  soem_exchange_process_data(soem_handle_t* h, const uint8_t* outputs, int outputs_len, uint8_t* inputs, int inputs_len, int timeout_us);
 SOEMSHIM_EXPORT int  soem_try_recover(soem_handle_t* h, int timeout_ms);
+/* One complete cycle in a single call: pack rx[0..rx_count) into slaves 1..rx_count, exchange, read the status
+   words of slaves 1..tx_count into tx[]. Either array may be NULL with a zero count. res may be NULL.
+   Returns the same codes as soem_exchange_process_data. */
+SOEMSHIM_EXPORT int  soem_cycle(soem_handle_t* h, const DriveRxPDO* rx, int rx_count, soem_status_word_t* tx, int tx_count,
+    int timeout_us, soem_cycle_result_t* res);
+/* soem_cycle split at the wire so the caller can work while the frames travel. soem_send_cycle ships the IOmap
+   outputs and returns 1, SOEM_ERR_SEND_FAIL, or SOEM_ERR_BUSY when a cycle is already in flight or the cyclic
+   engine runs. Until soem_receive_cycle the IOmap inputs still hold the previous cycle. Outputs written to the
+   IOmap in between are lost on SOEM's socket path: the receive copies each LRW payload back over the IOmap, the
+   sent outputs included (only the ring backend skips them). Stage the next outputs aside and write them after
+   soem_receive_cycle. soem_poll_cycle never waits: 1 once every frame is back (soem_receive_cycle then returns at once),
+   0 while any is outstanding, SOEM_ERR_BAD_ARGS without a cycle in flight. soem_receive_cycle waits up to
+   timeout_us for the rest, updates the IOmap inputs and reads statuses like soem_cycle; res->exchange_ns is the
+   round trip as seen by the first successful poll (or by the receive itself when nobody polled). */
+SOEMSHIM_EXPORT int  soem_send_cycle(soem_handle_t* h);
+SOEMSHIM_EXPORT int  soem_poll_cycle(soem_handle_t* h);
+SOEMSHIM_EXPORT int  soem_receive_cycle(soem_handle_t* h, soem_status_word_t* tx, int tx_count, int timeout_us, soem_cycle_result_t* res);
 
-/* Return a pointer to a null-terminated error string.
+/* Non-zero when SOEM's error list holds entries; one index compare, cheap enough for every cycle. */
+SOEMSHIM_EXPORT int  soem_has_errors(soem_handle_t* h);
+/* Pop up to max entries of SOEM's error list into buf, oldest first. Returns the number written; call again while
+   it returns max. Entries that do not fit stay queued. */
+SOEMSHIM_EXPORT int  soem_pop_errors(soem_handle_t* h, soem_error_record_t* buf, int max);
+/* Legacy text form of the error list (ecx_elist2string). Prefer soem_has_errors/soem_pop_errors.
+   Return a pointer to a null-terminated error string.
    - returns "invalid handle" if h is NULL
    - returns empty string ("") if there are no errors
    - otherwise returns a pointer to an internal buffer containing the readable error text
    The returned pointer is valid until the next call and is safe for P/Invoke string marshaling. */
 SOEMSHIM_EXPORT int soem_drain_error_list(soem_handle_t* h, char* buf, int buf_sz);
+/* Health from the last cycle and the AL state cache; no bus traffic, safe while the cyclic engine runs. */
 SOEMSHIM_EXPORT int  soem_get_health(soem_handle_t* h, soem_health_t* out);
+/* Slave AL states (soem_state.c). The cycle path never reads them inline: a WKC drop or the state_check_ms
+   interval sets soem_cycle_result_t.state_due and soem_check_state performs the ecx_readstate (the cyclic engine
+   does it itself after publishing the cycle's sample). soem_check_state returns the OP count, 0 when no read was
+   due and force is 0, SOEM_ERR_BUSY while the cyclic engine runs. soem_get_slave_states copies up to max_count
+   cached entries (slave 1 first) and the summary, and returns the count copied. */
+SOEMSHIM_EXPORT int  soem_check_state(soem_handle_t* h, int force);
+SOEMSHIM_EXPORT int  soem_get_slave_states(soem_handle_t* h, soem_slave_state_t* out, int max_count, soem_state_info_t* info);
+/* Per-slave recovery without stopping the cycle. soem_recover_start only arms it (returns 1, 0 for a bad handle)
+   and is non-blocking. Each soem_recover_step then takes one bounded action on one slave out of OP - acknowledge,
+   request OP, reconfigure, or probe a lost slave - so call it once between cycles; healthy slaves keep exchanging
+   throughout. Returns the slaves still out of OP (> 0), 0 once all are back (recovery disarms itself),
+   SOEM_ERR_BUSY while a cycle is in flight or the cyclic engine runs (the engine steps it after each cycle). */
+SOEMSHIM_EXPORT int  soem_recover_start(soem_handle_t* h);
+SOEMSHIM_EXPORT int  soem_recover_step(soem_handle_t* h);
+/* Distributed clock statistics without the bus round trip of soem_get_health. Safe to call while the cyclic
+   engine runs (the engine publishes them under a sequence lock). */
+SOEMSHIM_EXPORT int  soem_get_dc_stats(soem_handle_t* h, soem_dc_stats_t* out);
+/* Cable redundancy status, all zero for a handle opened without a secondary interface. A path change asks for a
+   probe of the per-side slave counts, which soem_check_state (or the cyclic engine, in its slack) runs; the
+   cycle result sets state_due meanwhile. */
+SOEMSHIM_EXPORT int  soem_get_redundancy(soem_handle_t* h, soem_redundancy_t* out);
+/* Process-data groups (soem_init_options_t.group_count / slave_group / group_divider). Each group is mapped into
+   its own IOmap region and logical address window. A cycle call exchanges the groups due on that cycle, staggered
+   so slow groups do not all land on the same one; the cycle's wkc/expected_wkc cover those groups only. Copies up
+   to max entries and returns the group count; safe while the cyclic engine runs (sequence lock). */
+SOEMSHIM_EXPORT int  soem_get_group_status(soem_handle_t* h, soem_group_status_t* out, int max);
+/* Asynchronous CoE SDO access (soem_sdo.c), for a handle opened with sdo_workers > 0. soem_sdo_read and
+   soem_sdo_write queue a transfer and return its ticket (> 0), 0 when all 64 slots are taken,
+   SOEM_ERR_UNSUPPORTED when the engine is off or the slave has no CoE mailbox. Up to sdo_workers transfers to
+   different slaves run at once, those to one slave in order. The mailboxes only move when soem_sdo_service runs, once between
+   cycles like soem_recover_step (SOEM_ERR_BUSY while a cycle is in flight or the cyclic engine runs; the engine
+   services them in its slack); it returns the mailboxes moved and costs nothing with no transfer open.
+   soem_sdo_poll copies up to max finished transfers and returns the count; none of these block. */
+SOEMSHIM_EXPORT int  soem_sdo_read(soem_handle_t* h, int slave, uint16_t index, uint8_t subindex);
+SOEMSHIM_EXPORT int  soem_sdo_write(soem_handle_t* h, int slave, uint16_t index, uint8_t subindex, const uint8_t* data, int size);
+SOEMSHIM_EXPORT int  soem_sdo_poll(soem_handle_t* h, soem_sdo_completion_t* out, int max);
+SOEMSHIM_EXPORT int  soem_sdo_service(soem_handle_t* h);
+SOEMSHIM_EXPORT int  soem_sdo_get_stats(soem_handle_t* h, soem_sdo_stats_t* out);
+/* Cyclic frame transport (soem_init_options_t.nic_backend). With SOEM_NIC_RING the cycle's frames are written
+   into a memory-mapped TX ring and sent with one send() per cycle, and replies are read straight from an RX ring;
+   mailbox, state and recovery traffic stays on SOEM's socket. Non-blocking. */
+SOEMSHIM_EXPORT int  soem_get_nic_stats(soem_handle_t* h, soem_nic_stats_t* out);
+/* Wire capture (soem_init_options_t.capture_bytes, Linux only). The cycle path copies every process-data frame it
+   sends or takes back into a ring in a memory-mapped file, <capture_dir>/soemshim-bus<id>.cap. soem_capture_export
+   writes the frames of the last capture_window_ms to a pcapng file while the cycle keeps running and returns their
+   count (SOEM_ERR_UNSUPPORTED without a ring, SOEM_ERR_IO when the file failed); it does file I/O, so call it
+   from any thread but the bus thread. soem_capture_convert does the same for a ring file a crashed process left
+   behind (renamed to .cap.prev at the next open), without a handle. */
+SOEMSHIM_EXPORT int  soem_capture_export(soem_handle_t* h, const char* path);
+SOEMSHIM_EXPORT int  soem_capture_convert(const char* ring_path, const char* path, uint32_t window_ms);
+SOEMSHIM_EXPORT int  soem_capture_get_stats(soem_handle_t* h, soem_capture_stats_t* out);
+
+/* Fast boot (soem_init_options_t.config_path, soem_boot.c). After a discovery the shim stores the configured slave
+   and group lists at config_path. The next initialization reads only the slave count, each slave's
+   vendor/product/revision and its open ports; when they match the file, the stored SM/FMMU settings go straight to
+   the slaves and the SII and PDO reads of a discovery are skipped. Anything else falls back to the discovery,
+   which rewrites the file; delete it to force one. soem_get_boot_report says which way the bus came up and how
+   long each phase of the startup took. From the end of the mapping to OP, process data is exchanged cyclically and
+   each slave is requested to OP as soon as it reports SAFE-OP (soem_state_bringup).
+   The SII cache (sii_cache_path, soem_sii.c) speeds up the discovery itself: each slave's EEPROM image is kept by
+   vendor/product/revision/serial, a known slave costs its identity words and one check word, and only new or
+   changed slaves are read in full. */
+SOEMSHIM_EXPORT int  soem_get_boot_report(soem_handle_t* h, soem_boot_report_t* out);
+
+/* Several handles in one process. Handles share nothing but the log ring: every record is tagged with the bus id
+   of the handle it was written for, and a callback set with soem_set_log_bus_callback receives that id, so each
+   bus's messages can go to its own sink. Take the id with soem_log_new_bus and pass it in
+   soem_init_options_t.bus_id to have the initialization's own records tagged too. soem_pin_thread binds the
+   calling thread to one CPU (returns 1, 0 when the OS refused), for a caller that runs each bus on its own thread. */
+SOEMSHIM_EXPORT uint32_t soem_get_bus_id(soem_handle_t* h);
+SOEMSHIM_EXPORT int      soem_pin_thread(int cpu);
+
+/* Logging (soem_log.c). Records queue in a lock-free ring of 1024; soem_log_drain formats up to max_records of them
+   and hands them to the callback on the calling thread (one drainer at a time, others return 0). A full ring drops
+   the new record; soem_log_dropped counts those since load, and the next drain reports them as a warning. */
+SOEMSHIM_EXPORT void     soem_set_log_callback(soem_log_callback_t cb);
+SOEMSHIM_EXPORT void     soem_set_log_bus_callback(soem_log_bus_callback_t cb);  // replaces soem_set_log_callback's while set
+SOEMSHIM_EXPORT uint32_t soem_log_new_bus(void);
+SOEMSHIM_EXPORT int      soem_log_drain(int max_records);
+SOEMSHIM_EXPORT uint64_t soem_log_dropped(void);
+
+/* Summarise the cycle latency histograms recorded since the previous call, then start a new window
+   (snapshot-and-reset). Every exchange path records: soem_exchange_process_data, soem_cycle, the split cycle and
+   the cyclic engine. Safe against the recording thread; call it from one thread at a time. */
+SOEMSHIM_EXPORT int  soem_get_cycle_stats(soem_handle_t* h, soem_cycle_stats_t* out);
+
+/* Zero-copy access to the process image. The pointer stays valid until soem_shutdown. Outputs written through it
+   are sent by the next exchange/soem_cycle; inputs are valid after it. Not to be touched while the cyclic engine runs. */
+SOEMSHIM_EXPORT uint8_t* soem_get_iomap(soem_handle_t* h, int* size);
+/* Fill out[0..n) with the IOmap layout of slaves 1..n. Returns n. */
+SOEMSHIM_EXPORT int  soem_get_io_layout(soem_handle_t* h, soem_slave_io_t* out, int max_count);
+
+/* Bulk input scan. Compares every slave's 8 input bytes with the previous call's and sets bit i % 32 of
+   changed[i / 32] when slave i + 1 differs; the first call on a handle reports every slave. status[i] is only
+   rewritten for changed slaves, so pass the same array every cycle. Returns the number of changed slaves or
+   SOEM_ERR_BAD_ARGS (changed_words must cover the slave count). Same threading rules as soem_get_iomap. */
+SOEMSHIM_EXPORT int  soem_scan_inputs(soem_handle_t* h, uint32_t* changed, int changed_words, soem_status_word_t* status, int status_count);
+/* The diff kernel behind soem_scan_inputs on caller buffers of count 8-byte records: clears changed[], marks
+   records of cur that differ from prev and copies them into prev. Returns the number changed. */
+SOEMSHIM_EXPORT int  soem_diff_inputs(const uint8_t* cur, uint8_t* prev, int count, uint32_t* changed, int changed_words, int isa);
+/* Expand packed status words to the one-byte-per-flag DriveTxPDO form. Returns count. */
+SOEMSHIM_EXPORT int  soem_expand_status(const soem_status_word_t* in, DriveTxPDO* out, int count, int isa);
+/* Best SOEM_ISA_* this CPU runs. */
+SOEMSHIM_EXPORT int  soem_simd_level(void);
+
+/* Cyclic engine. Returns 1 on success or a SOEM_ERR_* code. While running, soem_exchange_process_data and
+   soem_try_recover return SOEM_ERR_BUSY / 0; stop the engine first. soem_shutdown stops it implicitly. */
+SOEMSHIM_EXPORT int  soem_rt_start(soem_handle_t* h, const soem_rt_config_t* cfg);
+SOEMSHIM_EXPORT int  soem_rt_stop(soem_handle_t* h);
+/* Queue an RxPDO for slave_index (1-based); applied at the start of the next cycle. 1 = queued, 0 = ring full. */
+SOEMSHIM_EXPORT int  soem_rt_push_command(soem_handle_t* h, int slave_index, const DriveRxPDO* in);
+/* Pop the oldest sample. 1 = popped, 0 = empty. inputs may be NULL. */
+SOEMSHIM_EXPORT int  soem_rt_pop_sample(soem_handle_t* h, soem_rt_sample_t* out, uint8_t* inputs, int inputs_len);
+SOEMSHIM_EXPORT int  soem_rt_get_stats(soem_handle_t* h, soem_rt_stats_t* out);
 
 
 #ifdef __cplusplus
@@ -0,0 +1,536 @@
+/* SII cache. Most of ecx_config_init's time goes to the EEPROM interface: every SII word it needs is a command, a
+   busy poll and a read, and the category walk of each slave type it has not seen yet (general, strings, SMs,
+   FMMUs, later the PDOs) takes dozens of them, one after the other. sii_cache_path keeps each slave's SII image -
+   what SOEM pulled into its esibuf for that slave - keyed by vendor, product, revision and serial number.
+   soem_sii_config_init is ecx_config_init (SOEM 2.0) step for step, except that it reads only the identity words of
+   every slave plus the first category header as a check. A slave whose image passes gets its mailbox words from
+   the image and SOEM's SII buffer filled from it before its categories are parsed, so ecx_siifind and friends
+   answer from memory. A slave without an image, or whose check fails, is read from the bus as before and its
+   image stored for the next time. Shared verbatim by the Windows and Linux shims. */
+#include "soem_shim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SII_MAGIC       0x43494953u  // "SIIC"
+#define SII_VERSION     1u
+#define SII_MAX_ENTRIES 256
+#define SII_CHECK_WORD  ECT_SII_START  // first category header: type and length
+#define SII_MBXSM0      0x00010026u    // SOEM's EC_DEFAULTMBXSM0: mailbox out, master to slave
+#define SII_MBXSM1      0x00010022u    // EC_DEFAULTMBXSM1: mailbox in
+
+typedef struct sii_header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entries;
+    uint32_t body_size;
+    uint32_t checksum;  // FNV-1a over the body
+    uint32_t reserved;
+} sii_header_t;
+
+typedef struct sii_key {
+    uint32_t man;
+    uint32_t id;
+    uint32_t rev;
+    uint32_t serial;
+} sii_key_t;
+
+// On disk per entry: the key, used, the esimap words covering used, then the first used bytes of the image.
+typedef struct sii_entry {
+    sii_key_t key;
+    uint32_t used;               // image bytes kept, a multiple of 32 (one esimap word)
+    int seen;                    // 1: belongs to a slave of this bus, written back first; 2: rewritten from it
+    uint32 map[EC_MAXEEPBITMAP]; // as SOEM's esimap: bit n set = byte n of image was read from the EEPROM
+    uint8 image[EC_MAXEEPBUF];   // as SOEM's esibuf, in EEPROM byte order
+} sii_entry_t;
+
+typedef struct sii_cache {
+    const char* path;
+    sii_entry_t* entries;
+    int count;
+    int dirty;
+} sii_cache_t;
+
+void log_message(soem_log_level_t lvl, const char* fmt, ...);  // soem_log.c
+uint32_t soem_boot_fnv(uint32_t hash, const void* data, size_t size);  // soem_boot.c
+int  soem_boot_detect(ecx_contextt* ctx);
+void soem_boot_defaults(ecx_contextt* ctx);
+
+static size_t sii_record_size(uint32_t used)
+{
+    return sizeof(sii_key_t) + sizeof(uint32_t) + used / 32 * sizeof(uint32) + used;
+}
+
+static void sii_grow(sii_entry_t* e, uint32_t end)
+{
+    uint32_t used = (end + 31u) & ~31u;
+    if (used > e->used) e->used = used;
+}
+
+static int sii_has(const sii_entry_t* e, uint32_t byte, uint32_t n)
+{
+    for (uint32_t b = byte; b < byte + n; ++b)
+        if (b >= e->used || !(e->map[b >> 5] & (1u << (b & 31)))) return 0;
+    return 1;
+}
+
+/* A word pair as ecx_readeeprom2 returns it, when the image holds it. */
+static int sii_word(const sii_entry_t* e, uint16 word, uint32* raw)
+{
+    if (!e || !sii_has(e, word * 2u, 4)) return 0;
+    memcpy(raw, e->image + word * 2u, sizeof(*raw));
+    return 1;
+}
+
+static void sii_put(sii_entry_t* e, uint16 word, uint32 raw)
+{
+    uint32_t b = word * 2u;
+    memcpy(e->image + b, &raw, sizeof(raw));
+    for (uint32_t k = b; k < b + 4; ++k) e->map[k >> 5] |= 1u << (k & 31);
+    sii_grow(e, b + 4);
+}
+
+static sii_entry_t* sii_find(sii_cache_t* c, const sii_key_t* key)
+{
+    for (int i = 0; i < c->count; ++i)
+        if (!memcmp(&c->entries[i].key, key, sizeof(*key))) return &c->entries[i];
+    return NULL;
+}
+
+/* A blank entry for key: its old one, a new one, or one no slave of this bus uses. NULL when all are taken. Slaves
+   that share a key (serial 0 on a line of identical drives) share the entry. */
+static sii_entry_t* sii_claim(sii_cache_t* c, const sii_key_t* key)
+{
+    sii_entry_t* e = sii_find(c, key);
+    if (e && e->seen == 2) return e;
+    if (!e && c->count < SII_MAX_ENTRIES) e = &c->entries[c->count++];
+    for (int i = 0; !e && i < c->count; ++i)
+        if (!c->entries[i].seen) e = &c->entries[i];
+    if (!e) return NULL;
+    memset(e, 0, sizeof(*e));
+    e->key = *key;
+    e->seen = 2;
+    c->dirty = 1;
+    return e;
+}
+
+/* Hands the image to SOEM as the SII buffer of slave, so ecx_siigetbyte reads the bus only for what it lacks. */
+static void sii_give(ecx_contextt* ctx, uint16 slave, const sii_entry_t* e)
+{
+    memset(ctx->esimap, 0, sizeof(ctx->esimap));
+    memcpy(ctx->esimap, e->map, e->used / 32 * sizeof(uint32));
+    memcpy(ctx->esibuf, e->image, e->used);
+    ctx->esislave = slave;
+}
+
+/* Merges what SOEM's SII buffer holds beyond the image into it; the buffer belongs to the slave of e. */
+static void sii_take(sii_cache_t* c, sii_entry_t* e, const ecx_contextt* ctx)
+{
+    for (int w = 0; w < EC_MAXEEPBITMAP; ++w) {
+        uint32 fresh = ctx->esimap[w] & ~e->map[w];
+        if (!fresh) continue;
+        for (int b = 0; b < 32; ++b)
+            if (fresh & (1u << b)) e->image[w * 32 + b] = ctx->esibuf[w * 32 + b];
+        e->map[w] |= fresh;
+        sii_grow(e, (uint32_t)(w + 1) * 32);
+        c->dirty = 1;
+    }
+}
+
+static void sii_load(sii_cache_t* c)
+{
+    FILE* f = fopen(c->path, "rb");
+    if (!f) {
+        log_message(SOEM_LOG_INFO, "No SII cache at %s yet; reading every slave's SII from the bus", c->path);
+        return;
+    }
+
+    sii_header_t hdr;
+    uint8_t* body = NULL;
+    const char* why = NULL;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != SII_MAGIC || hdr.version != SII_VERSION) {
+        why = "not an SII cache of this version";
+    } else if (hdr.entries > SII_MAX_ENTRIES || hdr.body_size > hdr.entries * sii_record_size(EC_MAXEEPBUF)) {
+        why = "entry count or size out of range";
+    } else {
+        body = (uint8_t*)malloc(hdr.body_size ? hdr.body_size : 1);
+        if (!body || (hdr.body_size && fread(body, hdr.body_size, 1, f) != 1)
+            || soem_boot_fnv(2166136261u, body, hdr.body_size) != hdr.checksum)
+            why = "truncated or corrupt";
+    }
+    fclose(f);
+
+    size_t at = 0;
+    for (uint32_t i = 0; !why && i < hdr.entries; ++i) {
+        sii_entry_t* e = &c->entries[i];
+        if (at + sizeof(e->key) + sizeof(e->used) > hdr.body_size) {
+            why = "truncated or corrupt";
+            break;
+        }
+        memcpy(&e->key, body + at, sizeof(e->key));
+        memcpy(&e->used, body + at + sizeof(e->key), sizeof(e->used));
+        if (e->used % 32 || e->used > EC_MAXEEPBUF || at + sii_record_size(e->used) > hdr.body_size) {
+            why = "truncated or corrupt";
+            break;
+        }
+        at += sizeof(e->key) + sizeof(e->used);
+        memcpy(e->map, body + at, e->used / 32 * sizeof(uint32));
+        at += e->used / 32 * sizeof(uint32);
+        memcpy(e->image, body + at, e->used);
+        at += e->used;
+        c->count = (int)i + 1;
+    }
+    free(body);
+
+    if (why) {
+        log_message(SOEM_LOG_WARN, "SII cache %s not used (%s); reading every slave's SII from the bus", c->path, why);
+        memset(c->entries, 0, (size_t)c->count * sizeof(sii_entry_t));
+        c->count = 0;
+    }
+}
+
+/* Entries of this bus first, then the others this file held (another line, drives swapped out for now). Written
+   to a temporary file and renamed, like the stored configuration. */
+static int sii_save(const sii_cache_t* c)
+{
+    size_t size = 0;
+    for (int i = 0; i < c->count; ++i) size += sii_record_size(c->entries[i].used);
+    size_t len = strlen(c->path);
+    char* tmp = (char*)malloc(len + 5);
+    uint8_t* body = (uint8_t*)malloc(size ? size : 1);
+    if (!tmp || !body) {
+        free(tmp);
+        free(body);
+        return 0;
+    }
+
+    size_t at = 0;
+    for (int pass = 1; pass >= 0; --pass) {
+        for (int i = 0; i < c->count; ++i) {
+            const sii_entry_t* e = &c->entries[i];
+            if ((e->seen != 0) != pass) continue;
+            memcpy(body + at, &e->key, sizeof(e->key));
+            memcpy(body + at + sizeof(e->key), &e->used, sizeof(e->used));
+            at += sizeof(e->key) + sizeof(e->used);
+            memcpy(body + at, e->map, e->used / 32 * sizeof(uint32));
+            at += e->used / 32 * sizeof(uint32);
+            memcpy(body + at, e->image, e->used);
+            at += e->used;
+        }
+    }
+    sii_header_t hdr = { SII_MAGIC, SII_VERSION, (uint32_t)c->count, (uint32_t)size, soem_boot_fnv(2166136261u, body, size), 0 };
+
+    memcpy(tmp, c->path, len);
+    memcpy(tmp + len, ".tmp", 5);
+    FILE* f = fopen(tmp, "wb");
+    int ok = f && fwrite(&hdr, sizeof(hdr), 1, f) == 1 && (!size || fwrite(body, size, 1, f) == 1);
+    if (f && fclose(f) != 0) ok = 0;
+#if defined(_WIN32)
+    if (ok) remove(c->path);  // rename does not replace an existing file here
+#endif
+    if (ok && rename(tmp, c->path) != 0) ok = 0;
+    if (!ok) {
+        remove(tmp);
+        log_message(SOEM_LOG_WARN, "SII cache %s could not be written; the next start reads the SII from the bus again", c->path);
+    }
+    free(tmp);
+    free(body);
+    return ok;
+}
+
+/* One SII word pair of every slave with want[i] set, read in parallel as ecx_config_init does: the read command
+   to all of them, then the results. raw[i] as ecx_readeeprom2 returns it. */
+static void sii_round(ecx_contextt* ctx, uint16 word, const uint8* want, uint32* raw)
+{
+    int n = ctx->slavecount;
+    for (int i = 1; i <= n; ++i)
+        if (want[i]) ecx_readeeprom1(ctx, (uint16)i, word);
+    for (int i = 1; i <= n; ++i)
+        if (want[i]) raw[i] = ecx_readeeprom2(ctx, (uint16)i, EC_TIMEOUTEEP);
+}
+
+/* SOEM's ecx_lookup_prev_sii (static there): a slave with the identity of an earlier one takes that slave's SII
+   settings instead of reading its own. */
+static int sii_lookup_prev(ecx_contextt* ctx, uint16 slave)
+{
+    ec_slavet* s = &ctx->slavelist[slave];
+    int i = 1;
+    if (slave <= 1 || ctx->slavecount <= 0) return 0;
+    while (i < slave && (ctx->slavelist[i].eep_man != s->eep_man || ctx->slavelist[i].eep_id != s->eep_id
+        || ctx->slavelist[i].eep_rev != s->eep_rev))
+        ++i;
+    if (i >= slave) return 0;
+
+    const ec_slavet* p = &ctx->slavelist[i];
+    s->CoEdetails = p->CoEdetails;
+    s->FoEdetails = p->FoEdetails;
+    s->EoEdetails = p->EoEdetails;
+    s->SoEdetails = p->SoEdetails;
+    if (p->blockLRW > 0) {
+        s->blockLRW = 1;
+        ctx->slavelist[0].blockLRW++;
+    }
+    s->Ebuscurrent = p->Ebuscurrent;
+    ctx->slavelist[0].Ebuscurrent += s->Ebuscurrent;
+    memcpy(s->name, p->name, sizeof(s->name));
+    memcpy(s->SM, p->SM, sizeof(s->SM));
+    s->FMMU0func = p->FMMU0func;
+    s->FMMU1func = p->FMMU1func;
+    s->FMMU2func = p->FMMU2func;
+    s->FMMU3func = p->FMMU3func;
+    return 1;
+}
+
+/* What ecx_config_init does from the SII general category on: CoE/FoE/EoE/SoE details, name, SMs, FMMU functions. */
+static void sii_parse(ecx_contextt* ctx, uint16 slave)
+{
+    ec_slavet* s = &ctx->slavelist[slave];
+    uint16 gen = (uint16)ecx_siifind(ctx, slave, ECT_SII_GENERAL);
+    if (gen) {
+        s->CoEdetails = ecx_siigetbyte(ctx, slave, gen + 0x07);
+        s->FoEdetails = ecx_siigetbyte(ctx, slave, gen + 0x08);
+        s->EoEdetails = ecx_siigetbyte(ctx, slave, gen + 0x09);
+        s->SoEdetails = ecx_siigetbyte(ctx, slave, gen + 0x0a);
+        if (ecx_siigetbyte(ctx, slave, gen + 0x0d) & 0x02) {
+            s->blockLRW = 1;
+            ctx->slavelist[0].blockLRW++;
+        }
+        s->Ebuscurrent = ecx_siigetbyte(ctx, slave, gen + 0x0e);
+        s->Ebuscurrent += ecx_siigetbyte(ctx, slave, gen + 0x0f) << 8;
+        ctx->slavelist[0].Ebuscurrent += s->Ebuscurrent;
+    }
+    if (ecx_siifind(ctx, slave, ECT_SII_STRING) > 0)
+        ecx_siistring(ctx, s->name, slave, 1);
+    else
+        snprintf(s->name, sizeof(s->name), "? M:%8.8x I:%8.8x", (unsigned int)s->eep_man, (unsigned int)s->eep_id);
+
+    if (ecx_siiSM(ctx, slave, &ctx->eepSM)) {
+        uint16 sm = 0;
+        do {
+            s->SM[sm].StartAddr = htoes(ctx->eepSM.PhStart);
+            s->SM[sm].SMlength = htoes(ctx->eepSM.Plength);
+            s->SM[sm].SMflags = htoel(ctx->eepSM.Creg + (ctx->eepSM.Activate << 16));
+            ++sm;
+        } while (sm < EC_MAXSM && ecx_siiSMnext(ctx, slave, &ctx->eepSM, sm));
+    }
+    if (ecx_siiFMMU(ctx, slave, &ctx->eepFMMU)) {
+        if (ctx->eepFMMU.FMMU0 != 0xff) s->FMMU0func = ctx->eepFMMU.FMMU0;
+        if (ctx->eepFMMU.FMMU1 != 0xff) s->FMMU1func = ctx->eepFMMU.FMMU1;
+        if (ctx->eepFMMU.FMMU2 != 0xff) s->FMMU2func = ctx->eepFMMU.FMMU2;
+        if (ctx->eepFMMU.FMMU3 != 0xff) s->FMMU3func = ctx->eepFMMU.FMMU3;
+    }
+}
+
+/* ecx_config_init with the SII served from c: the same datagrams in the same order, minus the EEPROM reads an
+   image answers. Returns the slave count (<= 0: none answered) and how many slaves came from the cache. */
+static int sii_config_init(ecx_contextt* ctx, sii_cache_t* c, int* cached)
+{
+    sii_entry_t* entry[EC_MAXSLAVE] = { 0 };
+    uint8 hit[EC_MAXSLAVE] = { 0 };
+    uint8 want[EC_MAXSLAVE] = { 0 };
+    uint32 raw[EC_MAXSLAVE] = { 0 };
+
+    int n = soem_boot_detect(ctx);
+    if (n <= 0) return n;
+    ctx->slavecount = n;
+    soem_boot_defaults(ctx);
+
+    for (int i = 1; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        uint16 adp = (uint16)(1 - i);
+        uint16 alias = 0, estat = 0;
+        s->Itype = etohs(ecx_APRDw(&ctx->port, adp, ECT_REG_PDICTL, EC_TIMEOUTRET3));
+        ecx_APWRw(&ctx->port, adp, ECT_REG_STADR, htoes((uint16)(i + EC_NODEOFFSET)), EC_TIMEOUTRET3);
+        ecx_APWRw(&ctx->port, adp, ECT_REG_DLCTL, htoes(i == 1 ? 1 : 0), EC_TIMEOUTRET3);  // first slave drops non-EtherCAT frames
+        s->configadr = etohs(ecx_APRDw(&ctx->port, adp, ECT_REG_STADR, EC_TIMEOUTRET3));
+        ecx_FPRD(&ctx->port, s->configadr, ECT_REG_ALIAS, sizeof(alias), &alias, EC_TIMEOUTRET3);
+        s->aliasadr = etohs(alias);
+        ecx_FPRD(&ctx->port, s->configadr, ECT_REG_EEPSTAT, sizeof(estat), &estat, EC_TIMEOUTRET3);
+        if (etohs(estat) & EC_ESTAT_R64) s->eep_8byte = 1;
+        want[i] = 1;
+    }
+
+    // Identity of every slave, the only SII words always read from the bus.
+    sii_round(ctx, ECT_SII_MANUF, want, raw);
+    for (int i = 1; i <= n; ++i) ctx->slavelist[i].eep_man = etohl(raw[i]);
+    sii_round(ctx, ECT_SII_ID, want, raw);
+    for (int i = 1; i <= n; ++i) ctx->slavelist[i].eep_id = etohl(raw[i]);
+    sii_round(ctx, ECT_SII_REV, want, raw);
+    for (int i = 1; i <= n; ++i) ctx->slavelist[i].eep_rev = etohl(raw[i]);
+    sii_round(ctx, ECT_SII_SER, want, raw);
+    for (int i = 1; i <= n; ++i) ctx->slavelist[i].eep_ser = etohl(raw[i]);
+
+    // The check: the first category header, against the image of the slaves that have one. The others take it
+    // into their new image so the next start can check them too.
+    for (int i = 1; i <= n; ++i) {
+        const ec_slavet* s = &ctx->slavelist[i];
+        sii_key_t key = { s->eep_man, s->eep_id, s->eep_rev, s->eep_ser };
+        sii_entry_t* e = sii_find(c, &key);
+        hit[i] = e && sii_has(e, SII_CHECK_WORD * 2u, 4) && sii_has(e, ECT_SII_RXMBXADR * 2u, 4);
+        if (e && !e->seen) e->seen = 1;
+        entry[i] = e;
+    }
+    sii_round(ctx, SII_CHECK_WORD, want, raw);
+    for (int i = 1; i <= n; ++i) {
+        const ec_slavet* s = &ctx->slavelist[i];
+        uint32 stored;
+        if (hit[i] && sii_word(entry[i], SII_CHECK_WORD, &stored) && stored != raw[i]) {
+            log_message(SOEM_LOG_WARN, "Slave %d (%08x:%08x rev %08x serial %u): SII differs from the cached image; reading it again",
+                i, s->eep_man, s->eep_id, s->eep_rev, s->eep_ser);
+            hit[i] = 0;
+        }
+        if (!hit[i]) {
+            sii_key_t key = { s->eep_man, s->eep_id, s->eep_rev, s->eep_ser };
+            entry[i] = sii_claim(c, &key);
+        }
+        if (entry[i] && !hit[i]) {
+            sii_put(entry[i], ECT_SII_MANUF, htoel(s->eep_man));
+            sii_put(entry[i], ECT_SII_ID, htoel(s->eep_id));
+            sii_put(entry[i], ECT_SII_REV, htoel(s->eep_rev));
+            sii_put(entry[i], ECT_SII_SER, htoel(s->eep_ser));
+            sii_put(entry[i], SII_CHECK_WORD, raw[i]);
+        }
+    }
+
+    // Mailbox words: from the image, or read in parallel as ecx_config_init reads them.
+    for (int i = 1; i <= n; ++i) want[i] = !(hit[i] && sii_word(entry[i], ECT_SII_RXMBXADR, &raw[i]));
+    sii_round(ctx, ECT_SII_RXMBXADR, want, raw);
+    for (int i = 1; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        if (want[i] && entry[i]) sii_put(entry[i], ECT_SII_RXMBXADR, raw[i]);
+        s->mbx_wo = (uint16)LO_WORD(etohl(raw[i]));
+        s->mbx_l = (uint16)HI_WORD(etohl(raw[i]));
+        want[i] = s->mbx_l > 0 && !(hit[i] && sii_word(entry[i], ECT_SII_TXMBXADR, &raw[i]));
+    }
+    sii_round(ctx, ECT_SII_TXMBXADR, want, raw);
+    for (int i = 1; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        if (!s->mbx_l) continue;
+        if (want[i] && entry[i]) sii_put(entry[i], ECT_SII_TXMBXADR, raw[i]);
+        s->mbx_ro = (uint16)LO_WORD(etohl(raw[i]));
+        s->mbx_rl = (uint16)HI_WORD(etohl(raw[i]));
+        if (!s->mbx_rl) s->mbx_rl = s->mbx_l;
+    }
+    for (int i = 1; i <= n; ++i)
+        want[i] = ctx->slavelist[i].mbx_l > 0 && !(hit[i] && sii_word(entry[i], ECT_SII_MBXPROTO, &raw[i]));
+    sii_round(ctx, ECT_SII_MBXPROTO, want, raw);
+    for (int i = 1; i <= n; ++i) {
+        if (!ctx->slavelist[i].mbx_l) continue;
+        if (want[i] && entry[i]) sii_put(entry[i], ECT_SII_MBXPROTO, raw[i]);
+        ctx->slavelist[i].mbx_proto = (uint16)etohl(raw[i]);
+    }
+
+    int preload = 0;  // first slave whose PDO sizes ecx_config_map_group takes from the SII
+    for (int i = 1; i <= n; ++i) {
+        ec_slavet* s = &ctx->slavelist[i];
+        uint16 slave = (uint16)i;
+        s->hasdc = (etohs(ecx_FPRDw(&ctx->port, s->configadr, ECT_REG_ESCSUP, EC_TIMEOUTRET3)) & 0x04) ? TRUE : FALSE;
+        uint16 topology = etohs(ecx_FPRDw(&ctx->port, s->configadr, ECT_REG_DLSTAT, EC_TIMEOUTRET3));
+        uint8 ports = 0, links = 0;
+        if ((topology & 0x0300) == 0x0200) { ++links; ports |= 0x01; }  // port 0 open and communication established
+        if ((topology & 0x0c00) == 0x0800) { ++links; ports |= 0x02; }
+        if ((topology & 0x3000) == 0x2000) { ++links; ports |= 0x04; }
+        if ((topology & 0xc000) == 0x8000) { ++links; ports |= 0x08; }
+        s->ptype = LO_BYTE(etohs(ecx_FPRDw(&ctx->port, s->configadr, ECT_REG_PORTDES, EC_TIMEOUTRET3)));
+        s->topology = links;
+        s->activeports = ports;
+
+        // Parent: walk back over the line, counting the branches still open.
+        s->parent = 0;
+        int open = 0;
+        for (int p = i - 1; p > 0; --p) {
+            uint8 t = ctx->slavelist[p].topology;
+            if (t == 1) --open;      // end of a branch
+            if (t == 3) ++open;      // split
+            if (t == 4) open += 2;   // cross
+            if ((open >= 0 && t > 1) || p == 1) {
+                s->parent = (uint16)p;
+                break;
+            }
+        }
+        ecx_statecheck(ctx, slave, EC_STATE_INIT, EC_TIMEOUTSTATE);
+
+        if (s->mbx_l > 0) {
+            s->SMtype[0] = 1;
+            s->SMtype[1] = 2;
+            s->SMtype[2] = 3;
+            s->SMtype[3] = 4;
+            s->SM[0].StartAddr = htoes(s->mbx_wo);
+            s->SM[0].SMlength = htoes(s->mbx_l);
+            s->SM[0].SMflags = htoel(SII_MBXSM0);
+            s->SM[1].StartAddr = htoes(s->mbx_ro);
+            s->SM[1].SMlength = htoes(s->mbx_rl);
+            s->SM[1].SMflags = htoel(SII_MBXSM1);
+        }
+
+        if (!sii_lookup_prev(ctx, slave)) {
+            if (hit[i]) sii_give(ctx, slave, entry[i]);
+            sii_parse(ctx, slave);
+            int coe = (s->mbx_proto & ECT_MBXPROT_COE) != 0;
+            if (!coe && !hit[i]) {
+                // Without CoE the mapping sizes the process data from the PDO categories: take them into the image now.
+                ec_eepromPDOt pdo;
+                memset(&pdo, 0, sizeof(pdo));
+                ecx_siiPDO(ctx, slave, &pdo, 0);
+                ecx_siiPDO(ctx, slave, &pdo, 1);
+            }
+            if (entry[i]) sii_take(c, entry[i], ctx);
+            if (!coe && !preload) preload = i;
+        }
+
+        if (s->mbx_l > 0) {
+            if (!s->SM[0].StartAddr) {
+                log_message(SOEM_LOG_WARN, "Slave %d has no proper mailbox in its SII; using the default", i);
+                s->SM[0].StartAddr = htoes(0x1000);
+                s->SM[0].SMlength = htoes(0x0080);
+                s->SM[0].SMflags = htoel(SII_MBXSM0);
+                s->SMtype[0] = 1;
+            }
+            if (!s->SM[1].StartAddr) {
+                s->SM[1].StartAddr = htoes(0x1080);
+                s->SM[1].SMlength = htoes(0x0080);
+                s->SM[1].SMflags = htoel(SII_MBXSM1);
+                s->SMtype[1] = 2;
+            }
+            // Both mailbox SMs in one datagram, as SOEM does for old NETX slaves.
+            ecx_FPWR(&ctx->port, s->configadr, ECT_REG_SM0, sizeof(ec_smt) * 2, &s->SM[0], EC_TIMEOUTRET3);
+        }
+        ecx_eeprom2pdi(ctx, slave);  // some slaves need the EEPROM at the PDI for INIT -> PRE-OP
+        if (ctx->manualstatechange == 0)
+            ecx_FPWRw(&ctx->port, s->configadr, ECT_REG_ALCTL, htoes(EC_STATE_PRE_OP | EC_STATE_ACK), EC_TIMEOUTRET3);
+        if (hit[i]) ++*cached;
+    }
+
+    // ecx_config_map_group reads the PDO categories of the first such slave; the others copy its mapping.
+    if (preload && entry[preload]) sii_give(ctx, (uint16)preload, entry[preload]);
+    return n;
+}
+
+/* In place of ecx_config_init. Without opts->sii_cache_path it is ecx_config_init; with it, the SII of every slave
+   whose identity the cache knows is served from there, and what had to be read from the bus is stored for the next
+   start. h->boot.sii_cached and sii_read count the two kinds of slave. Returns the slave count. */
+int soem_sii_config_init(soem_handle_t* h, const soem_init_options_t* opts)
+{
+    ecx_contextt* ctx = &h->context;
+    if (!opts->sii_cache_path || !*opts->sii_cache_path) return ecx_config_init(ctx);
+
+    sii_cache_t c = { opts->sii_cache_path, NULL, 0, 0 };
+    c.entries = (sii_entry_t*)calloc(SII_MAX_ENTRIES, sizeof(sii_entry_t));
+    if (!c.entries) {
+        log_message(SOEM_LOG_WARN, "SII cache allocation failed; reading every slave's SII from the bus");
+        return ecx_config_init(ctx);
+    }
+    sii_load(&c);
+
+    int cached = 0;
+    int n = sii_config_init(ctx, &c, &cached);
+    if (n > 0) {
+        h->boot.sii_cached = cached;
+        h->boot.sii_read = n - cached;
+        log_message(SOEM_LOG_INFO, "SII of %d slave(s) from the cache at %s, %d read from the bus", cached, c.path, n - cached);
+        if (c.dirty) sii_save(&c);
+    }
+    free(c.entries);
+    return n;
+}
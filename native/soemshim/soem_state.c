@@ -0,0 +1,378 @@
+/* Slave AL state cache and per-slave recovery. The cycle path grades every WKC (soem_state_note) and only asks for
+   an ecx_readstate when the WKC drops below the previous cycle's or the periodic check interval has passed; a full
+   WKC is taken as every slave in OP. soem_state_refresh performs the read outside the process-data exchange and
+   publishes a per-slave state/AL status array under a sequence lock. soem_state_recover_step brings slaves back
+   to OP one action at a time between cycles, so the rest of the group keeps exchanging. soem_state_bringup takes a
+   new bus from the mapping to OP the same way, cycling all along.
+   Shared verbatim by the Windows and Linux shims. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STATE_FENCE() _ReadWriteBarrier()
+#else
+#define STATE_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define STATE_DEFAULT_INTERVAL_NS 1000000000LL
+#define RECOVER_TIMEOUT_US        500         // per state check inside a recovery step
+#define RECOVER_SWEEP_GAP_NS      100000000LL // between sweeps that had to probe a lost slave
+#define BRINGUP_MIN_PERIOD_NS     100000LL
+
+typedef struct soem_state_cache {
+    volatile uint32_t seq;     // odd while the states are rewritten
+    volatile int due;          // a read was requested by soem_state_note or soem_state_invalidate
+    int slave_count;
+    int slaves_op;
+    uint32_t al_status_code;   // first non-zero AL status code, 0 when none
+    int64_t read_ns;           // monotonic time of the last ecx_readstate
+    uint64_t reads;
+    int64_t interval_ns;
+    int prev_wkc;
+    int prev_expected;
+    volatile int recovering;   // armed by soem_recover_start, cleared once every slave is back in OP
+    int cursor;                // recovery: next slave to look at, 0 = start a new sweep with a state read
+    int pending;               // recovery: slaves not in OP at the start of the sweep
+    int sweep_lost;            // recovery: this sweep probed a lost slave
+    int64_t next_sweep_ns;
+    soem_slave_state_t slaves[];  // slave i at [i - 1]
+} soem_state_cache_t;
+
+int  soem_state_refresh(soem_handle_t* h);
+void soem_dc_rearm_slave(soem_handle_t* h, int slave);  // soem_dc.c
+void soem_log_event(soem_log_level_t lvl, int code, const int64_t* args, int argc);  // soem_log.c
+void log_message(soem_log_level_t lvl, const char* fmt, ...);
+
+static int64_t state_now_ns(void)
+{
+    ec_timet t;
+    osal_get_monotonic_time(&t);
+    return (int64_t)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static void state_publish_all_op(soem_state_cache_t* s)
+{
+    s->seq++;
+    STATE_FENCE();
+    for (int i = 0; i < s->slave_count; ++i) {
+        s->slaves[i].state = EC_STATE_OPERATIONAL;
+        s->slaves[i].al_status_code = 0;
+        s->slaves[i].flags = 0;
+    }
+    s->slaves_op = s->slave_count;
+    s->al_status_code = 0;
+    STATE_FENCE();
+    s->seq++;
+}
+
+int soem_state_init(soem_handle_t* h, int64_t interval_ns)
+{
+    if (!h) return 0;
+    int n = h->context.slavecount > 0 ? h->context.slavecount : 0;
+    soem_state_cache_t* s = (soem_state_cache_t*)calloc(1, sizeof(*s) + (size_t)n * sizeof(soem_slave_state_t));
+    if (!s) return 0;
+    s->slave_count = n;
+    s->interval_ns = interval_ns > 0 ? interval_ns : STATE_DEFAULT_INTERVAL_NS;
+    s->prev_wkc = -1;
+    h->al_state = s;
+    soem_state_refresh(h);
+    return 1;
+}
+
+void soem_state_release(soem_handle_t* h)
+{
+    if (!h || !h->al_state) return;
+    free(h->al_state);
+    h->al_state = NULL;
+}
+
+/* Grade one cycle's WKC. Returns non-zero when a state read is due; the caller runs soem_state_refresh once the
+   cycle is over (never between send and receive). */
+int soem_state_note(soem_handle_t* h, int wkc, int expected, int64_t now_ns)
+{
+    soem_state_cache_t* s = h ? h->al_state : NULL;
+    if (!s) return 0;
+
+    int full = expected > 0 && wkc >= expected;
+    int was_full = s->prev_expected > 0 && s->prev_wkc >= s->prev_expected;
+    if (full) {
+        if (!was_full && !s->due) state_publish_all_op(s);  // back to a full WKC: every slave exchanges in OP
+    } else if (was_full || expected - wkc > s->prev_expected - s->prev_wkc) {  // deficit grew (groups vary expected)
+        s->due = 1;
+    }
+    s->prev_wkc = wkc;
+    s->prev_expected = expected;
+
+    if (now_ns - s->read_ns >= s->interval_ns) s->due = 1;
+    return s->due;
+}
+
+int soem_state_due(const soem_handle_t* h)
+{
+    return h && h->al_state ? h->al_state->due : 0;
+}
+
+void soem_state_invalidate(soem_handle_t* h)
+{
+    if (h && h->al_state) h->al_state->due = 1;
+}
+
+/* ecx_readstate and publish. Returns the number of slaves in OP. Costs a bus round trip (two when a slave
+   reports an error or states differ), so only call it when soem_state_note asked for it or on demand. */
+int soem_state_refresh(soem_handle_t* h)
+{
+    soem_state_cache_t* s = h ? h->al_state : NULL;
+    if (!s) return 0;
+
+    ecx_readstate(&h->context);
+    int64_t now = state_now_ns();
+
+    s->seq++;
+    STATE_FENCE();
+    int op = 0;
+    uint32_t al = 0;
+    for (int i = 0; i < s->slave_count; ++i) {
+        const ec_slavet* slave = &h->context.slavelist[i + 1];
+        s->slaves[i].state = slave->state;
+        s->slaves[i].al_status_code = slave->ALstatuscode;
+        if (slave->state == EC_STATE_OPERATIONAL) ++op;
+        if (!al && slave->ALstatuscode) al = slave->ALstatuscode;
+    }
+    s->slaves_op = op;
+    s->al_status_code = al;
+    s->read_ns = now;
+    s->reads++;
+    STATE_FENCE();
+    s->seq++;
+    s->due = 0;
+    return op;
+}
+
+/* Cached OP count and AL status code for soem_get_health. Returns 0 when there is no cache. */
+int soem_state_summary(soem_handle_t* h, int* slaves_op, uint32_t* al_status_code)
+{
+    soem_state_cache_t* s = h ? h->al_state : NULL;
+    if (!s) return 0;
+
+    uint32_t seq;
+    int op;
+    uint32_t al;
+    do {
+        seq = s->seq;
+        STATE_FENCE();
+        op = s->slaves_op;
+        al = s->al_status_code;
+        STATE_FENCE();
+    } while ((seq & 1) || seq != s->seq);
+
+    *slaves_op = op;
+    *al_status_code = al;
+    return 1;
+}
+
+SOEMSHIM_EXPORT int soem_get_slave_states(soem_handle_t* h, soem_slave_state_t* out, int max_count, soem_state_info_t* info)
+{
+    if (!h || (!out && max_count > 0)) return 0;
+    soem_state_cache_t* s = h->al_state;
+    if (!s) {
+        if (info) memset(info, 0, sizeof(*info));
+        return 0;
+    }
+
+    int count = s->slave_count < max_count ? s->slave_count : max_count;
+    uint32_t seq;
+    do {
+        seq = s->seq;
+        STATE_FENCE();
+        if (count > 0) memcpy(out, s->slaves, (size_t)count * sizeof(*out));
+        if (info) {
+            info->slaves_op = s->slaves_op;
+            info->al_status_code = s->al_status_code;
+            info->read_ns = s->read_ns;
+            info->reads = s->reads;
+            info->recovering = s->recovering;
+            info->slaves_lost = 0;
+            for (int i = 0; i < s->slave_count; ++i)
+                if (s->slaves[i].flags & SOEM_SLAVE_LOST) info->slaves_lost++;
+        }
+        STATE_FENCE();
+    } while ((seq & 1) || seq != s->seq);
+    return count;
+}
+
+static void state_publish_slave(soem_state_cache_t* s, int slave, const ec_slavet* sl, uint16_t flags)
+{
+    s->seq++;
+    STATE_FENCE();
+    s->slaves[slave - 1].state = sl->state;
+    s->slaves[slave - 1].al_status_code = sl->ALstatuscode;
+    s->slaves[slave - 1].flags = flags;
+    STATE_FENCE();
+    s->seq++;
+}
+
+/* One recovery action for one slave, bounded by a few state checks of RECOVER_TIMEOUT_US (EC_TIMEOUTRET when a
+   silent slave is probed). A sweep starts with a state read and then visits every slave not in OP:
+   SAFE-OP+ERROR is acknowledged, SAFE-OP is requested to OP, a slave below SAFE-OP is reconfigured (SYNC0 re-armed)
+   and a silent one is marked lost until ecx_recover_slave finds it again. Returns the slaves still out of OP at the
+   start of the sweep, 0 once recovery is complete (or was never armed). Call between cycles only. */
+int soem_state_recover_step(soem_handle_t* h)
+{
+    soem_state_cache_t* s = h ? h->al_state : NULL;
+    if (!s || !s->recovering) return 0;
+    ecx_contextt* ctx = &h->context;
+
+    if (s->cursor == 0) {
+        if (s->next_sweep_ns && state_now_ns() < s->next_sweep_ns) return s->pending;
+
+        int op = soem_state_refresh(h);
+        s->pending = s->slave_count - op;
+        s->sweep_lost = 0;
+        s->seq++;
+        STATE_FENCE();
+        for (int i = 1; i <= s->slave_count; ++i) {
+            const ec_slavet* sl = &ctx->slavelist[i];
+            uint16_t flags = sl->state == EC_STATE_OPERATIONAL && !sl->islost ? 0 : SOEM_SLAVE_RECOVERING;
+            if (sl->islost) flags |= SOEM_SLAVE_LOST;
+            s->slaves[i - 1].flags = flags;
+        }
+        STATE_FENCE();
+        s->seq++;
+
+        if (s->pending == 0) {
+            s->recovering = 0;
+            LOG_EVENT(SOEM_LOG_INFO, SOEM_LOGC_RECOVERED, (int64_t)s->reads);
+            return 0;
+        }
+        s->cursor = 1;
+        return s->pending;
+    }
+
+    while (s->cursor <= s->slave_count && ctx->slavelist[s->cursor].state == EC_STATE_OPERATIONAL && !ctx->slavelist[s->cursor].islost)
+        s->cursor++;
+    if (s->cursor > s->slave_count) {
+        s->cursor = 0;
+        s->next_sweep_ns = s->sweep_lost ? state_now_ns() + RECOVER_SWEEP_GAP_NS : 0;
+        return s->pending;
+    }
+
+    int i = s->cursor++;
+    ec_slavet* sl = &ctx->slavelist[i];
+    if (sl->islost) {
+        s->sweep_lost = 1;
+        if (sl->state != EC_STATE_NONE || ecx_recover_slave(ctx, (uint16)i, RECOVER_TIMEOUT_US)) {
+            sl->islost = FALSE;
+            LOG_EVENT(SOEM_LOG_INFO, SOEM_LOGC_SLAVE_FOUND, i);
+        }
+    } else if (sl->state == (EC_STATE_SAFE_OP + EC_STATE_ERROR)) {
+        sl->state = EC_STATE_SAFE_OP + EC_STATE_ACK;
+        ecx_writestate(ctx, (uint16)i);
+    } else if (sl->state == EC_STATE_SAFE_OP) {
+        sl->state = EC_STATE_OPERATIONAL;
+        ecx_writestate(ctx, (uint16)i);
+    } else if (sl->state > EC_STATE_NONE) {
+        if (ecx_reconfig_slave(ctx, (uint16)i, RECOVER_TIMEOUT_US)) {
+            soem_dc_rearm_slave(h, i);  // the next sweep requests OP
+            LOG_EVENT(SOEM_LOG_INFO, SOEM_LOGC_SLAVE_RECONFIG, i);
+        }
+    } else {
+        ecx_statecheck(ctx, (uint16)i, EC_STATE_OPERATIONAL, EC_TIMEOUTRET);
+        if (sl->state == EC_STATE_NONE) {
+            sl->islost = TRUE;
+            s->sweep_lost = 1;
+            LOG_EVENT(SOEM_LOG_WARN, SOEM_LOGC_SLAVE_LOST, i);
+        }
+    }
+
+    uint16_t flags = SOEM_SLAVE_RECOVERING | (sl->islost ? SOEM_SLAVE_LOST : 0);
+    state_publish_slave(s, i, sl, flags);
+    return s->pending;
+}
+
+/* Startup from the mapping to OP, before the cache exists. Process data is exchanged every period_ns all along,
+   since some drives enter OP only with frames arriving, and between cycles one ecx_readstate reads every slave
+   (a single BRD while they agree). Each slave is requested to OP the cycle it reports SAFE-OP, and SAFE-OP+ERROR is
+   acknowledged, so no slave waits for the slowest. Gives up after timeout_ns. *safeop_ns is the time until the
+   last slave reached SAFE-OP, *op_ns the time from there on. Returns the slaves in OP. */
+int soem_state_bringup(soem_handle_t* h, int64_t period_ns, int64_t timeout_ns, int64_t* safeop_ns, int64_t* op_ns)
+{
+    ecx_contextt* ctx = &h->context;
+    int n = ctx->slavecount;
+    uint8 asked[EC_MAXSLAVE] = { 0 };  // OP requested since the slave last left SAFE-OP
+    uint8 acked[EC_MAXSLAVE] = { 0 };  // errors acknowledged, for the log
+    if (period_ns < BRINGUP_MIN_PERIOD_NS) period_ns = BRINGUP_MIN_PERIOD_NS;
+
+    int64_t start = state_now_ns(), safe_at = 0, now = start;
+    int op = 0;
+    for (;;) {
+        int64_t cycle = now;
+        soem_exchange_process_data(h, NULL, 0, NULL, 0, 2000);
+        ecx_readstate(ctx);
+
+        int safe = 0;
+        op = 0;
+        for (int i = 1; i <= n; ++i) {
+            ec_slavet* sl = &ctx->slavelist[i];
+            if (sl->state == EC_STATE_OPERATIONAL) {
+                ++op;
+                ++safe;
+            } else if (sl->state == EC_STATE_SAFE_OP) {
+                ++safe;
+                if (!asked[i]) {
+                    sl->state = EC_STATE_OPERATIONAL;
+                    ecx_writestate(ctx, (uint16)i);
+                    asked[i] = 1;
+                }
+            } else if (sl->state == (EC_STATE_SAFE_OP + EC_STATE_ERROR)) {
+                if (!acked[i]++)
+                    LOGW("Slave %d: SAFE-OP+ERROR during startup (AL status 0x%04x); acknowledging", i, sl->ALstatuscode);
+                sl->state = EC_STATE_SAFE_OP + EC_STATE_ACK;
+                ecx_writestate(ctx, (uint16)i);
+                asked[i] = 0;
+            } else {
+                asked[i] = 0;
+            }
+        }
+
+        now = state_now_ns();
+        if (!safe_at && safe == n) safe_at = now;
+        if (op == n || now - start >= timeout_ns) break;
+        int64_t rest = period_ns - (now - cycle);
+        if (rest > 0) osal_usleep((uint32)(rest / 1000));
+        now = state_now_ns();
+    }
+
+    if (op < n) {
+        for (int i = 1; i <= n; ++i) {
+            const ec_slavet* sl = &ctx->slavelist[i];
+            if (sl->state != EC_STATE_OPERATIONAL)
+                LOGW("Slave %d not in OP after %.0f ms of startup: state 0x%02x, AL status 0x%04x", i, (now - start) / 1e6,
+                    sl->state, sl->ALstatuscode);
+        }
+    }
+    if (!safe_at) safe_at = now;
+    *safeop_ns = safe_at - start;
+    *op_ns = now - safe_at;
+    return op;
+}
+
+int soem_state_recovering(const soem_handle_t* h)
+{
+    return h && h->al_state ? h->al_state->recovering : 0;
+}
+
+SOEMSHIM_EXPORT int soem_recover_start(soem_handle_t* h)
+{
+    soem_state_cache_t* s = h ? h->al_state : NULL;
+    if (!s) return 0;
+    if (!s->recovering) {
+        s->cursor = 0;
+        s->next_sweep_ns = 0;
+        STATE_FENCE();
+        s->recovering = 1;
+    }
+    return 1;
+}
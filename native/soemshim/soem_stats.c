@@ -0,0 +1,218 @@
+/* Cycle latency histograms: round trip, wake-up lateness and total cycle time of every bus cycle, kept in
+   log-linear (HDR-style) buckets and summarised into percentiles by soem_get_cycle_stats.
+   Shared verbatim by the Windows and Linux shims. soem_stats_record runs on the bus thread (managed loop or
+   cyclic engine) and never logs, blocks or allocates. */
+#include "soem_shim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define STATS_FENCE() _mm_mfence()
+static int stats_msb(uint64_t v) { unsigned long i; _BitScanReverse64(&i, v); return (int)i; }
+#else
+#define STATS_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+static int stats_msb(uint64_t v) { return 63 - __builtin_clzll(v); }
+#endif
+
+// Values below 2 * HIST_SUB get a bucket each; above that every power of two is split into HIST_SUB buckets,
+// so a bucket is never wider than 1/32 (3.1 %) of the values it holds.
+#define HIST_SUB_BITS 5
+#define HIST_SUB      (1 << HIST_SUB_BITS)
+#define HIST_MAX_BITS 40  // values clamp just below 2^40 ns (~18 minutes)
+#define HIST_BUCKETS  ((HIST_MAX_BITS - HIST_SUB_BITS + 1) * HIST_SUB)
+
+typedef struct stats_hist {
+    uint64_t count;
+    uint64_t sum;
+    int64_t min;
+    int64_t max;
+    uint64_t buckets[HIST_BUCKETS];
+} stats_hist_t;
+
+typedef struct stats_bank {
+    int64_t started_ns;
+    stats_hist_t round_trip;
+    stats_hist_t wake_lateness;
+    stats_hist_t total;
+} stats_bank_t;
+
+/* Two banks: the bus thread records into banks[active]; soem_get_cycle_stats flips active, waits for a record
+   still running against the old bank (busy), then summarises and clears it. */
+typedef struct soem_stats_state {
+    volatile int active;
+    volatile int busy[2];
+    stats_bank_t banks[2];
+    int64_t period_ns;      // caller's nominal cycle period, 0 = no lateness on the managed paths
+    int64_t next_deadline;  // where the next managed cycle should start, 0 until the first one
+} soem_stats_state_t;
+
+static int64_t stats_now_ns(void)
+{
+    ec_timet t;
+    osal_get_monotonic_time(&t);
+    return (int64_t)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static int hist_index(int64_t value)
+{
+    uint64_t v = value < 0 ? 0 : (uint64_t)value;
+    if (v >= (1ULL << HIST_MAX_BITS)) v = (1ULL << HIST_MAX_BITS) - 1;
+    if (v < 2 * HIST_SUB) return (int)v;
+    int e = stats_msb(v) - HIST_SUB_BITS;
+    return e * HIST_SUB + (int)(v >> e);
+}
+
+/* Highest value that lands in bucket idx. */
+static int64_t hist_bucket_top(int idx)
+{
+    if (idx < 2 * HIST_SUB) return idx;
+    int e = idx / HIST_SUB - 1;
+    int64_t m = (int64_t)(idx % HIST_SUB + HIST_SUB);
+    return ((m + 1) << e) - 1;
+}
+
+static void hist_clear(stats_hist_t* hist)
+{
+    memset(hist, 0, sizeof(*hist));
+    hist->min = INT64_MAX;
+}
+
+static void hist_record(stats_hist_t* hist, int64_t value)
+{
+    if (value < 0) return;
+    hist->buckets[hist_index(value)]++;
+    hist->count++;
+    hist->sum += (uint64_t)value;
+    if (value < hist->min) hist->min = value;
+    if (value > hist->max) hist->max = value;
+}
+
+static int64_t hist_percentile(const stats_hist_t* hist, double q)
+{
+    double target = q * (double)hist->count;
+    uint64_t rank = (uint64_t)target;
+    if ((double)rank < target) ++rank;
+    if (rank < 1) rank = 1;
+    if (rank > hist->count) rank = hist->count;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; ++i) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            int64_t v = hist_bucket_top(i);
+            if (v > hist->max) v = hist->max;
+            return v < hist->min ? hist->min : v;
+        }
+    }
+    return hist->max;
+}
+
+static void hist_summarise(const stats_hist_t* hist, soem_latency_summary_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    if (hist->count == 0) return;
+    out->count = hist->count;
+    out->min_ns = hist->min;
+    out->max_ns = hist->max;
+    out->mean_ns = (int64_t)(hist->sum / hist->count);
+    out->p50_ns = hist_percentile(hist, 0.50);
+    out->p90_ns = hist_percentile(hist, 0.90);
+    out->p99_ns = hist_percentile(hist, 0.99);
+    out->p999_ns = hist_percentile(hist, 0.999);
+    out->p9999_ns = hist_percentile(hist, 0.9999);
+}
+
+static void bank_clear(stats_bank_t* bank, int64_t now)
+{
+    bank->started_ns = now;
+    hist_clear(&bank->round_trip);
+    hist_clear(&bank->wake_lateness);
+    hist_clear(&bank->total);
+}
+
+int soem_stats_init(soem_handle_t* h, int64_t period_ns)
+{
+    if (!h) return 0;
+    soem_stats_state_t* s = (soem_stats_state_t*)calloc(1, sizeof(*s));
+    if (!s) return 0;
+    int64_t now = stats_now_ns();
+    bank_clear(&s->banks[0], now);
+    bank_clear(&s->banks[1], now);
+    s->period_ns = period_ns > 0 ? period_ns : 0;
+    h->stats = s;
+    return 1;
+}
+
+void soem_stats_release(soem_handle_t* h)
+{
+    if (!h || !h->stats) return;
+    free(h->stats);
+    h->stats = NULL;
+}
+
+/* Lateness of a managed cycle starting at entry_ns against an absolute schedule of period_ns steps. The
+   schedule re-anchors on the first cycle, on a cycle that starts early (the caller's timer runs on its own
+   phase) and after a whole period was missed. Returns -1 when no period is configured. */
+int64_t soem_stats_lateness(soem_handle_t* h, int64_t entry_ns)
+{
+    soem_stats_state_t* s = h ? h->stats : NULL;
+    if (!s || s->period_ns == 0) return -1;
+
+    int64_t late = s->next_deadline ? entry_ns - s->next_deadline : 0;
+    if (!s->next_deadline || late < 0 || late >= s->period_ns) {
+        s->next_deadline = entry_ns;
+        if (late < 0) late = 0;
+    }
+    s->next_deadline += s->period_ns;
+    return late;
+}
+
+/* Record one cycle; a negative value leaves that histogram alone. */
+void soem_stats_record(soem_handle_t* h, int64_t wake_lateness_ns, int64_t round_trip_ns, int64_t total_ns)
+{
+    soem_stats_state_t* s = h ? h->stats : NULL;
+    if (!s) return;
+
+    int b;
+    for (;;) {
+        b = s->active;
+        s->busy[b] = 1;
+        STATS_FENCE();
+        if (s->active == b) break;
+        s->busy[b] = 0;  // flipped under us: record into the new bank
+    }
+
+    stats_bank_t* bank = &s->banks[b];
+    hist_record(&bank->wake_lateness, wake_lateness_ns);
+    hist_record(&bank->round_trip, round_trip_ns);
+    hist_record(&bank->total, total_ns);
+
+    STATS_FENCE();
+    s->busy[b] = 0;
+}
+
+SOEMSHIM_EXPORT int soem_get_cycle_stats(soem_handle_t* h, soem_cycle_stats_t* out)
+{
+    if (!h || !out) return 0;
+    memset(out, 0, sizeof(*out));
+    soem_stats_state_t* s = h->stats;
+    if (!s) return 1;
+
+    int64_t now = stats_now_ns();
+    int old = s->active;
+    s->banks[old ^ 1].started_ns = now;
+    STATS_FENCE();
+    s->active = old ^ 1;
+    STATS_FENCE();
+    while (s->busy[old]) { }  // at most one record in flight
+
+    stats_bank_t* bank = &s->banks[old];
+    out->interval_ns = now - bank->started_ns;
+    hist_summarise(&bank->round_trip, &out->round_trip);
+    hist_summarise(&bank->wake_lateness, &out->wake_lateness);
+    hist_summarise(&bank->total, &out->total);
+    bank_clear(bank, now);
+    return 1;
+}
@@ -0,0 +1,108 @@
+#pragma once
+/* Virtual Xeryon slaves: a line of EtherCAT slave controllers (ESCs) answering real frames, so the unmodified
+   soemshim and SOEM can configure and cycle a bus without hardware. Each slave has the ESC's register space,
+   an SII image, FMMUs for logical addressing, the AL state machine and a distributed clock; the drive model
+   behind the process data runs the Xeryon command set on the 20-byte RX / 8-byte TX PDO layout. Linux only. */
+#include <stdint.h>
+
+#define VS_MAX_SLAVES   512
+#define VS_ESC_SIZE     0x2000   // registers 0x0000-0x0FFF, process data RAM 0x1000-0x1FFF
+#define VS_SII_WORDS    256
+#define VS_RX_BYTES     20       // Command, Parameter, Velocity, Acceleration, Deceleration, Execute, 3 pad
+#define VS_TX_BYTES     8        // ActualPosition, 24 status bits, Slot
+#define VS_OUT_ADDR     0x1100   // SM2, outputs
+#define VS_IN_ADDR      0x1180   // SM3, inputs
+
+/* EtherCAT datagram commands and the ESC registers the model gives meaning to (ETG.1000.4 / ESC datasheets). */
+enum {
+    VS_CMD_NOP, VS_CMD_APRD, VS_CMD_APWR, VS_CMD_APRW, VS_CMD_FPRD, VS_CMD_FPWR, VS_CMD_FPRW, VS_CMD_BRD,
+    VS_CMD_BWR, VS_CMD_BRW, VS_CMD_LRD, VS_CMD_LWR, VS_CMD_LRW, VS_CMD_ARMW, VS_CMD_FRMW, VS_CMD_COUNT
+};
+
+#define VS_REG_TYPE      0x0000
+#define VS_REG_FMMUS     0x0004
+#define VS_REG_PORTDES   0x0007
+#define VS_REG_ESCSUP    0x0008
+#define VS_REG_STADR     0x0010
+#define VS_REG_DLSTAT    0x0110
+#define VS_REG_ALCTL     0x0120
+#define VS_REG_ALSTAT    0x0130
+#define VS_REG_ALCODE    0x0134
+#define VS_REG_PDICTL    0x0140
+#define VS_REG_EEPCTL    0x0502
+#define VS_REG_EEPADR    0x0504
+#define VS_REG_EEPDAT    0x0508
+#define VS_REG_FMMU0     0x0600
+#define VS_REG_SM0       0x0800
+#define VS_REG_DCTIME0   0x0900
+#define VS_REG_DCSYSTIME 0x0910
+#define VS_REG_DCSOF     0x0918
+#define VS_REG_DCOFFSET  0x0920
+
+#define VS_AL_INIT    0x01
+#define VS_AL_PREOP   0x02
+#define VS_AL_BOOT    0x03
+#define VS_AL_SAFEOP  0x04
+#define VS_AL_OP      0x08
+#define VS_AL_ERROR   0x10
+
+#define VS_ALCODE_INVALID_CHANGE 0x0011
+#define VS_ALCODE_SM_WATCHDOG    0x001B
+
+/* Drive state behind one slave's process data (vslave_drive.c). */
+typedef struct vs_drive {
+    int32_t  position;       // encoder counts
+    int32_t  target;
+    double   carry;          // fraction of a count moved but not yet shown
+    int32_t  speed;          // counts/s of the motion in progress, 0 = jump
+    int      scan_dir;       // SCAN in progress: -1/+1, 0 = none
+    uint32_t status;         // the 24 status bits, bit 0 = AmplifiersEnabled ... bit 21 = PositionFail
+    uint8_t  execute;        // Execute seen on the last exchange, for the rising edge
+    int64_t  updated_ns;
+} vs_drive_t;
+
+typedef struct vs_slave {
+    uint8_t  esc[VS_ESC_SIZE];
+    uint16_t sii[VS_SII_WORDS];
+    int64_t  clock_base_ns;  // this slave's local clock = monotonic + base, as if it powered up on its own
+    int64_t  last_output_ns; // last process-data write while in OP, for the SM watchdog
+    int64_t  eeprom_ready_ns;// the EEPROM interface reads busy until then
+    vs_drive_t drive;
+} vs_slave_t;
+
+typedef struct vs_bus {
+    int        count;        // slaves on the line
+    int        reachable;    // slaves before a pulled cable (count when the line is whole)
+    int64_t    hop_ns;       // propagation per slave, both directions, for the DC receive time latches
+    int64_t    watchdog_ns;  // SM watchdog: OP drops to SAFEOP+ERROR without outputs for this long, 0 = off
+    int64_t    eeprom_ns;    // EEPROM busy time per command, 0 = never busy
+    double     counts_per_um;// Velocity is in um/s; positions in encoder counts
+    uint32_t   vendor, product, revision;
+    vs_slave_t* slaves;
+    uint64_t   frames;
+    uint64_t   datagrams[VS_CMD_COUNT];
+    uint64_t   unaddressed;  // datagrams no slave answered (WKC 0)
+} vs_bus_t;
+
+/* vslave_esc.c */
+int  vs_bus_init(vs_bus_t* bus, int count);
+void vs_bus_free(vs_bus_t* bus);
+void vs_slave_power_on(vs_bus_t* bus, int index);
+/* Runs every datagram of one EtherCAT frame (from the EtherCAT header on) through the line, in place, and sets
+   the working counters. Returns 1 when the frame was an EtherCAT command frame, 0 when it was left alone. */
+int  vs_process_frame(vs_bus_t* bus, uint8_t* ecat, int len, int64_t now_ns);
+/* Cable pulled behind the first `reachable` slaves (count = line whole); the DL status of the last one shows it. */
+void vs_set_reachable(vs_bus_t* bus, int reachable);
+void vs_set_al_error(vs_bus_t* bus, int index, uint16_t code);
+uint16_t vs_al_state(const vs_slave_t* s);
+
+/* vslave_sii.c: the slave information image SOEM reads while configuring (identity, SMs, FMMUs, PDOs). */
+void vs_sii_build(uint16_t* sii, uint32_t vendor, uint32_t product, uint32_t revision, uint32_t serial);
+
+/* vslave_drive.c: the Xeryon drive behind SM2/SM3. vs_drive_exchange applies the outputs just written (only
+   in OP) and refreshes the inputs; vs_drive_safe stops it when the slave leaves OP; vs_drive_fault raises a
+   status bit (elim, safety, estop, fail, encoder) until RSET or ENBL 1 clears it. */
+void vs_drive_reset(vs_drive_t* d, int64_t now_ns);
+void vs_drive_exchange(vs_bus_t* bus, vs_slave_t* s, int slot, int apply_outputs, int64_t now_ns);
+void vs_drive_safe(vs_drive_t* d, int64_t now_ns);
+int  vs_drive_fault(vs_drive_t* d, const char* name);
@@ -0,0 +1,167 @@
+/* The Xeryon drive behind a virtual slave's process data. Outputs (SM2, 20 bytes): Command (4 ASCII), Parameter,
+   Velocity (um/s), Acceleration, Deceleration, Execute. Inputs (SM3, 8 bytes): ActualPosition, 24 status bits,
+   Slot. A command is taken on the rising edge of Execute and acknowledged (status bit 19) for as long as Execute
+   stays high, as 'EtherCAT commands - Xeryon.pdf' describes the handshake. Motion runs at the commanded speed
+   in encoder counts (Velocity times the counts per um the bus was started with) with no acceleration profile;
+   a speed of 0 jumps to the target. */
+#include <string.h>
+#include "vslave.h"
+
+#define ST_ENABLED          (1u << 0)
+#define ST_FORCE_ZERO       (1u << 4)
+#define ST_MOTOR_ON         (1u << 5)
+#define ST_CLOSED_LOOP      (1u << 6)
+#define ST_ENCODER_VALID    (1u << 8)
+#define ST_SEARCHING_INDEX  (1u << 9)
+#define ST_POSITION_REACHED (1u << 10)
+#define ST_ENCODER_ERROR    (1u << 12)
+#define ST_SCANNING         (1u << 13)
+#define ST_ERROR_LIMIT      (1u << 16)
+#define ST_SAFETY_TIMEOUT   (1u << 18)
+#define ST_EXECUTE_ACK      (1u << 19)
+#define ST_EMERGENCY_STOP   (1u << 20)
+#define ST_POSITION_FAIL    (1u << 21)
+
+#define ST_ERRORS (ST_ENCODER_ERROR | ST_ERROR_LIMIT | ST_SAFETY_TIMEOUT | ST_EMERGENCY_STOP | ST_POSITION_FAIL)
+
+static int32_t get32(const uint8_t* b) { return (int32_t)((uint32_t)b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24); }
+
+static void halt(vs_drive_t* d)
+{
+    d->target = d->position;
+    d->scan_dir = 0;
+    d->carry = 0;
+    d->status &= ~ST_SCANNING;
+}
+
+void vs_drive_reset(vs_drive_t* d, int64_t now_ns)
+{
+    memset(d, 0, sizeof(*d));
+    d->status = ST_ENABLED | ST_MOTOR_ON | ST_CLOSED_LOOP | ST_ENCODER_VALID | ST_POSITION_REACHED;
+    d->updated_ns = now_ns;
+}
+
+static void move(vs_drive_t* d, int64_t now_ns)
+{
+    double dt = (double)(now_ns - d->updated_ns) / 1e9;
+    d->updated_ns = now_ns;
+    if (!(d->status & ST_ENABLED) || (d->status & (ST_FORCE_ZERO | ST_ERRORS))) return;
+
+    if (d->scan_dir) {
+        d->carry += d->scan_dir * (double)d->speed * dt;
+        int32_t whole = (int32_t)d->carry;
+        d->position += whole;
+        d->carry -= whole;
+        d->target = d->position;
+        return;
+    }
+    if (d->position == d->target) return;
+    int64_t left = (int64_t)d->target - d->position;
+    d->carry += (double)d->speed * dt;
+    int64_t step = d->speed ? (int64_t)d->carry : (left < 0 ? -left : left);
+    d->carry -= (double)step;
+    if (step >= (left < 0 ? -left : left)) {
+        d->position = d->target;
+        d->carry = 0;
+        d->status |= ST_POSITION_REACHED;
+    } else {
+        d->position += (int32_t)(left < 0 ? -step : step);
+    }
+}
+
+static void command(vs_bus_t* bus, vs_drive_t* d, const uint8_t* out)
+{
+    int32_t parameter = get32(out + 4);
+    int32_t speed = (int32_t)((double)(uint32_t)get32(out + 8) * bus->counts_per_um);
+    int motion_ok = (d->status & ST_ENABLED) && !(d->status & (ST_FORCE_ZERO | ST_ERRORS));
+
+    if (!memcmp(out, "DPOS", 4) || !memcmp(out, "STEP", 4)) {
+        if (!motion_ok) return;
+        d->scan_dir = 0;
+        d->status &= ~ST_SCANNING;
+        d->target = out[0] == 'D' ? parameter : d->target + parameter;
+        d->speed = speed;
+        if (d->target == d->position) d->status |= ST_POSITION_REACHED;
+        else d->status &= ~ST_POSITION_REACHED;
+    } else if (!memcmp(out, "SCAN", 4)) {
+        if (!motion_ok) return;
+        d->speed = speed;
+        d->scan_dir = parameter > 0 ? 1 : parameter < 0 ? -1 : 0;
+        if (d->scan_dir) {
+            d->status = (d->status | ST_SCANNING) & ~ST_POSITION_REACHED;
+        } else {
+            halt(d);
+            d->status |= ST_POSITION_REACHED;
+        }
+    } else if (!memcmp(out, "INDX", 4)) {
+        if (!motion_ok) return;
+        halt(d);
+        d->position = d->target = 0;
+        d->status = (d->status | ST_ENCODER_VALID | ST_POSITION_REACHED) & ~ST_SEARCHING_INDEX;
+    } else if (!memcmp(out, "ENBL", 4)) {
+        halt(d);
+        if (parameter) d->status = (d->status | ST_ENABLED | ST_MOTOR_ON | ST_CLOSED_LOOP | ST_POSITION_REACHED) & ~(ST_FORCE_ZERO | ST_ERRORS);
+        else d->status &= ~(ST_ENABLED | ST_MOTOR_ON | ST_CLOSED_LOOP);
+    } else if (!memcmp(out, "RSET", 4)) {
+        halt(d);
+        d->status = (d->status | ST_POSITION_REACHED) & ~(ST_FORCE_ZERO | ST_ERRORS);
+    } else if (!memcmp(out, "HALT", 4)) {
+        halt(d);
+        d->status |= ST_POSITION_REACHED;
+    } else if (!memcmp(out, "STOP", 4)) {
+        halt(d);
+        d->status = (d->status | ST_FORCE_ZERO) & ~ST_POSITION_REACHED;
+    }
+    // Anything else (settings such as SSPD or PTOL) is acknowledged and otherwise ignored.
+}
+
+void vs_drive_exchange(vs_bus_t* bus, vs_slave_t* s, int slot, int apply_outputs, int64_t now_ns)
+{
+    vs_drive_t* d = &s->drive;
+    const uint8_t* out = s->esc + VS_OUT_ADDR;
+    uint8_t* in = s->esc + VS_IN_ADDR;
+
+    move(d, now_ns);
+    if (apply_outputs) {
+        uint8_t execute = out[16];
+        if (execute && !d->execute) {
+            command(bus, d, out);
+            d->status |= ST_EXECUTE_ACK;
+        } else if (!execute) {
+            d->status &= ~ST_EXECUTE_ACK;
+        }
+        d->execute = execute;
+    }
+
+    uint32_t position = (uint32_t)d->position;
+    in[0] = (uint8_t)position;
+    in[1] = (uint8_t)(position >> 8);
+    in[2] = (uint8_t)(position >> 16);
+    in[3] = (uint8_t)(position >> 24);
+    in[4] = (uint8_t)d->status;
+    in[5] = (uint8_t)(d->status >> 8);
+    in[6] = (uint8_t)(d->status >> 16);
+    in[7] = (uint8_t)slot;
+}
+
+/* Outside OP the drive holds still and drops the acknowledge, as a real slave goes to its safe state. */
+void vs_drive_safe(vs_drive_t* d, int64_t now_ns)
+{
+    halt(d);
+    d->updated_ns = now_ns;
+    d->execute = 0;
+    d->status &= ~ST_EXECUTE_ACK;
+}
+
+int vs_drive_fault(vs_drive_t* d, const char* name)
+{
+    uint32_t bit = !strcmp(name, "elim") ? ST_ERROR_LIMIT
+        : !strcmp(name, "safety") ? ST_SAFETY_TIMEOUT
+        : !strcmp(name, "estop") ? ST_EMERGENCY_STOP | ST_FORCE_ZERO
+        : !strcmp(name, "fail") ? ST_POSITION_FAIL
+        : !strcmp(name, "encoder") ? ST_ENCODER_ERROR : 0;
+    if (!bit) return 0;
+    halt(d);
+    d->status = (d->status | bit) & ~ST_POSITION_REACHED;
+    return 1;
+}
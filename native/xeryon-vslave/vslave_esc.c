@@ -0,0 +1,310 @@
+/* The ESC side of the virtual slaves: each datagram of a frame passes the slaves in line order, and every slave
+   it addresses reads or writes its register space and counts the working counter the way an ESC does (read +1,
+   write +1, read-write +3; logical LRW +1 for the inputs read and +2 for the outputs written). Registers are
+   plain memory except for the few with behaviour SOEM relies on:
+
+   - AL control (0x0120) drives the state machine: INIT, PRE-OP and BOOT from anywhere, SAFE-OP from PRE-OP or
+     above, OP from SAFE-OP; anything else sets the error bit with code 0x0011, and the error bit holds until a
+     request carries the acknowledge. A slave in OP that has seen no outputs for the watchdog time drops to
+     SAFE-OP with the error bit and code 0x001B, as the SM watchdog of a real drive does.
+   - The EEPROM interface (0x0502-0x050F) serves the SII image 8 bytes per read. It reads busy for eeprom_ns
+     after each command (never, by default), as the I2C transfer of a real ESC does.
+   - A write to 0x0900 latches the DC receive times of every port, spaced by hop_ns per slave; the system time
+     (0x0910) reads as the slave's local clock plus the offset SOEM wrote to 0x0920.
+   - Logical datagrams go through the FMMUs, in SAFE-OP and OP only; the drive model sees the outputs in OP.
+
+   Registers that are read-only on an ESC (identity, DL and AL status, the time latches) ignore writes. */
+#include <stdlib.h>
+#include <string.h>
+#include "vslave.h"
+
+#define VS_HOP_NS_DEFAULT 300
+
+static uint16_t get16(const uint8_t* b) { return (uint16_t)(b[0] | b[1] << 8); }
+static void put16(uint8_t* b, uint16_t v) { b[0] = (uint8_t)v; b[1] = (uint8_t)(v >> 8); }
+static uint32_t get32(const uint8_t* b) { return (uint32_t)get16(b) | (uint32_t)get16(b + 2) << 16; }
+static void put32(uint8_t* b, uint32_t v) { put16(b, (uint16_t)v); put16(b + 2, (uint16_t)(v >> 16)); }
+static void put64(uint8_t* b, uint64_t v) { put32(b, (uint32_t)v); put32(b + 4, (uint32_t)(v >> 32)); }
+static uint64_t get64(const uint8_t* b) { return (uint64_t)get32(b) | (uint64_t)get32(b + 4) << 32; }
+
+static int overlaps(int ado, int len, int reg, int reg_len) { return ado < reg + reg_len && reg < ado + len; }
+
+uint16_t vs_al_state(const vs_slave_t* s) { return get16(s->esc + VS_REG_ALSTAT); }
+
+static void set_al(vs_slave_t* s, uint16_t status, uint16_t code, int64_t now_ns)
+{
+    put16(s->esc + VS_REG_ALSTAT, status);
+    put16(s->esc + VS_REG_ALCODE, code);
+    if ((status & 0x0F) != VS_AL_OP) vs_drive_safe(&s->drive, now_ns);
+    else s->last_output_ns = now_ns;  // the watchdog starts with OP
+}
+
+/* DL status: PDI up, port 0 open with traffic, port 1 open towards the next reachable slave or closed. */
+static void update_links(vs_bus_t* bus)
+{
+    for (int i = 0; i < bus->count; ++i) {
+        uint16_t dl = 0x0001 | 0x0010 | 0x0200;
+        dl |= i + 1 < bus->reachable ? 0x0020 | 0x0800 : 0x0400;
+        put16(bus->slaves[i].esc + VS_REG_DLSTAT, dl);
+    }
+}
+
+void vs_slave_power_on(vs_bus_t* bus, int index)
+{
+    vs_slave_t* s = &bus->slaves[index];
+    int64_t base = (int64_t)(index + 1) * 1000000007LL;  // each slave booted at its own moment
+    memset(s->esc, 0, sizeof(s->esc));
+    s->esc[VS_REG_TYPE] = 0x11;          // ET1100-class ESC
+    s->esc[VS_REG_FMMUS] = 8;
+    s->esc[VS_REG_FMMUS + 1] = 8;        // SyncManagers
+    s->esc[VS_REG_FMMUS + 2] = 8;        // KiB of process data RAM
+    s->esc[VS_REG_PORTDES] = 0x0F;       // ports 0 and 1 MII
+    put16(s->esc + VS_REG_ESCSUP, 0x000C);  // DC, 64-bit system time
+    put16(s->esc + VS_REG_PDICTL, 0x0008);
+    put16(s->esc + VS_REG_ALSTAT, VS_AL_INIT);
+    put16(s->esc + VS_REG_EEPCTL, 0x0040);  // 8-byte reads
+    vs_sii_build(s->sii, bus->vendor, bus->product, bus->revision, (uint32_t)index + 1);
+    s->clock_base_ns = base;
+    s->last_output_ns = 0;
+    vs_drive_reset(&s->drive, 0);
+    update_links(bus);
+}
+
+int vs_bus_init(vs_bus_t* bus, int count)
+{
+    if (count <= 0 || count > VS_MAX_SLAVES) return 0;
+    bus->slaves = (vs_slave_t*)calloc((size_t)count, sizeof(vs_slave_t));
+    if (!bus->slaves) return 0;
+    bus->count = bus->reachable = count;
+    if (!bus->hop_ns) bus->hop_ns = VS_HOP_NS_DEFAULT;
+    if (bus->counts_per_um <= 0) bus->counts_per_um = 1.0;
+    for (int i = 0; i < count; ++i) vs_slave_power_on(bus, i);
+    return 1;
+}
+
+void vs_bus_free(vs_bus_t* bus)
+{
+    free(bus->slaves);
+    bus->slaves = NULL;
+    bus->count = bus->reachable = 0;
+}
+
+void vs_set_reachable(vs_bus_t* bus, int reachable)
+{
+    bus->reachable = reachable < 0 ? 0 : reachable > bus->count ? bus->count : reachable;
+    update_links(bus);
+}
+
+void vs_set_al_error(vs_bus_t* bus, int index, uint16_t code)
+{
+    vs_slave_t* s = &bus->slaves[index];
+    uint16_t state = vs_al_state(s) & 0x0F;
+    if (state > VS_AL_SAFEOP) state = VS_AL_SAFEOP;
+    set_al(s, (uint16_t)(state | VS_AL_ERROR), code, 0);
+}
+
+static void check_watchdog(vs_bus_t* bus, vs_slave_t* s, int64_t now_ns)
+{
+    if (bus->watchdog_ns && (vs_al_state(s) & 0x0F) == VS_AL_OP && now_ns - s->last_output_ns > bus->watchdog_ns)
+        set_al(s, VS_AL_SAFEOP | VS_AL_ERROR, VS_ALCODE_SM_WATCHDOG, now_ns);
+}
+
+static void al_control(vs_slave_t* s, uint16_t control, int64_t now_ns)
+{
+    uint16_t status = vs_al_state(s);
+    uint16_t current = status & 0x0F, requested = control & 0x0F;
+    if (status & VS_AL_ERROR) {
+        if (!(control & VS_AL_ERROR)) return;  // not acknowledged: the error stays up
+        status &= (uint16_t)~VS_AL_ERROR;
+        put16(s->esc + VS_REG_ALSTAT, status);
+        put16(s->esc + VS_REG_ALCODE, 0);
+    }
+    int allowed = requested == VS_AL_INIT || requested == VS_AL_PREOP
+        || (requested == VS_AL_BOOT && current == VS_AL_INIT)
+        || (requested == VS_AL_SAFEOP && current >= VS_AL_PREOP && current != VS_AL_BOOT)
+        || (requested == VS_AL_OP && current >= VS_AL_SAFEOP);
+    if (!allowed) set_al(s, (uint16_t)(current | VS_AL_ERROR), VS_ALCODE_INVALID_CHANGE, now_ns);
+    else if (requested != current) set_al(s, requested, 0, now_ns);
+}
+
+static void eeprom_command(vs_bus_t* bus, vs_slave_t* s, int64_t now_ns)
+{
+    uint16_t command = get16(s->esc + VS_REG_EEPCTL) & 0x0700;
+    uint32_t word = get32(s->esc + VS_REG_EEPADR);
+    if (command == 0x0100) {
+        for (int k = 0; k < 4; ++k)
+            put16(s->esc + VS_REG_EEPDAT + 2 * k, word + (uint32_t)k < VS_SII_WORDS ? s->sii[word + (uint32_t)k] : 0xFFFF);
+    } else if (command == 0x0200 && word < VS_SII_WORDS) {
+        s->sii[word] = get16(s->esc + VS_REG_EEPDAT);
+    }
+    s->eeprom_ready_ns = now_ns + bus->eeprom_ns;
+    put16(s->esc + VS_REG_EEPCTL, bus->eeprom_ns ? 0x8040 : 0x0040);  // busy until eeprom_ready_ns, no error
+}
+
+static void dc_latch(vs_bus_t* bus, int index, int64_t now_ns)
+{
+    vs_slave_t* s = &bus->slaves[index];
+    int64_t port0 = now_ns + s->clock_base_ns + index * bus->hop_ns;
+    int downstream = bus->reachable - 1 - index;
+    int64_t port1 = downstream > 0 ? port0 + 2 * downstream * bus->hop_ns : 0;
+    put32(s->esc + VS_REG_DCTIME0, (uint32_t)port0);
+    put32(s->esc + VS_REG_DCTIME0 + 4, (uint32_t)port1);
+    put32(s->esc + VS_REG_DCTIME0 + 8, 0);
+    put32(s->esc + VS_REG_DCTIME0 + 12, 0);
+    put64(s->esc + VS_REG_DCSOF, (uint64_t)port0);
+}
+
+static int writable(int addr)
+{
+    return !(addr < 0x0010 || (addr >= 0x0110 && addr < 0x0120) || (addr >= 0x0130 && addr < 0x0140)
+        || (addr >= 0x0900 && addr < 0x0920));
+}
+
+static void esc_read(vs_slave_t* s, int ado, uint8_t* data, int len, int merge, int64_t now_ns)
+{
+    if (overlaps(ado, len, VS_REG_EEPCTL, 2) && (get16(s->esc + VS_REG_EEPCTL) & 0x8000) && now_ns >= s->eeprom_ready_ns)
+        put16(s->esc + VS_REG_EEPCTL, get16(s->esc + VS_REG_EEPCTL) & 0x7FFF);
+    if (overlaps(ado, len, VS_REG_DCSYSTIME, 8))
+        put64(s->esc + VS_REG_DCSYSTIME, (uint64_t)(now_ns + s->clock_base_ns) + get64(s->esc + VS_REG_DCOFFSET));
+    for (int k = 0; k < len; ++k) {
+        uint8_t v = ado + k < VS_ESC_SIZE ? s->esc[ado + k] : 0;
+        data[k] = merge ? (uint8_t)(data[k] | v) : v;
+    }
+}
+
+static void esc_write(vs_bus_t* bus, int index, int ado, const uint8_t* data, int len, int64_t now_ns)
+{
+    vs_slave_t* s = &bus->slaves[index];
+    if (ado >= VS_ESC_SIZE) return;
+    // Process data RAM has nothing read-only in it; the register page goes byte by byte through the mask.
+    if (ado >= 0x1000) {
+        memcpy(s->esc + ado, data, (size_t)(ado + len <= VS_ESC_SIZE ? len : VS_ESC_SIZE - ado));
+        return;
+    }
+    for (int k = 0; k < len && ado + k < VS_ESC_SIZE; ++k)
+        if (writable(ado + k)) s->esc[ado + k] = data[k];
+
+    if (overlaps(ado, len, VS_REG_ALCTL, 2)) al_control(s, get16(s->esc + VS_REG_ALCTL), now_ns);
+    if (overlaps(ado, len, VS_REG_EEPCTL, 2)) eeprom_command(bus, s, now_ns);
+    if (overlaps(ado, len, VS_REG_DCTIME0, 4)) dc_latch(bus, index, now_ns);
+}
+
+/* Logical addressing through the slave's FMMUs. Returns the WKC this slave adds. */
+static int logical(vs_bus_t* bus, int index, int cmd, uint32_t address, uint8_t* data, int len, int64_t now_ns)
+{
+    vs_slave_t* s = &bus->slaves[index];
+    uint16_t state = vs_al_state(s) & 0x0F;
+    if (state != VS_AL_SAFEOP && state != VS_AL_OP) return 0;
+
+    int wrote = 0, read = 0;
+    for (int pass = 0; pass < 2; ++pass) {  // outputs into the slave first, so the inputs read back are fresh
+        for (int f = 0; f < 8; ++f) {
+            const uint8_t* fmmu = s->esc + VS_REG_FMMU0 + 16 * f;
+            uint8_t type = fmmu[11];
+            if (!(fmmu[12] & 1) || !(type & (pass ? 1 : 2))) continue;
+            if (pass == 0 && cmd == VS_CMD_LRD) continue;
+            if (pass == 1 && cmd == VS_CMD_LWR) continue;
+            uint32_t start = get32(fmmu), length = get16(fmmu + 4);
+            uint32_t from = start > address ? start : address;
+            uint32_t to = start + length < address + (uint32_t)len ? start + length : address + (uint32_t)len;
+            if (from >= to) continue;
+            uint32_t phys = get16(fmmu + 8) + (from - start);
+            uint32_t n = to - from;
+            if (phys + n > VS_ESC_SIZE) continue;
+            if (pass == 0) {
+                memcpy(s->esc + phys, data + (from - address), n);
+                wrote = 1;
+            } else {
+                if (!read) vs_drive_exchange(bus, s, index + 1, wrote && state == VS_AL_OP, now_ns);
+                memcpy(data + (from - address), s->esc + phys, n);
+                read = 1;
+            }
+        }
+    }
+    if (wrote && state == VS_AL_OP) {
+        s->last_output_ns = now_ns;
+        if (!read) vs_drive_exchange(bus, s, index + 1, 1, now_ns);
+    }
+    return read + 2 * wrote;
+}
+
+static int addressed(vs_bus_t* bus, int index, int cmd, uint16_t adp)
+{
+    switch (cmd) {
+    case VS_CMD_APRD: case VS_CMD_APWR: case VS_CMD_APRW: case VS_CMD_ARMW:
+        return (uint16_t)(adp + index) == 0;
+    case VS_CMD_FPRD: case VS_CMD_FPWR: case VS_CMD_FPRW: case VS_CMD_FRMW:
+        return get16(bus->slaves[index].esc + VS_REG_STADR) == adp;
+    default:
+        return 1;
+    }
+}
+
+static void run_datagram(vs_bus_t* bus, uint8_t* dg, int64_t now_ns)
+{
+    int cmd = dg[0];
+    uint16_t adp = get16(dg + 2), ado = get16(dg + 4);
+    int len = get16(dg + 6) & 0x07FF;
+    uint8_t* data = dg + 10;
+    uint16_t wkc = get16(data + len), before = wkc;
+    if (cmd < VS_CMD_COUNT) bus->datagrams[cmd]++;
+
+    uint8_t scratch[0x800];  // a read-write datagram's data as it arrived, for the write half
+    for (int i = 0; i < bus->reachable; ++i) {
+        vs_slave_t* s = &bus->slaves[i];
+        check_watchdog(bus, s, now_ns);
+        int hit = addressed(bus, i, cmd, adp);
+        switch (cmd) {
+        case VS_CMD_APRD: case VS_CMD_FPRD: case VS_CMD_BRD:
+            if (hit) { esc_read(s, ado, data, len, cmd == VS_CMD_BRD, now_ns); wkc++; }
+            break;
+        case VS_CMD_APWR: case VS_CMD_FPWR: case VS_CMD_BWR:
+            if (hit) { esc_write(bus, i, ado, data, len, now_ns); wkc++; }
+            break;
+        case VS_CMD_APRW: case VS_CMD_FPRW: case VS_CMD_BRW:
+            if (hit) {
+                memcpy(scratch, data, (size_t)len);
+                esc_read(s, ado, data, len, cmd == VS_CMD_BRW, now_ns);
+                esc_write(bus, i, ado, scratch, len, now_ns);
+                wkc += 3;
+            }
+            break;
+        case VS_CMD_ARMW: case VS_CMD_FRMW:
+            // The addressed slave reads, every other slave writes what it read.
+            if (hit) esc_read(s, ado, data, len, 0, now_ns);
+            else esc_write(bus, i, ado, data, len, now_ns);
+            wkc++;
+            break;
+        case VS_CMD_LRD: case VS_CMD_LWR: case VS_CMD_LRW:
+            wkc = (uint16_t)(wkc + logical(bus, i, cmd, (uint32_t)adp | (uint32_t)ado << 16, data, len, now_ns));
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Auto-increment addresses come back advanced by every slave passed.
+    if (cmd == VS_CMD_APRD || cmd == VS_CMD_APWR || cmd == VS_CMD_APRW || cmd == VS_CMD_ARMW)
+        put16(dg + 2, (uint16_t)(adp + bus->reachable));
+    if (wkc == before) bus->unaddressed++;
+    put16(data + len, wkc);
+}
+
+int vs_process_frame(vs_bus_t* bus, uint8_t* ecat, int len, int64_t now_ns)
+{
+    if (len < 2 + 12) return 0;
+    uint16_t header = get16(ecat);
+    int payload = header & 0x07FF;
+    if ((header >> 12) != 1 || payload + 2 > len) return 0;  // not a command frame
+
+    bus->frames++;
+    for (int at = 2; at + 12 <= payload + 2;) {
+        uint8_t* dg = ecat + at;
+        int dlen = get16(dg + 6) & 0x07FF;
+        if (at + 12 + dlen > payload + 2) break;
+        run_datagram(bus, dg, now_ns);
+        at += 12 + dlen;
+        if (!(get16(dg + 6) & 0x8000)) break;
+    }
+    return 1;
+}
@@ -0,0 +1,233 @@
+/* xeryon_vslave: answers EtherCAT frames on a Linux interface as a line of N Xeryon drives.
+
+   On a veth pair the slaves sit on one end and the master (soemshim / SoemClient) opens the other:
+     ip link add ecat0 type veth peer name ecat1 && ip link set ecat0 up && ip link set ecat1 up
+     xeryon_vslave -n 16 ecat1            # then initialize the bus on ecat0
+   With -t the slaves create (or attach to) a TAP interface instead and the master opens that same interface:
+     xeryon_vslave -t -n 16 vslave0       # then initialize the bus on vslave0
+
+   Lines on stdin change the bus while it runs, for recovery and soak tests:
+     pull N          cable pulled in front of slave N: N and everything behind it stop answering
+     plug            cable back in; the slaves behind it kept their state (and tripped their watchdog)
+     reset N         slave N power-cycles: INIT, no station address, SII and drive state from scratch
+     al N CODE       slave N raises an AL error (hex code) and drops to SAFE-OP
+     fault N NAME    drive status error on slave N: elim, safety, estop, fail or encoder
+     stats           frame and datagram counters
+     quit */
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <linux/if_tun.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "vslave.h"
+
+#define VS_ETH_P_ECAT 0x88A4
+#define VS_FRAME_MAX  1536
+
+static volatile sig_atomic_t g_stop;
+
+static void on_signal(int sig) { (void)sig; g_stop = 1; }
+
+static int64_t mono_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int open_packet(const char* ifname)
+{
+    int fd = socket(AF_PACKET, SOCK_RAW, htons(VS_ETH_P_ECAT));
+    if (fd < 0) return -1;
+    struct sockaddr_ll addr = { 0 };
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(VS_ETH_P_ECAT);
+    addr.sll_ifindex = (int)if_nametoindex(ifname);
+    if (!addr.sll_ifindex || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_PACKET, PACKET_QDISC_BYPASS, &one, sizeof(one));  // best effort, as in soem_ring.c
+    return fd;
+}
+
+static int open_tap(const char* ifname)
+{
+    int fd = open("/dev/net/tun", O_RDWR);
+    if (fd < 0) return -1;
+    struct ifreq ifr = { 0 };
+    ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+    strncpy(ifr.ifr_name, ifname, IFNAMSIZ - 1);
+    if (ioctl(fd, TUNSETIFF, &ifr) < 0) {
+        close(fd);
+        return -1;
+    }
+    // Bring the interface up so the master's socket can bind to it.
+    int ctl = socket(AF_INET, SOCK_DGRAM, 0);
+    if (ctl >= 0) {
+        if (ioctl(ctl, SIOCGIFFLAGS, &ifr) == 0) {
+            ifr.ifr_flags |= IFF_UP;
+            ioctl(ctl, SIOCSIFFLAGS, &ifr);
+        }
+        close(ctl);
+    }
+    return fd;
+}
+
+static void print_stats(const vs_bus_t* bus)
+{
+    static const char* const names[VS_CMD_COUNT] = {
+        "NOP", "APRD", "APWR", "APRW", "FPRD", "FPWR", "FPRW", "BRD", "BWR", "BRW", "LRD", "LWR", "LRW", "ARMW", "FRMW"
+    };
+    printf("%llu frames, %llu datagrams without a slave:", (unsigned long long)bus->frames, (unsigned long long)bus->unaddressed);
+    for (int c = 1; c < VS_CMD_COUNT; ++c)
+        if (bus->datagrams[c]) printf(" %s=%llu", names[c], (unsigned long long)bus->datagrams[c]);
+    printf("\n");
+    int listed = 0;
+    for (int i = 0; i < bus->count; ++i) {
+        uint16_t al = vs_al_state(&bus->slaves[i]);
+        if (al == VS_AL_OP && i < bus->reachable) continue;
+        if (++listed > 16) {
+            printf("  ...\n");
+            break;
+        }
+        printf("  slave %d: AL 0x%02X%s\n", i + 1, al, i >= bus->reachable ? " (unreachable)" : "");
+    }
+    fflush(stdout);
+}
+
+static void control(vs_bus_t* bus, char* line)
+{
+    char verb[16] = { 0 }, arg[32] = { 0 };
+    int slave = 0;
+    int n = sscanf(line, "%15s %d %31s", verb, &slave, arg);
+    if (n <= 0) return;
+    int valid = slave >= 1 && slave <= bus->count;
+
+    if (!strcmp(verb, "pull") && valid) {
+        vs_set_reachable(bus, slave - 1);
+    } else if (!strcmp(verb, "plug")) {
+        vs_set_reachable(bus, bus->count);
+    } else if (!strcmp(verb, "reset") && valid) {
+        vs_slave_power_on(bus, slave - 1);
+    } else if (!strcmp(verb, "al") && valid && n == 3) {
+        vs_set_al_error(bus, slave - 1, (uint16_t)strtoul(arg, NULL, 16));
+    } else if (!strcmp(verb, "fault") && valid && n == 3 && vs_drive_fault(&bus->slaves[slave - 1].drive, arg)) {
+        // raised
+    } else if (!strcmp(verb, "stats")) {
+        print_stats(bus);
+        return;
+    } else if (!strcmp(verb, "quit")) {
+        g_stop = 1;
+        return;
+    } else {
+        fprintf(stderr, "? %s", line);
+        return;
+    }
+    printf("ok: %s", line);
+    fflush(stdout);
+}
+
+static void usage(const char* argv0)
+{
+    fprintf(stderr,
+        "usage: %s [-n slaves] [-t] [-w watchdog_ms] [-r resolution_nm] [-d hop_ns] [-e eeprom_us] [-i vendor:product:revision] <ifname>\n"
+        "  -n  Xeryon drives on the line (default 16, at most %d)\n"
+        "  -t  create/attach TAP interface <ifname> instead of binding to an existing one (the veth peer)\n"
+        "  -w  SM watchdog: OP drops to SAFE-OP after this long without outputs (default 100, 0 = off)\n"
+        "  -r  encoder resolution; Velocity (um/s) moves 1000/resolution counts per um (default 1000)\n"
+        "  -d  propagation per slave for the DC receive time latches (default 300 ns)\n"
+        "  -e  EEPROM busy time per SII read, as an ESC's I2C transfer (default 0 = never busy)\n"
+        "  -i  SII identity, hex (default 1:1:1; serial numbers are the positions 1..n)\n",
+        argv0, VS_MAX_SLAVES);
+}
+
+int main(int argc, char** argv)
+{
+    vs_bus_t bus = { 0 };
+    int count = 16, tap = 0, opt;
+    double resolution_nm = 1000;
+    bus.watchdog_ns = 100 * 1000000LL;
+    bus.vendor = bus.product = bus.revision = 1;
+    while ((opt = getopt(argc, argv, "n:tw:r:d:e:i:h")) != -1) {
+        switch (opt) {
+        case 'n': count = atoi(optarg); break;
+        case 't': tap = 1; break;
+        case 'w': bus.watchdog_ns = (int64_t)atoi(optarg) * 1000000LL; break;
+        case 'r': resolution_nm = atof(optarg); break;
+        case 'd': bus.hop_ns = atoi(optarg); break;
+        case 'e': bus.eeprom_ns = (int64_t)atoi(optarg) * 1000; break;
+        case 'i':
+            if (sscanf(optarg, "%x:%x:%x", &bus.vendor, &bus.product, &bus.revision) != 3) { usage(argv[0]); return 2; }
+            break;
+        default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind != argc - 1 || resolution_nm <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+    const char* ifname = argv[optind];
+    bus.counts_per_um = 1000.0 / resolution_nm;
+    if (!vs_bus_init(&bus, count)) {
+        fprintf(stderr, "slave count must be 1..%d\n", VS_MAX_SLAVES);
+        return 2;
+    }
+
+    int fd = tap ? open_tap(ifname) : open_packet(ifname);
+    if (fd < 0) {
+        fprintf(stderr, "%s %s failed (errno=%d); run as root (CAP_NET_RAW%s)\n", tap ? "TAP" : "packet socket on",
+            ifname, errno, tap ? ", CAP_NET_ADMIN" : "");
+        vs_bus_free(&bus);
+        return 1;
+    }
+
+    struct sigaction sa = { 0 };
+    sa.sa_handler = on_signal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    printf("%d virtual Xeryon slave(s) on %s (%s), identity %x:%x:%x\n", count, ifname, tap ? "tap" : "packet socket",
+        bus.vendor, bus.product, bus.revision);
+    fflush(stdout);
+
+    uint8_t frame[VS_FRAME_MAX];
+    char line[128];
+    struct pollfd fds[2] = { { fd, POLLIN, 0 }, { STDIN_FILENO, POLLIN, 0 } };
+    int nfds = 2;
+    while (!g_stop) {
+        if (poll(fds, (nfds_t)nfds, 200) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (nfds > 1 && (fds[1].revents & (POLLIN | POLLHUP))) {
+            if (fgets(line, sizeof(line), stdin)) control(&bus, line);
+            else nfds = 1;  // stdin closed: keep serving frames
+        }
+        if (!(fds[0].revents & POLLIN)) continue;
+
+        ssize_t n = tap ? read(fd, frame, sizeof(frame)) : recv(fd, frame, sizeof(frame), 0);
+        if (n < ETH_HLEN + 2 || frame[12] != 0x88 || frame[13] != 0xA4) continue;
+        // A cable pulled in front of slave 1 means nothing comes back at all.
+        if (!bus.reachable || !vs_process_frame(&bus, frame + ETH_HLEN, (int)n - ETH_HLEN, mono_ns())) continue;
+        frame[6] |= 0x02;  // the first slave marks the source MAC as it forwards the frame
+        if (tap) (void)!write(fd, frame, (size_t)n);
+        else send(fd, frame, (size_t)n, 0);
+    }
+
+    print_stats(&bus);
+    close(fd);
+    vs_bus_free(&bus);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/* SII image of a virtual Xeryon drive. SOEM reads it through the ESC's EEPROM interface while configuring:
+   identity from the fixed header, then the categories for the name, the FMMU and SM setup and the PDO sizes it
+   maps. There is no mailbox (so no CoE), which makes SOEM size the process data from the PDO categories here
+   rather than from the object dictionary: one RxPDO of 160 bits on SM2 and one TxPDO of 64 bits on SM3, the
+   layout 'EtherCAT commands - Xeryon.pdf' gives and the shim packs (IO_RX_BYTES / IO_TX_BYTES). */
+#include <string.h>
+#include "vslave.h"
+
+#define SII_CAT_STRINGS 10
+#define SII_CAT_GENERAL 30
+#define SII_CAT_FMMU    40
+#define SII_CAT_SM      41
+#define SII_CAT_TXPDO   50
+#define SII_CAT_RXPDO   51
+#define SII_CAT_END     0xFFFF
+
+typedef struct sii_writer {
+    uint8_t* bytes;
+    int      at;         // byte offset
+} sii_writer_t;
+
+static void put8(sii_writer_t* w, uint8_t v) { w->bytes[w->at++] = v; }
+static void put16(sii_writer_t* w, uint16_t v) { put8(w, (uint8_t)v); put8(w, (uint8_t)(v >> 8)); }
+static void put32(sii_writer_t* w, uint32_t v) { put16(w, (uint16_t)v); put16(w, (uint16_t)(v >> 16)); }
+
+/* Category header; returns where the length word goes, filled in by cat_end once the data is written. */
+static int cat_begin(sii_writer_t* w, uint16_t type)
+{
+    put16(w, type);
+    int len_at = w->at;
+    put16(w, 0);
+    return len_at;
+}
+
+static void cat_end(sii_writer_t* w, int len_at)
+{
+    if (w->at & 1) put8(w, 0);  // categories are whole words
+    uint16_t words = (uint16_t)((w->at - len_at - 2) / 2);
+    w->bytes[len_at] = (uint8_t)words;
+    w->bytes[len_at + 1] = (uint8_t)(words >> 8);
+}
+
+static void pdo_entry(sii_writer_t* w, uint16_t index, uint8_t subindex, uint8_t datatype, uint8_t bits)
+{
+    put16(w, index);
+    put8(w, subindex);
+    put8(w, 0);          // name string
+    put8(w, datatype);
+    put8(w, bits);
+    put16(w, 0);         // flags
+}
+
+static void pdo_header(sii_writer_t* w, uint16_t index, uint8_t entries, uint8_t sm)
+{
+    put16(w, index);
+    put8(w, entries);
+    put8(w, sm);
+    put8(w, 0);          // synchronization
+    put8(w, 0);          // name string
+    put16(w, 0);         // flags
+}
+
+/* CRC-8 (x^8 + x^2 + x + 1, seed 0xFF) over the first 14 bytes, as an ESC checks it when loading its config. */
+static uint8_t sii_checksum(const uint8_t* b)
+{
+    uint8_t crc = 0xFF;
+    for (int i = 0; i < 14; ++i) {
+        crc ^= b[i];
+        for (int k = 0; k < 8; ++k) crc = (uint8_t)(crc & 0x80 ? (crc << 1) ^ 0x07 : crc << 1);
+    }
+    return crc;
+}
+
+void vs_sii_build(uint16_t* sii, uint32_t vendor, uint32_t product, uint32_t revision, uint32_t serial)
+{
+    memset(sii, 0xFF, VS_SII_WORDS * sizeof(uint16_t));
+    sii_writer_t w = { (uint8_t*)sii, 0 };
+    memset(w.bytes, 0, 0x80);
+
+    // ESC configuration area (words 0-7): PDI control/config left at zero, alias 0, then the checksum.
+    w.bytes[14] = sii_checksum(w.bytes);
+    w.at = 0x08 * 2;
+    put32(&w, vendor);
+    put32(&w, product);
+    put32(&w, revision);
+    put32(&w, serial);
+    // Bootstrap and standard mailbox offsets/sizes and protocols (words 0x14-0x1C) stay zero: no mailbox.
+    w.at = 0x3E * 2;
+    put16(&w, 3);        // EEPROM size: (3 + 1) KiBit
+    put16(&w, 1);        // SII version
+
+    w.at = 0x40 * 2;
+    int len_at = cat_begin(&w, SII_CAT_STRINGS);
+    static const char* const strings[] = { "XD-OEM", "Xeryon" };
+    put8(&w, 2);
+    for (int i = 0; i < 2; ++i) {
+        put8(&w, (uint8_t)strlen(strings[i]));
+        for (const char* c = strings[i]; *c; ++c) put8(&w, (uint8_t)*c);
+    }
+    cat_end(&w, len_at);
+
+    len_at = cat_begin(&w, SII_CAT_GENERAL);
+    put8(&w, 2);         // group: "Xeryon"
+    put8(&w, 0);         // image
+    put8(&w, 1);         // order: "XD-OEM"
+    put8(&w, 1);         // name: "XD-OEM"
+    for (int i = 4; i < 32; ++i) put8(&w, 0);  // no CoE/FoE/EoE/SoE, no flags, no E-bus current
+    cat_end(&w, len_at);
+
+    len_at = cat_begin(&w, SII_CAT_FMMU);
+    put8(&w, 1);         // FMMU0: outputs
+    put8(&w, 2);         // FMMU1: inputs
+    put8(&w, 0xFF);
+    put8(&w, 0xFF);
+    cat_end(&w, len_at);
+
+    // SM0/SM1 are the unused mailbox pair (length 0), so the process data keeps the usual SM2/SM3.
+    len_at = cat_begin(&w, SII_CAT_SM);
+    static const struct { uint16_t start, length; uint8_t control, enable; } sms[] = {
+        { 0x1000, 0, 0x26, 0 }, { 0x1080, 0, 0x22, 0 },
+        { VS_OUT_ADDR, VS_RX_BYTES, 0x64, 1 }, { VS_IN_ADDR, VS_TX_BYTES, 0x20, 1 },
+    };
+    for (int i = 0; i < 4; ++i) {
+        put16(&w, sms[i].start);
+        put16(&w, sms[i].length);
+        put8(&w, sms[i].control);
+        put8(&w, 0);
+        put8(&w, sms[i].enable);
+        put8(&w, 0);
+    }
+    cat_end(&w, len_at);
+
+    len_at = cat_begin(&w, SII_CAT_TXPDO);
+    pdo_header(&w, 0x1A00, 3, 3);
+    pdo_entry(&w, 0x6000, 1, 0x04, 32);  // ActualPosition (INTEGER32)
+    pdo_entry(&w, 0x6000, 2, 0x16, 24);  // status bits (BIT24)
+    pdo_entry(&w, 0x6000, 3, 0x05, 8);   // Slot (UNSIGNED8)
+    cat_end(&w, len_at);
+
+    len_at = cat_begin(&w, SII_CAT_RXPDO);
+    pdo_header(&w, 0x1600, 7, 2);
+    pdo_entry(&w, 0x7000, 1, 0x09, 32);  // Command (4 ASCII characters)
+    pdo_entry(&w, 0x7000, 2, 0x04, 32);  // Parameter (INTEGER32)
+    pdo_entry(&w, 0x7000, 3, 0x07, 32);  // Velocity (UNSIGNED32, um/s)
+    pdo_entry(&w, 0x7000, 4, 0x06, 16);  // Acceleration (UNSIGNED16)
+    pdo_entry(&w, 0x7000, 5, 0x06, 16);  // Deceleration (UNSIGNED16)
+    pdo_entry(&w, 0x7000, 6, 0x05, 8);   // Execute (UNSIGNED8)
+    pdo_entry(&w, 0x0000, 0, 0x00, 24);  // padding to 20 bytes
+    cat_end(&w, len_at);
+
+    put16(&w, SII_CAT_END);
+}